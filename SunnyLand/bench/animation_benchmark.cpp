@@ -0,0 +1,117 @@
+// Cost of advancing animated actors, per 10k actors.
+// Build with -DSUNNYLAND_BUILD_BENCHMARKS=ON and run in Release from the SunnyLand directory.
+#include "../src/engine/animation/animation_library.h"
+#include "../src/engine/animation/animation_system.h"
+#include "../src/engine/animation/animator.h"
+#include "../src/engine/ecs/world.h"
+#include "../src/engine/ecs/components.h"
+#include "../src/engine/ecs/command_buffer.h"
+#include "../src/engine/core/job_system.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using engine::animation::Animator;
+    using engine::ecs::SpriteComponent;
+
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    void report(const char *name, Clock::time_point begin, std::size_t iterations, std::size_t actors)
+    {
+        double total_us = std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+        double per_update_us = total_us / static_cast<double>(iterations);
+        std::printf("%-34s %10.2f us/update %8.2f us per 10k actors\n", name, per_update_us,
+                    per_update_us * 10000.0 / static_cast<double>(actors));
+    }
+
+    engine::animation::AnimationLibrary loadLibrary()
+    {
+        engine::animation::AnimationLibrary library;
+        try
+        {
+            library.loadFromFile("assets/animations.json");
+        }
+        catch (const std::exception &e)
+        {
+            std::printf("%s\nUsing built-in clips instead.\n", e.what());
+            std::vector<engine::animation::AnimationFrame> frames;
+            for (int i = 0; i < 4; ++i)
+            {
+                frames.push_back({{static_cast<float>(i) * 40.0f, 0.0f, 40.0f, 41.0f}, 0.1f});
+            }
+            library.addClip("eagle_attack", "assets/textures/Actors/eagle-attack.png", frames, engine::animation::LoopMode::Loop);
+            frames[0].duration = 1.5f;
+            library.addClip("uneven", "assets/textures/Actors/eagle-attack.png", frames, engine::animation::LoopMode::PingPong);
+        }
+        return library;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t actor_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    std::size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+    engine::animation::AnimationLibrary library = loadLibrary();
+    std::printf("Animation benchmark: %zu actors, %zu clips, %zu updates\n", actor_count, library.getClipCount(), iterations);
+
+    // Actors cycle through all clips, with staggered start times
+    std::vector<Animator> animators(actor_count);
+    std::vector<SpriteComponent> sprites(actor_count);
+    for (std::size_t i = 0; i < actor_count; ++i)
+    {
+        animators[i].play(static_cast<engine::animation::AnimationClipId>(i % library.getClipCount()));
+        animators[i].time = static_cast<float>(i % 97) * 0.01f;
+    }
+
+    auto begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        engine::animation::advanceAnimators(library, animators.data(), sprites.data(), actor_count, DELTA_TIME);
+    }
+    report("advanceAnimators (arrays)", begin, iterations, actor_count);
+
+    // The same through the ECS, as GameApp runs it
+    engine::ecs::World world;
+    world.reserve<engine::ecs::Transform, SpriteComponent, Animator>(actor_count);
+    for (std::size_t i = 0; i < actor_count; ++i)
+    {
+        Animator animator;
+        animator.play(static_cast<engine::animation::AnimationClipId>(i % library.getClipCount()));
+        animator.time = static_cast<float>(i % 97) * 0.01f;
+        world.createEntity(engine::ecs::Transform{}, SpriteComponent{}, animator);
+    }
+    engine::core::JobSystem jobs(0);
+    engine::ecs::CommandBuffer commands;
+    engine::animation::AnimationSystem system(world, library);
+
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        system.update({world, commands, jobs, DELTA_TIME});
+    }
+    report("AnimationSystem (1 thread)", begin, iterations, actor_count);
+
+    engine::core::JobSystem parallel_jobs;
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        system.update({world, commands, parallel_jobs, DELTA_TIME});
+    }
+    char name[64];
+    std::snprintf(name, sizeof(name), "AnimationSystem (%zu-thread pool)", parallel_jobs.getThreadCount());
+    report(name, begin, iterations, actor_count);
+
+    // Printed so the compiler cannot drop the loops
+    float checksum = 0.0f;
+    for (const SpriteComponent &sprite : sprites)
+    {
+        checksum += sprite.source_rect.x;
+    }
+    std::printf("checksum: %.1f\n", checksum);
+    return 0;
+}
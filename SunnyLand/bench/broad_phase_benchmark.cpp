@@ -0,0 +1,163 @@
+// Cost of the sweep and prune broad phase with many moving bounds, checked against brute force.
+// Build with -DSUNNYLAND_BUILD_BENCHMARKS=ON and run in Release.
+#include "../src/engine/physics/broad_phase.h"
+#include "../src/engine/utils/random.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using engine::physics::BroadPhase;
+    using engine::physics::CollisionLayers;
+    using engine::utils::Rect;
+
+    struct Body
+    {
+        Rect bounds;
+        glm::vec2 velocity;
+        CollisionLayers layers;
+        CollisionLayers mask;
+    };
+
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    /// @brief Actors collide with everything, items and triggers only with actors.
+    std::vector<Body> makeBodies(std::size_t count, float world_size)
+    {
+        engine::utils::Random random(7);
+        std::vector<Body> bodies(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Body &body = bodies[i];
+            body.bounds.position = {random.range(0.0f, world_size), random.range(0.0f, world_size)};
+            body.bounds.size = {random.range(8.0f, 32.0f), random.range(8.0f, 32.0f)};
+            body.velocity = {random.range(-120.0f, 120.0f), random.range(-120.0f, 120.0f)};
+            switch (i % 4)
+            {
+            case 0:
+            case 1:
+                body.layers = 1;
+                body.mask = 1 | 2 | 4;
+                break;
+            case 2:
+                body.layers = 2;
+                body.mask = 1;
+                break;
+            default:
+                body.layers = 4;
+                body.mask = 1;
+                break;
+            }
+        }
+        return bodies;
+    }
+
+    void moveBodies(std::vector<Body> &bodies, float world_size)
+    {
+        for (Body &body : bodies)
+        {
+            body.bounds.position += body.velocity * DELTA_TIME;
+            if (body.bounds.position.x < 0.0f || body.bounds.position.x > world_size)
+                body.velocity.x = -body.velocity.x;
+            if (body.bounds.position.y < 0.0f || body.bounds.position.y > world_size)
+                body.velocity.y = -body.velocity.y;
+        }
+    }
+
+    std::size_t bruteForcePairs(const std::vector<Body> &bodies)
+    {
+        std::size_t pairs = 0;
+        for (std::size_t i = 0; i < bodies.size(); ++i)
+        {
+            const Body &a = bodies[i];
+            for (std::size_t j = i + 1; j < bodies.size(); ++j)
+            {
+                const Body &b = bodies[j];
+                if ((a.layers & b.mask) == 0 || (b.layers & a.mask) == 0)
+                    continue;
+                if (a.bounds.position.x <= b.bounds.position.x + b.bounds.size.x && b.bounds.position.x <= a.bounds.position.x + a.bounds.size.x &&
+                    a.bounds.position.y <= b.bounds.position.y + b.bounds.size.y && b.bounds.position.y <= a.bounds.position.y + a.bounds.size.y)
+                    ++pairs;
+            }
+        }
+        return pairs;
+    }
+
+    double elapsedUs(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t body_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    std::size_t frames = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 120;
+    // Keeps the density similar for every body count: about one body per 64x64 area
+    float world_size = 64.0f * std::sqrt(static_cast<float>(body_count));
+
+    std::vector<Body> bodies = makeBodies(body_count, world_size);
+    BroadPhase broad_phase;
+    std::vector<engine::physics::ProxyId> proxies;
+    for (const Body &body : bodies)
+    {
+        proxies.push_back(broad_phase.createProxy(body.bounds, body.layers, body.mask));
+    }
+
+    auto begin = Clock::now();
+    broad_phase.update();
+    std::printf("Broad phase benchmark: %zu bodies in %.0fx%.0f\n", body_count, world_size, world_size);
+    std::printf("%-24s %10.1f us\n", "first update (sort)", elapsedUs(begin));
+
+    double total_us = 0.0;
+    double max_us = 0.0;
+    std::size_t swaps = 0, tested = 0, filtered = 0, found = 0, full_sorts = 0;
+    for (std::size_t frame = 0; frame < frames; ++frame)
+    {
+        moveBodies(bodies, world_size);
+        begin = Clock::now();
+        for (std::size_t i = 0; i < bodies.size(); ++i)
+        {
+            broad_phase.moveProxy(proxies[i], bodies[i].bounds);
+        }
+        broad_phase.update();
+        double us = elapsedUs(begin);
+        total_us += us;
+        max_us = std::max(max_us, us);
+
+        const engine::physics::BroadPhaseStats &stats = broad_phase.getStats();
+        swaps += stats.endpoint_swaps;
+        tested += stats.pairs_tested;
+        filtered += stats.pairs_filtered;
+        found += stats.pairs_found;
+        full_sorts += stats.full_sort ? 1 : 0;
+    }
+    double n = static_cast<double>(frames);
+    std::printf("%-24s %10.1f us/frame (max %.1f us)\n", "incremental update", total_us / n, max_us);
+    std::printf("per frame: %.0f endpoint swaps, %.0f pairs tested, %.0f filtered, %.0f found, %zu full sorts\n",
+                static_cast<double>(swaps) / n, static_cast<double>(tested) / n, static_cast<double>(filtered) / n,
+                static_cast<double>(found) / n, full_sorts);
+    std::printf("pairs tested vs. all pairs: %.4f%%\n",
+                100.0 * static_cast<double>(tested) / n / (static_cast<double>(body_count) * static_cast<double>(body_count - 1) / 2.0));
+
+    // Brute force is quadratic, so it is only run on small counts
+    if (body_count <= 20000)
+    {
+        begin = Clock::now();
+        std::size_t expected = bruteForcePairs(bodies);
+        double brute_us = elapsedUs(begin);
+        std::printf("%-24s %10.1f us, %zu pairs (sweep and prune found %zu)\n", "brute force", brute_us, expected,
+                    broad_phase.getPairs().size());
+        if (expected != broad_phase.getPairs().size())
+        {
+            std::printf("MISMATCH\n");
+            return 1;
+        }
+    }
+    return 0;
+}
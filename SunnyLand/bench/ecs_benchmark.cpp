@@ -0,0 +1,174 @@
+// Iteration and structural-change timings of the ECS with 1M entities of 3 components.
+// Build with -DSUNNYLAND_BUILD_BENCHMARKS=ON and run in Release.
+#include "../src/engine/ecs/world.h"
+#include "../src/engine/ecs/components.h"
+#include "../src/engine/ecs/parallel_query.h"
+#include "../src/engine/core/job_system.h"
+#include "../src/engine/utils/string_id.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using engine::ecs::SpriteComponent;
+    using engine::ecs::Transform;
+    using engine::ecs::Velocity;
+
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    double elapsedMs(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    void report(const char *name, double total_ms, std::size_t iterations, std::size_t entities)
+    {
+        double per_iteration = total_ms / static_cast<double>(iterations);
+        std::printf("%-36s %10.3f ms %8.2f ns/entity\n", name, per_iteration,
+                    per_iteration * 1000000.0 / static_cast<double>(entities));
+    }
+
+    /// @brief Array-of-structs baseline: what ad-hoc game object classes would look like in memory.
+    struct GameObject
+    {
+        Transform transform;
+        Velocity velocity;
+        SpriteComponent sprite;
+    };
+
+    float sumPositions(engine::ecs::World &world)
+    {
+        float sum = 0.0f;
+        world.query<Transform>().each<Transform>([&sum](const Transform &transform)
+                                                 { sum += transform.position.x + transform.position.y; });
+        return sum;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t entity_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+    std::printf("ECS benchmark: %zu entities, %zu iterations\n", entity_count, iterations);
+
+    SpriteComponent sprite;
+    sprite.texture_id = engine::utils::StringTable::intern("assets/textures/Actors/frog.png");
+    sprite.source_rect = {0.0f, 0.0f, 35.0f, 32.0f};
+
+    engine::ecs::World world;
+    auto begin = Clock::now();
+    world.reserve<Transform, Velocity, SpriteComponent>(entity_count);
+    for (std::size_t i = 0; i < entity_count; ++i)
+    {
+        Transform transform;
+        transform.position = glm::vec2(static_cast<float>(i % 1000), static_cast<float>(i / 1000));
+        world.createEntity(transform, Velocity{glm::vec2(1.0f, 0.5f)}, sprite);
+    }
+    report("create", elapsedMs(begin), 1, entity_count);
+
+    engine::ecs::Query &query = world.query<Transform, Velocity, SpriteComponent>();
+
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        query.each<Transform, Velocity>([](Transform &transform, const Velocity &velocity)
+                                        { transform.position += velocity.value * DELTA_TIME; });
+    }
+    report("Query::each<Transform, Velocity>", elapsedMs(begin), iterations, entity_count);
+
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        query.forEachArchetype([](engine::ecs::Archetype &archetype)
+                               {
+                                   auto transforms = archetype.column<Transform>();
+                                   auto velocities = archetype.column<Velocity>();
+                                   for (std::size_t i = 0; i < transforms.size(); ++i)
+                                   {
+                                       transforms[i].position += velocities[i].value * DELTA_TIME;
+                                   } });
+    }
+    report("Query::forEachArchetype (columns)", elapsedMs(begin), iterations, entity_count);
+
+    begin = Clock::now();
+    std::size_t visible = 0;
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        query.each<Transform, SpriteComponent>([&visible](const Transform &transform, const SpriteComponent &entity_sprite)
+                                               {
+                                                   if (transform.position.x + entity_sprite.source_rect.w >= 0.0f && transform.position.x <= 1280.0f &&
+                                                       transform.position.y + entity_sprite.source_rect.h >= 0.0f && transform.position.y <= 720.0f)
+                                                   {
+                                                       ++visible;
+                                                   } });
+    }
+    report("Query::each<Transform, Sprite> cull", elapsedMs(begin), iterations, entity_count);
+
+    engine::core::JobSystem jobs;
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        engine::ecs::parallelForEachChunk(query, jobs, 4096, [](engine::ecs::Archetype &archetype, std::size_t first, std::size_t last)
+                                          {
+                                              auto transforms = archetype.column<Transform>();
+                                              auto velocities = archetype.column<Velocity>();
+                                              for (std::size_t i = first; i < last; ++i)
+                                              {
+                                                  transforms[i].position += velocities[i].value * DELTA_TIME;
+                                              } });
+    }
+    char parallel_name[64];
+    std::snprintf(parallel_name, sizeof(parallel_name), "parallelForEachChunk (%zu threads)", jobs.getThreadCount());
+    report(parallel_name, elapsedMs(begin), iterations, entity_count);
+
+    std::vector<GameObject> objects(entity_count, GameObject{Transform{}, Velocity{glm::vec2(1.0f, 0.5f)}, sprite});
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        for (GameObject &object : objects)
+        {
+            object.transform.position += object.velocity.value * DELTA_TIME;
+        }
+    }
+    report("AoS baseline (std::vector<GameObject>)", elapsedMs(begin), iterations, entity_count);
+
+    // Structural changes: remove Velocity from every other entity, then destroy them, all deferred
+    std::vector<engine::ecs::Entity> entities;
+    entities.reserve(entity_count);
+    query.eachWithEntity<>([&entities](engine::ecs::Entity entity)
+                           { entities.push_back(entity); });
+    engine::ecs::CommandBuffer &commands = world.getCommandBuffer();
+
+    begin = Clock::now();
+    for (std::size_t i = 0; i < entities.size(); i += 2)
+    {
+        commands.removeComponent<Velocity>(entities[i]);
+    }
+    world.flushCommands();
+    report("CommandBuffer remove Velocity (1/2)", elapsedMs(begin), 1, entity_count / 2);
+
+    begin = Clock::now();
+    for (std::size_t i = 0; i < entities.size(); i += 2)
+    {
+        commands.destroyEntity(entities[i]);
+    }
+    world.flushCommands();
+    report("CommandBuffer destroy (1/2)", elapsedMs(begin), 1, entity_count / 2);
+
+    begin = Clock::now();
+    for (std::size_t i = 0; i < entity_count / 2; ++i)
+    {
+        commands.createEntity(Transform{}, Velocity{glm::vec2(1.0f, 0.5f)}, sprite);
+    }
+    world.flushCommands();
+    report("CommandBuffer create (1/2)", elapsedMs(begin), 1, entity_count / 2);
+
+    // Printed so the compiler cannot drop the loops
+    std::printf("checksum: %.1f, visible: %zu, entities: %zu, archetypes: %zu\n",
+                sumPositions(world) + objects.back().transform.position.x, visible, world.getEntityCount(),
+                world.getArchetypes().size());
+    return 0;
+}
@@ -0,0 +1,347 @@
+// Microbenchmarks of engine hot paths: resource lookups, camera transforms, sprite and parallax drawing on the
+// software renderer, and Time::update. Results are written as JSON so two builds can be diffed.
+// Build with -DSUNNYLAND_BUILD_BENCHMARKS=ON and run in Release from the SunnyLand directory (it loads assets/):
+//   SunnyLand-engine-benchmark [--out results.json] [--baseline old.json] [--threshold 5] [--samples 25] [--filter name]
+// Every benchmark is run in batches of at least 10 ms; the median batch is reported with its spread. With --baseline,
+// benchmarks whose median got slower by more than the threshold (percent) are listed and the exit code is 1.
+#include "../src/engine/resource/resource_manager.h"
+#include "../src/engine/render/renderer.h"
+#include "../src/engine/render/camera.h"
+#include "../src/engine/render/sprite.h"
+#include "../src/engine/core/time.h"
+#include <SDL3/SDL.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double MIN_SAMPLE_NS = 10.0 * 1000000.0;
+    constexpr int WARMUP_SAMPLES = 3;
+
+    const std::vector<std::string> TEXTURES = {
+        "assets/textures/Actors/foxy.png",
+        "assets/textures/Actors/frog.png",
+        "assets/textures/Actors/opossum.png",
+        "assets/textures/Actors/eagle-attack.png",
+        "assets/textures/Props/crate.png",
+        "assets/textures/Props/bush.png",
+        "assets/textures/Layers/back.png",
+        "assets/textures/Layers/middle.png",
+    };
+    const std::vector<std::string> SOUNDS = {
+        "assets/audio/button_click.wav",
+        "assets/audio/button_hover.wav",
+        "assets/audio/punch2a.mp3",
+        "assets/audio/poka01.mp3",
+    };
+    const std::string FONT = "assets/fonts/VonwaonBitmap-16px.ttf";
+    const std::vector<int> FONT_SIZES = {16, 24, 32};
+
+    /// @brief Keeps results alive so the optimizer cannot drop the measured work.
+    volatile std::uintptr_t sink = 0;
+
+    template <typename T>
+    void keep(T *pointer)
+    {
+        sink = sink ^ reinterpret_cast<std::uintptr_t>(pointer);
+    }
+
+    void keep(const glm::vec2 &value)
+    {
+        sink = sink ^ static_cast<std::uintptr_t>(value.x + value.y);
+    }
+
+    struct Options
+    {
+        std::string out_path = "engine_benchmark.json";
+        std::string baseline_path;
+        double threshold_percent = 5.0;
+        int samples = 25;
+        std::string filter;
+    };
+
+    struct Result
+    {
+        std::string name;
+        std::uint64_t ops_per_sample = 0;
+        double median_ns = 0.0;
+        double min_ns = 0.0;
+        double p90_ns = 0.0;
+        /// @brief Median absolute deviation of the samples, relative to the median.
+        double mad_percent = 0.0;
+    };
+
+    /// @brief Runs body(n) in batches of n operations and collects the time per operation of each batch.
+    class Runner final
+    {
+    private:
+        const Options &options_;
+        std::vector<Result> results_;
+
+        static double runBatch(const std::function<void(std::uint64_t)> &body, std::uint64_t ops)
+        {
+            auto begin = Clock::now();
+            body(ops);
+            return std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+        }
+
+    public:
+        explicit Runner(const Options &options) : options_(options) {}
+
+        void run(const std::string &name, const std::function<void(std::uint64_t)> &body)
+        {
+            if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos)
+            {
+                return;
+            }
+
+            // Grow the batch until it is long enough that timer resolution and scheduling noise stop mattering
+            std::uint64_t ops = 1;
+            while (runBatch(body, ops) < MIN_SAMPLE_NS && ops < (std::uint64_t{1} << 40))
+            {
+                ops *= 2;
+            }
+            for (int i = 0; i < WARMUP_SAMPLES; ++i)
+            {
+                runBatch(body, ops);
+            }
+
+            std::vector<double> per_op(static_cast<std::size_t>(std::max(options_.samples, 1)));
+            for (double &sample : per_op)
+            {
+                sample = runBatch(body, ops) / static_cast<double>(ops);
+            }
+            std::sort(per_op.begin(), per_op.end());
+
+            Result result;
+            result.name = name;
+            result.ops_per_sample = ops;
+            result.median_ns = per_op[per_op.size() / 2];
+            result.min_ns = per_op.front();
+            result.p90_ns = per_op[std::min(per_op.size() - 1, per_op.size() * 9 / 10)];
+            std::vector<double> deviations(per_op.size());
+            std::transform(per_op.begin(), per_op.end(), deviations.begin(), [&result](double sample)
+                           { return std::abs(sample - result.median_ns); });
+            std::nth_element(deviations.begin(), deviations.begin() + static_cast<std::ptrdiff_t>(deviations.size() / 2), deviations.end());
+            result.mad_percent = result.median_ns > 0.0 ? deviations[deviations.size() / 2] * 100.0 / result.median_ns : 0.0;
+
+            std::printf("%-36s %12.2f ns/op  min %10.2f  p90 %10.2f  mad %5.2f%%\n", name.c_str(), result.median_ns,
+                        result.min_ns, result.p90_ns, result.mad_percent);
+            results_.push_back(result);
+        }
+
+        const std::vector<Result> &getResults() const { return results_; }
+    };
+
+    Options parseOptions(int argc, char **argv)
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+            bool has_value = i + 1 < argc;
+            if (arg == "--out" && has_value)
+                options.out_path = argv[++i];
+            else if (arg == "--baseline" && has_value)
+                options.baseline_path = argv[++i];
+            else if (arg == "--threshold" && has_value)
+                options.threshold_percent = std::atof(argv[++i]);
+            else if (arg == "--samples" && has_value)
+                options.samples = std::atoi(argv[++i]);
+            else if (arg == "--filter" && has_value)
+                options.filter = argv[++i];
+            else
+                std::fprintf(stderr, "Ignoring unknown argument: %s\n", argv[i]);
+        }
+        return options;
+    }
+
+    nlohmann::json toJson(const Options &options, const std::vector<Result> &results)
+    {
+        nlohmann::json json;
+        json["suite"] = "engine";
+#ifdef NDEBUG
+        json["build"] = "release";
+#else
+        json["build"] = "debug";
+#endif
+        json["samples"] = options.samples;
+        json["results"] = nlohmann::json::array();
+        for (const Result &result : results)
+        {
+            json["results"].push_back({{"name", result.name},
+                                       {"ops_per_sample", result.ops_per_sample},
+                                       {"median_ns", result.median_ns},
+                                       {"min_ns", result.min_ns},
+                                       {"p90_ns", result.p90_ns},
+                                       {"mad_percent", result.mad_percent}});
+        }
+        return json;
+    }
+
+    /// @brief Prints the change of every benchmark against the baseline. Returns the number of regressions.
+    int compareWithBaseline(const Options &options, const std::vector<Result> &results)
+    {
+        std::ifstream file(options.baseline_path);
+        if (!file.is_open())
+        {
+            std::fprintf(stderr, "Cannot open baseline %s\n", options.baseline_path.c_str());
+            return 0;
+        }
+        nlohmann::json baseline = nlohmann::json::parse(file, nullptr, false);
+        if (baseline.is_discarded() || !baseline.contains("results"))
+        {
+            std::fprintf(stderr, "Baseline %s is not a benchmark result file\n", options.baseline_path.c_str());
+            return 0;
+        }
+
+        std::printf("\nAgainst %s (threshold %.1f%%):\n", options.baseline_path.c_str(), options.threshold_percent);
+        int regressions = 0;
+        for (const Result &result : results)
+        {
+            auto it = std::find_if(baseline["results"].begin(), baseline["results"].end(), [&result](const nlohmann::json &entry)
+                                   { return entry.value("name", "") == result.name; });
+            if (it == baseline["results"].end())
+            {
+                continue;
+            }
+            double base = it->value("median_ns", 0.0);
+            if (base <= 0.0)
+            {
+                continue;
+            }
+            double change = (result.median_ns - base) * 100.0 / base;
+            bool regressed = change > options.threshold_percent;
+            regressions += regressed ? 1 : 0;
+            std::printf("%-36s %+7.2f%%%s\n", result.name.c_str(), change, regressed ? "  REGRESSION" : "");
+        }
+        return regressions;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options = parseOptions(argc, argv);
+    spdlog::set_level(spdlog::level::warn);
+
+    // No window or audio hardware needed: draw into a surface and mix into the dummy driver
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    if (!SDL_Init(SDL_INIT_AUDIO))
+    {
+        std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Surface *surface = SDL_CreateSurface(1280, 720, SDL_PIXELFORMAT_RGBA8888);
+    SDL_Renderer *sdl_renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!sdl_renderer)
+    {
+        std::fprintf(stderr, "Failed to create the software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    int exit_code = 0;
+    {
+        std::unique_ptr<engine::resource::ResourceManager> resources;
+        try
+        {
+            resources = std::make_unique<engine::resource::ResourceManager>(sdl_renderer);
+        }
+        catch (const std::exception &e)
+        {
+            std::fprintf(stderr, "Failed to create the ResourceManager: %s\n", e.what());
+            return 1;
+        }
+        for (const std::string &path : TEXTURES)
+            resources->loadTexture(path);
+        for (const std::string &path : SOUNDS)
+            resources->loadSound(path);
+        for (int size : FONT_SIZES)
+            resources->loadFont(FONT, size);
+
+        engine::render::Renderer renderer(resources.get(), sdl_renderer);
+        engine::render::Camera camera(glm::vec2(1280.0f, 720.0f), glm::vec2(37.0f, 11.0f));
+        engine::core::Time time;
+        Runner runner(options);
+
+        runner.run("resource.getTexture", [&](std::uint64_t ops)
+                   {
+                       for (std::uint64_t i = 0; i < ops; ++i)
+                           keep(resources->getTexture(TEXTURES[i % TEXTURES.size()]));
+                   });
+        runner.run("resource.getSound", [&](std::uint64_t ops)
+                   {
+                       for (std::uint64_t i = 0; i < ops; ++i)
+                           keep(resources->getSound(SOUNDS[i % SOUNDS.size()]));
+                   });
+        runner.run("resource.getFont", [&](std::uint64_t ops)
+                   {
+                       for (std::uint64_t i = 0; i < ops; ++i)
+                           keep(resources->getFont(FONT, FONT_SIZES[i % FONT_SIZES.size()]));
+                   });
+
+        std::vector<glm::vec2> positions(1024);
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            positions[i] = glm::vec2(static_cast<float>(i * 37 % 2000), static_cast<float>(i * 53 % 1200));
+        }
+        runner.run("camera.worldToScreen", [&](std::uint64_t ops)
+                   {
+                       for (std::uint64_t i = 0; i < ops; ++i)
+                           keep(camera.worldToScreen(positions[i & 1023]));
+                   });
+        runner.run("camera.worldToViewportWithParallax", [&](std::uint64_t ops)
+                   {
+                       const glm::vec2 scroll_factor(0.5f, 0.25f);
+                       for (std::uint64_t i = 0; i < ops; ++i)
+                           keep(camera.worldToViewportWithParallax(positions[i & 1023], scroll_factor));
+                   });
+
+        engine::render::Sprite sprite("assets/textures/Props/crate.png");
+        runner.run("renderer.drawSprite", [&](std::uint64_t ops)
+                   {
+                       for (std::uint64_t i = 0; i < ops; ++i)
+                           renderer.drawSprite(camera, sprite, positions[i & 1023]);
+                   });
+        engine::render::Sprite layer("assets/textures/Layers/back.png");
+        runner.run("renderer.drawParallax", [&](std::uint64_t ops)
+                   {
+                       for (std::uint64_t i = 0; i < ops; ++i)
+                           renderer.drawParallax(camera, layer, glm::vec2(0.0f, 0.0f), glm::vec2(0.5f, 0.0f), glm::bvec2(true, false), glm::vec2(3.0f, 3.0f));
+                   });
+
+        runner.run("time.update", [&](std::uint64_t ops)
+                   {
+                       for (std::uint64_t i = 0; i < ops; ++i)
+                           time.update();
+                       sink = sink ^ static_cast<std::uintptr_t>(time.getDeltaTime() * 1e9f);
+                   });
+
+        std::ofstream out(options.out_path);
+        out << toJson(options, runner.getResults()).dump(2) << '\n';
+        std::printf("Wrote %s\n", options.out_path.c_str());
+
+        if (!options.baseline_path.empty() && compareWithBaseline(options, runner.getResults()) > 0)
+        {
+            exit_code = 1;
+        }
+    }
+
+    SDL_DestroyRenderer(sdl_renderer);
+    SDL_DestroySurface(surface);
+    SDL_Quit();
+    return exit_code;
+}
@@ -0,0 +1,93 @@
+// Parse times of the JSON assets as text and as their cooked binary forms.
+// Build with -DSUNNYLAND_BUILD_BENCHMARKS=ON and run in Release from the game directory:
+//   SunnyLand-json-cache-benchmark [iterations] [file ...]
+// The default files are the biggest JSON assets. Times are per parse from memory, except "read + text", which reads
+// the file first, and loadJson(), which parses the text below COOKED_JSON_MIN_SIZE and maps the cooked copy above it.
+#include "../src/engine/utils/json_cache.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    template <typename Function>
+    double timeUs(std::size_t iterations, Function &&function)
+    {
+        auto begin = Clock::now();
+        for (std::size_t n = 0; n < iterations; ++n)
+        {
+            function();
+        }
+        return std::chrono::duration<double, std::micro>(Clock::now() - begin).count() / static_cast<double>(iterations);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+    std::vector<std::string> files;
+    for (int i = 2; i < argc; ++i)
+    {
+        files.emplace_back(argv[i]);
+    }
+    if (files.empty())
+    {
+        files = {"assets/maps/level1.tmj", "assets/animations.json", "assets/manifest.json"};
+    }
+    spdlog::set_level(spdlog::level::warn);
+
+    std::printf("%-28s %9s %9s %9s %13s %10s %9s %11s\n", "file", "bytes", "msgpack", "text us", "read+text us", "msgpack us",
+                "cbor us", "loadJson us");
+    for (const std::string &file_path : files)
+    {
+        std::ifstream file(file_path, std::ios::binary);
+        if (!file)
+        {
+            std::fprintf(stderr, "Cannot open %s\n", file_path.c_str());
+            continue;
+        }
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        nlohmann::json json = nlohmann::json::parse(text);
+        std::vector<std::uint8_t> msgpack = nlohmann::json::to_msgpack(json);
+        std::vector<std::uint8_t> cbor = nlohmann::json::to_cbor(json);
+
+        std::size_t sink = 0;
+        double text_us = timeUs(iterations, [&]
+                                { sink += nlohmann::json::parse(text).size(); });
+        double read_text_us = timeUs(iterations, [&]
+                                     {
+                                         std::ifstream source(file_path, std::ios::binary);
+                                         sink += nlohmann::json::parse(source).size(); });
+        double msgpack_us = timeUs(iterations, [&]
+                                   { sink += nlohmann::json::from_msgpack(msgpack).size(); });
+        double cbor_us = timeUs(iterations, [&]
+                                { sink += nlohmann::json::from_cbor(cbor).size(); });
+
+        // Leave the asset directory as it was
+        const std::string cooked_path = engine::utils::getCookedJsonPath(file_path);
+        bool had_cooked = std::filesystem::exists(cooked_path);
+        engine::utils::cookJson(file_path);
+        double load_us = timeUs(iterations, [&]
+                                { sink += engine::utils::loadJson(file_path).size(); });
+        if (!had_cooked)
+        {
+            std::filesystem::remove(cooked_path);
+        }
+
+        std::printf("%-28s %9zu %9zu %9.1f %13.1f %10.1f %9.1f %11.1f\n", file_path.c_str(), text.size(), msgpack.size(), text_us,
+                    read_text_us, msgpack_us, cbor_us, load_us);
+        if (sink == 0)
+        {
+            std::printf("(empty documents)\n");
+        }
+    }
+    return 0;
+}
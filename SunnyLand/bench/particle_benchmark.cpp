@@ -0,0 +1,98 @@
+// Cost of simulating, extracting and building the geometry of a steady particle population.
+// Build with -DSUNNYLAND_BUILD_BENCHMARKS=ON and run in Release. The target is 100k particles well inside a 16.6 ms frame.
+#include "../src/engine/particles/particle_system.h"
+#include "../src/engine/render/particle_geometry.h"
+#include "../src/engine/render/render_snapshot.h"
+#include "../src/engine/render/camera.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    void report(const char *name, Clock::time_point begin, std::size_t iterations, std::size_t particles)
+    {
+        double total_us = std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+        double per_frame_us = total_us / static_cast<double>(iterations);
+        std::printf("%-28s %10.2f us/frame %8.2f ns/particle\n", name, per_frame_us,
+                    per_frame_us * 1000.0 / static_cast<double>(particles));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t particle_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    std::size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 300;
+
+    // Particles live 1-3 s; the emit rate keeps the population near particle_count
+    engine::particles::EmitterSettings settings;
+    settings.texture_id = engine::utils::StringTable::intern("assets/textures/FX/enemy-deadth.png");
+    settings.source_rect = {0.0f, 0.0f, 40.0f, 41.0f};
+    settings.frame_count = 6;
+    settings.max_particles = particle_count;
+    settings.emit_rate = static_cast<float>(particle_count) / 2.0f;
+    settings.lifetime_min = 1.0f;
+    settings.lifetime_max = 3.0f;
+    settings.speed_max = 200.0f;
+    settings.spawn_radius = 300.0f;
+    settings.gravity = {0.0f, 30.0f};
+    settings.drag = 0.5f;
+    settings.size_start = 0.5f;
+    settings.size_end = 0.1f;
+
+    engine::particles::ParticleSystem particles;
+    engine::particles::EmitterId id = particles.createEmitter(settings, {640.0f, 360.0f}, 42);
+    particles.getEmitter(id)->burst(particle_count);
+    for (int i = 0; i < 120; ++i)
+    {
+        particles.update(DELTA_TIME);
+    }
+    std::printf("Particle benchmark: %zu live particles, %zu frames\n", particles.getParticleCount(), iterations);
+
+    auto begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        particles.update(DELTA_TIME);
+    }
+    report("update", begin, iterations, particles.getParticleCount());
+
+    engine::render::RenderSnapshot snapshot;
+    snapshot.setCamera(engine::render::Camera(glm::vec2(1280.0f, 720.0f)));
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        snapshot.clear();
+        particles.extract(snapshot);
+    }
+    report("extract", begin, iterations, particles.getParticleCount());
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    std::size_t drawn = 0;
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        for (const engine::render::ParticleBatch &batch : snapshot.getParticleBatches())
+        {
+            engine::render::buildParticleVertices(batch.particles, glm::vec2(0.0f), glm::vec2(240.0f, 41.0f), vertices);
+            engine::render::buildQuadIndices(batch.particles.size(), indices);
+            drawn = batch.particles.size();
+        }
+    }
+    report("build vertices", begin, iterations, drawn);
+    std::printf("visible particles: %zu of %zu\n", drawn, particles.getParticleCount());
+
+    // Printed so the compiler cannot drop the loops
+    float checksum = 0.0f;
+    for (const SDL_Vertex &vertex : vertices)
+    {
+        checksum += vertex.position.x;
+    }
+    std::printf("checksum: %.1f\n", checksum);
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Save and load timings of the binary world format with 100k entities, against a nlohmann_json baseline.
+// Build with -DSUNNYLAND_BUILD_BENCHMARKS=ON and run in Release:
+//   SunnyLand-save-benchmark [entities] [iterations] [directory]
+#include "../src/engine/ecs/world.h"
+#include "../src/engine/ecs/components.h"
+#include "../src/engine/save/world_serializer.h"
+#include "../src/engine/utils/string_id.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using engine::ecs::SpriteComponent;
+    using engine::ecs::Transform;
+    using engine::ecs::Velocity;
+
+    double elapsedMs(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+    void report(const char *name, double total_ms, std::size_t iterations, std::size_t bytes)
+    {
+        std::printf("%-28s %10.3f ms %12zu bytes\n", name, total_ms / static_cast<double>(iterations), bytes);
+    }
+
+    /// @brief Game-like world: moving sprites, static sprites and a few bare transforms.
+    void populate(engine::ecs::World &world, std::size_t entity_count)
+    {
+        SpriteComponent sprite;
+        sprite.texture_id = engine::utils::StringTable::intern("assets/textures/Actors/frog.png");
+        sprite.source_rect = {0.0f, 0.0f, 35.0f, 32.0f};
+        for (std::size_t i = 0; i < entity_count; ++i)
+        {
+            Transform transform;
+            transform.position = glm::vec2(static_cast<float>(i % 1000) * 16.0f, static_cast<float>(i / 1000) * 16.0f);
+            switch (i % 4)
+            {
+            case 0:
+            case 1:
+                world.createEntity(transform, Velocity{glm::vec2(static_cast<float>(i % 7), 0.0f)}, sprite);
+                break;
+            case 2:
+                world.createEntity(transform, sprite);
+                break;
+            default:
+                world.createEntity(transform);
+                break;
+            }
+        }
+    }
+
+    nlohmann::json toJson(engine::ecs::World &world)
+    {
+        nlohmann::json entities = nlohmann::json::array();
+        world.query<Transform>().each<Transform>([&](const Transform &transform)
+                                                 { entities.push_back({{"position", {transform.position.x, transform.position.y}},
+                                                                       {"scale", {transform.scale.x, transform.scale.y}},
+                                                                       {"rotation", transform.rotation}}); });
+        return entities;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t entity_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    std::size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10;
+    std::filesystem::path directory = argc > 3 ? std::filesystem::path(argv[3]) : std::filesystem::temp_directory_path();
+    std::printf("Save benchmark: %zu entities, %zu iterations\n", entity_count, iterations);
+    spdlog::set_level(spdlog::level::warn);
+
+    engine::ecs::World world;
+    populate(world, entity_count);
+
+    const std::string compressed_path = (directory / "sunnyland_bench.slsv").string();
+    const std::string raw_path = (directory / "sunnyland_bench_raw.slsv").string();
+    const std::string json_path = (directory / "sunnyland_bench.json").string();
+
+    engine::save::SaveStats stats;
+    auto begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        stats = engine::save::WorldSerializer::save(world, compressed_path);
+    }
+    report("save (delta + RLE)", elapsedMs(begin), iterations, stats.file_bytes);
+
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        stats = engine::save::WorldSerializer::save(world, raw_path, {false});
+    }
+    report("save (raw)", elapsedMs(begin), iterations, stats.file_bytes);
+
+    engine::ecs::World loaded;
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        stats = engine::save::WorldSerializer::load(loaded, compressed_path);
+    }
+    report("load (delta + RLE)", elapsedMs(begin), iterations, stats.file_bytes);
+
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        stats = engine::save::WorldSerializer::load(loaded, raw_path);
+    }
+    report("load (raw)", elapsedMs(begin), iterations, stats.file_bytes);
+    if (loaded.getEntityCount() != world.getEntityCount())
+    {
+        std::fprintf(stderr, "Loaded %zu entities instead of %zu\n", loaded.getEntityCount(), world.getEntityCount());
+        return 1;
+    }
+
+    // Only the transforms, which is already most of the JSON cost
+    std::size_t json_bytes = 0;
+    begin = Clock::now();
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        std::string text = toJson(world).dump();
+        std::ofstream(json_path, std::ios::binary) << text;
+        json_bytes = text.size();
+    }
+    report("save (nlohmann_json)", elapsedMs(begin), iterations, json_bytes);
+
+    begin = Clock::now();
+    std::size_t parsed = 0;
+    for (std::size_t n = 0; n < iterations; ++n)
+    {
+        std::ifstream file(json_path, std::ios::binary);
+        parsed = nlohmann::json::parse(file).size();
+    }
+    report("load (nlohmann_json)", elapsedMs(begin), iterations, json_bytes);
+    std::printf("%zu entities parsed back from JSON\n", parsed);
+
+    std::filesystem::remove(compressed_path);
+    std::filesystem::remove(raw_path);
+    std::filesystem::remove(json_path);
+    return 0;
+}
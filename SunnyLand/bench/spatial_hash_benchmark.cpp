@@ -0,0 +1,179 @@
+// Cost of rect, radius and ray queries on the spatial hash compared with brute force, at several item counts.
+// Build with -DSUNNYLAND_BUILD_BENCHMARKS=ON and run in Release. Exits with 1 if a query result differs from brute force.
+#include "../src/engine/physics/spatial_hash.h"
+#include "../src/engine/utils/random.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using engine::physics::SpatialHash;
+    using engine::physics::SpatialItem;
+    using engine::utils::Rect;
+
+    constexpr float CELL_SIZE = 64.0f;
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    struct Query
+    {
+        glm::vec2 center;
+        glm::vec2 direction;
+    };
+
+    double elapsedUs(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+    }
+
+    bool overlaps(const Rect &a, const Rect &b)
+    {
+        return a.position.x <= b.position.x + b.size.x && b.position.x <= a.position.x + a.size.x &&
+               a.position.y <= b.position.y + b.size.y && b.position.y <= a.position.y + a.size.y;
+    }
+
+    bool withinRadius(const Rect &b, const glm::vec2 &center, float radius)
+    {
+        glm::vec2 offset = glm::clamp(center, b.position, b.position + b.size) - center;
+        return offset.x * offset.x + offset.y * offset.y <= radius * radius;
+    }
+
+    bool rayHits(const Rect &b, const glm::vec2 &origin, const glm::vec2 &direction, float max_distance)
+    {
+        float t_enter = 0.0f;
+        float t_exit = max_distance;
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            float min = b.position[axis], max = b.position[axis] + b.size[axis];
+            if (direction[axis] == 0.0f)
+            {
+                if (origin[axis] < min || origin[axis] > max)
+                    return false;
+                continue;
+            }
+            float t1 = (min - origin[axis]) / direction[axis];
+            float t2 = (max - origin[axis]) / direction[axis];
+            t_enter = std::max(t_enter, std::min(t1, t2));
+            t_exit = std::min(t_exit, std::max(t1, t2));
+        }
+        return t_enter <= t_exit;
+    }
+
+    /// @brief Runs every query once against the hash and once by brute force. Returns false on a mismatch.
+    bool runQueries(const SpatialHash &hash, const std::vector<Rect> &bounds, const std::vector<Query> &queries, float radius,
+                    float ray_length)
+    {
+        std::size_t hash_rect = 0, hash_radius = 0, hash_ray = 0;
+        auto begin = Clock::now();
+        for (const Query &query : queries)
+            hash.queryRect({query.center - radius, glm::vec2(radius * 2.0f)}, [&](SpatialItem) { ++hash_rect; });
+        double rect_us = elapsedUs(begin);
+        begin = Clock::now();
+        for (const Query &query : queries)
+            hash.queryRadius(query.center, radius, [&](SpatialItem) { ++hash_radius; });
+        double radius_us = elapsedUs(begin);
+        begin = Clock::now();
+        for (const Query &query : queries)
+            hash.queryRay(query.center, query.direction, ray_length, [&](SpatialItem, float)
+                          { ++hash_ray; return true; });
+        double ray_us = elapsedUs(begin);
+
+        std::size_t brute_rect = 0, brute_radius = 0, brute_ray = 0;
+        begin = Clock::now();
+        for (const Query &query : queries)
+        {
+            Rect rect{query.center - radius, glm::vec2(radius * 2.0f)};
+            for (const Rect &b : bounds)
+                brute_rect += overlaps(rect, b) ? 1 : 0;
+        }
+        double brute_rect_us = elapsedUs(begin);
+        begin = Clock::now();
+        for (const Query &query : queries)
+            for (const Rect &b : bounds)
+                brute_radius += withinRadius(b, query.center, radius) ? 1 : 0;
+        double brute_radius_us = elapsedUs(begin);
+        begin = Clock::now();
+        for (const Query &query : queries)
+            for (const Rect &b : bounds)
+                brute_ray += rayHits(b, query.center, query.direction, ray_length) ? 1 : 0;
+        double brute_ray_us = elapsedUs(begin);
+
+        double n = static_cast<double>(queries.size());
+        auto report = [&](const char *name, double us, double brute_us, std::size_t found, std::size_t expected)
+        {
+            std::printf("  %-7s %9.2f us/query, brute force %10.2f us/query (%6.1fx), %.1f results/query%s\n", name, us / n,
+                        brute_us / n, brute_us / us, static_cast<double>(found) / n, found == expected ? "" : "  MISMATCH");
+        };
+        report("rect", rect_us, brute_rect_us, hash_rect, brute_rect);
+        report("radius", radius_us, brute_radius_us, hash_radius, brute_radius);
+        report("ray", ray_us, brute_ray_us, hash_ray, brute_ray);
+        return hash_rect == brute_rect && hash_radius == brute_radius && hash_ray == brute_ray;
+    }
+
+    bool runCount(std::size_t count, std::size_t query_count)
+    {
+        // About one item per 64x64 area, so results per query stay similar for every count
+        const float world_size = 64.0f * std::sqrt(static_cast<float>(count));
+        engine::utils::Random random(11);
+        std::vector<Rect> bounds(count);
+        std::vector<glm::vec2> velocities(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            bounds[i] = {{random.range(0.0f, world_size), random.range(0.0f, world_size)},
+                         {random.range(8.0f, 48.0f), random.range(8.0f, 48.0f)}};
+            velocities[i] = {random.range(-120.0f, 120.0f), random.range(-120.0f, 120.0f)};
+        }
+        std::vector<Query> queries(query_count);
+        for (Query &query : queries)
+        {
+            float angle = random.range(0.0f, 6.2831853f);
+            query.center = {random.range(0.0f, world_size), random.range(0.0f, world_size)};
+            query.direction = {std::cos(angle), std::sin(angle)};
+        }
+        // Axis aligned rays take the degenerate paths of the ray walk
+        queries[0].direction = {1.0f, 0.0f};
+        queries[1].direction = {0.0f, -1.0f};
+
+        SpatialHash hash(CELL_SIZE);
+        std::vector<SpatialItem> items(count);
+        auto begin = Clock::now();
+        for (std::size_t i = 0; i < count; ++i)
+            items[i] = hash.insert(bounds[i]);
+        hash.build();
+        double build_us = elapsedUs(begin);
+
+        // One tick of movement: only items that changed cells force the rebuild
+        for (std::size_t i = 0; i < count; ++i)
+            bounds[i].position += velocities[i] * DELTA_TIME;
+        begin = Clock::now();
+        for (std::size_t i = 0; i < count; ++i)
+            hash.move(items[i], bounds[i]);
+        hash.build();
+        double tick_us = elapsedUs(begin);
+
+        std::printf("%zu items: %zu cells, %zu entries, build %.1f us, move all + rebuild %.1f us\n", count, hash.getCellCount(),
+                    hash.getEntryCount(), build_us, tick_us);
+        return runQueries(hash, bounds, queries, 96.0f, 512.0f);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t query_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+    std::printf("Spatial hash benchmark: cell size %.0f, %zu queries per count, radius 96, ray length 512\n", CELL_SIZE, query_count);
+
+    bool matched = true;
+    for (std::size_t count : {std::size_t{1000}, std::size_t{10000}, std::size_t{100000}})
+    {
+        matched = runCount(count, query_count) && matched;
+    }
+    if (!matched)
+    {
+        std::printf("MISMATCH\n");
+        return 1;
+    }
+    return 0;
+}
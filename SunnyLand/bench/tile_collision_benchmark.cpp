@@ -0,0 +1,228 @@
+// Checks that fast boxes do not tunnel through tiles, then measures batched tile collision for many actors.
+// Build with -DSUNNYLAND_BUILD_BENCHMARKS=ON and run in Release. Exits with 1 if a check fails.
+#include "../src/engine/physics/tile_collision_map.h"
+#include "../src/engine/physics/tile_mover.h"
+#include "../src/engine/utils/random.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using engine::physics::TileCollisionMap;
+    using engine::physics::TileType;
+    using engine::utils::Rect;
+
+    constexpr float TILE = 16.0f;
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    int failures = 0;
+
+    void check(bool condition, const char *name)
+    {
+        std::printf("  %-52s %s\n", name, condition ? "ok" : "FAILED");
+        if (!condition)
+        {
+            ++failures;
+        }
+    }
+
+    bool near(float a, float b) { return std::fabs(a - b) < 0.01f; }
+
+    /// @brief True if the box overlaps a solid tile by more than the mover's tolerance.
+    bool insideSolid(const TileCollisionMap &map, const Rect &box)
+    {
+        constexpr float TOLERANCE = 0.001f;
+        for (int y = map.toTile(box.position.y + TOLERANCE); y <= map.toTile(box.position.y + box.size.y - TOLERANCE); ++y)
+            for (int x = map.toTile(box.position.x + TOLERANCE); x <= map.toTile(box.position.x + box.size.x - TOLERANCE); ++x)
+                if (map.isSolid(x, y))
+                    return true;
+        return false;
+    }
+
+    void runTunnelingChecks()
+    {
+        std::printf("Tunneling checks:\n");
+        TileCollisionMap map(64, 64, TILE);
+        for (int y = 0; y < 64; ++y)
+            map.setTile(40, y, TileType::Solid); // one tile thick wall
+        for (int x = 0; x < 64; ++x)
+            map.setTile(x, 50, TileType::Solid); // one tile thick floor
+        for (int x = 0; x < 20; ++x)
+            map.setTile(x, 30, TileType::OneWay);
+        for (int x = 0; x < 64; ++x)
+            map.setTile(x, 2, TileType::Solid); // ceiling
+
+        Rect box{{100.0f, 100.0f}, {10.0f, 12.0f}};
+        auto result = engine::physics::moveBox(map, box, {100000.0f, 0.0f});
+        check(result.hit_right && near(box.position.x, 40.0f * TILE - 10.0f), "100000 px/tick right stops at a 1-tile wall");
+
+        box = {{700.0f, 100.0f}, {10.0f, 12.0f}};
+        result = engine::physics::moveBox(map, box, {-100000.0f, 0.0f});
+        check(result.hit_left && near(box.position.x, 41.0f * TILE), "100000 px/tick left stops at a 1-tile wall");
+
+        box = {{400.0f, 500.0f}, {10.0f, 12.0f}};
+        result = engine::physics::moveBox(map, box, {0.0f, 1.0e6f});
+        check(result.on_ground && near(box.position.y + box.size.y, 50.0f * TILE), "1e6 px/tick fall lands on a 1-tile floor");
+
+        box = {{400.0f, 500.0f}, {10.0f, 12.0f}};
+        result = engine::physics::moveBox(map, box, {0.0f, -1.0e6f});
+        check(result.hit_ceiling && near(box.position.y, 3.0f * TILE), "1e6 px/tick jump stops at the ceiling");
+
+        box = {{100.0f, 100.0f}, {10.0f, 12.0f}};
+        result = engine::physics::moveBox(map, box, {0.0f, 5000.0f});
+        check(result.on_ground && near(box.position.y + box.size.y, 30.0f * TILE), "fast fall lands on a one-way platform");
+
+        box = {{100.0f, 100.0f}, {10.0f, 12.0f}};
+        result = engine::physics::moveBox(map, box, {0.0f, 5000.0f}, true);
+        check(near(box.position.y + box.size.y, 50.0f * TILE), "drop-through falls past the one-way platform");
+
+        box = {{100.0f, 30.0f * TILE + 4.0f}, {10.0f, 12.0f}};
+        result = engine::physics::moveBox(map, box, {0.0f, -40.0f});
+        check(!result.hit_ceiling && near(box.position.y, 30.0f * TILE - 36.0f), "jumping up through a one-way platform");
+
+        box = {{100.0f, 100.0f}, {10.0f, 12.0f}};
+        result = engine::physics::moveBox(map, box, {50000.0f, 50000.0f});
+        check(result.hit_right && result.on_ground && !insideSolid(map, box), "diagonal 50000 px/tick ends in the corner");
+
+        box = {{200.0f, 50.0f * TILE - 12.0f}, {10.0f, 12.0f}};
+        result = engine::physics::moveBox(map, box, {0.0f, 0.0f});
+        check(result.on_ground && near(box.position.y, 50.0f * TILE - 12.0f), "resting box reports ground without moving");
+
+        // Staircase of "/" slopes with solid tiles beneath, rising to the right from the floor
+        TileCollisionMap slopes(32, 32, TILE);
+        for (int x = 0; x < 32; ++x)
+            slopes.setTile(x, 20, TileType::Solid);
+        for (int i = 0; i < 4; ++i)
+        {
+            slopes.setTile(10 + i, 19 - i, TileType::SlopeUp);
+            for (int y = 20 - i; y < 20; ++y)
+                slopes.setTile(10 + i, y, TileType::Solid);
+        }
+        for (int x = 14; x < 32; ++x)
+            for (int y = 16; y < 20; ++y)
+                slopes.setTile(x, y, TileType::Solid);
+
+        box = {{100.0f, 20.0f * TILE - 12.0f}, {10.0f, 12.0f}};
+        bool stayed_out = true;
+        for (int tick = 0; tick < 120; ++tick)
+        {
+            engine::physics::moveBox(slopes, box, {2.0f, 4.0f});
+            stayed_out = stayed_out && !insideSolid(slopes, box);
+        }
+        check(stayed_out && box.position.x > 14.0f * TILE && near(box.position.y + box.size.y, 16.0f * TILE),
+              "walking up a slope staircase onto the plateau");
+
+        // Low step in a corridor: stepping onto it would lift the box's top into the ceiling
+        TileCollisionMap corridor(32, 32, TILE);
+        for (int x = 0; x < 32; ++x)
+            corridor.setTile(x, 17, TileType::Solid);
+        corridor.setTile(12, 19, TileType::Solid);
+        TileCollisionMap open_step(32, 32, TILE);
+        open_step.setTile(12, 19, TileType::Solid);
+
+        box = {{10.0f * TILE, 18.0f * TILE + 2.0f}, {10.0f, 20.0f}};
+        result = engine::physics::moveBox(open_step, box, {40.0f, 0.0f});
+        check(!result.hit_right && near(box.position.y, 18.0f * TILE - 4.0f), "steps up onto a low tile with headroom");
+
+        box = {{10.0f * TILE, 18.0f * TILE + 2.0f}, {10.0f, 20.0f}};
+        result = engine::physics::moveBox(corridor, box, {40.0f, 0.0f});
+        check(result.hit_right && near(box.position.x, 12.0f * TILE - 10.0f) && !insideSolid(corridor, box),
+              "low step under a low ceiling blocks like a wall");
+    }
+
+    TileCollisionMap makeLevel(int width, int height, engine::utils::Random &random)
+    {
+        TileCollisionMap map(width, height, TILE);
+        for (int x = 0; x < width; ++x)
+        {
+            map.setTile(x, height - 1, TileType::Solid);
+        }
+        for (int i = 0; i < width * height / 40; ++i)
+        {
+            int x = static_cast<int>(random.nextU64() % static_cast<std::uint64_t>(width - 4));
+            int y = static_cast<int>(random.nextU64() % static_cast<std::uint64_t>(height - 2));
+            TileType type = i % 3 == 0 ? TileType::OneWay : TileType::Solid;
+            for (int k = 0; k < 4; ++k)
+            {
+                map.setTile(x + k, y, type);
+            }
+        }
+        return map;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t actor_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    std::size_t ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 300;
+
+    runTunnelingChecks();
+
+    engine::utils::Random random(3);
+    TileCollisionMap map = makeLevel(1024, 256, random);
+    std::printf("Tile collision benchmark: %dx%d tiles (%zu bytes), %zu actors, %zu ticks\n", map.getWidth(), map.getHeight(),
+                map.getMemoryUsage(), actor_count, ticks);
+
+    std::vector<Rect> boxes(actor_count);
+    std::vector<glm::vec2> velocities(actor_count);
+    std::vector<glm::vec2> deltas(actor_count);
+    std::vector<engine::physics::TileMoveResult> results(actor_count);
+    for (std::size_t i = 0; i < actor_count; ++i)
+    {
+        do
+        {
+            boxes[i] = {{random.range(0.0f, 1000.0f * TILE), random.range(0.0f, 200.0f * TILE)}, {12.0f, 14.0f}};
+        } while (insideSolid(map, boxes[i]));
+        velocities[i] = {random.range(-150.0f, 150.0f), 0.0f};
+    }
+
+    double total_us = 0.0;
+    std::size_t grounded = 0;
+    for (std::size_t tick = 0; tick < ticks; ++tick)
+    {
+        for (std::size_t i = 0; i < actor_count; ++i)
+        {
+            velocities[i].y = std::min(velocities[i].y + 900.0f * DELTA_TIME, 600.0f);
+            deltas[i] = velocities[i] * DELTA_TIME;
+        }
+        auto begin = Clock::now();
+        engine::physics::moveBoxes(map, boxes, deltas, results);
+        total_us += std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+
+        grounded = 0;
+        for (std::size_t i = 0; i < actor_count; ++i)
+        {
+            const auto &result = results[i];
+            if (result.on_ground)
+            {
+                velocities[i].y = tick % 90 == 0 ? -400.0f : 0.0f;
+                ++grounded;
+            }
+            if (result.hit_ceiling)
+                velocities[i].y = 0.0f;
+            if (result.hit_left || result.hit_right)
+                velocities[i].x = -velocities[i].x;
+        }
+    }
+    double per_tick_us = total_us / static_cast<double>(ticks);
+    std::printf("moveBoxes: %.1f us/tick, %.1f ns/actor, %zu actors on ground at the end\n", per_tick_us,
+                per_tick_us * 1000.0 / static_cast<double>(actor_count), grounded);
+
+    std::size_t stuck = 0;
+    for (const Rect &box : boxes)
+    {
+        stuck += insideSolid(map, box) ? 1 : 0;
+    }
+    check(stuck == 0, "no actor ends inside a solid tile");
+
+    if (failures > 0)
+    {
+        std::printf("%d checks FAILED\n", failures);
+        return 1;
+    }
+    return 0;
+}
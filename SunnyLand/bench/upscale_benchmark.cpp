@@ -0,0 +1,145 @@
+// Frame time of drawing a tiled world straight into a large window versus into a 320x180 target upscaled in one blit.
+// Build with -DSUNNYLAND_BUILD_BENCHMARKS=ON and run in Release:
+//   SunnyLand-upscale-benchmark [window width] [window height] [frames] [layers] [renderer name]
+// The window is hidden; one pixel is read back every frame so the GPU has to finish the frame before it is timed.
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int TILE_SIZE = 16;
+    constexpr int INTERNAL_WIDTH = 320;
+    constexpr int INTERNAL_HEIGHT = 180;
+
+    /// @brief Checkerboard tile with transparent corners, so layers blend like the game's tile layers.
+    SDL_Texture *createTileTexture(SDL_Renderer *renderer)
+    {
+        SDL_Surface *surface = SDL_CreateSurface(TILE_SIZE, TILE_SIZE, SDL_PIXELFORMAT_RGBA8888);
+        if (!surface)
+        {
+            return nullptr;
+        }
+        for (int y = 0; y < TILE_SIZE; ++y)
+        {
+            for (int x = 0; x < TILE_SIZE; ++x)
+            {
+                bool corner = (x < 2 || x >= TILE_SIZE - 2) && (y < 2 || y >= TILE_SIZE - 2);
+                Uint8 shade = ((x / 4 + y / 4) & 1) ? 200 : 90;
+                SDL_WriteSurfacePixel(surface, x, y, shade, static_cast<Uint8>(shade / 2), 60, corner ? 0 : 255);
+            }
+        }
+        SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+        SDL_DestroySurface(surface);
+        if (texture)
+        {
+            SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+        }
+        return texture;
+    }
+
+    /// @brief Covers a width x height view with layers of tiles drawn at scale, offset per layer like parallax.
+    void drawWorld(SDL_Renderer *renderer, SDL_Texture *tile, int width, int height, int layers, float scale, int frame)
+    {
+        const float size = TILE_SIZE * scale;
+        for (int layer = 0; layer < layers; ++layer)
+        {
+            const float offset = static_cast<float>((frame * (layer + 1)) % TILE_SIZE) * scale;
+            for (float y = -offset; y < height; y += size)
+            {
+                for (float x = -offset; x < width; x += size)
+                {
+                    SDL_FRect dest_rect{x, y, size, size};
+                    SDL_RenderTexture(renderer, tile, nullptr, &dest_rect);
+                }
+            }
+        }
+    }
+
+    void finishFrame(SDL_Renderer *renderer)
+    {
+        SDL_Rect pixel{0, 0, 1, 1};
+        SDL_Surface *readback = SDL_RenderReadPixels(renderer, &pixel);
+        SDL_DestroySurface(readback);
+        SDL_RenderPresent(renderer);
+    }
+
+    void report(const char *name, Clock::time_point begin, int frames)
+    {
+        double total_ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        std::printf("%-36s %10.3f ms/frame\n", name, total_ms / frames);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int window_width = argc > 1 ? std::atoi(argv[1]) : 3840;
+    int window_height = argc > 2 ? std::atoi(argv[2]) : 2160;
+    int frames = argc > 3 ? std::atoi(argv[3]) : 300;
+    int layers = argc > 4 ? std::atoi(argv[4]) : 4;
+    const char *renderer_name = argc > 5 ? argv[5] : nullptr;
+
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Window *window = SDL_CreateWindow("upscale benchmark", window_width, window_height, SDL_WINDOW_HIDDEN);
+    SDL_Renderer *renderer = window ? SDL_CreateRenderer(window, renderer_name) : nullptr;
+    SDL_Texture *tile = renderer ? createTileTexture(renderer) : nullptr;
+    SDL_Texture *target = renderer ? SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, INTERNAL_WIDTH, INTERNAL_HEIGHT)
+                                   : nullptr;
+    if (!tile || !target)
+    {
+        std::fprintf(stderr, "Setup failed: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    SDL_SetTextureScaleMode(target, SDL_SCALEMODE_NEAREST);
+    SDL_SetRenderVSync(renderer, 0);
+
+    int output_width = 0, output_height = 0;
+    SDL_GetRenderOutputSize(renderer, &output_width, &output_height);
+    const int scale = std::max(1, std::min(output_width / INTERNAL_WIDTH, output_height / INTERNAL_HEIGHT));
+    const SDL_FRect upscaled{static_cast<float>((output_width - INTERNAL_WIDTH * scale) / 2), static_cast<float>((output_height - INTERNAL_HEIGHT * scale) / 2),
+                             static_cast<float>(INTERNAL_WIDTH * scale), static_cast<float>(INTERNAL_HEIGHT * scale)};
+    std::printf("Upscale benchmark: %dx%d output (%s), %d layers, %dx integer scale, %d frames\n", output_width, output_height,
+                SDL_GetRendererName(renderer), layers, scale, frames);
+
+    // Same world on screen both ways: tiles drawn at the upscale factor, or at 1x and upscaled once
+    auto begin = Clock::now();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        drawWorld(renderer, tile, output_width, output_height, layers, static_cast<float>(scale), frame);
+        finishFrame(renderer);
+    }
+    report("window resolution", begin, frames);
+
+    begin = Clock::now();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        SDL_SetRenderTarget(renderer, target);
+        SDL_RenderClear(renderer);
+        drawWorld(renderer, tile, INTERNAL_WIDTH, INTERNAL_HEIGHT, layers, 1.0f, frame);
+        SDL_SetRenderTarget(renderer, nullptr);
+        SDL_RenderTexture(renderer, target, nullptr, &upscaled);
+        finishFrame(renderer);
+    }
+    report("320x180 target + integer upscale", begin, frames);
+
+    SDL_DestroyTexture(target);
+    SDL_DestroyTexture(tile);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return 0;
+}
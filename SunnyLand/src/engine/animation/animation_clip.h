@@ -0,0 +1,33 @@
+#pragma once
+#include "../utils/string_id.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace engine::animation
+{
+    using AnimationClipId = std::uint32_t;
+    constexpr AnimationClipId INVALID_ANIMATION_CLIP = std::numeric_limits<AnimationClipId>::max();
+
+    enum class LoopMode : std::uint8_t
+    {
+        Once,     ///< Stops on the last frame.
+        Loop,     ///< Restarts from the first frame.
+        PingPong, ///< Plays forward, then backward.
+    };
+
+    /// @brief A sequence of frames of one texture. The frame rects and end times live in the
+    /// AnimationLibrary's flat tables, starting at first_frame.
+    struct AnimationClip
+    {
+        std::string name;
+        engine::utils::StringId texture_id = engine::utils::EMPTY_STRING_ID;
+        LoopMode loop_mode = LoopMode::Loop;
+        std::uint32_t first_frame = 0;
+        std::uint32_t frame_count = 0;
+        /// @brief Length of one pass through all frames, in seconds.
+        float duration = 0.0f;
+        /// @brief 1 / frame duration when all frames last equally long, so the frame is one multiply away. 0 otherwise.
+        float inverse_frame_duration = 0.0f;
+    };
+} // namespace engine::animation
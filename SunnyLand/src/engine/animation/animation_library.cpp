@@ -0,0 +1,129 @@
+#include "animation_library.h"
+#include "../utils/json_cache.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::animation
+{
+    namespace
+    {
+        LoopMode parseLoopMode(const std::string &loop_mode)
+        {
+            if (loop_mode == "once")
+                return LoopMode::Once;
+            if (loop_mode == "loop")
+                return LoopMode::Loop;
+            if (loop_mode == "ping_pong")
+                return LoopMode::PingPong;
+            throw std::runtime_error("Unknown loop mode: " + loop_mode);
+        }
+
+        /// @brief Frames given either explicitly ("frames") or as a row of equally sized cells ("frame_size", "frame_count").
+        std::vector<AnimationFrame> parseFrames(const nlohmann::json &clip)
+        {
+            std::vector<AnimationFrame> frames;
+            if (clip.contains("frames"))
+            {
+                for (const auto &frame : clip.at("frames"))
+                {
+                    auto rect = frame.at("rect").get<std::array<float, 4>>();
+                    frames.push_back({{rect[0], rect[1], rect[2], rect[3]}, frame.at("duration").get<float>()});
+                }
+                return frames;
+            }
+
+            auto size = clip.at("frame_size").get<std::array<float, 2>>();
+            auto start = clip.value("start", std::array<int, 2>{0, 0});
+            int count = clip.at("frame_count").get<int>();
+            float duration = clip.at("frame_duration").get<float>();
+            for (int i = 0; i < count; ++i)
+            {
+                frames.push_back({{static_cast<float>(start[0] + i) * size[0], static_cast<float>(start[1]) * size[1], size[0], size[1]}, duration});
+            }
+            return frames;
+        }
+    }
+
+    void AnimationLibrary::loadFromFile(const std::string &file_path)
+    {
+        std::size_t clip_count = 0;
+        try
+        {
+            nlohmann::json json = engine::utils::loadJson(file_path);
+            for (const auto &clip : json.at("clips"))
+            {
+                addClip(clip.at("name").get<std::string>(), clip.at("texture").get<std::string>(), parseFrames(clip),
+                        parseLoopMode(clip.value("loop", std::string("loop"))));
+                ++clip_count;
+            }
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            throw std::runtime_error("Failed to parse animation file " + file_path + ": " + e.what());
+        }
+
+        spdlog::debug("Animation file loaded: {} ({} clips, {} frames in total)", file_path, clip_count, frame_rects_.size());
+    }
+
+    AnimationClipId AnimationLibrary::addClip(const std::string &name, const std::string &texture_path,
+                                              const std::vector<AnimationFrame> &frames, LoopMode loop_mode)
+    {
+        if (frames.empty())
+        {
+            throw std::runtime_error("Animation clip has no frames: " + name);
+        }
+
+        AnimationClip clip;
+        clip.name = name;
+        clip.texture_id = engine::utils::StringTable::intern(texture_path);
+        clip.loop_mode = loop_mode;
+        clip.first_frame = static_cast<std::uint32_t>(frame_rects_.size());
+        clip.frame_count = static_cast<std::uint32_t>(frames.size());
+
+        bool uniform = true;
+        for (const AnimationFrame &frame : frames)
+        {
+            if (frame.duration <= 0.0f)
+            {
+                throw std::runtime_error("Animation clip has a frame without duration: " + name);
+            }
+            uniform = uniform && frame.duration == frames.front().duration;
+            clip.duration += frame.duration;
+            frame_rects_.push_back(frame.rect);
+            frame_end_times_.push_back(clip.duration);
+        }
+        clip.inverse_frame_duration = uniform ? 1.0f / frames.front().duration : 0.0f;
+
+        auto clip_id = static_cast<AnimationClipId>(clips_.size());
+        clips_.push_back(std::move(clip));
+        clip_ids_[name] = clip_id;
+        return clip_id;
+    }
+
+    AnimationClipId AnimationLibrary::findClip(std::string_view name) const
+    {
+        auto it = clip_ids_.find(std::string(name));
+        return it != clip_ids_.end() ? it->second : INVALID_ANIMATION_CLIP;
+    }
+
+    std::vector<std::string> AnimationLibrary::getTextures(const std::vector<AnimationClipId> &clip_ids) const
+    {
+        std::vector<std::string> textures;
+        for (AnimationClipId clip_id : clip_ids)
+        {
+            if (clip_id >= clips_.size())
+            {
+                continue;
+            }
+            const std::string &texture = engine::utils::StringTable::lookup(clips_[clip_id].texture_id);
+            if (std::find(textures.begin(), textures.end(), texture) == textures.end())
+            {
+                textures.push_back(texture);
+            }
+        }
+        return textures;
+    }
+} // namespace engine::animation
@@ -0,0 +1,52 @@
+#pragma once
+#include "animation_clip.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <SDL3/SDL_rect.h>
+
+namespace engine::animation
+{
+    /// @brief One frame of a clip being defined: the part of the texture and how long it shows.
+    struct AnimationFrame
+    {
+        SDL_FRect rect;
+        float duration;
+    };
+
+    /// @brief All animation clips, with their frames stored in flat tables computed at load time,
+    /// so that advancing an animator is a table lookup. Read-only once loaded; safe to share between threads.
+    class AnimationLibrary final
+    {
+    private:
+        std::vector<AnimationClip> clips_;
+        std::vector<SDL_FRect> frame_rects_;
+        /// @brief Time within its clip at which each frame ends.
+        std::vector<float> frame_end_times_;
+        std::unordered_map<std::string, AnimationClipId> clip_ids_;
+
+    public:
+        AnimationLibrary() = default;
+
+        /// @brief Adds every clip of a JSON file. Throws std::runtime_error if the file cannot be read or is invalid.
+        void loadFromFile(const std::string &file_path);
+
+        /// @brief Adds a clip. A clip with the same name is replaced for later lookups.
+        AnimationClipId addClip(const std::string &name, const std::string &texture_path,
+                                const std::vector<AnimationFrame> &frames, LoopMode loop_mode);
+
+        /// @brief Returns INVALID_ANIMATION_CLIP if there is no clip with that name.
+        AnimationClipId findClip(std::string_view name) const;
+        const AnimationClip &getClip(AnimationClipId clip_id) const { return clips_[clip_id]; }
+        std::size_t getClipCount() const { return clips_.size(); }
+
+        const AnimationClip *getClips() const { return clips_.data(); }
+        const SDL_FRect *getFrameRects() const { return frame_rects_.data(); }
+        const float *getFrameEndTimes() const { return frame_end_times_.data(); }
+
+        /// @brief Texture paths used by the given clips, e.g. for a scene's resource manifest.
+        std::vector<std::string> getTextures(const std::vector<AnimationClipId> &clip_ids) const;
+    };
+} // namespace engine::animation
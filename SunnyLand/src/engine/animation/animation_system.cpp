@@ -0,0 +1,110 @@
+#include "animation_system.h"
+#include "animation_library.h"
+#include "animator.h"
+#include "../ecs/world.h"
+#include "../ecs/components.h"
+#include "../ecs/parallel_query.h"
+#include <algorithm>
+#include <cmath>
+
+namespace engine::animation
+{
+    namespace
+    {
+        constexpr std::size_t MIN_CHUNK = 2048;
+
+        /// @brief Frame shown at time (0 <= time <= clip.duration) within the clip.
+        std::uint32_t frameAt(const AnimationClip &clip, const float *frame_end_times, float time)
+        {
+            if (clip.inverse_frame_duration > 0.0f)
+            {
+                return std::min(static_cast<std::uint32_t>(time * clip.inverse_frame_duration), clip.frame_count - 1);
+            }
+            // Clips with uneven frames are short, a linear scan beats a binary search
+            const float *end_times = frame_end_times + clip.first_frame;
+            std::uint32_t frame = 0;
+            while (frame + 1 < clip.frame_count && time >= end_times[frame])
+            {
+                ++frame;
+            }
+            return frame;
+        }
+    }
+
+    void advanceAnimators(const AnimationLibrary &library, Animator *animators, engine::ecs::SpriteComponent *sprites,
+                          std::size_t count, float delta_time)
+    {
+        const AnimationClip *clips = library.getClips();
+        const SDL_FRect *frame_rects = library.getFrameRects();
+        const float *frame_end_times = library.getFrameEndTimes();
+        const std::size_t clip_count = library.getClipCount();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Animator &animator = animators[i];
+            if (!animator.playing || animator.clip_id >= clip_count)
+            {
+                continue;
+            }
+
+            const AnimationClip &clip = clips[animator.clip_id];
+            float time = animator.time + delta_time * animator.speed;
+            float clip_time = time;
+            switch (clip.loop_mode)
+            {
+            case LoopMode::Once:
+                if (time >= clip.duration || time < 0.0f)
+                {
+                    time = std::clamp(time, 0.0f, clip.duration);
+                    animator.playing = false;
+                    animator.finished = true;
+                }
+                clip_time = time;
+                break;
+            case LoopMode::Loop:
+                if (time >= clip.duration || time < 0.0f)
+                {
+                    time -= std::floor(time / clip.duration) * clip.duration;
+                }
+                clip_time = time;
+                break;
+            case LoopMode::PingPong:
+            {
+                float period = clip.duration * 2.0f;
+                if (time >= period || time < 0.0f)
+                {
+                    time -= std::floor(time / period) * period;
+                }
+                clip_time = time < clip.duration ? time : period - time;
+                break;
+            }
+            }
+
+            std::uint32_t frame = frameAt(clip, frame_end_times, clip_time);
+            animator.time = time;
+            animator.frame = frame;
+            engine::ecs::SpriteComponent &sprite = sprites[i];
+            sprite.texture_id = clip.texture_id;
+            sprite.source_rect = frame_rects[clip.first_frame + frame];
+        }
+    }
+
+    AnimationSystem::AnimationSystem(engine::ecs::World &world, const AnimationLibrary &library)
+        : library_(library), query_(world.query<Animator, engine::ecs::SpriteComponent>())
+    {
+    }
+
+    engine::ecs::SystemAccess AnimationSystem::getAccess() const
+    {
+        return engine::ecs::SystemAccess().write<Animator, engine::ecs::SpriteComponent>();
+    }
+
+    void AnimationSystem::update(const engine::ecs::SystemContext &context)
+    {
+        float delta_time = context.delta_time;
+        engine::ecs::parallelForEachChunk(query_, context.jobs, MIN_CHUNK, [this, delta_time](engine::ecs::Archetype &archetype, std::size_t begin, std::size_t end)
+                                          { advanceAnimators(library_, archetype.column<Animator>().data() + begin,
+                                                             archetype.column<engine::ecs::SpriteComponent>().data() + begin,
+                                                             end - begin, delta_time); });
+    }
+} // namespace engine::animation
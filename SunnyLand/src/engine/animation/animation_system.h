@@ -0,0 +1,34 @@
+#pragma once
+#include "../ecs/system.h"
+#include <cstddef>
+
+namespace engine::ecs
+{
+    class Query;
+    struct SpriteComponent;
+}
+
+namespace engine::animation
+{
+    class AnimationLibrary;
+    struct Animator;
+
+    /// @brief Advances count animators by delta_time and writes their current frame into the matching sprites.
+    void advanceAnimators(const AnimationLibrary &library, Animator *animators, engine::ecs::SpriteComponent *sprites,
+                          std::size_t count, float delta_time);
+
+    /// @brief Plays the Animator of every entity that also has a SpriteComponent.
+    class AnimationSystem final : public engine::ecs::System
+    {
+    private:
+        const AnimationLibrary &library_;
+        engine::ecs::Query &query_;
+
+    public:
+        AnimationSystem(engine::ecs::World &world, const AnimationLibrary &library);
+
+        std::string_view getName() const override { return "AnimationSystem"; }
+        engine::ecs::SystemAccess getAccess() const override;
+        void update(const engine::ecs::SystemContext &context) override;
+    };
+} // namespace engine::animation
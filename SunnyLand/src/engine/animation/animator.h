@@ -0,0 +1,38 @@
+#pragma once
+#include "animation_clip.h"
+#include <string_view>
+
+namespace engine::animation
+{
+    /// @brief ECS component playing an AnimationClip on the entity's SpriteComponent.
+    struct Animator
+    {
+        static constexpr std::string_view COMPONENT_NAME = "Animator";
+
+        AnimationClipId clip_id = INVALID_ANIMATION_CLIP;
+        /// @brief Time into the clip, in seconds.
+        float time = 0.0f;
+        /// @brief Playback rate. Negative values play backwards.
+        float speed = 1.0f;
+        /// @brief Current frame within the clip, updated by the AnimationSystem.
+        std::uint32_t frame = 0;
+        bool playing = true;
+        /// @brief Set when a LoopMode::Once clip reached its end.
+        bool finished = false;
+
+        /// @brief Switches to another clip. Does nothing if it is already playing, unless restart is set.
+        void play(AnimationClipId clip, bool restart = false)
+        {
+            if (clip == clip_id && !restart && !finished)
+            {
+                playing = true;
+                return;
+            }
+            clip_id = clip;
+            time = 0.0f;
+            frame = 0;
+            playing = true;
+            finished = false;
+        }
+    };
+} // namespace engine::animation
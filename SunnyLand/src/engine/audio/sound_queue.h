@@ -0,0 +1,104 @@
+#pragma once
+#include "../utils/string_id.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace engine::audio
+{
+    /// @brief Handle of a sound started through a SoundQueue. 0 is never a valid voice.
+    using VoiceId = std::uint64_t;
+    constexpr VoiceId INVALID_VOICE = 0;
+
+    struct SoundParams
+    {
+        /// @brief 0 .. 1. Voices below VoiceSettings::audible_volume do not use a mixer channel.
+        float volume = 1.0f;
+        /// @brief Higher priorities take channels from lower ones when all channels are busy.
+        int priority = 0;
+        bool loop = false;
+    };
+
+    struct SoundCommand
+    {
+        enum class Type : std::uint8_t
+        {
+            Play,
+            Stop,
+            SetVolume,
+            SetPosition
+        };
+
+        Type type;
+        VoiceId voice;
+        engine::utils::StringId sound;
+        SoundParams params;
+        /// @brief World position of a positional voice; panned and attenuated relative to the camera.
+        bool positional;
+        glm::vec2 position;
+    };
+
+    /// @brief Sound commands of one simulation tick, handed to the VoiceManager with the frame's snapshot.
+    /// The simulation only records commands here, so it never touches SDL_mixer or the loaded sounds.
+    class SoundQueue final
+    {
+    private:
+        std::vector<SoundCommand> commands_;
+        VoiceId next_voice_ = 1;
+
+    public:
+        SoundQueue() = default;
+
+        SoundQueue(const SoundQueue &) = delete;
+        SoundQueue &operator=(const SoundQueue &) = delete;
+        SoundQueue(SoundQueue &&) = delete;
+        SoundQueue &operator=(SoundQueue &&) = delete;
+
+        /// @brief Plays a loaded sound. The returned handle stays valid until the sound ends or is stopped.
+        VoiceId play(engine::utils::StringId sound, const SoundParams &params = {})
+        {
+            VoiceId voice = next_voice_++;
+            commands_.push_back({SoundCommand::Type::Play, voice, sound, params, false, {}});
+            return voice;
+        }
+        VoiceId play(std::string_view file_path, const SoundParams &params = {})
+        {
+            return play(engine::utils::StringTable::intern(file_path), params);
+        }
+
+        /// @brief Plays a sound at a world position. Sources too far outside the view are not mixed at all.
+        VoiceId play(engine::utils::StringId sound, const glm::vec2 &position, const SoundParams &params = {})
+        {
+            VoiceId voice = next_voice_++;
+            commands_.push_back({SoundCommand::Type::Play, voice, sound, params, true, position});
+            return voice;
+        }
+        VoiceId play(std::string_view file_path, const glm::vec2 &position, const SoundParams &params = {})
+        {
+            return play(engine::utils::StringTable::intern(file_path), position, params);
+        }
+
+        void stop(VoiceId voice) { commands_.push_back({SoundCommand::Type::Stop, voice, 0, {}, false, {}}); }
+
+        void setVolume(VoiceId voice, float volume)
+        {
+            SoundParams params;
+            params.volume = volume;
+            commands_.push_back({SoundCommand::Type::SetVolume, voice, 0, params, false, {}});
+        }
+
+        /// @brief Moves a voice started with a position, e.g. to follow the entity making the sound.
+        void setPosition(VoiceId voice, const glm::vec2 &position)
+        {
+            commands_.push_back({SoundCommand::Type::SetPosition, voice, 0, {}, true, position});
+        }
+
+        /// @brief Moves the recorded commands into commands, whose previous content is dropped. Both keep their capacity.
+        void flush(std::vector<SoundCommand> &commands)
+        {
+            commands.swap(commands_);
+            commands_.clear();
+        }
+    };
+} // namespace engine::audio
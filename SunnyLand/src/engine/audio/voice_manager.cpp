@@ -0,0 +1,459 @@
+#include "voice_manager.h"
+#include "../resource/resource_manager.h"
+#include "../utils/log.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <SDL3/SDL_timer.h>
+#include <glm/glm.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::audio
+{
+    namespace
+    {
+        /// @brief Stored in VoiceManager::sound_cache_ for sounds that failed to load. Its address is compared, never played.
+        Mix_Chunk missing_sound{};
+    }
+
+    VoiceManager::VoiceManager(engine::resource::ResourceManager &resource_manager, const VoiceSettings &settings)
+        : resource_manager_(resource_manager), settings_(settings)
+    {
+        if (settings_.channels <= 0 || settings_.max_voices == 0)
+        {
+            throw std::runtime_error("VoiceManager needs a positive channel and voice count");
+        }
+        int frequency = 0;
+        int device_channels = 0;
+        SDL_AudioFormat format = SDL_AUDIO_UNKNOWN;
+        if (!Mix_QuerySpec(&frequency, &format, &device_channels))
+        {
+            throw std::runtime_error("VoiceManager needs an open audio device. SDL_mixer Error: " + std::string(SDL_GetError()));
+        }
+        // Loaded chunks are converted to the device format, so their length maps straight to time
+        frame_bytes_ = static_cast<std::uint32_t>(SDL_AUDIO_BYTESIZE(format) * device_channels);
+        bytes_per_second_ = static_cast<double>(frame_bytes_) * frequency;
+
+        settings_.channels = Mix_AllocateChannels(settings_.channels);
+        channel_voices_.assign(static_cast<std::size_t>(settings_.channels), -1);
+        channel_mix_.assign(static_cast<std::size_t>(settings_.channels), ChannelMix{});
+        free_channels_.reserve(static_cast<std::size_t>(settings_.channels));
+        for (int channel = settings_.channels; channel-- > 0;)
+        {
+            free_channels_.push_back(channel);
+        }
+
+        // The mixer keeps pointers to Voice::view while playing, so voices_ is never resized
+        voices_.resize(settings_.max_voices);
+        free_voices_.reserve(settings_.max_voices);
+        for (std::size_t i = settings_.max_voices; i-- > 0;)
+        {
+            free_voices_.push_back(static_cast<std::uint32_t>(i));
+        }
+        voice_ids_.reserve(settings_.max_voices);
+        started_.reserve(settings_.max_voices);
+        candidates_.reserve(settings_.max_voices);
+        spdlog::trace("VoiceManager created: {} channels, {} voices", settings_.channels, settings_.max_voices);
+    }
+
+    VoiceManager::~VoiceManager()
+    {
+        Mix_HaltChannel(-1);
+    }
+
+    Mix_Chunk *VoiceManager::getChunk(engine::utils::StringId sound)
+    {
+        if (sound >= sound_cache_.size())
+        {
+            sound_cache_.resize(sound + 1, nullptr);
+        }
+        Mix_Chunk *&chunk = sound_cache_[sound];
+        if (!chunk)
+        {
+            // A failed load is not retried on every play, only after forgetMissingSounds()
+            Mix_Chunk *loaded = resource_manager_.getSound(engine::utils::StringTable::lookup(sound));
+            chunk = loaded ? loaded : &missing_sound;
+        }
+        return chunk == &missing_sound ? nullptr : chunk;
+    }
+
+    double VoiceManager::getPosition(const Voice &voice, std::uint64_t now_ns) const
+    {
+        return static_cast<double>(now_ns - voice.start_ns) * 1e-9;
+    }
+
+    float VoiceManager::computeGain(const glm::vec2 &position) const
+    {
+        const glm::vec2 outside = glm::max(glm::max(listener_min_ - position, position - listener_max_), glm::vec2(0.0f));
+        const float distance = std::sqrt(outside.x * outside.x + outside.y * outside.y);
+        if (settings_.falloff_distance <= 0.0f)
+        {
+            return distance > 0.0f ? 0.0f : 1.0f;
+        }
+        return std::max(0.0f, 1.0f - distance / settings_.falloff_distance);
+    }
+
+    void VoiceManager::setListener(const glm::vec2 &view_position, const glm::vec2 &view_size)
+    {
+        listener_min_ = view_position;
+        listener_max_ = view_position + view_size;
+    }
+
+    void VoiceManager::startVoice(const SoundCommand &command, std::uint64_t now_ns)
+    {
+        Mix_Chunk *chunk = getChunk(command.sound);
+        if (!chunk)
+        {
+            return;
+        }
+
+        // Identical one-shots of the same update would only play louder together; keep the first one
+        if (!command.params.loop)
+        {
+            for (std::uint32_t index : started_)
+            {
+                Voice &voice = voices_[index];
+                if (voice.id != INVALID_VOICE && voice.chunk == chunk && !voice.loop && voice.positional == command.positional)
+                {
+                    // Heard from the source nearest to the camera
+                    if (voice.positional && computeGain(command.position) > computeGain(voice.position))
+                    {
+                        voice.position = command.position;
+                    }
+                    voice.volume = std::max(voice.volume, std::clamp(command.params.volume, 0.0f, 1.0f));
+                    voice.priority = std::max(voice.priority, command.params.priority);
+                    ++stats_.coalesced;
+                    return;
+                }
+            }
+        }
+
+        if (free_voices_.empty())
+        {
+            ++stats_.culled;
+            return;
+        }
+        const std::uint32_t index = free_voices_.back();
+        free_voices_.pop_back();
+        Voice &voice = voices_[index];
+        voice.id = command.voice;
+        voice.sound = command.sound;
+        voice.chunk = chunk;
+        voice.volume = std::clamp(command.params.volume, 0.0f, 1.0f);
+        voice.priority = command.params.priority;
+        voice.loop = command.params.loop;
+        voice.positional = command.positional;
+        voice.position = command.position;
+        voice.gain = 1.0f;
+        voice.pan = 0.0f;
+        voice.channel = -1;
+        voice.start_ns = now_ns;
+        voice.duration = chunk->alen / bytes_per_second_;
+        voice.is_new = true;
+        voice_ids_[voice.id] = index;
+        started_.push_back(index);
+        ++stats_.started;
+    }
+
+    void VoiceManager::playOnChannel(std::uint32_t index, int channel, std::uint64_t now_ns)
+    {
+        Voice &voice = voices_[index];
+        voice.view = *voice.chunk;
+        voice.view.allocated = 0;
+        if (voice.loop)
+        {
+            // A view cannot loop back to the start of the chunk, so loops restart
+            voice.start_ns = now_ns;
+        }
+        else
+        {
+            // Skip what would have played while the voice was virtual, on a sample frame boundary
+            const double played_bytes = getPosition(voice, now_ns) * bytes_per_second_;
+            const std::uint32_t offset = static_cast<std::uint32_t>(played_bytes / frame_bytes_) * frame_bytes_;
+            if (offset >= voice.view.alen)
+            {
+                free_channels_.push_back(channel);
+                freeVoice(index);
+                return;
+            }
+            voice.view.abuf += offset;
+            voice.view.alen -= offset;
+        }
+
+        applyMix(voice, channel);
+        if (Mix_PlayChannel(channel, &voice.view, voice.loop ? -1 : 0) < 0)
+        {
+            ENGINE_LOG_ERROR_THROTTLED("Failed to play sound {}: {}", engine::utils::StringTable::lookup(voice.sound), SDL_GetError());
+            free_channels_.push_back(channel);
+            freeVoice(index);
+            return;
+        }
+        voice.channel = channel;
+        channel_voices_[static_cast<std::size_t>(channel)] = static_cast<std::int32_t>(index);
+    }
+
+    void VoiceManager::applyMix(const Voice &voice, int channel)
+    {
+        ChannelMix &mix = channel_mix_[static_cast<std::size_t>(channel)];
+        const int volume = static_cast<int>(getLoudness(voice) * MIX_MAX_VOLUME + 0.5f);
+        if (volume != mix.volume)
+        {
+            Mix_Volume(channel, volume);
+            mix.volume = volume;
+        }
+        // Balance rather than constant power: the near side stays at full volume, 255/255 removes the effect
+        const Uint8 left = static_cast<Uint8>(255.0f * std::min(1.0f, 1.0f - voice.pan) + 0.5f);
+        const Uint8 right = static_cast<Uint8>(255.0f * std::min(1.0f, 1.0f + voice.pan) + 0.5f);
+        if (left != mix.left || right != mix.right)
+        {
+            if (!Mix_SetPanning(channel, left, right))
+            {
+                spdlog::warn("Failed to pan channel {}: {}", channel, SDL_GetError());
+            }
+            mix.left = left;
+            mix.right = right;
+        }
+    }
+
+    void VoiceManager::releaseChannel(Voice &voice)
+    {
+        if (voice.channel < 0)
+        {
+            return;
+        }
+        Mix_HaltChannel(voice.channel);
+        // Whether or not halting drops the channel's effects, the next voice on it starts centered
+        ChannelMix &mix = channel_mix_[static_cast<std::size_t>(voice.channel)];
+        if (mix.left != 255 || mix.right != 255)
+        {
+            Mix_SetPanning(voice.channel, 255, 255);
+            mix.left = 255;
+            mix.right = 255;
+        }
+        channel_voices_[static_cast<std::size_t>(voice.channel)] = -1;
+        free_channels_.push_back(voice.channel);
+        voice.channel = -1;
+    }
+
+    void VoiceManager::virtualize(std::uint32_t index, std::uint64_t now_ns)
+    {
+        Voice &voice = voices_[index];
+        releaseChannel(voice);
+        if (!voice.loop && voice.duration - getPosition(voice, now_ns) < settings_.min_virtual_seconds)
+        {
+            freeVoice(index);
+            ++stats_.culled;
+        }
+    }
+
+    void VoiceManager::freeVoice(std::uint32_t index)
+    {
+        Voice &voice = voices_[index];
+        releaseChannel(voice);
+        voice_ids_.erase(voice.id);
+        voice.id = INVALID_VOICE;
+        voice.chunk = nullptr;
+        voice.is_new = false;
+        free_voices_.push_back(index);
+    }
+
+    std::int32_t VoiceManager::findVictim() const
+    {
+        std::int32_t victim = -1;
+        for (std::int32_t index : channel_voices_)
+        {
+            if (index < 0)
+            {
+                continue;
+            }
+            const Voice &voice = voices_[static_cast<std::size_t>(index)];
+            if (victim < 0)
+            {
+                victim = index;
+                continue;
+            }
+            const Voice &worst = voices_[static_cast<std::size_t>(victim)];
+            if (voice.priority < worst.priority || (voice.priority == worst.priority && getLoudness(voice) < getLoudness(worst)))
+            {
+                victim = index;
+            }
+        }
+        return victim;
+    }
+
+    void VoiceManager::update(std::span<const SoundCommand> commands)
+    {
+        const std::uint64_t now_ns = SDL_GetTicksNS();
+        stats_ = {};
+
+        // Retire one-shots that played to the end, on a channel or virtually
+        for (std::uint32_t index = 0; index < voices_.size(); ++index)
+        {
+            const Voice &voice = voices_[index];
+            if (voice.id == INVALID_VOICE || voice.loop)
+            {
+                continue;
+            }
+            if (voice.channel >= 0 ? !Mix_Playing(voice.channel) : getPosition(voice, now_ns) >= voice.duration)
+            {
+                freeVoice(index);
+            }
+        }
+
+        started_.clear();
+        for (const SoundCommand &command : commands)
+        {
+            switch (command.type)
+            {
+            case SoundCommand::Type::Play:
+                startVoice(command, now_ns);
+                break;
+            case SoundCommand::Type::Stop:
+            {
+                // Unknown handles belong to sounds that already ended or were coalesced
+                auto it = voice_ids_.find(command.voice);
+                if (it != voice_ids_.end())
+                {
+                    freeVoice(it->second);
+                }
+                break;
+            }
+            case SoundCommand::Type::SetVolume:
+            {
+                auto it = voice_ids_.find(command.voice);
+                if (it != voice_ids_.end())
+                {
+                    voices_[it->second].volume = std::clamp(command.params.volume, 0.0f, 1.0f);
+                }
+                break;
+            }
+            case SoundCommand::Type::SetPosition:
+            {
+                auto it = voice_ids_.find(command.voice);
+                if (it != voice_ids_.end() && voices_[it->second].positional)
+                {
+                    voices_[it->second].position = command.position;
+                }
+                break;
+            }
+            }
+        }
+
+        // Spatialize every positional voice in one pass against the current view
+        const glm::vec2 listener_center = (listener_min_ + listener_max_) * 0.5f;
+        const float half_width = std::max((listener_max_.x - listener_min_.x) * 0.5f, 1.0f);
+        for (Voice &voice : voices_)
+        {
+            if (voice.id == INVALID_VOICE || !voice.positional)
+            {
+                continue;
+            }
+            voice.gain = computeGain(voice.position);
+            voice.pan = std::clamp((voice.position.x - listener_center.x) / half_width, -1.0f, 1.0f);
+        }
+
+        // Inaudible voices give up their channel; audible voices without one compete for the free and stolen channels
+        candidates_.clear();
+        for (std::uint32_t index = 0; index < voices_.size(); ++index)
+        {
+            const Voice &voice = voices_[index];
+            if (voice.id == INVALID_VOICE)
+            {
+                continue;
+            }
+            if (getLoudness(voice) < settings_.audible_volume)
+            {
+                if (voice.channel >= 0)
+                {
+                    virtualize(index, now_ns);
+                }
+            }
+            else if (voice.channel < 0)
+            {
+                candidates_.push_back(index);
+            }
+        }
+        std::sort(candidates_.begin(), candidates_.end(), [this](std::uint32_t a, std::uint32_t b)
+                  {
+                      const Voice &va = voices_[a];
+                      const Voice &vb = voices_[b];
+                      if (va.priority != vb.priority)
+                          return va.priority > vb.priority;
+                      return getLoudness(va) > getLoudness(vb); });
+
+        for (std::uint32_t index : candidates_)
+        {
+            if (free_channels_.empty())
+            {
+                const std::int32_t victim = findVictim();
+                if (victim >= 0 && voices_[index].priority > voices_[static_cast<std::size_t>(victim)].priority)
+                {
+                    virtualize(static_cast<std::uint32_t>(victim), now_ns);
+                    ++stats_.stolen;
+                }
+            }
+            if (!free_channels_.empty())
+            {
+                const int channel = free_channels_.back();
+                free_channels_.pop_back();
+                playOnChannel(index, channel, now_ns);
+            }
+            else if (voices_[index].is_new)
+            {
+                // Left without a channel from the start: keep it only if it is worth resuming later
+                virtualize(index, now_ns);
+            }
+        }
+
+        for (std::uint32_t index : started_)
+        {
+            voices_[index].is_new = false;
+        }
+        for (std::size_t channel = 0; channel < channel_voices_.size(); ++channel)
+        {
+            if (channel_voices_[channel] >= 0)
+            {
+                applyMix(voices_[static_cast<std::size_t>(channel_voices_[channel])], static_cast<int>(channel));
+            }
+        }
+        for (const Voice &voice : voices_)
+        {
+            if (voice.id != INVALID_VOICE && voice.positional && voice.gain <= 0.0f)
+            {
+                ++stats_.distant;
+            }
+        }
+        stats_.active = static_cast<std::size_t>(settings_.channels) - free_channels_.size();
+        stats_.virtual_voices = voice_ids_.size() - stats_.active;
+    }
+
+    void VoiceManager::releaseSound(Mix_Chunk *chunk)
+    {
+        for (std::uint32_t index = 0; index < voices_.size(); ++index)
+        {
+            if (voices_[index].id != INVALID_VOICE && voices_[index].chunk == chunk)
+            {
+                freeVoice(index);
+            }
+        }
+        std::replace(sound_cache_.begin(), sound_cache_.end(), chunk, static_cast<Mix_Chunk *>(nullptr));
+    }
+
+    void VoiceManager::releaseSounds()
+    {
+        for (std::uint32_t index = 0; index < voices_.size(); ++index)
+        {
+            if (voices_[index].id != INVALID_VOICE)
+            {
+                freeVoice(index);
+            }
+        }
+        sound_cache_.clear();
+    }
+
+    void VoiceManager::forgetMissingSounds()
+    {
+        std::replace(sound_cache_.begin(), sound_cache_.end(), &missing_sound, static_cast<Mix_Chunk *>(nullptr));
+    }
+} // namespace engine::audio
@@ -0,0 +1,155 @@
+#pragma once
+#include "sound_queue.h"
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <SDL3_mixer/SDL_mixer.h>
+
+namespace engine::resource
+{
+    class ResourceManager;
+}
+
+namespace engine::audio
+{
+    struct VoiceSettings
+    {
+        /// @brief Mixer channels; at most this many voices are mixed at once.
+        int channels = 16;
+        /// @brief Voices tracked at once, playing or virtual.
+        std::size_t max_voices = 128;
+        /// @brief Voices quieter than this are virtual: they keep their place in time without being mixed.
+        float audible_volume = 0.01f;
+        /// @brief One-shots with less left to play are dropped instead of made virtual when they lose their channel.
+        float min_virtual_seconds = 0.25f;
+        /// @brief Positional voices fade out over this many pixels outside the view; beyond it they are silent and not mixed.
+        float falloff_distance = 320.0f;
+    };
+
+    /// @brief What happened to voices in the last update().
+    struct VoiceStats
+    {
+        /// @brief Voices being mixed and voices waiting as virtual at the end of the update.
+        std::size_t active = 0;
+        std::size_t virtual_voices = 0;
+        /// @brief Sounds dropped because no channel was left for them (including stolen one-shots).
+        std::size_t culled = 0;
+        /// @brief Plays merged into an identical sound started in the same update.
+        std::size_t coalesced = 0;
+        /// @brief Channels taken from a lower priority voice.
+        std::size_t stolen = 0;
+        std::size_t started = 0;
+        /// @brief Positional voices out of earshot of the camera at the end of the update.
+        std::size_t distant = 0;
+    };
+
+    /// @brief Plays sounds on a fixed budget of mixer channels.
+    /// Every sound is a voice. Voices that are too quiet to hear, or lose their channel to a higher priority
+    /// sound, become virtual: they keep advancing in time without being mixed, and resume at the right
+    /// position once a channel is free and they are audible again. Identical one-shots started in the same
+    /// update are played once, at the loudest of their volumes.
+    /// Positional voices are panned and attenuated by their distance to the view set with setListener(),
+    /// recomputed for all of them once per update.
+    /// Not thread-safe; call everything on the thread that owns the ResourceManager.
+    class VoiceManager final
+    {
+    private:
+        struct Voice
+        {
+            VoiceId id = INVALID_VOICE;
+            engine::utils::StringId sound = 0;
+            Mix_Chunk *chunk = nullptr;
+            /// @brief What the mixer plays: chunk, or the part of it after the position a virtual voice resumes at.
+            Mix_Chunk view{};
+            float volume = 1.0f;
+            /// @brief Attenuation by distance to the listener; always 1 for voices without a position.
+            float gain = 1.0f;
+            /// @brief -1 (left) .. 1 (right).
+            float pan = 0.0f;
+            int priority = 0;
+            bool loop = false;
+            bool positional = false;
+            glm::vec2 position{0.0f, 0.0f};
+            /// @brief -1 while virtual.
+            int channel = -1;
+            /// @brief SDL_GetTicksNS() at which the voice was (or would have been) at its start.
+            std::uint64_t start_ns = 0;
+            double duration = 0.0;
+            /// @brief Started by the current update; new voices are coalesced and placed first.
+            bool is_new = false;
+        };
+
+        engine::resource::ResourceManager &resource_manager_;
+        VoiceSettings settings_;
+        double bytes_per_second_ = 0.0;
+        std::uint32_t frame_bytes_ = 1;
+
+        /// @brief What was last set on a mixer channel, to skip redundant calls into the mixer.
+        struct ChannelMix
+        {
+            int volume = -1;
+            Uint8 left = 255;
+            Uint8 right = 255;
+        };
+
+        std::vector<Voice> voices_;
+        std::vector<std::uint32_t> free_voices_;
+        std::unordered_map<VoiceId, std::uint32_t> voice_ids_;
+        /// @brief Voice index per mixer channel, or -1.
+        std::vector<std::int32_t> channel_voices_;
+        std::vector<std::int32_t> free_channels_;
+        std::vector<ChannelMix> channel_mix_;
+        glm::vec2 listener_min_{0.0f, 0.0f};
+        glm::vec2 listener_max_{0.0f, 0.0f};
+        /// @brief Loaded sound per interned path, or nullptr if not looked up yet. Sounds that failed to load hold a sentinel.
+        std::vector<Mix_Chunk *> sound_cache_;
+        /// @brief Scratch of update(): voices started by it, and voices waiting for a channel, best first.
+        std::vector<std::uint32_t> started_;
+        std::vector<std::uint32_t> candidates_;
+        VoiceStats stats_;
+
+        Mix_Chunk *getChunk(engine::utils::StringId sound);
+        void startVoice(const SoundCommand &command, std::uint64_t now_ns);
+        double getPosition(const Voice &voice, std::uint64_t now_ns) const;
+        /// @brief Attenuation of a source at the position: 1 in view, fading to 0 at falloff_distance outside it.
+        float computeGain(const glm::vec2 &position) const;
+        static float getLoudness(const Voice &voice) { return voice.volume * voice.gain; }
+        void applyMix(const Voice &voice, int channel);
+        /// @brief Halts the voice's channel, if it has one, and returns the channel to the free list.
+        void releaseChannel(Voice &voice);
+        void playOnChannel(std::uint32_t index, int channel, std::uint64_t now_ns);
+        /// @brief Stops mixing the voice. It stays virtual if it can resume later, otherwise it is freed and counted as culled.
+        void virtualize(std::uint32_t index, std::uint64_t now_ns);
+        void freeVoice(std::uint32_t index);
+        /// @brief Playing voice with the lowest priority, then loudness, or -1.
+        std::int32_t findVictim() const;
+
+    public:
+        /// @brief Allocates the mixer channels. The audio device must be open; sounds are looked up in resource_manager.
+        VoiceManager(engine::resource::ResourceManager &resource_manager, const VoiceSettings &settings = {});
+        ~VoiceManager();
+
+        VoiceManager(const VoiceManager &) = delete;
+        VoiceManager &operator=(const VoiceManager &) = delete;
+        VoiceManager(VoiceManager &&) = delete;
+        VoiceManager &operator=(VoiceManager &&) = delete;
+
+        /// @brief Sets the view positional voices are heard from, in world coordinates. Takes effect on the next update().
+        void setListener(const glm::vec2 &view_position, const glm::vec2 &view_size);
+
+        /// @brief Applies the commands of one tick, retires finished voices and hands out channels. Call once per frame,
+        /// with no commands on frames without a simulation tick.
+        void update(std::span<const SoundCommand> commands);
+
+        /// @brief Stops every voice using the sound and forgets the cached chunk. Call before the chunk is freed.
+        void releaseSound(Mix_Chunk *chunk);
+        /// @brief Stops every voice and forgets all cached chunks. Call before sounds are cleared.
+        void releaseSounds();
+        /// @brief Looks sounds that failed to load up again on their next play. Call when a sound is added.
+        void forgetMissingSounds();
+
+        const VoiceStats &getStats() const { return stats_; }
+        const VoiceSettings &getSettings() const { return settings_; }
+    };
+} // namespace engine::audio
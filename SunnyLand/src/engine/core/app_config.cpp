@@ -0,0 +1,177 @@
+#include "app_config.h"
+#include <spdlog/spdlog.h>
+#include <string_view>
+#include <stdexcept>
+
+namespace engine::core
+{
+    AppConfig AppConfig::fromCommandLine(int argc, char **argv)
+    {
+        AppConfig config;
+        bool explicit_log_level = false;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+            bool has_value = i + 1 < argc;
+
+            try
+            {
+                if (arg == "--record" && has_value)
+                {
+                    config.record_path = argv[++i];
+                }
+                else if (arg == "--replay" && has_value)
+                {
+                    config.replay_path = argv[++i];
+                }
+                else if (arg == "--uncapped")
+                {
+                    config.uncapped = true;
+                }
+                else if (arg == "--seed" && has_value)
+                {
+                    config.seed = std::stoull(argv[++i]);
+                }
+                else if (arg == "--fps" && has_value)
+                {
+                    config.target_fps = std::stoi(argv[++i]);
+                }
+                else if (arg == "--pipelined")
+                {
+                    config.pipelined = true;
+                }
+                else if (arg == "--on-demand")
+                {
+                    config.on_demand = true;
+                }
+                else if (arg == "--idle-timeout" && has_value)
+                {
+                    config.idle_timeout_ms = std::stoi(argv[++i]);
+                }
+                else if (arg == "--internal-resolution" && has_value)
+                {
+                    std::string_view value = argv[++i];
+                    std::size_t separator = value.find('x');
+                    if (separator == std::string_view::npos)
+                    {
+                        throw std::invalid_argument("expected WIDTHxHEIGHT");
+                    }
+                    int width = std::stoi(std::string(value.substr(0, separator)));
+                    int height = std::stoi(std::string(value.substr(separator + 1)));
+                    if (width <= 0 || height <= 0)
+                    {
+                        throw std::invalid_argument("width and height must be positive");
+                    }
+                    config.internal_width = width;
+                    config.internal_height = height;
+                }
+                else if (arg == "--job-threads" && has_value)
+                {
+                    config.job_threads = std::stoi(argv[++i]);
+                }
+                else if (arg == "--headless")
+                {
+                    config.headless = true;
+                }
+                else if (arg == "--stress")
+                {
+                    config.stress = true;
+                }
+                else if (arg == "--stress-start" && has_value)
+                {
+                    config.stress_start_count = std::stoi(argv[++i]);
+                }
+                else if (arg == "--stress-step" && has_value)
+                {
+                    config.stress_step = std::stoi(argv[++i]);
+                }
+                else if (arg == "--stress-budget" && has_value)
+                {
+                    config.stress_budget_ms = std::stod(argv[++i]);
+                }
+                else if (arg == "--memory-report" && has_value)
+                {
+                    config.memory_report_s = std::stod(argv[++i]);
+                }
+                else if (arg == "--dump-schedule")
+                {
+                    config.dump_schedule = true;
+                }
+                else if (arg == "--perf-hud")
+                {
+                    config.perf_hud = true;
+                }
+                else if (arg == "--capture-render" && has_value)
+                {
+                    config.capture_path = argv[++i];
+                }
+                else if (arg == "--capture-frames" && has_value)
+                {
+                    config.capture_frames = std::stoi(argv[++i]);
+                }
+                else if (arg == "--animations" && has_value)
+                {
+                    config.animations_path = argv[++i];
+                }
+                else if (arg == "--manifest" && has_value)
+                {
+                    config.manifest_path = argv[++i];
+                }
+                else if (arg == "--log-level" && has_value)
+                {
+                    config.log_level = spdlog::level::from_str(argv[++i]);
+                    explicit_log_level = true;
+                }
+                else
+                {
+                    spdlog::warn("Ignoring unknown command line argument: {}", arg);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                spdlog::warn("Invalid value for command line argument {}: {}", arg, e.what());
+            }
+        }
+
+        if (config.isRecording() && config.isReplaying())
+        {
+            spdlog::warn("Both --record and --replay given. Recording is disabled.");
+            config.record_path.clear();
+        }
+
+        if (config.on_demand && config.isReplaying())
+        {
+            spdlog::warn("On-demand rendering is disabled while replaying.");
+            config.on_demand = false;
+        }
+        if (config.on_demand && config.pipelined)
+        {
+            spdlog::warn("On-demand rendering uses the serial loop. --pipelined is ignored.");
+            config.pipelined = false;
+        }
+
+        if (config.stress)
+        {
+            // Spawning depends on measured frame times, so a recording could not be replayed
+            if (config.isRecording() || config.isReplaying())
+            {
+                spdlog::warn("--record and --replay are ignored by the stress test.");
+                config.record_path.clear();
+                config.replay_path.clear();
+            }
+            config.on_demand = false;
+            // The frame limiter would hide how much time is left
+            config.target_fps = 0;
+        }
+
+        // The replay report, the schedule dump, the stress report, memory reports and captures are logged at info level
+        if ((config.isReplaying() || config.dump_schedule || config.stress || config.memory_report_s > 0.0 || !config.capture_path.empty()) &&
+            !explicit_log_level)
+        {
+            config.log_level = spdlog::level::info;
+        }
+
+        return config;
+    }
+} // namespace engine::core
@@ -0,0 +1,87 @@
+#pragma once
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <spdlog/common.h>
+
+namespace engine::core
+{
+    /// @brief Startup options of the application, usually parsed from the command line.
+    struct AppConfig
+    {
+        /// @brief Log level applied by main(). Levels below SPDLOG_ACTIVE_LEVEL only reach plain spdlog:: calls,
+        /// since the ENGINE_LOG_* macros below it are compiled out (trace and debug in every build but Debug).
+        spdlog::level::level_enum log_level = spdlog::level::warn;
+
+        /// @brief Resource manifest preloaded at startup. Empty to disable preloading.
+        std::string manifest_path = "assets/manifest.json";
+
+        /// @brief Animation clips loaded at startup. Empty to start without clips.
+        std::string animations_path = "assets/animations.json";
+
+        /// @brief Target frames per second used by the frame limiter (0 = no limit).
+        int target_fps = 60;
+
+        /// @brief Seed of the game RNG. A random seed is chosen when not set.
+        std::optional<std::uint64_t> seed;
+
+        /// @brief File the per-tick input stream is recorded into.
+        std::string record_path;
+        /// @brief File a recorded input stream is replayed from.
+        std::string replay_path;
+        /// @brief Run the replay as fast as possible, ignoring the target FPS.
+        bool uncapped = false;
+
+        /// @brief Simulate frame N+1 on a worker thread while frame N is rendered.
+        bool pipelined = false;
+
+        /// @brief Only redraw when something changed, and block on events while idle.
+        bool on_demand = false;
+        /// @brief Longest time an idle on-demand loop sleeps before running a tick anyway.
+        int idle_timeout_ms = 250;
+
+        /// @brief Resolution the world is rendered at before being upscaled to the window, e.g. 320x180.
+        /// 0 renders the world at window resolution with a 1280x720 camera.
+        int internal_width = 0;
+        int internal_height = 0;
+
+        /// @brief Time per frame spent handing background-loaded resources to the ResourceManager, in ms.
+        double upload_budget_ms = 2.0;
+
+        /// @brief Worker threads of the job system running ECS systems. Negative picks one less than the hardware threads.
+        int job_threads = -1;
+        /// @brief Log the ECS system schedule after the first tick.
+        bool dump_schedule = false;
+
+        /// @brief Run without a visible window or audio device, e.g. for stress tests on build machines.
+        bool headless = false;
+
+        /// @brief Start in the stress scene, which adds sprites until frames take longer than stress_budget_ms.
+        bool stress = false;
+        int stress_start_count = 1000;
+        int stress_step = 1000;
+        double stress_budget_ms = 1000.0 / 60.0;
+
+        /// @brief Seconds between memory reports (tracked allocations per tag and resource sizes). 0 only reports at exit.
+        double memory_report_s = 0.0;
+
+        /// @brief Show the performance overlay from the start. F3 toggles it at any time.
+        /// While it is visible an on-demand loop draws every frame.
+        bool perf_hud = false;
+
+        /// @brief File the render commands of the first capture_frames frames are captured into. Empty to not capture
+        /// at startup; F4 starts a capture at any time, into this file or render_capture.slrc.
+        std::string capture_path;
+        int capture_frames = 120;
+
+        /// @brief Simulation step used while recording or replaying, in seconds.
+        double fixed_step = 1.0 / 60.0;
+
+        bool isRecording() const { return !record_path.empty(); }
+        bool isReplaying() const { return !replay_path.empty(); }
+        bool useFixedStep() const { return isRecording() || isReplaying(); }
+
+        /// @brief Parses the command line arguments. Unknown arguments are ignored with a warning.
+        static AppConfig fromCommandLine(int argc, char **argv);
+    };
+} // namespace engine::core
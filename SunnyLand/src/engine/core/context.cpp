@@ -0,0 +1,35 @@
+#include "context.h"
+#include "../input/input_state.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    Context::Context(const engine::input::InputState &input, const engine::input::InputState &previous_input,
+                     engine::render::Camera &camera, engine::utils::Random &random,
+                     engine::resource::AsyncResourceLoader &resource_loader, engine::ecs::World &world,
+                     const engine::animation::AnimationLibrary &animations, engine::particles::ParticleSystem &particles,
+                     const engine::physics::CollisionSystem &collisions, engine::audio::SoundQueue &sounds)
+        : input_(input), previous_input_(previous_input), camera_(camera), random_(random), resource_loader_(resource_loader),
+          world_(world), animations_(animations), particles_(particles), collisions_(collisions), sounds_(sounds)
+    {
+        spdlog::trace("Context created");
+    }
+
+    bool Context::isKeyDown(SDL_Scancode key) const
+    {
+        return input_.isKeyDown(key);
+    }
+
+    bool Context::isKeyPressed(SDL_Scancode key) const
+    {
+        return input_.isKeyDown(key) && !previous_input_.isKeyDown(key);
+    }
+
+    bool Context::consumeRedraw()
+    {
+        bool needs_redraw = redraw_requested_ || animating_;
+        redraw_requested_ = false;
+        animating_ = false;
+        return needs_redraw;
+    }
+} // namespace engine::core
@@ -0,0 +1,140 @@
+#pragma once
+#include <cstdint>
+#include <SDL3/SDL_scancode.h>
+
+namespace engine::input
+{
+    class InputState;
+}
+
+namespace engine::render
+{
+    class Camera;
+}
+
+namespace engine::resource
+{
+    class AsyncResourceLoader;
+}
+
+namespace engine::utils
+{
+    class Random;
+}
+
+namespace engine::ecs
+{
+    class World;
+}
+
+namespace engine::animation
+{
+    class AnimationLibrary;
+}
+
+namespace engine::particles
+{
+    class ParticleSystem;
+}
+
+namespace engine::physics
+{
+    class CollisionSystem;
+}
+
+namespace engine::audio
+{
+    class SoundQueue;
+}
+
+namespace engine::core
+{
+    /// @brief Cost of the last frame that was drawn, for scenes that adapt to it such as the stress test.
+    struct FrameTimings
+    {
+        /// @brief Number of frames drawn so far; changes whenever the other fields do.
+        std::uint64_t frame = 0;
+        double frame_ms = 0.0;
+        double simulation_ms = 0.0;
+        /// @brief Includes present_ms.
+        double render_ms = 0.0;
+        double present_ms = 0.0;
+        /// @brief Time the frame limiter slept before the frame started; not part of frame_ms.
+        double sleep_ms = 0.0;
+        std::uint32_t draw_calls = 0;
+        /// @brief Heap allocations made by all threads since the previous frame. Always 0 unless the engine is
+        /// built with SUNNYLAND_TRACK_ALLOCATIONS.
+        std::uint64_t allocations = 0;
+    };
+
+    /// @brief Everything a scene may use while simulating, handed out by GameApp.
+    /// Only state that belongs to the simulation is reachable from here; the Renderer is not,
+    /// so that simulation may run on a different thread than rendering.
+    class Context final
+    {
+    private:
+        const engine::input::InputState &input_;
+        const engine::input::InputState &previous_input_;
+        engine::render::Camera &camera_;
+        engine::utils::Random &random_;
+        engine::resource::AsyncResourceLoader &resource_loader_;
+        engine::ecs::World &world_;
+        const engine::animation::AnimationLibrary &animations_;
+        engine::particles::ParticleSystem &particles_;
+        const engine::physics::CollisionSystem &collisions_;
+        engine::audio::SoundQueue &sounds_;
+
+        FrameTimings last_frame_;
+
+        bool redraw_requested_ = true;
+        bool animating_ = false;
+        bool quit_requested_ = false;
+
+    public:
+        Context(const engine::input::InputState &input, const engine::input::InputState &previous_input,
+                engine::render::Camera &camera, engine::utils::Random &random,
+                engine::resource::AsyncResourceLoader &resource_loader, engine::ecs::World &world,
+                const engine::animation::AnimationLibrary &animations, engine::particles::ParticleSystem &particles,
+                const engine::physics::CollisionSystem &collisions, engine::audio::SoundQueue &sounds);
+
+        Context(const Context &) = delete;
+        Context &operator=(const Context &) = delete;
+        Context(Context &&) = delete;
+        Context &operator=(Context &&) = delete;
+
+        const engine::input::InputState &getInput() const { return input_; }
+        engine::render::Camera &getCamera() const { return camera_; }
+        engine::utils::Random &getRandom() const { return random_; }
+        engine::resource::AsyncResourceLoader &getResourceLoader() const { return resource_loader_; }
+        /// @brief Entities of all scenes. Its systems are run by GameApp after the scene update.
+        engine::ecs::World &getWorld() const { return world_; }
+        const engine::animation::AnimationLibrary &getAnimations() const { return animations_; }
+        /// @brief Particle emitters of all scenes, updated by GameApp together with the world.
+        engine::particles::ParticleSystem &getParticles() const { return particles_; }
+        /// @brief Overlapping colliders found by the previous tick's systems.
+        const engine::physics::CollisionSystem &getCollisions() const { return collisions_; }
+        /// @brief Sound effects of the tick; GameApp plays them once the tick is done.
+        engine::audio::SoundQueue &getSounds() const { return sounds_; }
+
+        /// @brief True while the key is held.
+        bool isKeyDown(SDL_Scancode key) const;
+        /// @brief True only on the tick the key went down.
+        bool isKeyPressed(SDL_Scancode key) const;
+
+        /// @brief Asks for the next frame to be drawn. Needed in on-demand mode whenever the scene changed.
+        void requestRedraw() { redraw_requested_ = true; }
+        /// @brief Keeps on-demand mode drawing for the current tick, e.g. while an animation plays.
+        void markAnimating() { animating_ = true; }
+        /// @brief Returns whether the tick that just ran needs to be drawn, and resets the flags.
+        bool consumeRedraw();
+
+        /// @brief Timings of the last drawn frame. In pipelined mode that frame is one tick behind.
+        const FrameTimings &getLastFrame() const { return last_frame_; }
+        /// @brief Called by GameApp between ticks, never while one is being simulated.
+        void setLastFrame(const FrameTimings &timings) { last_frame_ = timings; }
+
+        /// @brief Asks the application to exit after the current tick.
+        void requestQuit() { quit_requested_ = true; }
+        bool isQuitRequested() const { return quit_requested_; }
+    };
+} // namespace engine::core
@@ -0,0 +1,79 @@
+#include "frame_stats.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    FrameStats::FrameStats(std::size_t capacity)
+        : capacity_(std::max<std::size_t>(capacity, 1))
+    {
+        samples_ms_.reserve(capacity_);
+    }
+
+    void FrameStats::addSample(double frame_ms)
+    {
+        if (samples_ms_.size() < capacity_)
+        {
+            samples_ms_.push_back(frame_ms);
+        }
+        else
+        {
+            samples_ms_[next_] = frame_ms;
+            next_ = (next_ + 1) % capacity_;
+        }
+
+        min_ms_ = count_ == 0 ? frame_ms : std::min(min_ms_, frame_ms);
+        max_ms_ = count_ == 0 ? frame_ms : std::max(max_ms_, frame_ms);
+        total_ms_ += frame_ms;
+        ++count_;
+    }
+
+    void FrameStats::clear()
+    {
+        samples_ms_.clear();
+        next_ = 0;
+        count_ = 0;
+        total_ms_ = 0.0;
+        min_ms_ = 0.0;
+        max_ms_ = 0.0;
+    }
+
+    FrameStats::Summary FrameStats::summarize() const
+    {
+        Summary summary;
+        if (samples_ms_.empty())
+        {
+            return summary;
+        }
+
+        std::vector<double> sorted = samples_ms_;
+        std::sort(sorted.begin(), sorted.end());
+
+        auto percentile = [&sorted](double p)
+        {
+            std::size_t index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[index];
+        };
+
+        summary.frames = count_;
+        summary.total_ms = total_ms_;
+        summary.min_ms = min_ms_;
+        summary.avg_ms = total_ms_ / static_cast<double>(count_);
+        summary.p50_ms = percentile(0.50);
+        summary.p95_ms = percentile(0.95);
+        summary.p99_ms = percentile(0.99);
+        summary.max_ms = max_ms_;
+        return summary;
+    }
+
+    void FrameStats::logSummary(const char *title) const
+    {
+        Summary s = summarize();
+        if (count_ > samples_ms_.size())
+        {
+            spdlog::info("{}: percentiles over the last {} frames", title, samples_ms_.size());
+        }
+        spdlog::info("{}: {} frames in {:.1f} ms | min {:.3f} avg {:.3f} p50 {:.3f} p95 {:.3f} p99 {:.3f} max {:.3f} (ms)",
+                     title, s.frames, s.total_ms, s.min_ms, s.avg_ms, s.p50_ms, s.p95_ms, s.p99_ms, s.max_ms);
+    }
+} // namespace engine::core
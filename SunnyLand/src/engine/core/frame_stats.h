@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+namespace engine::core
+{
+    /// @brief Collects per-frame durations and summarizes them.
+    /// @details Keeps the most recent `capacity` samples in a ring, so a live session uses fixed memory. Frame count,
+    ///          total, min, avg and max cover every sample; percentiles cover the samples still in the ring.
+    class FrameStats final
+    {
+    public:
+        /// @brief Default ring size: a little over four minutes at 60 FPS.
+        static constexpr std::size_t DEFAULT_CAPACITY = 16384;
+
+        struct Summary
+        {
+            std::size_t frames = 0;
+            double total_ms = 0.0;
+            double min_ms = 0.0;
+            double avg_ms = 0.0;
+            double p50_ms = 0.0;
+            double p95_ms = 0.0;
+            double p99_ms = 0.0;
+            double max_ms = 0.0;
+        };
+
+    private:
+        std::vector<double> samples_ms_; ///< @brief Ring of the most recent samples.
+        std::size_t capacity_;
+        std::size_t next_ = 0;           ///< @brief Ring slot overwritten once the ring is full.
+        std::size_t count_ = 0;
+        double total_ms_ = 0.0;
+        double min_ms_ = 0.0;
+        double max_ms_ = 0.0;
+
+    public:
+        /// @param capacity Samples kept for percentiles. Pass the exact frame count when it is known (replays) to keep all.
+        explicit FrameStats(std::size_t capacity = DEFAULT_CAPACITY);
+
+        void addSample(double frame_ms);
+        void clear();
+
+        std::size_t getSampleCount() const { return count_; }
+
+        /// @brief Computes min/avg/percentiles/max; percentiles are over the retained window.
+        Summary summarize() const;
+
+        /// @brief Logs the summary at info level.
+        void logSummary(const char *title) const;
+    };
+} // namespace engine::core
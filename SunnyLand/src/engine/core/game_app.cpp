@@ -4,12 +4,35 @@
 #include <spdlog/spdlog.h>
 #include "time.h"
 #include "../resource/resource_manager.h"
+#include "../resource/audio_manager.h"
+#include "../resource/font_manager.h"
 #include "../render/renderer.h"
 #include "../render/camera.h"
+#include "../render/render_snapshot.h"
+#include "../resource/async_resource_loader.h"
+#include "../input/input_recorder.h"
+#include "../scene/scene_manager.h"
+#include "../ecs/world.h"
+#include "../ecs/components.h"
+#include "../ecs/movement_system.h"
+#include "../ecs/system_scheduler.h"
+#include "../animation/animation_library.h"
+#include "../animation/animation_system.h"
+#include "../ecs/sprite_render_system.h"
+#include "../particles/particle_system.h"
+#include "../physics/collision_system.h"
+#include "../physics/collider.h"
+#include "../animation/animator.h"
+#include "worker_thread.h"
+#include "job_system.h"
+#include "memory_tracker.h"
+#include "context.h"
+#include "../utils/hash.h"
+#include <bit>
 
 namespace engine::core
 {
-    GameApp::GameApp() = default;
+    GameApp::GameApp(AppConfig config) : config_(std::move(config)) {}
 
     GameApp::~GameApp()
     {
@@ -24,34 +47,90 @@ namespace engine::core
     {
         spdlog::info("Initializing GameApp");
 
-        if (!initSDL())
+        auto timed = [this](const char *name, auto &&init)
+        {
+            StartupTimeline::Scope scope(startup_timeline_, name, "main");
+            return init();
+        };
+
+        if (!timed("SDL_Init", [this]
+                   { return initSDL(); }))
         {
             spdlog::error("Failed to initialize SDL");
             return false;
         }
-        if (!initTime())
+
+        // Audio device, TTF and manifest preloading do not depend on the window, so they run on
+        // worker threads while the window and renderer are created. The futures are joined in
+        // initResourceManager, or on return if an earlier step fails.
+        engine::resource::ResourceManifest manifest = loadManifest();
+        auto audio_future = std::async(std::launch::async, [this, sounds = manifest.sounds, music = manifest.music]
+                                       {
+                                           StartupTimeline::Scope scope(startup_timeline_, "Audio device + sounds", "worker");
+                                           return engine::resource::ResourceManager::createAudioManager(sounds, music); });
+        auto font_future = std::async(std::launch::async, [this, fonts = manifest.fonts]
+                                      {
+                                          StartupTimeline::Scope scope(startup_timeline_, "TTF + fonts", "worker");
+                                          return engine::resource::ResourceManager::createFontManager(fonts); });
+        auto texture_future = std::async(std::launch::async, [this, textures = manifest.textures]
+                                         {
+                                             StartupTimeline::Scope scope(startup_timeline_, "Texture decode", "worker");
+                                             return engine::resource::decodeTextures(textures); });
+
+        if (!timed("Window + SDL renderer", [this]
+                   { return initWindow(); }))
+        {
+            spdlog::error("Failed to initialize window");
+            return false;
+        }
+        if (!timed("Time", [this]
+                   { return initTime(); }))
         {
             spdlog::error("Failed to initialize Time");
             return false;
         }
-        if (!initResourceManager())
+        if (!timed("ResourceManager (join + upload)", [&]
+                   { return initResourceManager(audio_future, font_future, texture_future); }))
         {
             spdlog::error("Failed to initialize ResourceManager");
             return false;
         }
 
-        if (!initCamera())
+        if (!timed("Camera", [this]
+                   { return initCamera(); }))
         {
             spdlog::error("Failed to initialize Camera");
             return false;
         }
 
-        if (!initRenderer())
+        if (!timed("Renderer", [this]
+                   { return initRenderer(); }))
         {
             spdlog::error("Failed to initialize Renderer");
             return false;
         }
 
+        if (!timed("Input", [this]
+                   { return initInput(); }))
+        {
+            spdlog::error("Failed to initialize Input");
+            return false;
+        }
+
+        if (!timed("World", [this]
+                   { return initWorld(); }))
+        {
+            spdlog::error("Failed to initialize World");
+            return false;
+        }
+
+        if (!timed("SceneManager", [this]
+                   { return initSceneManager(); }))
+        {
+            spdlog::error("Failed to initialize SceneManager");
+            return false;
+        }
+
         testResourceManager();
 
         is_running_ = true;
@@ -61,13 +140,23 @@ namespace engine::core
 
     bool GameApp::initSDL()
     {
+        if (config_.headless)
+        {
+            // Render into an offscreen framebuffer and mix into nothing, so no display or audio device is needed
+            SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+            SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+        }
         if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO))
         {
             spdlog::error("SDL could not initialize! SDL_Error: {}", SDL_GetError());
             return false;
         }
+        return true;
+    }
 
-        window_ = SDL_CreateWindow("SunnyLand", 1280, 720, SDL_WINDOW_RESIZABLE);
+    bool GameApp::initWindow()
+    {
+        window_ = SDL_CreateWindow("SunnyLand", 1280, 720, config_.headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_RESIZABLE);
         if (!window_)
         {
             spdlog::error("Window could not be created! SDL_Error: {}", SDL_GetError());
@@ -99,11 +188,32 @@ namespace engine::core
         }
     }
 
-    bool GameApp::initResourceManager()
+    engine::resource::ResourceManifest GameApp::loadManifest() const
     {
+        if (config_.manifest_path.empty())
+        {
+            return {};
+        }
         try
         {
-            resource_manager_ = std::make_unique<engine::resource::ResourceManager>(sdl_renderer_);
+            return engine::resource::ResourceManifest::loadFromFile(config_.manifest_path);
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::warn("Skipping resource preloading: {}", e.what());
+            return {};
+        }
+    }
+
+    bool GameApp::initResourceManager(std::future<std::unique_ptr<engine::resource::AudioManager>> &audio_future,
+                                      std::future<std::unique_ptr<engine::resource::FontManager>> &font_future,
+                                      std::future<std::vector<engine::resource::DecodedTexture>> &texture_future)
+    {
+        try
+        {
+            resource_manager_ = std::make_unique<engine::resource::ResourceManager>(sdl_renderer_, audio_future.get(), font_future.get());
+            auto decoded_textures = texture_future.get();
+            resource_manager_->uploadTextures(decoded_textures);
             spdlog::trace("ResourceManager initialized successfully");
         }
         catch (const std::exception &e)
@@ -118,7 +228,12 @@ namespace engine::core
     {
         try
         {
-            camera_ = std::make_unique<engine::render::Camera>(glm::vec2(1280.0f, 720.0f));
+            glm::vec2 viewport_size(1280.0f, 720.0f);
+            if (config_.internal_width > 0 && config_.internal_height > 0)
+            {
+                viewport_size = glm::vec2(static_cast<float>(config_.internal_width), static_cast<float>(config_.internal_height));
+            }
+            camera_ = std::make_unique<engine::render::Camera>(viewport_size);
             spdlog::trace("Camera initialized successfully");
             return true;
         }
@@ -134,6 +249,16 @@ namespace engine::core
         try
         {
             renderer_ = std::make_unique<engine::render::Renderer>(resource_manager_.get(), sdl_renderer_);
+            if (config_.internal_width > 0 && config_.internal_height > 0)
+            {
+                renderer_->setInternalResolution(config_.internal_width, config_.internal_height);
+                spdlog::info("Rendering the world at {}x{}", config_.internal_width, config_.internal_height);
+            }
+            renderer_->applyScreenMapping(*camera_);
+            if (!config_.capture_path.empty())
+            {
+                renderer_->startCapture(config_.capture_path, config_.capture_frames);
+            }
             spdlog::trace("Renderer initialized successfully");
             return true;
         }
@@ -144,6 +269,103 @@ namespace engine::core
         }
     }
 
+    bool GameApp::initInput()
+    {
+        try
+        {
+            std::uint64_t seed = config_.seed.value_or(SDL_GetPerformanceCounter());
+            if (config_.isReplaying())
+            {
+                input_player_ = std::make_unique<engine::input::InputPlayer>(config_.replay_path);
+                seed = input_player_->getSeed();
+                config_.fixed_step = input_player_->getFixedStep();
+            }
+            else if (config_.isRecording())
+            {
+                input_recorder_ = std::make_unique<engine::input::InputRecorder>(config_.record_path, seed, config_.fixed_step);
+            }
+            random_.setSeed(seed);
+            spdlog::trace("Input initialized successfully");
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("Failed to initialize input: {}", e.what());
+            return false;
+        }
+    }
+
+    bool GameApp::initWorld()
+    {
+        try
+        {
+            std::size_t job_threads = config_.job_threads < 0 ? JobSystem::defaultWorkerCount() : static_cast<std::size_t>(config_.job_threads);
+            job_system_ = std::make_unique<JobSystem>(job_threads);
+            world_ = std::make_unique<engine::ecs::World>();
+            // Save files find component types by name, which only works for types registered before the load
+            engine::ecs::ComponentRegistry::registerTypes<engine::ecs::Transform, engine::ecs::Velocity, engine::ecs::SpriteComponent,
+                                                          engine::physics::Collider, engine::animation::Animator>();
+            system_scheduler_ = std::make_unique<engine::ecs::SystemScheduler>(*job_system_);
+            animation_library_ = std::make_unique<engine::animation::AnimationLibrary>();
+            if (!config_.animations_path.empty())
+            {
+                try
+                {
+                    animation_library_->loadFromFile(config_.animations_path);
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::warn("Starting without animation clips: {}", e.what());
+                }
+            }
+            system_scheduler_->addSystem(std::make_unique<engine::ecs::MovementSystem>(*world_));
+            system_scheduler_->addSystem(std::make_unique<engine::animation::AnimationSystem>(*world_, *animation_library_));
+            auto collision_system = std::make_unique<engine::physics::CollisionSystem>(*world_);
+            collision_system_ = collision_system.get();
+            system_scheduler_->addSystem(std::move(collision_system));
+            sprite_render_system_ = std::make_unique<engine::ecs::SpriteRenderSystem>(*world_);
+            particle_system_ = std::make_unique<engine::particles::ParticleSystem>();
+            spdlog::trace("World initialized successfully");
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("Failed to create World instance: {}", e.what());
+            return false;
+        }
+    }
+
+    bool GameApp::initSceneManager()
+    {
+        try
+        {
+            resource_loader_ = std::make_unique<engine::resource::AsyncResourceLoader>(*resource_manager_);
+            context_ = std::make_unique<Context>(input_, previous_input_, *camera_, random_, *resource_loader_, *world_, *animation_library_,
+                                                 *particle_system_, *collision_system_, sound_queue_);
+            scene_manager_ = std::make_unique<engine::scene::SceneManager>(*context_, *resource_loader_);
+            if (scene_setup_)
+            {
+                scene_setup_(*context_, *scene_manager_);
+            }
+            else
+            {
+                spdlog::warn("No scene setup registered; nothing will be shown");
+            }
+            spdlog::trace("SceneManager initialized successfully");
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("Failed to create SceneManager instance: {}", e.what());
+            return false;
+        }
+    }
+
+    void GameApp::registerSceneSetup(std::function<void(Context &, engine::scene::SceneManager &)> scene_setup)
+    {
+        scene_setup_ = std::move(scene_setup);
+    }
+
     void GameApp::run()
     {
         if (!Init())
@@ -152,18 +374,231 @@ namespace engine::core
             return;
         }
 
-        time_->setTargetFPS(60); // Set target FPS to 60
+        // Uncapped runs ignore the target FPS so replays measure raw throughput
+        time_->setTargetFPS(config_.uncapped ? 0 : config_.target_fps);
+        if (input_player_)
+        {
+            // A replay's length is known, so every frame is kept and its percentiles are exact
+            const std::size_t ticks = input_player_->getTickCount();
+            frame_stats_ = FrameStats(ticks);
+            simulation_stats_ = FrameStats(ticks);
+            render_stats_ = FrameStats(ticks);
+            latency_stats_ = FrameStats(ticks);
+            allocation_stats_ = FrameStats(ticks);
+        }
+        // Loading before the first frame is not counted against it
+        allocation_count_ = MemoryTracker::getAllocationCount();
+        if (config_.memory_report_s > 0.0)
+        {
+            next_memory_report_ns_ = SDL_GetTicksNS() + static_cast<Uint64>(config_.memory_report_s * 1e9);
+        }
+        perf_hud_.setVisible(config_.perf_hud);
+        perf_hud_.setFrameBudget(config_.target_fps > 0 ? 1000.0 / config_.target_fps : 0.0);
+
+        if (config_.pipelined)
+        {
+            runPipelined();
+        }
+        else
+        {
+            runSerial();
+        }
 
+        logSessionReport();
+        close();
+    }
+
+    void GameApp::runSerial()
+    {
+        engine::render::RenderSnapshot &snapshot = snapshots_[0];
         while (is_running_)
         {
+            // An idle on-demand loop sleeps until something happens instead of spinning. The HUD shows live timings,
+            // so while it is visible every frame is drawn
+            if (config_.on_demand && !snapshot.getNeedsRedraw() && !window_dirty_ && !perf_hud_.isVisible() &&
+                !resource_loader_->isBusy())
+            {
+                waitForEvents();
+            }
+
             time_->update();
+            Uint64 frame_begin = SDL_GetTicksNS();
             // spdlog::info("Running GameApp frame with delta time: {}", time_->getDeltaTime());
             handleEvents();
-            update(time_->getDeltaTime());
-            render();
+            resource_loader_->pump(config_.upload_budget_ms);
+            if (!is_running_)
+            {
+                break;
+            }
+
+            if (isSimulationStalled())
+            {
+                snapshot.setNeedsRedraw(false);
+                playSounds({}, snapshot.getCamera());
+            }
+            else
+            {
+                pollInput();
+                if (!is_running_)
+                {
+                    break;
+                }
+                simulate(getSimulationDeltaTime(), snapshot);
+                playSounds(snapshot.getSoundCommands(), snapshot.getCamera());
+                if (context_->isQuitRequested())
+                {
+                    is_running_ = false;
+                }
+            }
+
+            if (config_.on_demand && !snapshot.getNeedsRedraw() && !window_dirty_ && !perf_hud_.isVisible())
+            {
+                ++skipped_frames_;
+                continue;
+            }
+
+            Uint64 simulation_end = SDL_GetTicksNS();
+            render(snapshot);
+            window_dirty_ = false;
+            endFrame(frame_begin, simulation_end - frame_begin, SDL_GetTicksNS() - simulation_end, snapshot);
         }
+    }
 
-        close();
+    void GameApp::runPipelined()
+    {
+        // The worker simulates frame N+1 into the back snapshot while this thread draws frame N
+        // from the front snapshot. Only the snapshots are shared, and never at the same time.
+        WorkerThread simulation_thread("simulation");
+        int front = 0;
+        bool has_front = false;
+
+        while (is_running_)
+        {
+            time_->update();
+            Uint64 frame_begin = SDL_GetTicksNS();
+            handleEvents();
+            resource_loader_->pump(config_.upload_budget_ms);
+            if (!is_running_)
+            {
+                break;
+            }
+
+            bool stalled = isSimulationStalled();
+            if (!stalled)
+            {
+                pollInput();
+                if (!is_running_)
+                {
+                    break;
+                }
+            }
+
+            engine::render::RenderSnapshot &back = snapshots_[1 - front];
+            float delta_time = getSimulationDeltaTime();
+            Uint64 simulation_ns = 0;
+            if (!stalled)
+            {
+                simulation_thread.submit([this, delta_time, &back, &simulation_ns]
+                                         {
+                                             Uint64 simulation_begin = SDL_GetTicksNS();
+                                             simulate(delta_time, back);
+                                             simulation_ns = SDL_GetTicksNS() - simulation_begin; });
+            }
+
+            Uint64 render_ns = 0;
+            if (has_front)
+            {
+                Uint64 render_begin = SDL_GetTicksNS();
+                render(snapshots_[front]);
+                render_ns = SDL_GetTicksNS() - render_begin;
+            }
+            simulation_thread.wait();
+            window_dirty_ = false;
+            // The tick's sounds start as soon as it is simulated, one frame before it is drawn
+            std::span<const engine::audio::SoundCommand> sounds;
+            if (!stalled)
+            {
+                sounds = back.getSoundCommands();
+            }
+            playSounds(sounds, back.getCamera());
+
+            if (has_front)
+            {
+                endFrame(frame_begin, simulation_ns, render_ns, snapshots_[front]);
+            }
+            if (stalled)
+            {
+                continue;
+            }
+            if (context_->isQuitRequested())
+            {
+                is_running_ = false;
+            }
+            front = 1 - front;
+            has_front = true;
+        }
+    }
+
+    float GameApp::getSimulationDeltaTime() const
+    {
+        // Recorded and replayed sessions always advance by the same step so they stay deterministic
+        return config_.useFixedStep() ? static_cast<float>(config_.fixed_step) : time_->getDeltaTime();
+    }
+
+    bool GameApp::isSimulationStalled() const
+    {
+        return config_.useFixedStep() && scene_manager_->isWaitingForResources();
+    }
+
+    void GameApp::simulate(float delta_time, engine::render::RenderSnapshot &snapshot)
+    {
+        MemoryScope memory_scope(MemoryTag::Core);
+        update(delta_time);
+        snapshot.clear();
+        snapshot.setCamera(*camera_);
+        snapshot.setInputTime(input_time_ns_);
+        snapshot.setNeedsRedraw(context_->consumeRedraw());
+        scene_manager_->render(snapshot);
+        sprite_render_system_->extract(snapshot);
+        particle_system_->extract(snapshot);
+        sound_queue_.flush(snapshot.getSoundCommands());
+    }
+
+    void GameApp::endFrame(Uint64 frame_begin, Uint64 simulation_ns, Uint64 render_ns, const engine::render::RenderSnapshot &presented)
+    {
+        Uint64 now = SDL_GetTicksNS();
+        if (!startup_timeline_.isFirstFrameMarked())
+        {
+            startup_timeline_.markFirstFrame();
+        }
+        ++rendered_frames_;
+        FrameTimings timings;
+        timings.frame = rendered_frames_;
+        timings.frame_ms = static_cast<double>(now - frame_begin) / 1000000.0;
+        timings.simulation_ms = static_cast<double>(simulation_ns) / 1000000.0;
+        timings.render_ms = static_cast<double>(render_ns) / 1000000.0;
+        timings.present_ms = static_cast<double>(present_ns_) / 1000000.0;
+        timings.sleep_ms = static_cast<double>(time_->getSleepTime()) * 1000.0;
+        timings.draw_calls = renderer_->getDrawCalls();
+        frame_stats_.addSample(timings.frame_ms);
+        simulation_stats_.addSample(timings.simulation_ms);
+        render_stats_.addSample(timings.render_ms);
+        latency_stats_.addSample(static_cast<double>(now - presented.getInputTime()) / 1000000.0);
+        if (MemoryTracker::isEnabled())
+        {
+            std::uint64_t allocation_count = MemoryTracker::getAllocationCount();
+            timings.allocations = allocation_count - allocation_count_;
+            allocation_count_ = allocation_count;
+            allocation_stats_.addSample(static_cast<double>(timings.allocations));
+        }
+        if (next_memory_report_ns_ != 0 && now >= next_memory_report_ns_)
+        {
+            logMemoryReport();
+            next_memory_report_ns_ = now + static_cast<Uint64>(config_.memory_report_s * 1e9);
+        }
+        perf_hud_.addFrame(timings, now);
+        // Both loops call this while no tick is being simulated
+        context_->setLastFrame(timings);
     }
 
     void GameApp::handleEvents()
@@ -171,31 +606,159 @@ namespace engine::core
         SDL_Event event;
         while (SDL_PollEvent(&event))
         {
-            if (event.type == SDL_EVENT_QUIT)
+            switch (event.type)
             {
+            case SDL_EVENT_QUIT:
                 is_running_ = false;
+                break;
+            case SDL_EVENT_WINDOW_SHOWN:
+            case SDL_EVENT_WINDOW_EXPOSED:
+            case SDL_EVENT_WINDOW_RESIZED:
+            case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+            case SDL_EVENT_WINDOW_RESTORED:
+                window_dirty_ = true;
+                break;
+            case SDL_EVENT_KEY_DOWN:
+                // Not part of the input stream, so recordings stay the same with the overlay on or off
+                if (event.key.scancode == SDL_SCANCODE_F3 && !event.key.repeat)
+                {
+                    perf_hud_.toggle();
+                    window_dirty_ = true;
+                }
+                else if (event.key.scancode == SDL_SCANCODE_F4 && !event.key.repeat && renderer_ && !renderer_->isCapturing())
+                {
+                    renderer_->startCapture(config_.capture_path.empty() ? "render_capture.slrc" : config_.capture_path, config_.capture_frames);
+                }
+                break;
+            case SDL_EVENT_RENDER_TARGETS_RESET:
+            case SDL_EVENT_RENDER_DEVICE_RESET:
+                // The content of render targets is lost
+                if (renderer_)
+                {
+                    renderer_->invalidateUICaches();
+                }
+                window_dirty_ = true;
+                break;
+            default:
+                break;
             }
         }
     }
 
+    void GameApp::waitForEvents()
+    {
+        // Leaves the event in the queue for handleEvents()
+        ++idle_waits_;
+        SDL_WaitEventTimeout(nullptr, config_.idle_timeout_ms);
+        // Nothing advanced while idle; don't hand the wait to the simulation as one huge step
+        time_->resetFrameStart();
+    }
+
+    void GameApp::pollInput()
+    {
+        // The window may have been resized; the camera needs to know where its viewport is to map the cursor
+        renderer_->applyScreenMapping(*camera_);
+        previous_input_ = input_;
+        if (input_player_)
+        {
+            if (input_player_->isFinished())
+            {
+                is_running_ = false;
+                return;
+            }
+            input_ = input_player_->next();
+            input_time_ns_ = SDL_GetTicksNS();
+            return;
+        }
+
+        input_ = engine::input::InputState::fromDevices();
+        input_time_ns_ = SDL_GetTicksNS();
+        if (input_recorder_)
+        {
+            input_recorder_->record(input_);
+        }
+    }
+
     void GameApp::update(float deltaTime)
     {
-        // update game logic here
-        testCamera();
+        scene_manager_->update(deltaTime);
+        // Entities created or destroyed by the scenes exist before the systems run
+        world_->flushCommands();
+        if (!scene_manager_->isWorldPaused())
+        {
+            system_scheduler_->run(*world_, deltaTime);
+            particle_system_->update(deltaTime);
+            if (config_.dump_schedule && !schedule_dumped_)
+            {
+                spdlog::info("{}", system_scheduler_->describeSchedule());
+                schedule_dumped_ = true;
+            }
+        }
+        ++tick_;
     }
 
-    void GameApp::render()
+    void GameApp::render(const engine::render::RenderSnapshot &snapshot)
     {
+        MemoryScope memory_scope(MemoryTag::Render);
         renderer_->clearScreen();
-
-        // Render game objects here
-        testRenderer();
+        renderer_->drawSnapshot(snapshot);
+        if (perf_hud_.isVisible())
+        {
+            perf_hud_.draw(*renderer_, resource_manager_->getMemoryUsage());
+        }
+        Uint64 present_begin = SDL_GetTicksNS();
         renderer_->present();
+        present_ns_ = SDL_GetTicksNS() - present_begin;
+    }
+
+    void GameApp::playSounds(std::span<const engine::audio::SoundCommand> commands, const engine::render::Camera &camera)
+    {
+        engine::audio::VoiceManager &voices = resource_manager_->getVoiceManager();
+        voices.setListener(camera.getPosition(), camera.getViewportSize());
+        voices.update(commands);
+        const engine::audio::VoiceStats &stats = voices.getStats();
+        if (stats.started > 0 || stats.culled > 0 || stats.stolen > 0)
+        {
+            spdlog::trace("Voices: {} active, {} virtual ({} out of earshot), {} started, {} coalesced, {} stolen, {} culled", stats.active,
+                          stats.virtual_voices, stats.distant, stats.started, stats.coalesced, stats.stolen, stats.culled);
+        }
+        voice_totals_.active = std::max(voice_totals_.active, stats.active);
+        voice_totals_.virtual_voices = std::max(voice_totals_.virtual_voices, stats.virtual_voices);
+        voice_totals_.culled += stats.culled;
+        voice_totals_.coalesced += stats.coalesced;
+        voice_totals_.stolen += stats.stolen;
+        voice_totals_.started += stats.started;
     }
 
     void GameApp::close()
     {
         spdlog::info("Closing GameApp");
+        if (input_recorder_)
+        {
+            input_recorder_->finish();
+        }
+        // Scenes and background loads go away before the resources and SDL they use
+        if (scene_manager_)
+        {
+            scene_manager_->close();
+        }
+        scene_manager_.reset();
+        context_.reset();
+        sprite_render_system_.reset();
+        particle_system_.reset();
+        system_scheduler_.reset();
+        collision_system_ = nullptr;
+        animation_library_.reset();
+        world_.reset();
+        job_system_.reset();
+        resource_loader_.reset();
+        if (resource_manager_)
+        {
+            resource_manager_->getVoiceManager().releaseSounds();
+        }
+        // Owns render targets, which must go before the SDL renderer
+        renderer_.reset();
+
         if (sdl_renderer_)
         {
             SDL_DestroyRenderer(sdl_renderer_);
@@ -212,6 +775,97 @@ namespace engine::core
         is_running_ = false;
     }
 
+    std::uint64_t GameApp::computeStateChecksum() const
+    {
+        using engine::utils::fnv1a64Value;
+        std::uint64_t hash = fnv1a64Value(tick_);
+        hash = fnv1a64Value(random_.getState(), hash);
+        if (scene_manager_)
+        {
+            hash = scene_manager_->computeChecksum(hash);
+        }
+        if (world_)
+        {
+            // Archetypes and rows are created in the same order in every run, so the columns can be hashed as they are
+            world_->query<engine::ecs::Transform>().forEachArchetype([&hash](engine::ecs::Archetype &archetype)
+                                                                    {
+                                                                        auto transforms = archetype.column<engine::ecs::Transform>();
+                                                                        hash = engine::utils::fnv1a64(transforms.data(), transforms.size_bytes(), hash); });
+        }
+        if (particle_system_)
+        {
+            hash = fnv1a64Value(static_cast<std::uint64_t>(particle_system_->getParticleCount()), hash);
+        }
+        if (camera_)
+        {
+            glm::vec2 position = camera_->getPosition();
+            hash = fnv1a64Value(std::bit_cast<std::uint32_t>(position.x), hash);
+            hash = fnv1a64Value(std::bit_cast<std::uint32_t>(position.y), hash);
+        }
+        return hash;
+    }
+
+    void GameApp::logSessionReport() const
+    {
+        spdlog::info("Session finished: {} ticks, {} loop", tick_, config_.pipelined ? "pipelined" : "serial");
+        if (config_.on_demand)
+        {
+            std::uint64_t frames = rendered_frames_ + skipped_frames_;
+            spdlog::info("On-demand rendering: {} rendered, {} skipped ({:.1f}% skipped), {} idle waits",
+                         rendered_frames_, skipped_frames_,
+                         frames > 0 ? 100.0 * static_cast<double>(skipped_frames_) / static_cast<double>(frames) : 0.0,
+                         idle_waits_);
+        }
+        if (input_player_ || input_recorder_)
+        {
+            const char *mode = input_player_ ? "Replay" : "Recording";
+            spdlog::info("{} seed {}, state checksum {:016x}", mode, random_.getSeed(), computeStateChecksum());
+        }
+        frame_stats_.logSummary("Frame times");
+        simulation_stats_.logSummary("Simulation times");
+        render_stats_.logSummary("Render times");
+        latency_stats_.logSummary("Input-to-present latency");
+        if (allocation_stats_.getSampleCount() > 0)
+        {
+            // Not a duration, so FrameStats::logSummary would print the wrong unit
+            FrameStats::Summary allocations = allocation_stats_.summarize();
+            spdlog::info("Allocations per frame: avg {:.1f}, p50 {:.0f}, p95 {:.0f}, p99 {:.0f}, max {:.0f}", allocations.avg_ms,
+                         allocations.p50_ms, allocations.p95_ms, allocations.p99_ms, allocations.max_ms);
+        }
+        logMemoryReport();
+        if (system_scheduler_)
+        {
+            system_scheduler_->logTimings();
+        }
+        if (voice_totals_.started > 0)
+        {
+            spdlog::info("Voices: {} started, peak {} active and {} virtual, {} coalesced, {} stolen, {} culled",
+                         voice_totals_.started, voice_totals_.active, voice_totals_.virtual_voices, voice_totals_.coalesced,
+                         voice_totals_.stolen, voice_totals_.culled);
+        }
+        if (collision_system_)
+        {
+            const engine::physics::BroadPhaseStats &stats = collision_system_->getBroadPhase().getStats();
+            spdlog::info("Broad phase (last tick): {} proxies, {} endpoint swaps{}, {} pairs tested, {} filtered, {} found",
+                         stats.proxies, stats.endpoint_swaps, stats.full_sort ? " (full sort)" : "",
+                         stats.pairs_tested, stats.pairs_filtered, stats.pairs_found);
+        }
+    }
+
+    void GameApp::logMemoryReport() const
+    {
+        MemoryTracker::logReport();
+        if (resource_manager_)
+        {
+            constexpr double MIB = 1024.0 * 1024.0;
+            engine::resource::ResourceMemoryUsage usage = resource_manager_->getMemoryUsage();
+            spdlog::info("Resources: {} textures {:.2f} MiB (peak {:.2f} MiB), {} sounds {:.2f} MiB (peak {:.2f} MiB), {} music, {} fonts",
+                         usage.texture_count, static_cast<double>(usage.texture_bytes) / MIB, static_cast<double>(usage.peak_texture_bytes) / MIB,
+                         usage.sound_count, static_cast<double>(usage.sound_bytes) / MIB, static_cast<double>(usage.peak_sound_bytes) / MIB,
+                         usage.music_count, usage.font_count);
+        }
+    }
+
     void GameApp::testResourceManager()
     {
         resource_manager_->loadTexture("assets/textures/Actors/eagle-attack.png");
@@ -223,32 +877,4 @@ namespace engine::core
         resource_manager_->unloadSound("assets/audio/button_click.wav");
     }
 
-    void GameApp::testRenderer()
-    {
-        engine::render::Sprite sprite_world("assets/textures/Actors/frog.png");
-        engine::render::Sprite sprite_ui("assets/textures/UI/buttons/Start1.png");
-        engine::render::Sprite sprite_parallax("assets/textures/Layers/back.png");
-
-        static float rotation = 0.0f;
-        rotation += 0.1f;
-
-        // 注意渲染顺序
-        renderer_->drawParallax(*camera_, sprite_parallax, glm::vec2(100, 100), glm::vec2(0.5f, 0.5f), glm::bvec2(true, false));
-        renderer_->drawSprite(*camera_, sprite_world, glm::vec2(200, 200), glm::vec2(1.0f, 1.0f), rotation);
-        renderer_->drawUISprite(sprite_ui, glm::vec2(100, 100));
-    }
-
-    void GameApp::testCamera()
-    {
-        auto key_state = SDL_GetKeyboardState(nullptr);
-        if (key_state[SDL_SCANCODE_UP])
-            camera_->move(glm::vec2(0, -1));
-        if (key_state[SDL_SCANCODE_DOWN])
-            camera_->move(glm::vec2(0, 1));
-        if (key_state[SDL_SCANCODE_LEFT])
-            camera_->move(glm::vec2(-1, 0));
-        if (key_state[SDL_SCANCODE_RIGHT])
-            camera_->move(glm::vec2(1, 0));
-    }
-
 } // namespace engine::core
\ No newline at end of file
@@ -1,11 +1,48 @@
 #pragma once
 #include <memory>
+#include <cstdint>
+#include <future>
+#include <vector>
+#include <array>
+#include <functional>
+#include <span>
+#include <SDL3/SDL_stdinc.h>
+#include "app_config.h"
+#include "frame_stats.h"
+#include "perf_hud.h"
+#include "startup_timeline.h"
+#include "../resource/resource_manifest.h"
+#include "../input/input_state.h"
+#include "../utils/random.h"
+#include "../render/render_snapshot.h"
+#include "../audio/voice_manager.h"
 
 struct SDL_Window;
 struct SDL_Renderer;
 namespace engine::resource
 {
     class ResourceManager;
+    class AudioManager;
+    class FontManager;
+    class AsyncResourceLoader;
+}
+
+namespace engine::scene
+{
+    class SceneManager;
+}
+
+namespace engine::ecs
+{
+    class World;
+    class SystemScheduler;
+    class SpriteRenderSystem;
+}
+
+namespace engine::input
+{
+    class InputRecorder;
+    class InputPlayer;
 }
 
 namespace engine::render
@@ -14,16 +51,33 @@ namespace engine::render
     class Renderer;
 }
 
+namespace engine::animation
+{
+    class AnimationLibrary;
+}
+
+namespace engine::particles
+{
+    class ParticleSystem;
+}
+
+namespace engine::physics
+{
+    class CollisionSystem;
+}
+
 namespace engine::core
 {
     class Time;
+    class Context;
+    class JobSystem;
 
     /// @brief The main application class for the game.
     /// Manages the game loop, window, and renderer.
     class GameApp final
     {
     public:
-        GameApp();
+        explicit GameApp(AppConfig config = {});
         ~GameApp();
 
         GameApp(const GameApp &) = delete;
@@ -32,6 +86,14 @@ namespace engine::core
         GameApp &operator=(GameApp &&) = delete;
 
         [[nodiscard]] bool IsRunning() const { return is_running_; }
+        [[nodiscard]] const AppConfig &getConfig() const { return config_; }
+        [[nodiscard]] engine::utils::Random &getRandom() { return random_; }
+
+        /// @brief Checksum of the simulation state, used to verify that replays are deterministic.
+        [[nodiscard]] std::uint64_t computeStateChecksum() const;
+
+        /// @brief Registers the function that pushes the first scene once the engine is initialized.
+        void registerSceneSetup(std::function<void(Context &, engine::scene::SceneManager &)> scene_setup);
 
         void run();
 
@@ -40,25 +102,94 @@ namespace engine::core
         SDL_Renderer *sdl_renderer_ = nullptr;
         bool is_running_ = false;
 
+        AppConfig config_;
+        engine::input::InputState input_;
+        engine::input::InputState previous_input_;
+        engine::utils::Random random_;
+        std::uint64_t tick_ = 0;
+        Uint64 input_time_ns_ = 0;
+
+        // On-demand rendering state
+        bool window_dirty_ = true;
+        std::uint64_t rendered_frames_ = 0;
+        std::uint64_t skipped_frames_ = 0;
+        std::uint64_t idle_waits_ = 0;
+        bool schedule_dumped_ = false;
+        FrameStats frame_stats_;
+        FrameStats simulation_stats_;
+        FrameStats render_stats_;
+        FrameStats latency_stats_;
+        /// @brief Allocations per frame, kept in a FrameStats for its percentiles. Only filled when tracking is built in.
+        FrameStats allocation_stats_;
+        std::uint64_t allocation_count_ = 0;
+        Uint64 next_memory_report_ns_ = 0;
+        /// @brief Duration of the last present(), part of the render time.
+        Uint64 present_ns_ = 0;
+        PerfHud perf_hud_;
+        /// @brief Voice statistics of the whole session: peaks of active and virtual voices, totals of the rest.
+        engine::audio::VoiceStats voice_totals_;
+        engine::audio::SoundQueue sound_queue_;
+        /// @brief Double-buffered frame descriptions. Serial mode only uses the first one.
+        std::array<engine::render::RenderSnapshot, 2> snapshots_;
+        StartupTimeline startup_timeline_;
+        std::function<void(Context &, engine::scene::SceneManager &)> scene_setup_;
+
         std::unique_ptr<engine::core::Time> time_;
         std::unique_ptr<engine::resource::ResourceManager> resource_manager_;
         std::unique_ptr<engine::render::Camera> camera_;
         std::unique_ptr<engine::render::Renderer> renderer_;
+        std::unique_ptr<engine::input::InputRecorder> input_recorder_;
+        std::unique_ptr<engine::input::InputPlayer> input_player_;
+        std::unique_ptr<engine::resource::AsyncResourceLoader> resource_loader_;
+        std::unique_ptr<JobSystem> job_system_;
+        std::unique_ptr<engine::ecs::World> world_;
+        std::unique_ptr<engine::animation::AnimationLibrary> animation_library_;
+        /// @brief Runs the ECS systems every tick, after the scene update.
+        std::unique_ptr<engine::ecs::SystemScheduler> system_scheduler_;
+        /// @brief Owned by the scheduler.
+        engine::physics::CollisionSystem *collision_system_ = nullptr;
+        std::unique_ptr<engine::ecs::SpriteRenderSystem> sprite_render_system_;
+        std::unique_ptr<engine::particles::ParticleSystem> particle_system_;
+        std::unique_ptr<Context> context_;
+        std::unique_ptr<engine::scene::SceneManager> scene_manager_;
 
         [[nodiscard]] bool Init();
         void handleEvents();
+        void waitForEvents();
+        void pollInput();
+        void runSerial();
+        void runPipelined();
+        float getSimulationDeltaTime() const;
+        /// @brief Record/replay sessions hold the simulation while a scene transition loads, so the
+        /// transition happens on the same tick in every run.
+        bool isSimulationStalled() const;
+        /// @brief Advances the game by one tick and describes the result in snapshot. Must not touch the Renderer.
+        void simulate(float delta_time, engine::render::RenderSnapshot &snapshot);
         void update(float deltaTime);
-        void render();
+        void render(const engine::render::RenderSnapshot &snapshot);
+        /// @brief Hands the sound commands of a finished tick to the voice manager, heard from the tick's camera.
+        /// Called every frame, on the main thread.
+        void playSounds(std::span<const engine::audio::SoundCommand> commands, const engine::render::Camera &camera);
+        void endFrame(Uint64 frame_begin, Uint64 simulation_ns, Uint64 render_ns, const engine::render::RenderSnapshot &presented);
         void close();
 
         [[nodiscard]] bool initSDL();
+        [[nodiscard]] bool initWindow();
         [[nodiscard]] bool initTime();
-        [[nodiscard]] bool initResourceManager();
+        [[nodiscard]] bool initResourceManager(std::future<std::unique_ptr<engine::resource::AudioManager>> &audio_future,
+                                               std::future<std::unique_ptr<engine::resource::FontManager>> &font_future,
+                                               std::future<std::vector<engine::resource::DecodedTexture>> &texture_future);
         [[nodiscard]] bool initCamera();
         [[nodiscard]] bool initRenderer();
+        [[nodiscard]] bool initInput();
+        [[nodiscard]] bool initWorld();
+        [[nodiscard]] bool initSceneManager();
+
+        void logSessionReport() const;
+        /// @brief Logs tracked heap usage per tag and the sizes of the cached resources.
+        void logMemoryReport() const;
+        engine::resource::ResourceManifest loadManifest() const;
 
         void testResourceManager();
-        void testRenderer();
-        void testCamera();
     };
 } // namespace engine::core
\ No newline at end of file
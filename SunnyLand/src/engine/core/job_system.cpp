@@ -0,0 +1,160 @@
+#include "job_system.h"
+#include "memory_tracker.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    std::size_t JobSystem::defaultWorkerCount()
+    {
+        unsigned int hardware_threads = std::thread::hardware_concurrency();
+        return hardware_threads > 1 ? hardware_threads - 1 : 0;
+    }
+
+    JobSystem::JobSystem(std::size_t worker_count)
+    {
+        for (std::size_t i = 0; i < worker_count; ++i)
+        {
+            workers_.emplace_back(&JobSystem::workerMain, this);
+        }
+        spdlog::trace("JobSystem started with {} worker threads", worker_count);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto &worker : workers_)
+        {
+            worker.join();
+        }
+        spdlog::trace("JobSystem stopped");
+    }
+
+    void JobSystem::submit(std::function<void()> job, JobGroup &group)
+    {
+        group.pending_.fetch_add(1, std::memory_order_acq_rel);
+        {
+            std::lock_guard lock(mutex_);
+            jobs_.push_back({std::move(job), &group});
+        }
+        cv_.notify_all();
+    }
+
+    void JobSystem::wait(JobGroup &group)
+    {
+        std::unique_lock lock(mutex_);
+        while (!group.isDone())
+        {
+            if (!runOne(lock))
+            {
+                // Woken whenever a job is queued or finishes
+                cv_.wait(lock, [this, &group]
+                         { return group.isDone() || !jobs_.empty(); });
+            }
+        }
+        lock.unlock();
+
+        std::lock_guard error_lock(group.error_mutex_);
+        if (group.error_)
+        {
+            std::rethrow_exception(std::exchange(group.error_, nullptr));
+        }
+    }
+
+    void JobSystem::parallelFor(std::size_t count, std::size_t min_chunk, const std::function<void(std::size_t, std::size_t)> &func)
+    {
+        min_chunk = std::max<std::size_t>(min_chunk, 1);
+        // A few chunks per thread so uneven chunks still balance out
+        std::size_t chunk = std::max(min_chunk, (count + getThreadCount() * 4 - 1) / (getThreadCount() * 4));
+        if (count <= chunk || workers_.empty())
+        {
+            if (count > 0)
+            {
+                func(0, count);
+            }
+            return;
+        }
+
+        JobGroup group;
+        for (std::size_t begin = chunk; begin < count; begin += chunk)
+        {
+            std::size_t end = std::min(begin + chunk, count);
+            submit([&func, begin, end]
+                   { func(begin, end); }, group);
+        }
+        // The first chunk runs here instead of idling until the workers are done.
+        // The group must be waited for even if it throws, since the queued jobs reference it.
+        std::exception_ptr error;
+        try
+        {
+            func(0, chunk);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        wait(group);
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    bool JobSystem::runOne(std::unique_lock<std::mutex> &lock)
+    {
+        if (jobs_.empty())
+        {
+            return false;
+        }
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        lock.unlock();
+        execute(job);
+        lock.lock();
+        return true;
+    }
+
+    void JobSystem::execute(Job &job)
+    {
+        try
+        {
+            job.function();
+        }
+        catch (...)
+        {
+            std::lock_guard error_lock(job.group->error_mutex_);
+            if (!job.group->error_)
+            {
+                job.group->error_ = std::current_exception();
+            }
+        }
+
+        if (job.group->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            // Take the lock so a waiter cannot miss the wake-up between its check and its wait
+            std::lock_guard lock(mutex_);
+            cv_.notify_all();
+        }
+    }
+
+    void JobSystem::workerMain()
+    {
+        // Workers run the ECS systems, which belong to the simulation
+        MemoryScope memory_scope(MemoryTag::Core);
+        std::unique_lock lock(mutex_);
+        while (true)
+        {
+            cv_.wait(lock, [this]
+                     { return stopping_ || !jobs_.empty(); });
+            if (stopping_)
+            {
+                return;
+            }
+            runOne(lock);
+        }
+    }
+} // namespace engine::core
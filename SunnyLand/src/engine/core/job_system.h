@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::core
+{
+    class JobSystem;
+
+    /// @brief Counts the unfinished jobs of one batch and keeps the first exception one of them threw.
+    class JobGroup final
+    {
+        friend class JobSystem;
+
+    private:
+        std::atomic<std::size_t> pending_ = 0;
+        std::mutex error_mutex_;
+        std::exception_ptr error_;
+
+    public:
+        JobGroup() = default;
+
+        JobGroup(const JobGroup &) = delete;
+        JobGroup &operator=(const JobGroup &) = delete;
+        JobGroup(JobGroup &&) = delete;
+        JobGroup &operator=(JobGroup &&) = delete;
+
+        bool isDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+    };
+
+    /// @brief Fixed pool of worker threads running short jobs from one shared queue.
+    /// The thread calling wait() runs queued jobs too, so jobs may submit and wait for
+    /// other jobs without deadlocking, and a pool with zero workers runs everything inline.
+    class JobSystem final
+    {
+    private:
+        struct Job
+        {
+            std::function<void()> function;
+            JobGroup *group;
+        };
+
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<Job> jobs_;
+        bool stopping_ = false;
+
+        void workerMain();
+        /// @brief Runs one queued job if there is one. Returns false if the queue was empty.
+        bool runOne(std::unique_lock<std::mutex> &lock);
+        void execute(Job &job);
+
+    public:
+        /// @param worker_count Threads besides the caller. Defaults to one less than the hardware threads.
+        explicit JobSystem(std::size_t worker_count = defaultWorkerCount());
+        ~JobSystem();
+
+        JobSystem(const JobSystem &) = delete;
+        JobSystem &operator=(const JobSystem &) = delete;
+        JobSystem(JobSystem &&) = delete;
+        JobSystem &operator=(JobSystem &&) = delete;
+
+        /// @brief Queues a job as part of group. May be called from any thread, including from inside a job.
+        void submit(std::function<void()> job, JobGroup &group);
+
+        /// @brief Runs queued jobs until every job of group finished, then rethrows the first exception of the group.
+        void wait(JobGroup &group);
+
+        /// @brief Calls func(begin, end) over [0, count) split into chunks of at least min_chunk items,
+        /// and returns when all chunks are done. Small ranges run inline on the calling thread.
+        void parallelFor(std::size_t count, std::size_t min_chunk, const std::function<void(std::size_t, std::size_t)> &func);
+
+        /// @brief Number of threads that run jobs, including the one calling wait().
+        std::size_t getThreadCount() const { return workers_.size() + 1; }
+
+        static std::size_t defaultWorkerCount();
+    };
+} // namespace engine::core
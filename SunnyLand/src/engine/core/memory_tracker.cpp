@@ -0,0 +1,272 @@
+#include "memory_tracker.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    namespace
+    {
+        constexpr std::size_t TAG_COUNT = static_cast<std::size_t>(MemoryTag::Count);
+
+        /// @brief Not a std::atomic<MemoryTag> on purpose: it is only ever touched by its own thread.
+        thread_local MemoryTag current_tag = MemoryTag::Untagged;
+
+#ifdef SUNNYLAND_TRACK_ALLOCATIONS
+        struct TagCounters
+        {
+            std::atomic<std::size_t> live_bytes{0};
+            std::atomic<std::size_t> live_allocations{0};
+            std::atomic<std::size_t> peak_bytes{0};
+            std::atomic<std::uint64_t> total_allocations{0};
+        };
+
+        // Plain arrays of atomics are constant-initialized, so they work before any static constructor runs
+        TagCounters tag_counters[TAG_COUNT];
+        std::atomic<std::size_t> total_live_bytes{0};
+        std::atomic<std::size_t> total_peak_bytes{0};
+        std::atomic<std::uint64_t> total_allocations{0};
+
+        /// @brief Placed in front of every tracked block. 32 bytes keep the user block aligned for any fundamental type.
+        struct alignas(16) AllocationHeader
+        {
+            void *base;
+            std::size_t size;
+            MemoryTag tag;
+        };
+        static_assert(sizeof(AllocationHeader) <= 32);
+        constexpr std::size_t HEADER_SIZE = 32;
+
+        void raisePeak(std::atomic<std::size_t> &peak, std::size_t value)
+        {
+            std::size_t current = peak.load(std::memory_order_relaxed);
+            while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        /// @brief Bytes malloc'ed on top of the user block: the header, and for large alignments room to move the block forward.
+        /// malloc already aligns for max_align_t.
+        std::size_t getOverhead(std::size_t alignment) noexcept
+        {
+            return HEADER_SIZE + (alignment > alignof(std::max_align_t) ? alignment : 0);
+        }
+
+        /// @brief True if size plus the overhead does not fit in a size_t, so no allocation can succeed.
+        bool isTooLarge(std::size_t size, std::size_t alignment) noexcept
+        {
+            return size > SIZE_MAX - getOverhead(alignment);
+        }
+
+        void *trackedAllocate(std::size_t size, std::size_t alignment) noexcept
+        {
+            alignment = alignment < alignof(std::max_align_t) ? alignof(std::max_align_t) : alignment;
+            if (isTooLarge(size, alignment))
+            {
+                return nullptr;
+            }
+            void *base = std::malloc(size + getOverhead(alignment));
+            if (!base)
+            {
+                return nullptr;
+            }
+            std::uintptr_t user = reinterpret_cast<std::uintptr_t>(base) + HEADER_SIZE;
+            user = (user + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+            const MemoryTag tag = current_tag;
+            auto *header = reinterpret_cast<AllocationHeader *>(user - HEADER_SIZE);
+            header->base = base;
+            header->size = size;
+            header->tag = tag;
+
+            TagCounters &counters = tag_counters[static_cast<std::size_t>(tag)];
+            const std::size_t live = counters.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+            raisePeak(counters.peak_bytes, live);
+            counters.live_allocations.fetch_add(1, std::memory_order_relaxed);
+            counters.total_allocations.fetch_add(1, std::memory_order_relaxed);
+            raisePeak(total_peak_bytes, total_live_bytes.fetch_add(size, std::memory_order_relaxed) + size);
+            total_allocations.fetch_add(1, std::memory_order_relaxed);
+            return reinterpret_cast<void *>(user);
+        }
+
+        void trackedFree(void *pointer) noexcept
+        {
+            if (!pointer)
+            {
+                return;
+            }
+            auto *header = reinterpret_cast<AllocationHeader *>(reinterpret_cast<std::uintptr_t>(pointer) - HEADER_SIZE);
+            TagCounters &counters = tag_counters[static_cast<std::size_t>(header->tag)];
+            counters.live_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+            counters.live_allocations.fetch_sub(1, std::memory_order_relaxed);
+            total_live_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+            std::free(header->base);
+        }
+
+        void *allocateOrThrow(std::size_t size, std::size_t alignment)
+        {
+            // Freeing memory cannot make such a size fit, so the new-handler is not called; the nothrow forms return nullptr
+            if (isTooLarge(size, alignment < alignof(std::max_align_t) ? alignof(std::max_align_t) : alignment))
+            {
+                throw std::bad_alloc();
+            }
+            // Same contract as the default operator new: retry through the new-handler, then throw
+            while (true)
+            {
+                if (void *pointer = trackedAllocate(size == 0 ? 1 : size, alignment))
+                {
+                    return pointer;
+                }
+                std::new_handler handler = std::get_new_handler();
+                if (!handler)
+                {
+                    throw std::bad_alloc();
+                }
+                handler();
+            }
+        }
+#endif
+    }
+
+    const char *toString(MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::Untagged:
+            return "untagged";
+        case MemoryTag::Core:
+            return "core";
+        case MemoryTag::Resource:
+            return "resource";
+        case MemoryTag::Render:
+            return "render";
+        default:
+            return "?";
+        }
+    }
+
+    bool MemoryTracker::isEnabled()
+    {
+#ifdef SUNNYLAND_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    MemoryTagStats MemoryTracker::getStats([[maybe_unused]] MemoryTag tag)
+    {
+        MemoryTagStats stats;
+#ifdef SUNNYLAND_TRACK_ALLOCATIONS
+        const TagCounters &counters = tag_counters[static_cast<std::size_t>(tag)];
+        stats.live_bytes = counters.live_bytes.load(std::memory_order_relaxed);
+        stats.live_allocations = counters.live_allocations.load(std::memory_order_relaxed);
+        stats.peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed);
+        stats.total_allocations = counters.total_allocations.load(std::memory_order_relaxed);
+#endif
+        return stats;
+    }
+
+    MemoryTagStats MemoryTracker::getTotalStats()
+    {
+        MemoryTagStats stats;
+        for (std::size_t i = 0; i < TAG_COUNT; ++i)
+        {
+            MemoryTagStats tag_stats = getStats(static_cast<MemoryTag>(i));
+            stats.live_bytes += tag_stats.live_bytes;
+            stats.live_allocations += tag_stats.live_allocations;
+            stats.total_allocations += tag_stats.total_allocations;
+        }
+#ifdef SUNNYLAND_TRACK_ALLOCATIONS
+        stats.peak_bytes = total_peak_bytes.load(std::memory_order_relaxed);
+#endif
+        return stats;
+    }
+
+    std::uint64_t MemoryTracker::getAllocationCount()
+    {
+#ifdef SUNNYLAND_TRACK_ALLOCATIONS
+        return total_allocations.load(std::memory_order_relaxed);
+#else
+        return 0;
+#endif
+    }
+
+    void MemoryTracker::logReport()
+    {
+        if (!isEnabled())
+        {
+            return;
+        }
+        constexpr double MIB = 1024.0 * 1024.0;
+        for (std::size_t i = 0; i < TAG_COUNT; ++i)
+        {
+            MemoryTagStats stats = getStats(static_cast<MemoryTag>(i));
+            spdlog::info("Heap {:<9} {:8.2f} MiB live in {:>7} blocks, peak {:8.2f} MiB, {} allocations", toString(static_cast<MemoryTag>(i)),
+                         static_cast<double>(stats.live_bytes) / MIB, stats.live_allocations, static_cast<double>(stats.peak_bytes) / MIB,
+                         stats.total_allocations);
+        }
+        MemoryTagStats total = getTotalStats();
+        spdlog::info("Heap total     {:8.2f} MiB live, peak {:8.2f} MiB", static_cast<double>(total.live_bytes) / MIB,
+                     static_cast<double>(total.peak_bytes) / MIB);
+    }
+
+    MemoryScope::MemoryScope(MemoryTag tag) : previous_(current_tag)
+    {
+        current_tag = tag;
+    }
+
+    MemoryScope::~MemoryScope()
+    {
+        current_tag = previous_;
+    }
+} // namespace engine::core
+
+#ifdef SUNNYLAND_TRACK_ALLOCATIONS
+// Replaceable global allocation functions. Every form is replaced, so that no block allocated here reaches the
+// default operator delete or the other way around.
+void *operator new(std::size_t size) { return engine::core::allocateOrThrow(size, alignof(std::max_align_t)); }
+void *operator new[](std::size_t size) { return engine::core::allocateOrThrow(size, alignof(std::max_align_t)); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return engine::core::allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return engine::core::allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return engine::core::allocateOrThrow(size, alignof(std::max_align_t));
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept { return ::operator new(size, tag); }
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return engine::core::allocateOrThrow(size, static_cast<std::size_t>(alignment));
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &tag) noexcept { return ::operator new(size, alignment, tag); }
+
+void operator delete(void *pointer) noexcept { engine::core::trackedFree(pointer); }
+void operator delete[](void *pointer) noexcept { engine::core::trackedFree(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { engine::core::trackedFree(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept { engine::core::trackedFree(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { engine::core::trackedFree(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { engine::core::trackedFree(pointer); }
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { engine::core::trackedFree(pointer); }
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept { engine::core::trackedFree(pointer); }
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { engine::core::trackedFree(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept { engine::core::trackedFree(pointer); }
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t &) noexcept { engine::core::trackedFree(pointer); }
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t &) noexcept { engine::core::trackedFree(pointer); }
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::core
+{
+    /// @brief Subsystem an allocation is charged to, chosen by the innermost MemoryScope of the allocating thread.
+    enum class MemoryTag : std::uint8_t
+    {
+        Untagged,
+        Core,
+        Resource,
+        Render,
+        Count
+    };
+
+    const char *toString(MemoryTag tag);
+
+    struct MemoryTagStats
+    {
+        std::size_t live_bytes = 0;
+        std::size_t live_allocations = 0;
+        /// @brief High-water mark of live_bytes.
+        std::size_t peak_bytes = 0;
+        std::uint64_t total_allocations = 0;
+    };
+
+    /// @brief Counts heap allocations per MemoryTag through a global operator new/delete replacement.
+    /// The replacement is only compiled with SUNNYLAND_TRACK_ALLOCATIONS; otherwise isEnabled() is false and every
+    /// query returns zeros. Each allocation carries a small header with its size and tag, so frees are charged
+    /// back to the tag that allocated, whichever scope or thread frees them.
+    class MemoryTracker final
+    {
+    public:
+        MemoryTracker() = delete;
+
+        static bool isEnabled();
+        static MemoryTagStats getStats(MemoryTag tag);
+        /// @brief All tags together; peak_bytes is the high-water mark of the total.
+        static MemoryTagStats getTotalStats();
+        /// @brief Allocations made so far by all threads. The difference between two frames is the per-frame count.
+        static std::uint64_t getAllocationCount();
+        /// @brief Logs live and peak bytes per tag at info level.
+        static void logReport();
+    };
+
+    /// @brief Charges allocations of the current thread to a tag until it goes out of scope. Scopes nest.
+    class MemoryScope final
+    {
+    private:
+        MemoryTag previous_;
+
+    public:
+        explicit MemoryScope(MemoryTag tag);
+        ~MemoryScope();
+
+        MemoryScope(const MemoryScope &) = delete;
+        MemoryScope &operator=(const MemoryScope &) = delete;
+        MemoryScope(MemoryScope &&) = delete;
+        MemoryScope &operator=(MemoryScope &&) = delete;
+    };
+} // namespace engine::core
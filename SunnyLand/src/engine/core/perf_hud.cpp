@@ -0,0 +1,231 @@
+#include "perf_hud.h"
+#include "context.h"
+#include "memory_tracker.h"
+#include "../render/renderer.h"
+#include "../resource/resource_manager.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace engine::core
+{
+    namespace
+    {
+        /// @brief Window pixels per font pixel.
+        constexpr float PIXEL = 2.0f;
+        constexpr float ADVANCE = 4.0f * PIXEL;
+        constexpr float LINE_HEIGHT = 7.0f * PIXEL;
+        constexpr float MARGIN = 8.0f;
+        constexpr float PADDING = 6.0f;
+        constexpr float GRAPH_HEIGHT = 64.0f;
+        constexpr std::size_t FPS_FRAMES = 60;
+        constexpr std::size_t MAX_LINE = 32;
+
+        constexpr SDL_FColor BACKGROUND = {0.0f, 0.0f, 0.0f, 0.6f};
+        constexpr SDL_FColor TEXT = {1.0f, 1.0f, 1.0f, 1.0f};
+        constexpr SDL_FColor UPDATE = {0.35f, 0.85f, 0.35f, 1.0f};
+        constexpr SDL_FColor RENDER = {0.35f, 0.6f, 1.0f, 1.0f};
+        constexpr SDL_FColor PRESENT = {1.0f, 0.85f, 0.3f, 1.0f};
+        constexpr SDL_FColor OTHER = {0.7f, 0.7f, 0.7f, 1.0f};
+        constexpr SDL_FColor SLEEP = {0.6f, 0.45f, 0.85f, 0.7f};
+        constexpr SDL_FColor BUDGET = {1.0f, 0.3f, 0.3f, 0.8f};
+
+        /// @brief 3x5 glyphs, one row per 3 bits from the top, the left pixel in the high bit. 0 for unknown characters.
+        constexpr std::uint16_t glyph(char c)
+        {
+            constexpr std::uint16_t DIGITS[10] = {
+                0b111'101'101'101'111, 0b010'110'010'010'111, 0b111'001'111'100'111, 0b111'001'111'001'111,
+                0b101'101'111'001'001, 0b111'100'111'001'111, 0b111'100'111'101'111, 0b111'001'001'010'010,
+                0b111'101'111'101'111, 0b111'101'111'001'111};
+            constexpr std::uint16_t LETTERS[26] = {
+                0b010'101'111'101'101, 0b110'101'110'101'110, 0b011'100'100'100'011, 0b110'101'101'101'110,
+                0b111'100'110'100'111, 0b111'100'110'100'100, 0b011'100'101'101'011, 0b101'101'111'101'101,
+                0b111'010'010'010'111, 0b001'001'001'101'010, 0b101'101'110'101'101, 0b100'100'100'100'111,
+                0b101'111'111'101'101, 0b110'101'101'101'101, 0b010'101'101'101'010, 0b110'101'110'100'100,
+                0b010'101'101'110'011, 0b110'101'110'101'101, 0b011'100'010'001'110, 0b111'010'010'010'010,
+                0b101'101'101'101'111, 0b101'101'101'101'010, 0b101'101'111'111'101, 0b101'101'010'101'101,
+                0b101'101'010'010'010, 0b111'001'010'100'111};
+            if (c >= '0' && c <= '9')
+            {
+                return DIGITS[c - '0'];
+            }
+            if (c >= 'A' && c <= 'Z')
+            {
+                return LETTERS[c - 'A'];
+            }
+            switch (c)
+            {
+            case '.':
+                return 0b000'000'000'000'010;
+            case ':':
+                return 0b000'010'000'010'000;
+            case '/':
+                return 0b001'001'010'100'100;
+            case '-':
+                return 0b000'000'111'000'000;
+            case '%':
+                return 0b101'001'010'100'101;
+            default:
+                return 0;
+            }
+        }
+
+        float toMs(double ms)
+        {
+            return static_cast<float>(std::max(ms, 0.0));
+        }
+    }
+
+    PerfHud::PerfHud()
+    {
+        // Enough for the text and a full graph, so the buffer does not grow while the HUD is shown
+        vertices_.reserve(4 * (GRAPH_FRAMES * 5 + 1024));
+    }
+
+    void PerfHud::setFrameBudget(double budget_ms)
+    {
+        frame_budget_ms_ = budget_ms > 0.0 ? budget_ms : 1000.0 / 60.0;
+    }
+
+    void PerfHud::addFrame(const FrameTimings &timings, Uint64 now_ns)
+    {
+        FrameSample &sample = samples_[next_sample_];
+        sample.update_ms = toMs(timings.simulation_ms);
+        sample.present_ms = toMs(timings.present_ms);
+        sample.render_ms = toMs(timings.render_ms - timings.present_ms);
+        sample.other_ms = toMs(timings.frame_ms - timings.simulation_ms - timings.render_ms);
+        sample.sleep_ms = toMs(timings.sleep_ms);
+        sample.interval_ms = last_sample_ns_ != 0 ? static_cast<float>(now_ns - last_sample_ns_) / 1000000.0f : 0.0f;
+        last_sample_ns_ = now_ns;
+        next_sample_ = (next_sample_ + 1) % GRAPH_FRAMES;
+        sample_count_ = std::min(sample_count_ + 1, GRAPH_FRAMES);
+        draw_calls_ = timings.draw_calls;
+        allocations_ = timings.allocations;
+    }
+
+    void PerfHud::addQuad(float x, float y, float w, float h, const SDL_FColor &color)
+    {
+        vertices_.push_back({{x, y}, color, {0.0f, 0.0f}});
+        vertices_.push_back({{x + w, y}, color, {0.0f, 0.0f}});
+        vertices_.push_back({{x + w, y + h}, color, {0.0f, 0.0f}});
+        vertices_.push_back({{x, y + h}, color, {0.0f, 0.0f}});
+    }
+
+    float PerfHud::addText(float x, float y, std::string_view text, const SDL_FColor &color)
+    {
+        for (char c : text)
+        {
+            std::uint16_t bits = glyph(c);
+            for (int row = 0; row < 5; ++row)
+            {
+                unsigned row_bits = (bits >> (3 * (4 - row))) & 0b111u;
+                // One quad per horizontal run of lit pixels
+                int column = 0;
+                while (column < 3)
+                {
+                    if (!(row_bits & (0b100u >> column)))
+                    {
+                        ++column;
+                        continue;
+                    }
+                    int run_begin = column;
+                    while (column < 3 && (row_bits & (0b100u >> column)))
+                    {
+                        ++column;
+                    }
+                    addQuad(x + static_cast<float>(run_begin) * PIXEL, y + static_cast<float>(row) * PIXEL,
+                            static_cast<float>(column - run_begin) * PIXEL, PIXEL, color);
+                }
+            }
+            x += ADVANCE;
+        }
+        return x;
+    }
+
+    void PerfHud::addGraph(float x, float y)
+    {
+        const float scale = GRAPH_HEIGHT / static_cast<float>(frame_budget_ms_ * 2.0);
+        const float bottom = y + GRAPH_HEIGHT;
+        // Oldest sample on the left, so the newest frame is always at the right edge
+        std::size_t first = (next_sample_ + GRAPH_FRAMES - sample_count_) % GRAPH_FRAMES;
+        float column = x + static_cast<float>(GRAPH_FRAMES - sample_count_);
+        for (std::size_t i = 0; i < sample_count_; ++i, column += 1.0f)
+        {
+            const FrameSample &sample = samples_[(first + i) % GRAPH_FRAMES];
+            float top = bottom;
+            for (auto [ms, color] : {std::pair{sample.update_ms, UPDATE}, std::pair{sample.render_ms, RENDER},
+                                     std::pair{sample.present_ms, PRESENT}, std::pair{sample.other_ms, OTHER},
+                                     std::pair{sample.sleep_ms, SLEEP}})
+            {
+                float height = std::min(ms * scale, top - y);
+                if (height <= 0.0f)
+                {
+                    continue;
+                }
+                top -= height;
+                addQuad(column, top, 1.0f, height, color);
+            }
+        }
+        addQuad(x, bottom - static_cast<float>(frame_budget_ms_) * scale, static_cast<float>(GRAPH_FRAMES), 1.0f, BUDGET);
+    }
+
+    void PerfHud::draw(engine::render::Renderer &renderer, const engine::resource::ResourceMemoryUsage &resources)
+    {
+        if (!visible_)
+        {
+            return;
+        }
+        vertices_.clear();
+
+        const FrameSample &last = samples_[(next_sample_ + GRAPH_FRAMES - 1) % GRAPH_FRAMES];
+        float interval_sum = 0.0f;
+        std::size_t interval_count = 0;
+        for (std::size_t i = 1; i <= std::min(sample_count_, FPS_FRAMES); ++i)
+        {
+            const FrameSample &sample = samples_[(next_sample_ + GRAPH_FRAMES - i) % GRAPH_FRAMES];
+            if (sample.interval_ms > 0.0f)
+            {
+                interval_sum += sample.interval_ms;
+                ++interval_count;
+            }
+        }
+        const float fps = interval_sum > 0.0f ? 1000.0f * static_cast<float>(interval_count) / interval_sum : 0.0f;
+
+        const float width = static_cast<float>(GRAPH_FRAMES) + 2.0f * PADDING;
+        const int lines = MemoryTracker::isEnabled() ? 6 : 5;
+        const float height = 2.0f * PADDING + static_cast<float>(lines) * LINE_HEIGHT + GRAPH_HEIGHT;
+        addQuad(MARGIN, MARGIN, width, height, BACKGROUND);
+
+        const float left = MARGIN + PADDING;
+        const float column = left + 12.0f * ADVANCE;
+        float y = MARGIN + PADDING;
+        char line[MAX_LINE];
+        auto text = [&](float x, const SDL_FColor &color, const char *format, auto... values)
+        {
+            int length = std::snprintf(line, sizeof(line), format, values...);
+            return addText(x, y, std::string_view(line, static_cast<std::size_t>(std::clamp(length, 0, static_cast<int>(MAX_LINE) - 1))), color);
+        };
+
+        text(left, TEXT, "FPS %.1f", fps);
+        text(column, TEXT, "%.2f MS", last.interval_ms);
+        y += LINE_HEIGHT;
+        text(left, UPDATE, "UPD %.2f", last.update_ms);
+        text(column, RENDER, "RND %.2f", last.render_ms);
+        y += LINE_HEIGHT;
+        text(left, PRESENT, "PRS %.2f", last.present_ms);
+        text(column, SLEEP, "SLP %.2f", last.sleep_ms);
+        y += LINE_HEIGHT;
+        text(left, TEXT, "DRAW %u", static_cast<unsigned>(draw_calls_));
+        text(column, TEXT, "TEX %zu", resources.texture_count);
+        y += LINE_HEIGHT;
+        text(left, TEXT, "TEX MEM %.1f MB", static_cast<double>(resources.texture_bytes) / (1024.0 * 1024.0));
+        y += LINE_HEIGHT;
+        if (MemoryTracker::isEnabled())
+        {
+            text(left, TEXT, "ALLOC %llu", static_cast<unsigned long long>(allocations_));
+            y += LINE_HEIGHT;
+        }
+
+        addGraph(left, y);
+        renderer.drawQuads(vertices_);
+    }
+} // namespace engine::core
@@ -0,0 +1,84 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <SDL3/SDL_render.h>
+
+namespace engine::render
+{
+    class Renderer;
+}
+
+namespace engine::resource
+{
+    struct ResourceMemoryUsage;
+}
+
+namespace engine::core
+{
+    struct FrameTimings;
+
+    /// @brief On-screen overlay with the FPS, the split of the last frame, a graph of the last frames and the
+    /// resource counts. Text uses a built-in 3x5 pixel font and everything is drawn as untextured quads in one call.
+    /// Vertices are kept between frames, so drawing allocates nothing once the buffer has grown.
+    class PerfHud final
+    {
+    public:
+        static constexpr std::size_t GRAPH_FRAMES = 240;
+
+    private:
+        /// @brief Stacked segments of one graph bar, in ms.
+        struct FrameSample
+        {
+            float update_ms = 0.0f;
+            float render_ms = 0.0f;
+            float present_ms = 0.0f;
+            /// @brief Rest of the frame: events, resource uploads and waiting for the simulation.
+            float other_ms = 0.0f;
+            float sleep_ms = 0.0f;
+            /// @brief Time since the previous sample, for the FPS.
+            float interval_ms = 0.0f;
+        };
+
+        std::array<FrameSample, GRAPH_FRAMES> samples_{};
+        /// @brief Index the next sample is written to; samples_[next_sample_ - 1] is the newest.
+        std::size_t next_sample_ = 0;
+        std::size_t sample_count_ = 0;
+        Uint64 last_sample_ns_ = 0;
+        std::uint32_t draw_calls_ = 0;
+        std::uint64_t allocations_ = 0;
+
+        double frame_budget_ms_ = 1000.0 / 60.0;
+        bool visible_ = false;
+
+        std::vector<SDL_Vertex> vertices_;
+
+        void addQuad(float x, float y, float w, float h, const SDL_FColor &color);
+        /// @brief Adds uppercase text in the built-in font. Returns the x after the last character.
+        float addText(float x, float y, std::string_view text, const SDL_FColor &color);
+        void addGraph(float x, float y);
+
+    public:
+        PerfHud();
+
+        PerfHud(const PerfHud &) = delete;
+        PerfHud &operator=(const PerfHud &) = delete;
+        PerfHud(PerfHud &&) = delete;
+        PerfHud &operator=(PerfHud &&) = delete;
+
+        void setVisible(bool visible) { visible_ = visible; }
+        bool isVisible() const { return visible_; }
+        void toggle() { visible_ = !visible_; }
+
+        /// @brief Frame time the graph is scaled to: its height is twice the budget.
+        void setFrameBudget(double budget_ms);
+
+        /// @brief Records a finished frame. Called every frame, also while hidden, so the graph is full when shown.
+        void addFrame(const FrameTimings &timings, Uint64 now_ns);
+
+        /// @brief Draws the overlay in the top left corner of the window, if visible.
+        void draw(engine::render::Renderer &renderer, const engine::resource::ResourceMemoryUsage &resources);
+    };
+} // namespace engine::core
@@ -0,0 +1,71 @@
+#include "startup_timeline.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    namespace
+    {
+        double toMilliseconds(StartupTimeline::Clock::duration duration)
+        {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+    }
+
+    StartupTimeline::Scope::Scope(StartupTimeline &timeline, std::string name, std::string thread)
+        : timeline_(timeline), name_(std::move(name)), thread_(std::move(thread)), start_(Clock::now())
+    {
+    }
+
+    StartupTimeline::Scope::~Scope()
+    {
+        timeline_.addPhase(std::move(name_), std::move(thread_), start_, Clock::now());
+    }
+
+    StartupTimeline::StartupTimeline() : origin_(Clock::now()) {}
+
+    void StartupTimeline::addPhase(std::string name, std::string thread, Clock::time_point start, Clock::time_point end)
+    {
+        std::lock_guard lock(mutex_);
+        phases_.push_back({std::move(name), std::move(thread), start, end});
+    }
+
+    void StartupTimeline::markFirstFrame()
+    {
+        Clock::time_point now = Clock::now();
+        {
+            std::lock_guard lock(mutex_);
+            if (first_frame_marked_)
+            {
+                return;
+            }
+            first_frame_marked_ = true;
+        }
+        logReport(now);
+    }
+
+    bool StartupTimeline::isFirstFrameMarked() const
+    {
+        std::lock_guard lock(mutex_);
+        return first_frame_marked_;
+    }
+
+    void StartupTimeline::logReport(Clock::time_point first_frame) const
+    {
+        std::vector<Phase> phases;
+        {
+            std::lock_guard lock(mutex_);
+            phases = phases_;
+        }
+        std::sort(phases.begin(), phases.end(), [](const Phase &a, const Phase &b)
+                  { return a.start < b.start; });
+
+        spdlog::info("Startup timeline (ms from start):");
+        for (const auto &phase : phases)
+        {
+            spdlog::info("  {:>8.2f} - {:>8.2f} {:>8.2f} ms  [{}] {}", toMilliseconds(phase.start - origin_),
+                         toMilliseconds(phase.end - origin_), toMilliseconds(phase.end - phase.start), phase.thread, phase.name);
+        }
+        spdlog::info("Time to first frame: {:.2f} ms", toMilliseconds(first_frame - origin_));
+    }
+} // namespace engine::core
@@ -0,0 +1,68 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+namespace engine::core
+{
+    /// @brief Records how long each startup phase takes, from application start to the first presented frame.
+    /// Phases may be recorded from several threads at once.
+    class StartupTimeline final
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Phase
+        {
+            std::string name;
+            std::string thread;
+            Clock::time_point start;
+            Clock::time_point end;
+        };
+
+        /// @brief Records the phase it was created for when it goes out of scope.
+        class Scope final
+        {
+        private:
+            StartupTimeline &timeline_;
+            std::string name_;
+            std::string thread_;
+            Clock::time_point start_;
+
+        public:
+            Scope(StartupTimeline &timeline, std::string name, std::string thread);
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+            Scope(Scope &&) = delete;
+            Scope &operator=(Scope &&) = delete;
+        };
+
+    private:
+        mutable std::mutex mutex_;
+        Clock::time_point origin_;
+        std::vector<Phase> phases_;
+        bool first_frame_marked_ = false;
+
+    public:
+        StartupTimeline();
+
+        StartupTimeline(const StartupTimeline &) = delete;
+        StartupTimeline &operator=(const StartupTimeline &) = delete;
+        StartupTimeline(StartupTimeline &&) = delete;
+        StartupTimeline &operator=(StartupTimeline &&) = delete;
+
+        void addPhase(std::string name, std::string thread, Clock::time_point start, Clock::time_point end);
+
+        /// @brief Marks the first presented frame and logs the timeline. Only the first call has an effect.
+        void markFirstFrame();
+
+        bool isFirstFrameMarked() const;
+
+        /// @brief Logs every phase with its offset from the origin and its duration.
+        void logReport(Clock::time_point first_frame) const;
+    };
+} // namespace engine::core
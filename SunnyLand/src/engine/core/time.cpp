@@ -1,6 +1,7 @@
 #include "time.h"
 #include <spdlog/spdlog.h>
 #include <SDL3/SDL_timer.h>
+#include <cmath>
 
 namespace engine::core
 {
@@ -17,6 +18,7 @@ namespace engine::core
         frame_start_time_ = current_time;
 
         double current_delta_time = static_cast<double>(frame_start_time_ - last_time_) / 1000000000.0;
+        sleep_time_ = 0.0;
 
         // Limit time
         if (target_frame_time_ > 0)
@@ -31,6 +33,14 @@ namespace engine::core
         // spdlog::info("Time updated: frame_start_time_ = {}, delta_time_ = {}", frame_start_time_, delta_time_);
     }
 
+    void Time::resetFrameStart()
+    {
+        // Pretend exactly one target frame has passed, so the limiter doesn't add a frame of latency to the waking event
+        Uint64 frame_ns = static_cast<Uint64>(std::ceil(target_frame_time_ * 1000000000.0));
+        frame_start_time_ = SDL_GetTicksNS();
+        last_time_ = frame_start_time_ > frame_ns ? frame_start_time_ - frame_ns : 0;
+    }
+
     float Time::getDeltaTime() const
     {
         return static_cast<float>(delta_time_ * time_scale_);
@@ -41,6 +51,11 @@ namespace engine::core
         return static_cast<float>(delta_time_);
     }
 
+    float Time::getSleepTime() const
+    {
+        return static_cast<float>(sleep_time_);
+    }
+
     void Time::setTimeScale(float scale)
     {
         if (scale < 0.0f)
@@ -63,7 +78,10 @@ namespace engine::core
     {
         if (fps <= 0)
         {
-            spdlog::warn("Invalid target FPS: {}. Setting to 0 (no limit).", fps);
+            if (fps < 0)
+            {
+                spdlog::warn("Invalid target FPS: {}. Setting to 0 (no limit).", fps);
+            }
             target_fps_ = 0;
             target_frame_time_ = 0.0;
             return;
@@ -92,6 +110,11 @@ namespace engine::core
                 SDL_DelayNS(wait_time);
                 delta_time_ = SDL_GetTicksNS() - frame_start_time_;
                 delta_time_ /= 1000000000.0; // Convert to seconds
+                sleep_time_ = delta_time_;
+            }
+            else
+            {
+                delta_time_ = delta_time;
             }
         }
     }
@@ -13,6 +13,8 @@ namespace engine::core
         Uint64 last_time_ = 0;
         double delta_time_ = 0.0;
         double time_scale_ = 1.0;
+        /// @brief Time the frame limiter slept in the last update(), in seconds.
+        double sleep_time_ = 0.0;
 
         int target_fps_ = 0;           // Target frames per second
         double target_frame_time_ = 0; // Target frame time in milliseconds
@@ -23,12 +25,18 @@ namespace engine::core
         /// @brief Updates the time variables.
         void update();
 
+        /// @brief Restarts the frame clock after an idle wait, so the next update() reports one frame instead of the whole wait.
+        void resetFrameStart();
+
         /// @brief Gets the current frame's delta time.
         float getDeltaTime() const;
 
         /// @brief Gets the unscaled delta time.
         float getUnscaledDeltaTime() const;
 
+        /// @brief Gets the time the frame limiter slept at the start of the current frame.
+        float getSleepTime() const;
+
         /// @brief Sets the time scale.
         void setTimeScale(float scale);
 
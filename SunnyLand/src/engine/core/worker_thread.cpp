@@ -0,0 +1,81 @@
+#include "worker_thread.h"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+namespace engine::core
+{
+    WorkerThread::WorkerThread(std::string name) : name_(std::move(name))
+    {
+        thread_ = std::thread(&WorkerThread::threadMain, this);
+        spdlog::trace("Worker thread '{}' started", name_);
+    }
+
+    WorkerThread::~WorkerThread()
+    {
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this]
+                     { return !has_job_; });
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+        spdlog::trace("Worker thread '{}' stopped", name_);
+    }
+
+    void WorkerThread::submit(std::function<void()> job)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (has_job_)
+            {
+                throw std::logic_error("Worker thread '" + name_ + "' is still busy");
+            }
+            job_ = std::move(job);
+            has_job_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    void WorkerThread::wait()
+    {
+        std::unique_lock lock(mutex_);
+        cv_.wait(lock, [this]
+                 { return !has_job_; });
+        if (error_)
+        {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    void WorkerThread::threadMain()
+    {
+        std::unique_lock lock(mutex_);
+        while (true)
+        {
+            cv_.wait(lock, [this]
+                     { return has_job_ || stopping_; });
+            if (stopping_)
+            {
+                return;
+            }
+
+            auto job = std::move(job_);
+            lock.unlock();
+            std::exception_ptr error;
+            try
+            {
+                job();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            lock.lock();
+
+            error_ = error;
+            has_job_ = false;
+            cv_.notify_all();
+        }
+    }
+} // namespace engine::core
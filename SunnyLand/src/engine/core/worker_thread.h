@@ -0,0 +1,42 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <string>
+
+namespace engine::core
+{
+    /// @brief A single persistent thread that runs one job at a time.
+    /// submit() hands a job over, wait() blocks until it finished and rethrows any exception it threw.
+    class WorkerThread final
+    {
+    private:
+        std::string name_;
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::function<void()> job_;
+        std::exception_ptr error_;
+        bool has_job_ = false;
+        bool stopping_ = false;
+
+        void threadMain();
+
+    public:
+        explicit WorkerThread(std::string name);
+        ~WorkerThread();
+
+        WorkerThread(const WorkerThread &) = delete;
+        WorkerThread &operator=(const WorkerThread &) = delete;
+        WorkerThread(WorkerThread &&) = delete;
+        WorkerThread &operator=(WorkerThread &&) = delete;
+
+        /// @brief Starts a job. The previous job must have been waited for.
+        void submit(std::function<void()> job);
+
+        /// @brief Blocks until the current job finished. Does nothing when no job is running.
+        void wait();
+    };
+} // namespace engine::core
@@ -0,0 +1,85 @@
+#include "archetype.h"
+#include <bit>
+#include <cstring>
+
+namespace engine::ecs
+{
+    void Column::swapRemove(std::size_t row)
+    {
+        std::size_t last = data_.size() / element_size_ - 1;
+        if (row != last)
+        {
+            std::memcpy(get(row), get(last), element_size_);
+        }
+        data_.resize(data_.size() - element_size_);
+    }
+
+    Archetype::Archetype(ComponentMask mask) : mask_(mask)
+    {
+        column_index_.fill(-1);
+        for (ComponentMask remaining = mask; remaining != 0; remaining &= remaining - 1)
+        {
+            auto type_id = static_cast<ComponentTypeId>(std::countr_zero(remaining));
+            column_index_[type_id] = static_cast<std::int8_t>(columns_.size());
+            columns_.emplace_back(type_id, ComponentRegistry::info(type_id).size);
+        }
+    }
+
+    void Archetype::reserve(std::size_t rows)
+    {
+        entities_.reserve(rows);
+        for (auto &column : columns_)
+        {
+            column.reserve(rows);
+        }
+    }
+
+    std::size_t Archetype::pushRow(Entity entity)
+    {
+        entities_.push_back(entity);
+        for (auto &column : columns_)
+        {
+            column.pushBack();
+        }
+        return entities_.size() - 1;
+    }
+
+    Entity Archetype::swapRemoveRow(std::size_t row)
+    {
+        for (auto &column : columns_)
+        {
+            column.swapRemove(row);
+        }
+        std::size_t last = entities_.size() - 1;
+        Entity moved;
+        if (row != last)
+        {
+            entities_[row] = entities_[last];
+            moved = entities_[row];
+        }
+        entities_.pop_back();
+        return moved;
+    }
+
+    std::size_t Archetype::moveRowTo(std::size_t row, Archetype &target)
+    {
+        std::size_t target_row = target.pushRow(entities_[row]);
+        for (auto &column : columns_)
+        {
+            if (target.hasComponent(column.getTypeId()))
+            {
+                std::memcpy(target.getComponent(target_row, column.getTypeId()), column.get(row), column.getElementSize());
+            }
+        }
+        return target_row;
+    }
+
+    void Archetype::clear()
+    {
+        entities_.clear();
+        for (auto &column : columns_)
+        {
+            column.clear();
+        }
+    }
+} // namespace engine::ecs
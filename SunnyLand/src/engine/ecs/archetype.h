@@ -0,0 +1,113 @@
+#pragma once
+#include "entity.h"
+#include "component.h"
+#include <array>
+#include <cstddef>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::save
+{
+    class WorldSerializer;
+}
+
+namespace engine::ecs
+{
+    /// @brief Contiguous storage of one component type, as raw bytes.
+    class Column final
+    {
+    private:
+        ComponentTypeId type_id_;
+        std::size_t element_size_;
+        std::vector<std::byte> data_;
+
+    public:
+        Column(ComponentTypeId type_id, std::size_t element_size) : type_id_(type_id), element_size_(element_size) {}
+
+        ComponentTypeId getTypeId() const { return type_id_; }
+        std::size_t getElementSize() const { return element_size_; }
+
+        void *get(std::size_t row) { return data_.data() + row * element_size_; }
+        const void *get(std::size_t row) const { return data_.data() + row * element_size_; }
+
+        template <typename T>
+        T *data() { return reinterpret_cast<T *>(data_.data()); }
+        template <typename T>
+        const T *data() const { return reinterpret_cast<const T *>(data_.data()); }
+
+        void reserve(std::size_t rows) { data_.reserve(rows * element_size_); }
+        /// @brief Appends a zero-filled row.
+        void pushBack() { data_.resize(data_.size() + element_size_); }
+        /// @brief Grows or shrinks to rows; new rows are zero-filled.
+        void resize(std::size_t rows) { data_.resize(rows * element_size_); }
+        /// @brief Moves the last row into row and shrinks the column by one.
+        void swapRemove(std::size_t row);
+        void clear() { data_.clear(); }
+    };
+
+    /// @brief Table of all entities that have exactly the same set of components.
+    /// Every component type is a column and every entity a row, so systems iterate tightly packed arrays.
+    class Archetype final
+    {
+        friend class World;
+        friend class engine::save::WorldSerializer;
+
+    private:
+        ComponentMask mask_;
+        std::vector<Column> columns_;
+        /// @brief Position of each component type in columns_, or -1.
+        std::array<std::int8_t, MAX_COMPONENT_TYPES> column_index_;
+        std::vector<Entity> entities_;
+
+        // Cached neighbours in the archetype graph, so adding or removing a component is one lookup
+        std::unordered_map<ComponentTypeId, Archetype *> add_edges_;
+        std::unordered_map<ComponentTypeId, Archetype *> remove_edges_;
+
+    public:
+        explicit Archetype(ComponentMask mask);
+
+        Archetype(const Archetype &) = delete;
+        Archetype &operator=(const Archetype &) = delete;
+        Archetype(Archetype &&) = delete;
+        Archetype &operator=(Archetype &&) = delete;
+
+        ComponentMask getMask() const { return mask_; }
+        std::size_t size() const { return entities_.size(); }
+        bool empty() const { return entities_.empty(); }
+        const std::vector<Entity> &getEntities() const { return entities_; }
+        const std::vector<Column> &getColumns() const { return columns_; }
+
+        bool hasComponent(ComponentTypeId type_id) const { return column_index_[type_id] >= 0; }
+
+        /// @brief Raw pointer to a component of a row. The archetype must have the component.
+        void *getComponent(std::size_t row, ComponentTypeId type_id) { return columns_[column_index_[type_id]].get(row); }
+        const void *getComponent(std::size_t row, ComponentTypeId type_id) const { return columns_[column_index_[type_id]].get(row); }
+
+        /// @brief The whole column of a component type. The archetype must have the component.
+        template <Component T>
+        std::span<T> column()
+        {
+            return {columns_[column_index_[ComponentRegistry::id<T>()]].template data<T>(), entities_.size()};
+        }
+        template <Component T>
+        std::span<const T> column() const
+        {
+            return {columns_[column_index_[ComponentRegistry::id<T>()]].template data<T>(), entities_.size()};
+        }
+
+        void reserve(std::size_t rows);
+
+    private:
+        /// @brief Appends a zero-filled row for entity and returns its index.
+        std::size_t pushRow(Entity entity);
+        /// @brief Removes a row by moving the last row into it.
+        /// @return The entity that now lives in row, or an invalid entity if row was the last one.
+        Entity swapRemoveRow(std::size_t row);
+        /// @brief Copies the components of a row that target also has into a new row of target.
+        /// The source row is left in place for the caller to remove.
+        /// @return The row in target.
+        std::size_t moveRowTo(std::size_t row, Archetype &target);
+        void clear();
+    };
+} // namespace engine::ecs
@@ -0,0 +1,89 @@
+#include "command_buffer.h"
+#include "world.h"
+#include <cstring>
+
+namespace engine::ecs
+{
+    Entity CommandBuffer::createEntity()
+    {
+        Entity entity{pending_count_++, PENDING_GENERATION};
+        commands_.push_back({CommandType::Create, entity});
+        return entity;
+    }
+
+    void CommandBuffer::destroyEntity(Entity entity)
+    {
+        commands_.push_back({CommandType::Destroy, entity});
+    }
+
+    void CommandBuffer::addComponent(Entity entity, ComponentTypeId type_id, const void *data, std::size_t size)
+    {
+        auto offset = static_cast<std::uint32_t>(payload_.size());
+        payload_.resize(payload_.size() + size);
+        std::memcpy(payload_.data() + offset, data, size);
+        commands_.push_back({CommandType::AddComponent, entity, type_id, offset});
+    }
+
+    void CommandBuffer::removeComponent(Entity entity, ComponentTypeId type_id)
+    {
+        commands_.push_back({CommandType::RemoveComponent, entity, type_id});
+    }
+
+    void CommandBuffer::flush(World &world)
+    {
+        if (commands_.empty())
+        {
+            return;
+        }
+
+        // Collect the components of each new entity first, so it is created in its final archetype
+        // instead of moving through one archetype per added component
+        pending_masks_.assign(pending_count_, 0);
+        created_.assign(pending_count_, Entity{});
+        for (const Command &command : commands_)
+        {
+            if (command.type == CommandType::AddComponent && isPending(command.entity))
+            {
+                pending_masks_[command.entity.index] |= ComponentMask(1) << command.type_id;
+            }
+        }
+
+        for (const Command &command : commands_)
+        {
+            Entity entity = isPending(command.entity) ? created_[command.entity.index] : command.entity;
+            if (command.type == CommandType::Create)
+            {
+                created_[command.entity.index] = world.createEntityWithMask(pending_masks_[command.entity.index]);
+                continue;
+            }
+            if (!world.isAlive(entity))
+            {
+                continue;
+            }
+
+            switch (command.type)
+            {
+            case CommandType::Destroy:
+                world.destroyEntity(entity);
+                break;
+            case CommandType::AddComponent:
+                world.addComponent(entity, command.type_id, payload_.data() + command.data_offset);
+                break;
+            case CommandType::RemoveComponent:
+                world.removeComponent(entity, command.type_id);
+                break;
+            case CommandType::Create:
+                break;
+            }
+        }
+
+        clear();
+    }
+
+    void CommandBuffer::clear()
+    {
+        commands_.clear();
+        payload_.clear();
+        pending_count_ = 0;
+    }
+} // namespace engine::ecs
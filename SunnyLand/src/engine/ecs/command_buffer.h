@@ -0,0 +1,91 @@
+#pragma once
+#include "entity.h"
+#include "component.h"
+#include <cstddef>
+#include <vector>
+
+namespace engine::ecs
+{
+    class World;
+
+    /// @brief Records structural changes (create, destroy, add, remove) to apply later with flush().
+    /// Systems use it while iterating a query, where changing archetypes directly is not allowed.
+    /// Entities created here are placeholders that are only valid within this buffer until flushed.
+    class CommandBuffer final
+    {
+    private:
+        enum class CommandType : std::uint8_t
+        {
+            Create,
+            Destroy,
+            AddComponent,
+            RemoveComponent
+        };
+
+        struct Command
+        {
+            CommandType type;
+            Entity entity;
+            ComponentTypeId type_id = 0;
+            std::uint32_t data_offset = 0;
+        };
+
+        static constexpr std::uint32_t PENDING_GENERATION = 0xFFFFFFFFu;
+
+        std::vector<Command> commands_;
+        /// @brief Component values of AddComponent commands, copied as raw bytes.
+        std::vector<std::byte> payload_;
+        std::uint32_t pending_count_ = 0;
+
+        // Scratch space of flush(), kept to reuse its capacity
+        std::vector<ComponentMask> pending_masks_;
+        std::vector<Entity> created_;
+
+    public:
+        CommandBuffer() = default;
+
+        CommandBuffer(const CommandBuffer &) = delete;
+        CommandBuffer &operator=(const CommandBuffer &) = delete;
+        CommandBuffer(CommandBuffer &&) = default;
+        CommandBuffer &operator=(CommandBuffer &&) = default;
+
+        /// @brief Returns a placeholder for an entity that is created on flush().
+        Entity createEntity();
+
+        template <Component... Ts>
+        Entity createEntity(const Ts &...components)
+        {
+            Entity entity = createEntity();
+            (addComponent(entity, components), ...);
+            return entity;
+        }
+
+        void destroyEntity(Entity entity);
+
+        template <Component T>
+        void addComponent(Entity entity, const T &component)
+        {
+            addComponent(entity, ComponentRegistry::id<T>(), &component, sizeof(T));
+        }
+
+        template <Component T>
+        void removeComponent(Entity entity)
+        {
+            removeComponent(entity, ComponentRegistry::id<T>());
+        }
+
+        void addComponent(Entity entity, ComponentTypeId type_id, const void *data, std::size_t size);
+        void removeComponent(Entity entity, ComponentTypeId type_id);
+
+        /// @brief Applies the commands in recording order and clears the buffer.
+        /// Entities created in the buffer go straight into their final archetype.
+        /// Commands for entities that died in the meantime are skipped.
+        void flush(World &world);
+
+        bool empty() const { return commands_.empty(); }
+        std::size_t size() const { return commands_.size(); }
+        void clear();
+
+        static bool isPending(Entity entity) { return entity.generation == PENDING_GENERATION; }
+    };
+} // namespace engine::ecs
@@ -0,0 +1,67 @@
+#include "component.h"
+#include <array>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace engine::ecs
+{
+    namespace
+    {
+        struct Registry
+        {
+            std::mutex mutex;
+            std::array<ComponentInfo, MAX_COMPONENT_TYPES> infos;
+            std::size_t count = 0;
+        };
+
+        Registry &registry()
+        {
+            static Registry instance;
+            return instance;
+        }
+    }
+
+    const ComponentInfo &ComponentRegistry::info(ComponentTypeId type_id)
+    {
+        // Entries never change once registered, so reading does not need the lock
+        return registry().infos.at(type_id);
+    }
+
+    std::size_t ComponentRegistry::count()
+    {
+        Registry &r = registry();
+        std::lock_guard lock(r.mutex);
+        return r.count;
+    }
+
+    std::optional<ComponentTypeId> ComponentRegistry::find(std::string_view name)
+    {
+        Registry &r = registry();
+        std::lock_guard lock(r.mutex);
+        for (std::size_t type_id = 0; type_id < r.count; ++type_id)
+        {
+            if (r.infos[type_id].name == name)
+            {
+                return static_cast<ComponentTypeId>(type_id);
+            }
+        }
+        return std::nullopt;
+    }
+
+    ComponentTypeId ComponentRegistry::registerType(const ComponentInfo &info)
+    {
+        Registry &r = registry();
+        std::lock_guard lock(r.mutex);
+        if (r.count >= MAX_COMPONENT_TYPES)
+        {
+            throw std::runtime_error("Too many component types, cannot register " + std::string(info.name));
+        }
+        auto type_id = static_cast<ComponentTypeId>(r.count);
+        r.infos[type_id] = info;
+        ++r.count;
+        spdlog::trace("Registered component type '{}' as id {} ({} bytes)", info.name, type_id, info.size);
+        return type_id;
+    }
+} // namespace engine::ecs
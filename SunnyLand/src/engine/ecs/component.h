@@ -0,0 +1,94 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <concepts>
+#include <optional>
+
+namespace engine::ecs
+{
+    using ComponentTypeId = std::uint32_t;
+    /// @brief Bit i is set when the component type with id i is present.
+    using ComponentMask = std::uint64_t;
+
+    constexpr std::size_t MAX_COMPONENT_TYPES = 64;
+    constexpr std::size_t MAX_STRING_ID_FIELDS = 4;
+
+    /// @brief A component is plain data with a stable name.
+    /// Components are stored as raw bytes in archetype columns and moved with memcpy,
+    /// so they must be trivially copyable; the name identifies the type in debug output and save files.
+    /// Column bytes come from plain operator new, so a component can't need more than its default alignment.
+    /// Components holding utils::StringIds list their byte offsets in a static constexpr stringIdOffsets(),
+    /// because interned ids differ between runs and save files have to renumber them.
+    template <typename T>
+    concept Component = std::is_trivially_copyable_v<T> && alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ && requires {
+        { T::COMPONENT_NAME } -> std::convertible_to<std::string_view>;
+    };
+
+    struct ComponentInfo
+    {
+        std::string_view name;
+        std::size_t size = 0;
+        std::size_t alignment = 0;
+        /// @brief Byte offsets of StringId members.
+        std::array<std::uint16_t, MAX_STRING_ID_FIELDS> string_id_offsets{};
+        std::size_t string_id_count = 0;
+    };
+
+    template <Component T>
+    ComponentInfo makeComponentInfo()
+    {
+        ComponentInfo info{T::COMPONENT_NAME, sizeof(T), alignof(T)};
+        if constexpr (requires { T::stringIdOffsets(); })
+        {
+            constexpr auto offsets = T::stringIdOffsets();
+            static_assert(offsets.size() <= MAX_STRING_ID_FIELDS, "Too many StringId members in one component");
+            for (std::size_t i = 0; i < offsets.size(); ++i)
+            {
+                info.string_id_offsets[i] = static_cast<std::uint16_t>(offsets[i]);
+            }
+            info.string_id_count = offsets.size();
+        }
+        return info;
+    }
+
+    /// @brief Assigns a small id to every component type on first use. Thread-safe.
+    class ComponentRegistry final
+    {
+    public:
+        ComponentRegistry() = delete;
+
+        template <Component T>
+        static ComponentTypeId id()
+        {
+            static const ComponentTypeId type_id = registerType(makeComponentInfo<T>());
+            return type_id;
+        }
+
+        template <Component T>
+        static ComponentMask mask() { return ComponentMask(1) << id<T>(); }
+
+        /// @brief Registers the types now rather than on first use, so find() knows them before anything was created.
+        template <Component... Ts>
+        static void registerTypes() { (id<Ts>(), ...); }
+
+        static const ComponentInfo &info(ComponentTypeId type_id);
+        static std::size_t count();
+        /// @brief Id of a registered type with this name. Types register on first use or through registerTypes(), so a type
+        /// the program has neither touched nor registered is not found. Save files are loaded by name and rely on this.
+        static std::optional<ComponentTypeId> find(std::string_view name);
+
+    private:
+        /// @brief Throws std::runtime_error when MAX_COMPONENT_TYPES is exceeded.
+        static ComponentTypeId registerType(const ComponentInfo &info);
+    };
+
+    /// @brief Mask of all the given component types.
+    template <Component... Ts>
+    ComponentMask componentMask()
+    {
+        return (ComponentMask(0) | ... | ComponentRegistry::mask<Ts>());
+    }
+} // namespace engine::ecs
@@ -0,0 +1,41 @@
+#pragma once
+#include "component.h"
+#include "../utils/string_id.h"
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <SDL3/SDL_rect.h>
+#include <glm/vec2.hpp>
+
+namespace engine::ecs
+{
+    struct Transform
+    {
+        static constexpr std::string_view COMPONENT_NAME = "Transform";
+
+        glm::vec2 position{0.0f, 0.0f};
+        glm::vec2 scale{1.0f, 1.0f};
+        float rotation = 0.0f;
+    };
+
+    struct Velocity
+    {
+        static constexpr std::string_view COMPONENT_NAME = "Velocity";
+
+        glm::vec2 value{0.0f, 0.0f};
+    };
+
+    /// @brief Sprite of an entity, drawn at its Transform.
+    /// Unlike render::Sprite the texture is an interned id, so the component stays trivially copyable.
+    struct SpriteComponent
+    {
+        static constexpr std::string_view COMPONENT_NAME = "Sprite";
+
+        engine::utils::StringId texture_id = engine::utils::EMPTY_STRING_ID;
+        /// @brief Part of the texture to draw. A zero size draws the whole texture.
+        SDL_FRect source_rect{0.0f, 0.0f, 0.0f, 0.0f};
+        bool is_flipped = false;
+
+        static constexpr std::array<std::size_t, 1> stringIdOffsets() { return {offsetof(SpriteComponent, texture_id)}; }
+    };
+} // namespace engine::ecs
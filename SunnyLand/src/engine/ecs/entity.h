@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+namespace engine::ecs
+{
+    /// @brief Handle of an entity in a World.
+    /// The generation changes every time an index is reused, so stale handles are detected.
+    struct Entity
+    {
+        static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t index = INVALID_INDEX;
+        std::uint32_t generation = 0;
+
+        bool isValid() const { return index != INVALID_INDEX; }
+        bool operator==(const Entity &) const = default;
+    };
+} // namespace engine::ecs
@@ -0,0 +1,34 @@
+#include "movement_system.h"
+#include "world.h"
+#include "components.h"
+#include "parallel_query.h"
+
+namespace engine::ecs
+{
+    namespace
+    {
+        constexpr std::size_t MIN_CHUNK = 4096;
+    }
+
+    MovementSystem::MovementSystem(World &world) : query_(world.query<Transform, Velocity>())
+    {
+    }
+
+    SystemAccess MovementSystem::getAccess() const
+    {
+        return SystemAccess().read<Velocity>().write<Transform>();
+    }
+
+    void MovementSystem::update(const SystemContext &context)
+    {
+        float delta_time = context.delta_time;
+        parallelForEachChunk(query_, context.jobs, MIN_CHUNK, [delta_time](Archetype &archetype, std::size_t begin, std::size_t end)
+                             {
+                                 auto transforms = archetype.column<Transform>();
+                                 auto velocities = archetype.column<Velocity>();
+                                 for (std::size_t i = begin; i < end; ++i)
+                                 {
+                                     transforms[i].position += velocities[i].value * delta_time;
+                                 } });
+    }
+} // namespace engine::ecs
@@ -0,0 +1,21 @@
+#pragma once
+#include "system.h"
+
+namespace engine::ecs
+{
+    class Query;
+
+    /// @brief Moves every entity with a Transform by its Velocity.
+    class MovementSystem final : public System
+    {
+    private:
+        Query &query_;
+
+    public:
+        explicit MovementSystem(World &world);
+
+        std::string_view getName() const override { return "MovementSystem"; }
+        SystemAccess getAccess() const override;
+        void update(const SystemContext &context) override;
+    };
+} // namespace engine::ecs
@@ -0,0 +1,41 @@
+#pragma once
+#include "query.h"
+#include "../core/job_system.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace engine::ecs
+{
+    /// @brief Calls func(Archetype&, begin_row, end_row) over every row of the query, with the rows of all
+    /// matching archetypes split into chunks of at least min_chunk rows that run on the job system.
+    /// Chunks never overlap, so func may write the components of its rows.
+    template <typename Func>
+    void parallelForEachChunk(const Query &query, engine::core::JobSystem &jobs, std::size_t min_chunk, Func &&func)
+    {
+        // First global row of each archetype
+        std::vector<std::pair<Archetype *, std::size_t>> ranges;
+        ranges.reserve(query.getArchetypes().size());
+        std::size_t total = 0;
+        query.forEachArchetype([&](Archetype &archetype)
+                               {
+                                   ranges.emplace_back(&archetype, total);
+                                   total += archetype.size(); });
+
+        jobs.parallelFor(total, min_chunk, [&](std::size_t begin, std::size_t end)
+                         {
+                             for (const auto &[archetype, start] : ranges)
+                             {
+                                 std::size_t archetype_end = start + archetype->size();
+                                 if (archetype_end <= begin)
+                                 {
+                                     continue;
+                                 }
+                                 if (start >= end)
+                                 {
+                                     break;
+                                 }
+                                 func(*archetype, std::max(begin, start) - start, std::min(end, archetype_end) - start);
+                             } });
+    }
+} // namespace engine::ecs
@@ -0,0 +1,98 @@
+#pragma once
+#include "archetype.h"
+#include <cassert>
+#include <tuple>
+#include <vector>
+
+namespace engine::ecs
+{
+    /// @brief Cached list of the archetypes that have all included and none of the excluded components.
+    /// Owned by the World, which adds new matching archetypes as they are created, so a
+    /// reference to a query stays valid and up to date for the lifetime of the World.
+    class Query final
+    {
+        friend class World;
+
+    private:
+        ComponentMask include_;
+        ComponentMask exclude_;
+        std::vector<Archetype *> archetypes_;
+
+        bool matches(const Archetype &archetype) const
+        {
+            return (archetype.getMask() & include_) == include_ && (archetype.getMask() & exclude_) == 0;
+        }
+
+    public:
+        Query(ComponentMask include, ComponentMask exclude) : include_(include), exclude_(exclude) {}
+
+        Query(const Query &) = delete;
+        Query &operator=(const Query &) = delete;
+        Query(Query &&) = delete;
+        Query &operator=(Query &&) = delete;
+
+        ComponentMask getInclude() const { return include_; }
+        ComponentMask getExclude() const { return exclude_; }
+        const std::vector<Archetype *> &getArchetypes() const { return archetypes_; }
+
+        /// @brief Number of matching entities.
+        std::size_t count() const
+        {
+            std::size_t total = 0;
+            for (const Archetype *archetype : archetypes_)
+            {
+                total += archetype->size();
+            }
+            return total;
+        }
+
+        /// @brief Calls func(Archetype&) for every non-empty matching archetype, for systems that work on whole columns.
+        template <typename Func>
+        void forEachArchetype(Func &&func) const
+        {
+            for (Archetype *archetype : archetypes_)
+            {
+                if (!archetype->empty())
+                {
+                    func(*archetype);
+                }
+            }
+        }
+
+        /// @brief Calls func(Ts&...) for every matching entity. Ts must be included in the query.
+        /// Structural changes are not allowed while iterating; use the World's CommandBuffer instead.
+        template <Component... Ts, typename Func>
+        void each(Func &&func) const
+        {
+            assert((componentMask<Ts...>() & ~include_) == 0 && "Query::each with a component the query does not include");
+            for (Archetype *archetype : archetypes_)
+            {
+                std::size_t size = archetype->size();
+                auto columns = std::make_tuple(archetype->column<Ts>().data()...);
+                for (std::size_t row = 0; row < size; ++row)
+                {
+                    std::apply([&](auto *...column)
+                               { func(column[row]...); }, columns);
+                }
+            }
+        }
+
+        /// @brief Like each(), but also passes the entity: func(Entity, Ts&...).
+        template <Component... Ts, typename Func>
+        void eachWithEntity(Func &&func) const
+        {
+            assert((componentMask<Ts...>() & ~include_) == 0 && "Query::eachWithEntity with a component the query does not include");
+            for (Archetype *archetype : archetypes_)
+            {
+                std::size_t size = archetype->size();
+                const Entity *entities = archetype->getEntities().data();
+                auto columns = std::make_tuple(archetype->column<Ts>().data()...);
+                for (std::size_t row = 0; row < size; ++row)
+                {
+                    std::apply([&](auto *...column)
+                               { func(entities[row], column[row]...); }, columns);
+                }
+            }
+        }
+    };
+} // namespace engine::ecs
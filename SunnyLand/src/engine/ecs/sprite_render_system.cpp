@@ -0,0 +1,44 @@
+#include "sprite_render_system.h"
+#include "world.h"
+#include "components.h"
+#include "../render/render_snapshot.h"
+
+namespace engine::ecs
+{
+    SpriteRenderSystem::SpriteRenderSystem(World &world) : query_(world.query<Transform, SpriteComponent>())
+    {
+    }
+
+    void SpriteRenderSystem::extract(engine::render::RenderSnapshot &snapshot) const
+    {
+        const engine::render::Camera &camera = snapshot.getCamera();
+        glm::vec2 view_min = camera.getPosition();
+        glm::vec2 view_max = view_min + camera.getViewportSize();
+
+        std::vector<engine::render::SpriteInstance> &instances = snapshot.getSpriteInstances();
+        instances.reserve(instances.size() + query_.count());
+        query_.forEachArchetype([&](Archetype &archetype)
+                                {
+                                    auto transforms = archetype.column<Transform>();
+                                    auto sprites = archetype.column<SpriteComponent>();
+                                    for (std::size_t i = 0; i < transforms.size(); ++i)
+                                    {
+                                        const Transform &transform = transforms[i];
+                                        const SpriteComponent &sprite = sprites[i];
+                                        if (sprite.texture_id == engine::utils::EMPTY_STRING_ID)
+                                        {
+                                            continue;
+                                        }
+                                        // Sprites with a known size are culled here, so they never reach the render thread
+                                        glm::vec2 size = glm::vec2(sprite.source_rect.w, sprite.source_rect.h) * transform.scale;
+                                        if (size.x > 0.0f && size.y > 0.0f &&
+                                            (transform.position.x + size.x < view_min.x || transform.position.x > view_max.x ||
+                                             transform.position.y + size.y < view_min.y || transform.position.y > view_max.y))
+                                        {
+                                            continue;
+                                        }
+                                        instances.push_back({sprite.texture_id, sprite.source_rect, transform.position,
+                                                             transform.scale, transform.rotation, sprite.is_flipped});
+                                    } });
+    }
+} // namespace engine::ecs
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace engine::render
+{
+    class RenderSnapshot;
+}
+
+namespace engine::ecs
+{
+    class World;
+    class Query;
+
+    /// @brief Copies the Transform and SpriteComponent columns of all visible entities into a snapshot.
+    /// Runs on the simulation side; the Renderer then draws the packed instances without touching the World.
+    class SpriteRenderSystem final
+    {
+    private:
+        Query &query_;
+
+    public:
+        explicit SpriteRenderSystem(World &world);
+
+        void extract(engine::render::RenderSnapshot &snapshot) const;
+    };
+} // namespace engine::ecs
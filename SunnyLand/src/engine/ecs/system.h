@@ -0,0 +1,70 @@
+#pragma once
+#include "component.h"
+#include <string_view>
+
+namespace engine::core
+{
+    class JobSystem;
+}
+
+namespace engine::ecs
+{
+    class World;
+    class CommandBuffer;
+
+    /// @brief Components a system reads and writes. Systems whose accesses do not conflict may run at the same time.
+    struct SystemAccess
+    {
+        ComponentMask reads = 0;
+        ComponentMask writes = 0;
+        /// @brief The system touches state besides its declared components, so it runs alone.
+        bool exclusive = false;
+
+        template <Component... Ts>
+        SystemAccess &read()
+        {
+            reads |= componentMask<Ts...>();
+            return *this;
+        }
+
+        template <Component... Ts>
+        SystemAccess &write()
+        {
+            writes |= componentMask<Ts...>();
+            return *this;
+        }
+
+        bool conflictsWith(const SystemAccess &other) const
+        {
+            return exclusive || other.exclusive ||
+                   (writes & (other.reads | other.writes)) != 0 ||
+                   (other.writes & reads) != 0;
+        }
+    };
+
+    /// @brief What a system gets to work with during one update.
+    struct SystemContext
+    {
+        World &world;
+        /// @brief The system's own deferred changes. All buffers are flushed in registration order
+        /// after every system ran, so entities created here are visible from the next tick on.
+        CommandBuffer &commands;
+        /// @brief For splitting large queries with parallelForEachChunk().
+        engine::core::JobSystem &jobs;
+        float delta_time;
+    };
+
+    /// @brief Logic that runs once per tick over the components of a World.
+    /// Systems may run concurrently with others, so they must only touch the components declared in
+    /// getAccess(), must not change archetypes directly, and must get their queries in the constructor.
+    class System
+    {
+    public:
+        virtual ~System() = default;
+
+        virtual std::string_view getName() const = 0;
+        /// @brief Declared component access. Systems that do not declare one run alone.
+        virtual SystemAccess getAccess() const { return {0, 0, true}; }
+        virtual void update(const SystemContext &context) = 0;
+    };
+} // namespace engine::ecs
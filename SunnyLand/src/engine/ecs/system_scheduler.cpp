@@ -0,0 +1,190 @@
+#include "system_scheduler.h"
+#include "world.h"
+#include "../core/job_system.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+
+namespace engine::ecs
+{
+    namespace
+    {
+        std::string describeMask(ComponentMask mask)
+        {
+            std::string names;
+            for (; mask != 0; mask &= mask - 1)
+            {
+                if (!names.empty())
+                {
+                    names += ", ";
+                }
+                names += ComponentRegistry::info(static_cast<ComponentTypeId>(std::countr_zero(mask))).name;
+            }
+            return names.empty() ? "-" : names;
+        }
+    }
+
+    SystemScheduler::SystemScheduler(engine::core::JobSystem &jobs) : jobs_(jobs)
+    {
+        spdlog::trace("SystemScheduler created");
+    }
+
+    System &SystemScheduler::addSystem(std::unique_ptr<System> system)
+    {
+        auto entry = std::make_unique<Entry>();
+        entry->system = std::move(system);
+        spdlog::debug("Registered system '{}'", entry->system->getName());
+        return *entries_.emplace_back(std::move(entry))->system;
+    }
+
+    void SystemScheduler::setEnabled(std::string_view name, bool enabled)
+    {
+        for (auto &entry : entries_)
+        {
+            if (entry->system->getName() == name)
+            {
+                entry->enabled = enabled;
+                return;
+            }
+        }
+        spdlog::warn("Cannot {} unknown system '{}'", enabled ? "enable" : "disable", name);
+    }
+
+    void SystemScheduler::buildGraph()
+    {
+        for (std::size_t i = 0; i < entries_.size(); ++i)
+        {
+            Entry &entry = *entries_[i];
+            entry.dependencies.clear();
+            entry.dependents.clear();
+            entry.stage = 0;
+            if (!entry.enabled)
+            {
+                continue;
+            }
+
+            entry.access = entry.system->getAccess();
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                Entry &earlier = *entries_[j];
+                if (earlier.enabled && earlier.access.conflictsWith(entry.access))
+                {
+                    entry.dependencies.push_back(j);
+                    earlier.dependents.push_back(i);
+                    entry.stage = std::max(entry.stage, earlier.stage + 1);
+                }
+            }
+            entry.remaining_dependencies.store(entry.dependencies.size(), std::memory_order_relaxed);
+        }
+    }
+
+    void SystemScheduler::run(World &world, float delta_time)
+    {
+        buildGraph();
+
+        if (!parallel_ || jobs_.getThreadCount() == 1)
+        {
+            for (auto &entry : entries_)
+            {
+                if (entry->enabled)
+                {
+                    runSystem(*entry, world, delta_time);
+                }
+            }
+        }
+        else
+        {
+            engine::core::JobGroup group;
+            for (std::size_t i = 0; i < entries_.size(); ++i)
+            {
+                if (entries_[i]->enabled && entries_[i]->dependencies.empty())
+                {
+                    submitSystem(i, world, delta_time, group);
+                }
+            }
+            jobs_.wait(group);
+        }
+
+        for (auto &entry : entries_)
+        {
+            entry->commands.flush(world);
+        }
+    }
+
+    void SystemScheduler::submitSystem(std::size_t index, World &world, float delta_time, engine::core::JobGroup &group)
+    {
+        jobs_.submit([this, index, &world, delta_time, &group]
+                     {
+                         Entry &entry = *entries_[index];
+                         runSystem(entry, world, delta_time);
+                         for (std::size_t dependent : entry.dependents)
+                         {
+                             if (entries_[dependent]->remaining_dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                             {
+                                 submitSystem(dependent, world, delta_time, group);
+                             }
+                         } },
+                     group);
+    }
+
+    void SystemScheduler::runSystem(Entry &entry, World &world, float delta_time)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        entry.system->update({world, entry.commands, jobs_, delta_time});
+        entry.last_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        entry.stats.addSample(entry.last_ms);
+    }
+
+    std::string SystemScheduler::describeSchedule() const
+    {
+        std::size_t stage_count = 0;
+        for (const auto &entry : entries_)
+        {
+            if (entry->enabled)
+            {
+                stage_count = std::max(stage_count, entry->stage + 1);
+            }
+        }
+
+        std::string text = fmt::format("System schedule: {} systems in {} stages on {} threads", entries_.size(), stage_count, jobs_.getThreadCount());
+        for (std::size_t stage = 0; stage < stage_count; ++stage)
+        {
+            text += fmt::format("\n  stage {}:", stage);
+            for (const auto &entry : entries_)
+            {
+                if (!entry->enabled || entry->stage != stage)
+                {
+                    continue;
+                }
+                std::string after;
+                for (std::size_t dependency : entry->dependencies)
+                {
+                    after += after.empty() ? "" : ", ";
+                    after += entries_[dependency]->system->getName();
+                }
+                text += fmt::format("\n    {:<24} {:>8.3f} ms  {}reads [{}] writes [{}] after [{}]",
+                                    entry->system->getName(), entry->last_ms, entry->access.exclusive ? "exclusive " : "",
+                                    describeMask(entry->access.reads), describeMask(entry->access.writes), after);
+            }
+        }
+        for (const auto &entry : entries_)
+        {
+            if (!entry->enabled)
+            {
+                text += fmt::format("\n  disabled: {}", entry->system->getName());
+            }
+        }
+        return text;
+    }
+
+    void SystemScheduler::logTimings() const
+    {
+        for (const auto &entry : entries_)
+        {
+            std::string title = fmt::format("System {}", entry->system->getName());
+            entry->stats.logSummary(title.c_str());
+        }
+    }
+} // namespace engine::ecs
@@ -0,0 +1,76 @@
+#pragma once
+#include "system.h"
+#include "command_buffer.h"
+#include "../core/frame_stats.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::core
+{
+    class JobGroup;
+}
+
+namespace engine::ecs
+{
+    /// @brief Runs systems in parallel where their declared accesses allow it.
+    /// Every tick the enabled systems form a dependency graph: a system depends on each earlier-registered
+    /// system it conflicts with, so the result is the same as running them serially in registration order.
+    /// Systems without pending dependencies run as jobs on the JobSystem; command buffers are flushed
+    /// afterwards in registration order, which keeps structural changes deterministic.
+    class SystemScheduler final
+    {
+    private:
+        struct Entry
+        {
+            std::unique_ptr<System> system;
+            CommandBuffer commands;
+            bool enabled = true;
+
+            // Rebuilt every tick by buildGraph()
+            SystemAccess access;
+            std::vector<std::size_t> dependencies;
+            std::vector<std::size_t> dependents;
+            std::atomic<std::size_t> remaining_dependencies = 0;
+            std::size_t stage = 0;
+
+            double last_ms = 0.0;
+            engine::core::FrameStats stats;
+        };
+
+        engine::core::JobSystem &jobs_;
+        std::vector<std::unique_ptr<Entry>> entries_;
+        bool parallel_ = true;
+
+        void buildGraph();
+        void runSystem(Entry &entry, World &world, float delta_time);
+        void submitSystem(std::size_t index, World &world, float delta_time, engine::core::JobGroup &group);
+
+    public:
+        explicit SystemScheduler(engine::core::JobSystem &jobs);
+
+        SystemScheduler(const SystemScheduler &) = delete;
+        SystemScheduler &operator=(const SystemScheduler &) = delete;
+        SystemScheduler(SystemScheduler &&) = delete;
+        SystemScheduler &operator=(SystemScheduler &&) = delete;
+
+        System &addSystem(std::unique_ptr<System> system);
+
+        /// @brief Disabled systems are left out of the graph until enabled again.
+        void setEnabled(std::string_view name, bool enabled);
+        /// @brief Runs every system on the calling thread, in registration order. For debugging races.
+        void setParallel(bool parallel) { parallel_ = parallel; }
+
+        /// @brief Runs all enabled systems once, then flushes their command buffers.
+        void run(World &world, float delta_time);
+
+        std::size_t getSystemCount() const { return entries_.size(); }
+
+        /// @brief Human-readable schedule of the last tick: stages, accesses, dependencies and timings.
+        std::string describeSchedule() const;
+        /// @brief Logs the timing summary of every system at info level.
+        void logTimings() const;
+    };
+} // namespace engine::ecs
@@ -0,0 +1,213 @@
+#include "world.h"
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace engine::ecs
+{
+    World::World()
+    {
+        getOrCreateArchetype(0);
+        spdlog::trace("World created");
+    }
+
+    World::~World() = default;
+
+    Archetype &World::getOrCreateArchetype(ComponentMask mask)
+    {
+        auto it = archetype_by_mask_.find(mask);
+        if (it != archetype_by_mask_.end())
+        {
+            return *it->second;
+        }
+
+        Archetype &archetype = *archetypes_.emplace_back(std::make_unique<Archetype>(mask));
+        archetype_by_mask_.emplace(mask, &archetype);
+        for (auto &[key, query] : queries_)
+        {
+            if (query->matches(archetype))
+            {
+                query->archetypes_.push_back(&archetype);
+            }
+        }
+        spdlog::trace("Created archetype {:016x} ({} archetypes)", mask, archetypes_.size());
+        return archetype;
+    }
+
+    const World::EntityRecord *World::findRecord(Entity entity) const
+    {
+        if (entity.index >= records_.size())
+        {
+            return nullptr;
+        }
+        const EntityRecord &record = records_[entity.index];
+        if (record.generation != entity.generation || record.archetype == nullptr)
+        {
+            return nullptr;
+        }
+        return &record;
+    }
+
+    Entity World::createEntityWithMask(ComponentMask mask)
+    {
+        std::uint32_t index;
+        if (!free_indices_.empty())
+        {
+            index = free_indices_.back();
+            free_indices_.pop_back();
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>(records_.size());
+            records_.emplace_back();
+        }
+
+        Archetype &archetype = getOrCreateArchetype(mask);
+        EntityRecord &record = records_[index];
+        Entity entity{index, record.generation};
+        record.archetype = &archetype;
+        record.row = static_cast<std::uint32_t>(archetype.pushRow(entity));
+        ++entity_count_;
+        return entity;
+    }
+
+    bool World::destroyEntity(Entity entity)
+    {
+        if (!isAlive(entity))
+        {
+            spdlog::warn("Trying to destroy an entity that is not alive: {}:{}", entity.index, entity.generation);
+            return false;
+        }
+
+        EntityRecord &record = records_[entity.index];
+        removeRow(*record.archetype, record.row);
+        record.archetype = nullptr;
+        ++record.generation;
+        free_indices_.push_back(entity.index);
+        --entity_count_;
+        return true;
+    }
+
+    void World::removeRow(Archetype &archetype, std::uint32_t row)
+    {
+        Entity moved = archetype.swapRemoveRow(row);
+        if (moved.isValid())
+        {
+            records_[moved.index].row = row;
+        }
+    }
+
+    void World::moveEntity(EntityRecord &record, Archetype &target)
+    {
+        Archetype &source = *record.archetype;
+        std::uint32_t source_row = record.row;
+        auto target_row = static_cast<std::uint32_t>(source.moveRowTo(source_row, target));
+        removeRow(source, source_row);
+        record.archetype = &target;
+        record.row = target_row;
+    }
+
+    void *World::addComponent(Entity entity, ComponentTypeId type_id, const void *data)
+    {
+        if (!isAlive(entity))
+        {
+            spdlog::warn("Trying to add component '{}' to an entity that is not alive", ComponentRegistry::info(type_id).name);
+            return nullptr;
+        }
+
+        EntityRecord &record = records_[entity.index];
+        if (!record.archetype->hasComponent(type_id))
+        {
+            Archetype &source = *record.archetype;
+            auto edge = source.add_edges_.find(type_id);
+            Archetype *target = edge != source.add_edges_.end()
+                                    ? edge->second
+                                    : source.add_edges_[type_id] = &getOrCreateArchetype(source.getMask() | (ComponentMask(1) << type_id));
+            moveEntity(record, *target);
+        }
+
+        void *component = record.archetype->getComponent(record.row, type_id);
+        std::memcpy(component, data, ComponentRegistry::info(type_id).size);
+        return component;
+    }
+
+    bool World::removeComponent(Entity entity, ComponentTypeId type_id)
+    {
+        if (!isAlive(entity))
+        {
+            spdlog::warn("Trying to remove component '{}' from an entity that is not alive", ComponentRegistry::info(type_id).name);
+            return false;
+        }
+
+        EntityRecord &record = records_[entity.index];
+        Archetype &source = *record.archetype;
+        if (!source.hasComponent(type_id))
+        {
+            return false;
+        }
+
+        auto edge = source.remove_edges_.find(type_id);
+        Archetype *target = edge != source.remove_edges_.end()
+                                ? edge->second
+                                : source.remove_edges_[type_id] = &getOrCreateArchetype(source.getMask() & ~(ComponentMask(1) << type_id));
+        moveEntity(record, *target);
+        return true;
+    }
+
+    void *World::getComponent(Entity entity, ComponentTypeId type_id)
+    {
+        return const_cast<void *>(std::as_const(*this).getComponent(entity, type_id));
+    }
+
+    const void *World::getComponent(Entity entity, ComponentTypeId type_id) const
+    {
+        const EntityRecord *record = findRecord(entity);
+        if (!record || !record->archetype->hasComponent(type_id))
+        {
+            return nullptr;
+        }
+        return record->archetype->getComponent(record->row, type_id);
+    }
+
+    ComponentMask World::getMask(Entity entity) const
+    {
+        const EntityRecord *record = findRecord(entity);
+        return record ? record->archetype->getMask() : 0;
+    }
+
+    Query &World::query(ComponentMask include, ComponentMask exclude)
+    {
+        auto &query = queries_[{include, exclude}];
+        if (!query)
+        {
+            query = std::make_unique<Query>(include, exclude);
+            for (const auto &archetype : archetypes_)
+            {
+                if (query->matches(*archetype))
+                {
+                    query->archetypes_.push_back(archetype.get());
+                }
+            }
+        }
+        return *query;
+    }
+
+    void World::clear()
+    {
+        for (std::uint32_t index = 0; index < records_.size(); ++index)
+        {
+            EntityRecord &record = records_[index];
+            if (record.archetype)
+            {
+                record.archetype = nullptr;
+                ++record.generation;
+                free_indices_.push_back(index);
+            }
+        }
+        for (auto &archetype : archetypes_)
+        {
+            archetype->clear();
+        }
+        command_buffer_.clear();
+        entity_count_ = 0;
+    }
+} // namespace engine::ecs
@@ -0,0 +1,136 @@
+#pragma once
+#include "entity.h"
+#include "component.h"
+#include "archetype.h"
+#include "query.h"
+#include "command_buffer.h"
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine::save
+{
+    class WorldSerializer;
+}
+
+namespace engine::ecs
+{
+    /// @brief Owns all entities and their components, grouped into archetype tables.
+    /// Not thread-safe: structural changes must happen on one thread, or be recorded in a
+    /// CommandBuffer and flushed there.
+    class World final
+    {
+        /// @brief Restores entity records and archetype rows in bulk.
+        friend class engine::save::WorldSerializer;
+
+    private:
+        struct EntityRecord
+        {
+            Archetype *archetype = nullptr;
+            std::uint32_t row = 0;
+            std::uint32_t generation = 0;
+        };
+
+        std::vector<EntityRecord> records_;
+        std::vector<std::uint32_t> free_indices_;
+        std::size_t entity_count_ = 0;
+
+        std::vector<std::unique_ptr<Archetype>> archetypes_;
+        std::unordered_map<ComponentMask, Archetype *> archetype_by_mask_;
+        std::map<std::pair<ComponentMask, ComponentMask>, std::unique_ptr<Query>> queries_;
+
+        CommandBuffer command_buffer_;
+
+        Archetype &getOrCreateArchetype(ComponentMask mask);
+        /// @brief Moves an entity's row to target, keeping the components both archetypes share.
+        void moveEntity(EntityRecord &record, Archetype &target);
+        /// @brief Removes a row and fixes the record of the entity that was moved into it.
+        void removeRow(Archetype &archetype, std::uint32_t row);
+        const EntityRecord *findRecord(Entity entity) const;
+
+    public:
+        World();
+        ~World();
+
+        World(const World &) = delete;
+        World &operator=(const World &) = delete;
+        World(World &&) = delete;
+        World &operator=(World &&) = delete;
+
+        /// @brief Creates an entity with the given components, all zero-filled.
+        Entity createEntityWithMask(ComponentMask mask);
+
+        template <Component... Ts>
+        Entity createEntity(const Ts &...components)
+        {
+            Entity entity = createEntityWithMask(componentMask<Ts...>());
+            (setComponent(entity, components), ...);
+            return entity;
+        }
+
+        /// @brief Destroys an entity. Returns false if it was not alive.
+        bool destroyEntity(Entity entity);
+        bool isAlive(Entity entity) const { return findRecord(entity) != nullptr; }
+
+        /// @brief Adds a component, or overwrites it if the entity already has one.
+        template <Component T>
+        T *addComponent(Entity entity, const T &component = {})
+        {
+            return static_cast<T *>(addComponent(entity, ComponentRegistry::id<T>(), &component));
+        }
+
+        template <Component T>
+        bool removeComponent(Entity entity) { return removeComponent(entity, ComponentRegistry::id<T>()); }
+
+        /// @brief Returns nullptr if the entity is dead or does not have the component.
+        template <Component T>
+        T *getComponent(Entity entity) { return static_cast<T *>(getComponent(entity, ComponentRegistry::id<T>())); }
+        template <Component T>
+        const T *getComponent(Entity entity) const { return static_cast<const T *>(getComponent(entity, ComponentRegistry::id<T>())); }
+
+        template <Component T>
+        bool hasComponent(Entity entity) const { return getComponent<T>(entity) != nullptr; }
+
+        /// @brief Overwrites a component the entity already has. Returns false otherwise.
+        template <Component T>
+        bool setComponent(Entity entity, const T &component)
+        {
+            T *existing = getComponent<T>(entity);
+            if (!existing)
+            {
+                return false;
+            }
+            *existing = component;
+            return true;
+        }
+
+        // Type-erased versions, for command buffers and serialization
+        void *addComponent(Entity entity, ComponentTypeId type_id, const void *data);
+        bool removeComponent(Entity entity, ComponentTypeId type_id);
+        void *getComponent(Entity entity, ComponentTypeId type_id);
+        const void *getComponent(Entity entity, ComponentTypeId type_id) const;
+        /// @brief Components of a live entity, 0 otherwise.
+        ComponentMask getMask(Entity entity) const;
+
+        /// @brief Returns the cached query for these components. The reference stays valid for the World's lifetime.
+        template <Component... Ts>
+        Query &query(ComponentMask exclude = 0) { return query(componentMask<Ts...>(), exclude); }
+        Query &query(ComponentMask include, ComponentMask exclude = 0);
+
+        /// @brief Deferred structural changes, applied by flushCommands().
+        CommandBuffer &getCommandBuffer() { return command_buffer_; }
+        void flushCommands() { command_buffer_.flush(*this); }
+
+        /// @brief Pre-allocates rows of the archetype with exactly these components.
+        template <Component... Ts>
+        void reserve(std::size_t rows) { getOrCreateArchetype(componentMask<Ts...>()).reserve(rows); }
+
+        /// @brief Destroys all entities. Archetypes and queries are kept.
+        void clear();
+
+        std::size_t getEntityCount() const { return entity_count_; }
+        const std::vector<std::unique_ptr<Archetype>> &getArchetypes() const { return archetypes_; }
+    };
+} // namespace engine::ecs
@@ -0,0 +1,122 @@
+#include "input_recorder.h"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <cstring>
+
+namespace engine::input
+{
+    InputRecorder::InputRecorder(const std::string &file_path, std::uint64_t seed, double fixed_step)
+        : file_path_(file_path), file_(file_path, std::ios::binary | std::ios::trunc)
+    {
+        if (!file_)
+        {
+            throw std::runtime_error("Failed to open input recording file: " + file_path);
+        }
+        header_.seed = seed;
+        header_.fixed_step = fixed_step;
+        // The tick count is patched in finish()
+        file_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+        spdlog::info("Recording input to {} (seed {})", file_path_, seed);
+    }
+
+    InputRecorder::~InputRecorder()
+    {
+        finish();
+    }
+
+    void InputRecorder::record(const InputState &input)
+    {
+        if (finished_)
+        {
+            return;
+        }
+
+        if (header_.tick_count == 0 || input != last_input_)
+        {
+            std::uint64_t tick = header_.tick_count;
+            file_.write(reinterpret_cast<const char *>(&tick), sizeof(tick));
+            file_.write(reinterpret_cast<const char *>(input.getKeyBits().data()), InputState::KEY_BYTES);
+            float mouse_x = input.getMouseX();
+            float mouse_y = input.getMouseY();
+            Uint32 mouse_buttons = input.getMouseButtons();
+            file_.write(reinterpret_cast<const char *>(&mouse_x), sizeof(mouse_x));
+            file_.write(reinterpret_cast<const char *>(&mouse_y), sizeof(mouse_y));
+            file_.write(reinterpret_cast<const char *>(&mouse_buttons), sizeof(mouse_buttons));
+            last_input_ = input;
+        }
+        ++header_.tick_count;
+    }
+
+    void InputRecorder::finish()
+    {
+        if (finished_)
+        {
+            return;
+        }
+        finished_ = true;
+
+        file_.seekp(0);
+        file_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+        file_.close();
+        if (!file_)
+        {
+            spdlog::error("Failed to write input recording: {}", file_path_);
+            return;
+        }
+        spdlog::info("Input recording saved: {} ({} ticks)", file_path_, header_.tick_count);
+    }
+
+    InputPlayer::InputPlayer(const std::string &file_path)
+    {
+        std::ifstream file(file_path, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Failed to open input recording file: " + file_path);
+        }
+
+        RecordingHeader expected;
+        file.read(reinterpret_cast<char *>(&header_), sizeof(header_));
+        if (!file || std::memcmp(header_.magic, expected.magic, sizeof(expected.magic)) != 0)
+        {
+            throw std::runtime_error("Not an input recording file: " + file_path);
+        }
+        if (header_.version != 1 && header_.version != expected.version)
+        {
+            throw std::runtime_error("Unsupported input recording version " + std::to_string(header_.version) + ": " + file_path);
+        }
+        if (header_.fixed_step <= 0.0)
+        {
+            throw std::runtime_error("Invalid fixed step in input recording: " + file_path);
+        }
+
+        const bool has_mouse = header_.version >= 2;
+        Entry entry;
+        while (file.read(reinterpret_cast<char *>(&entry.tick), sizeof(entry.tick)) &&
+               file.read(reinterpret_cast<char *>(entry.keys.data()), InputState::KEY_BYTES))
+        {
+            if (has_mouse && !(file.read(reinterpret_cast<char *>(&entry.mouse_x), sizeof(entry.mouse_x)) &&
+                               file.read(reinterpret_cast<char *>(&entry.mouse_y), sizeof(entry.mouse_y)) &&
+                               file.read(reinterpret_cast<char *>(&entry.mouse_buttons), sizeof(entry.mouse_buttons))))
+            {
+                break;
+            }
+            entries_.push_back(entry);
+        }
+
+        spdlog::info("Loaded input recording {}: {} ticks, {} input changes, seed {}",
+                     file_path, header_.tick_count, entries_.size(), header_.seed);
+    }
+
+    const InputState &InputPlayer::next()
+    {
+        if (next_entry_ < entries_.size() && entries_[next_entry_].tick == current_tick_)
+        {
+            const Entry &entry = entries_[next_entry_];
+            current_input_.setKeyBits(entry.keys);
+            current_input_.setMouse(entry.mouse_x, entry.mouse_y, entry.mouse_buttons);
+            ++next_entry_;
+        }
+        ++current_tick_;
+        return current_input_;
+    }
+} // namespace engine::input
@@ -0,0 +1,86 @@
+#pragma once
+#include "input_state.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+namespace engine::input
+{
+    /// @brief Header of an input recording file.
+    /// The file is followed by (tick, key bits, mouse x, mouse y, mouse buttons) entries, written only for ticks whose
+    /// input changed. Version 1 files have no mouse fields.
+    struct RecordingHeader
+    {
+        char magic[4] = {'S', 'L', 'I', 'R'};
+        std::uint32_t version = 2;
+        std::uint64_t seed = 0;
+        double fixed_step = 0.0;
+        std::uint64_t tick_count = 0;
+    };
+
+    /// @brief Writes the per-tick input stream of a session to a file.
+    class InputRecorder final
+    {
+    private:
+        std::string file_path_;
+        std::ofstream file_;
+        RecordingHeader header_;
+        InputState last_input_;
+        bool finished_ = false;
+
+    public:
+        InputRecorder(const std::string &file_path, std::uint64_t seed, double fixed_step);
+        ~InputRecorder();
+
+        InputRecorder(const InputRecorder &) = delete;
+        InputRecorder &operator=(const InputRecorder &) = delete;
+        InputRecorder(InputRecorder &&) = delete;
+        InputRecorder &operator=(InputRecorder &&) = delete;
+
+        /// @brief Records the input of the next tick.
+        void record(const InputState &input);
+
+        /// @brief Writes the final tick count and closes the file.
+        void finish();
+
+        std::uint64_t getTickCount() const { return header_.tick_count; }
+    };
+
+    /// @brief Reads a recording and hands back the input of each tick in order.
+    class InputPlayer final
+    {
+    private:
+        struct Entry
+        {
+            std::uint64_t tick;
+            InputState::KeyBits keys;
+            float mouse_x = 0.0f;
+            float mouse_y = 0.0f;
+            Uint32 mouse_buttons = 0;
+        };
+
+        RecordingHeader header_;
+        std::vector<Entry> entries_;
+        std::size_t next_entry_ = 0;
+        std::uint64_t current_tick_ = 0;
+        InputState current_input_;
+
+    public:
+        explicit InputPlayer(const std::string &file_path);
+
+        InputPlayer(const InputPlayer &) = delete;
+        InputPlayer &operator=(const InputPlayer &) = delete;
+        InputPlayer(InputPlayer &&) = delete;
+        InputPlayer &operator=(InputPlayer &&) = delete;
+
+        /// @brief Returns the input of the next tick. Must not be called once finished.
+        const InputState &next();
+
+        bool isFinished() const { return current_tick_ >= header_.tick_count; }
+        std::uint64_t getSeed() const { return header_.seed; }
+        double getFixedStep() const { return header_.fixed_step; }
+        std::uint64_t getTickCount() const { return header_.tick_count; }
+        std::uint64_t getCurrentTick() const { return current_tick_; }
+    };
+} // namespace engine::input
@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <SDL3/SDL_keyboard.h>
+#include <SDL3/SDL_mouse.h>
+#include <SDL3/SDL_scancode.h>
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::input
+{
+    /// @brief Snapshot of the input of one simulation tick.
+    /// The game reads input only through this type so that ticks can be recorded and replayed.
+    class InputState final
+    {
+    public:
+        static constexpr std::size_t KEY_BYTES = SDL_SCANCODE_COUNT / 8;
+        using KeyBits = std::array<Uint8, KEY_BYTES>;
+
+    private:
+        KeyBits keys_{};
+        /// @brief Cursor position in window coordinates, and SDL_BUTTON_MASK bits of the held buttons.
+        float mouse_x_ = 0.0f;
+        float mouse_y_ = 0.0f;
+        Uint32 mouse_buttons_ = 0;
+
+    public:
+        /// @brief Captures the current keyboard state from SDL.
+        static InputState fromKeyboard()
+        {
+            InputState state;
+            int num_keys = 0;
+            const bool *key_state = SDL_GetKeyboardState(&num_keys);
+            for (int i = 0; i < num_keys && i < SDL_SCANCODE_COUNT; ++i)
+            {
+                if (key_state[i])
+                {
+                    state.keys_[i >> 3] |= static_cast<Uint8>(1u << (i & 7));
+                }
+            }
+            return state;
+        }
+
+        /// @brief Captures the current keyboard and mouse state from SDL.
+        static InputState fromDevices()
+        {
+            InputState state = fromKeyboard();
+            state.mouse_buttons_ = SDL_GetMouseState(&state.mouse_x_, &state.mouse_y_);
+            return state;
+        }
+
+        bool isKeyDown(SDL_Scancode key) const
+        {
+            return (keys_[key >> 3] >> (key & 7)) & 1u;
+        }
+
+        void setKey(SDL_Scancode key, bool down)
+        {
+            Uint8 mask = static_cast<Uint8>(1u << (key & 7));
+            keys_[key >> 3] = down ? (keys_[key >> 3] | mask) : (keys_[key >> 3] & ~mask);
+        }
+
+        const KeyBits &getKeyBits() const { return keys_; }
+        void setKeyBits(const KeyBits &bits) { keys_ = bits; }
+
+        float getMouseX() const { return mouse_x_; }
+        float getMouseY() const { return mouse_y_; }
+        Uint32 getMouseButtons() const { return mouse_buttons_; }
+        /// @brief button is SDL_BUTTON_LEFT, SDL_BUTTON_RIGHT...
+        bool isMouseButtonDown(int button) const { return (mouse_buttons_ & SDL_BUTTON_MASK(button)) != 0; }
+
+        void setMouse(float x, float y, Uint32 buttons)
+        {
+            mouse_x_ = x;
+            mouse_y_ = y;
+            mouse_buttons_ = buttons;
+        }
+
+        bool operator==(const InputState &other) const = default;
+    };
+} // namespace engine::input
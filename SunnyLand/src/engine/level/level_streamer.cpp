@@ -0,0 +1,293 @@
+#include "level_streamer.h"
+#include "../render/camera.h"
+#include "../core/memory_tracker.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <spdlog/spdlog.h>
+
+namespace engine::level
+{
+    LevelStreamer::LevelStreamer(const TiledMap &map, const StreamSettings &settings) : map_(map), settings_(settings)
+    {
+        if (settings_.chunk_size <= 0 || settings_.max_chunks == 0)
+        {
+            throw std::runtime_error("LevelStreamer needs a positive chunk size and chunk count");
+        }
+        tiles_per_layer_ = static_cast<std::size_t>(settings_.chunk_size) * static_cast<std::size_t>(settings_.chunk_size);
+
+        chunks_.resize(settings_.max_chunks);
+        for (StreamedChunk &chunk : chunks_)
+        {
+            chunk.tiles.resize(tiles_per_layer_ * map_.getTileLayers().size());
+        }
+        states_.assign(settings_.max_chunks, ChunkState::Free);
+        last_used_.assign(settings_.max_chunks, 0);
+        free_chunks_.reserve(settings_.max_chunks);
+        requests_.resize(settings_.max_chunks);
+        for (std::size_t i = settings_.max_chunks; i-- > 0;)
+        {
+            free_chunks_.push_back(static_cast<std::uint32_t>(i));
+        }
+        resident_.assign(std::bit_ceil(settings_.max_chunks * 2), NO_CHUNK);
+        missing_.reserve(settings_.max_chunks);
+        requested_.reserve(settings_.max_chunks);
+        finished_.reserve(settings_.max_chunks);
+        finished_scratch_.reserve(settings_.max_chunks);
+
+        worker_ = std::thread([this]
+                              { workerMain(); });
+        spdlog::debug("LevelStreamer started: {} chunks of {}x{} tiles, {} bytes", settings_.max_chunks, settings_.chunk_size,
+                      settings_.chunk_size, getMemoryUsage());
+    }
+
+    LevelStreamer::~LevelStreamer()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        worker_.join();
+    }
+
+    void LevelStreamer::workerMain()
+    {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        std::ifstream file(map_.getFilePath(), std::ios::binary);
+        if (!file)
+        {
+            spdlog::error("LevelStreamer failed to open {}", map_.getFilePath());
+        }
+        const std::size_t layer_count = map_.getTileLayers().size();
+
+        for (;;)
+        {
+            std::uint32_t index;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [this]
+                         { return stopping_ || request_count_ > 0; });
+                if (stopping_)
+                {
+                    return;
+                }
+                index = requests_[request_head_];
+                request_head_ = (request_head_ + 1) % requests_.size();
+                --request_count_;
+            }
+
+            // The chunk belongs to this thread until it is handed back through finished_
+            StreamedChunk &chunk = chunks_[index];
+            const int size = settings_.chunk_size;
+            const TileRect rect{chunk.chunk_x * size, chunk.chunk_y * size, size, size};
+            for (std::size_t layer = 0; layer < layer_count; ++layer)
+            {
+                std::span<std::uint32_t> tiles(chunk.tiles.data() + layer * tiles_per_layer_, tiles_per_layer_);
+                if (file && !map_.readTiles(file, layer, rect, tiles))
+                {
+                    spdlog::error("LevelStreamer failed to read chunk ({}, {}) of layer {} from {}", chunk.chunk_x, chunk.chunk_y, layer,
+                                  map_.getFilePath());
+                }
+            }
+
+            std::lock_guard lock(mutex_);
+            finished_.push_back(index);
+        }
+    }
+
+    bool LevelStreamer::acquireChunk(std::uint32_t &index)
+    {
+        if (!free_chunks_.empty())
+        {
+            index = free_chunks_.back();
+            free_chunks_.pop_back();
+            return true;
+        }
+        bool found = false;
+        for (std::uint32_t i = 0; i < chunks_.size(); ++i)
+        {
+            if (states_[i] == ChunkState::Ready && !range_.contains(chunks_[i].chunk_x, chunks_[i].chunk_y) &&
+                (!found || last_used_[i] < last_used_[index]))
+            {
+                index = i;
+                found = true;
+            }
+        }
+        if (found)
+        {
+            eraseResident(index);
+            states_[index] = ChunkState::Free;
+        }
+        return found;
+    }
+
+    void LevelStreamer::releaseChunk(std::uint32_t index)
+    {
+        eraseResident(index);
+        states_[index] = ChunkState::Free;
+        free_chunks_.push_back(index);
+    }
+
+    std::uint32_t LevelStreamer::findResident(int x, int y) const
+    {
+        const std::size_t mask = resident_.size() - 1;
+        for (std::size_t slot = residentSlot(x, y);; slot = (slot + 1) & mask)
+        {
+            const std::uint32_t index = resident_[slot];
+            if (index == NO_CHUNK || (chunks_[index].chunk_x == x && chunks_[index].chunk_y == y))
+            {
+                return index;
+            }
+        }
+    }
+
+    void LevelStreamer::insertResident(std::uint32_t index)
+    {
+        const std::size_t mask = resident_.size() - 1;
+        std::size_t slot = residentSlot(chunks_[index].chunk_x, chunks_[index].chunk_y);
+        while (resident_[slot] != NO_CHUNK)
+        {
+            slot = (slot + 1) & mask;
+        }
+        resident_[slot] = index;
+        ++resident_count_;
+    }
+
+    void LevelStreamer::eraseResident(std::uint32_t index)
+    {
+        const std::size_t mask = resident_.size() - 1;
+        std::size_t hole = residentSlot(chunks_[index].chunk_x, chunks_[index].chunk_y);
+        while (resident_[hole] != index)
+        {
+            hole = (hole + 1) & mask;
+        }
+        // Shift later entries of the probe run back into the hole, so lookups never stop early at it
+        for (std::size_t slot = (hole + 1) & mask; resident_[slot] != NO_CHUNK; slot = (slot + 1) & mask)
+        {
+            const StreamedChunk &chunk = chunks_[resident_[slot]];
+            const std::size_t home = residentSlot(chunk.chunk_x, chunk.chunk_y);
+            // The entry may move to the hole only if its home slot is not cyclically within (hole, slot]
+            if (((slot - home) & mask) >= ((slot - hole) & mask))
+            {
+                resident_[hole] = resident_[slot];
+                hole = slot;
+            }
+        }
+        resident_[hole] = NO_CHUNK;
+        --resident_count_;
+    }
+
+    void LevelStreamer::update(const engine::render::Camera &camera)
+    {
+        ++frame_;
+        const int size = settings_.chunk_size;
+        const glm::vec2 chunk_pixels(static_cast<float>(size * map_.getTileWidth()), static_cast<float>(size * map_.getTileHeight()));
+        const glm::vec2 view_min = camera.getPosition();
+        const glm::vec2 view_max = view_min + camera.getViewportSize();
+
+        // Chunks in view plus the margin, limited to the chunks holding any tile
+        const TileRect &bounds = map_.getBounds();
+        auto floor_div = [](int value, int divisor)
+        { return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor); };
+        range_.min_x = std::max(static_cast<int>(std::floor(view_min.x / chunk_pixels.x)) - settings_.margin_chunks, floor_div(bounds.x, size));
+        range_.min_y = std::max(static_cast<int>(std::floor(view_min.y / chunk_pixels.y)) - settings_.margin_chunks, floor_div(bounds.y, size));
+        range_.max_x = std::min(static_cast<int>(std::floor(view_max.x / chunk_pixels.x)) + settings_.margin_chunks,
+                                floor_div(bounds.x + bounds.width - 1, size));
+        range_.max_y = std::min(static_cast<int>(std::floor(view_max.y / chunk_pixels.y)) + settings_.margin_chunks,
+                                floor_div(bounds.y + bounds.height - 1, size));
+
+        {
+            std::lock_guard lock(mutex_);
+            finished_scratch_.swap(finished_);
+            // Requests the worker has not started on are dropped once their chunk left the range; the rest keep their order
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < request_count_; ++i)
+            {
+                const std::uint32_t index = requests_[(request_head_ + i) % requests_.size()];
+                if (range_.contains(chunks_[index].chunk_x, chunks_[index].chunk_y))
+                    requests_[(request_head_ + kept++) % requests_.size()] = index;
+                else
+                    releaseChunk(index);
+            }
+            request_count_ = kept;
+        }
+        for (std::uint32_t index : finished_scratch_)
+        {
+            states_[index] = ChunkState::Ready;
+        }
+        finished_scratch_.clear();
+
+        missing_.clear();
+        for (int y = range_.min_y; y <= range_.max_y; ++y)
+        {
+            for (int x = range_.min_x; x <= range_.max_x; ++x)
+            {
+                const std::uint32_t index = findResident(x, y);
+                if (index != NO_CHUNK)
+                    last_used_[index] = frame_;
+                else
+                    missing_.push_back({x, y});
+            }
+        }
+        if (missing_.empty())
+        {
+            return;
+        }
+
+        // Nearest to the center of the view first
+        const glm::vec2 center = (view_min + view_max) * 0.5f / chunk_pixels - 0.5f;
+        std::sort(missing_.begin(), missing_.end(), [&center](const glm::ivec2 &a, const glm::ivec2 &b)
+                  {
+                      glm::vec2 da = glm::vec2(a) - center;
+                      glm::vec2 db = glm::vec2(b) - center;
+                      return da.x * da.x + da.y * da.y < db.x * db.x + db.y * db.y; });
+
+        requested_.clear();
+        for (const glm::ivec2 &coordinates : missing_)
+        {
+            std::uint32_t index;
+            if (!acquireChunk(index))
+            {
+                if (!budget_warned_)
+                {
+                    spdlog::warn("LevelStreamer: {} chunks are not enough for the view, raise StreamSettings::max_chunks", settings_.max_chunks);
+                    budget_warned_ = true;
+                }
+                break;
+            }
+            chunks_[index].chunk_x = coordinates.x;
+            chunks_[index].chunk_y = coordinates.y;
+            states_[index] = ChunkState::Loading;
+            last_used_[index] = frame_;
+            insertResident(index);
+            requested_.push_back(index);
+        }
+        {
+            std::lock_guard lock(mutex_);
+            for (std::uint32_t index : requested_)
+            {
+                requests_[(request_head_ + request_count_++) % requests_.size()] = index;
+            }
+        }
+        cv_.notify_one();
+    }
+
+    std::uint32_t LevelStreamer::getTile(std::size_t layer, int x, int y) const
+    {
+        const int size = settings_.chunk_size;
+        const int chunk_x = x >= 0 ? x / size : -((-x + size - 1) / size);
+        const int chunk_y = y >= 0 ? y / size : -((-y + size - 1) / size);
+        const std::uint32_t index = findResident(chunk_x, chunk_y);
+        if (index == NO_CHUNK || states_[index] != ChunkState::Ready || layer >= map_.getTileLayers().size())
+        {
+            return 0;
+        }
+        const std::size_t local = static_cast<std::size_t>(y - chunk_y * size) * static_cast<std::size_t>(size) +
+                                  static_cast<std::size_t>(x - chunk_x * size);
+        return chunks_[index].tiles[layer * tiles_per_layer_ + local];
+    }
+} // namespace engine::level
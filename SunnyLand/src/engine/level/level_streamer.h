@@ -0,0 +1,142 @@
+#pragma once
+#include "tiled_map.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::render
+{
+    class Camera;
+}
+
+namespace engine::level
+{
+    struct StreamSettings
+    {
+        /// @brief Width and height of a chunk in tiles.
+        int chunk_size = 16;
+        /// @brief Chunks kept loaded beyond the edges of the view, so that scrolling finds them ready.
+        int margin_chunks = 1;
+        /// @brief Upper bound of chunks in memory; each holds every tile layer.
+        std::size_t max_chunks = 256;
+    };
+
+    /// @brief The tiles of every tile layer of a chunk_size x chunk_size area.
+    struct StreamedChunk
+    {
+        int chunk_x = 0;
+        int chunk_y = 0;
+        /// @brief Layer after layer, rows from the top left; 0 where there is no tile.
+        std::vector<std::uint32_t> tiles;
+    };
+
+    /// @brief Keeps the chunks of a TiledMap around the camera in memory, reading them on a background thread.
+    /// All chunk buffers are allocated up front, so memory use is fixed by the settings, whatever the map's size.
+    /// When the pool is full, the least recently seen chunk outside the view is reused; requests for chunks that
+    /// scrolled out of range before being read are dropped.
+    /// Everything but the background thread runs on the thread calling update().
+    class LevelStreamer final
+    {
+    private:
+        enum class ChunkState : std::uint8_t
+        {
+            Free,
+            Loading,
+            Ready
+        };
+
+        struct ChunkRange
+        {
+            int min_x = 0, min_y = 0, max_x = -1, max_y = -1;
+
+            bool contains(int x, int y) const { return x >= min_x && x <= max_x && y >= min_y && y <= max_y; }
+        };
+
+        const TiledMap &map_;
+        StreamSettings settings_;
+        std::size_t tiles_per_layer_;
+
+        std::vector<StreamedChunk> chunks_;
+        std::vector<ChunkState> states_;
+        std::vector<std::uint64_t> last_used_;
+        std::vector<std::uint32_t> free_chunks_;
+        /// @brief Open-addressed table (linear probing, power-of-two size, at most half full) of the chunks that are loading
+        /// or ready, keyed by their coordinates; NO_CHUNK marks an empty slot. Allocated once, like the chunks.
+        std::vector<std::uint32_t> resident_;
+        std::size_t resident_count_ = 0;
+        ChunkRange range_;
+        std::uint64_t frame_ = 0;
+        /// @brief Scratch of update(): chunks in range but not resident, and the chunks requested for them.
+        std::vector<glm::ivec2> missing_;
+        std::vector<std::uint32_t> requested_;
+        std::vector<std::uint32_t> finished_scratch_;
+        bool budget_warned_ = false;
+
+        std::thread worker_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        /// @brief Ring of chunks waiting for the worker, oldest at request_head_. Sized to the pool: every queued chunk is Loading.
+        std::vector<std::uint32_t> requests_;
+        std::size_t request_head_ = 0;
+        std::size_t request_count_ = 0;
+        std::vector<std::uint32_t> finished_;
+        bool stopping_ = false;
+
+        static constexpr std::uint32_t NO_CHUNK = UINT32_MAX;
+
+        static std::uint64_t chunkKey(int x, int y) { return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y); }
+        std::size_t residentSlot(int x, int y) const { return static_cast<std::size_t>((chunkKey(x, y) * 0x9E3779B97F4A7C15ull) >> 32) & (resident_.size() - 1); }
+        /// @brief Index of the loading or ready chunk at chunk coordinates, or NO_CHUNK.
+        std::uint32_t findResident(int x, int y) const;
+        /// @brief Adds chunks_[index] under its current coordinates.
+        void insertResident(std::uint32_t index);
+        /// @brief Removes chunks_[index], which must be resident and still hold the coordinates it was added with.
+        void eraseResident(std::uint32_t index);
+
+        void workerMain();
+        /// @brief Takes a free chunk, or evicts the least recently used ready chunk outside range_. Returns false if none is left.
+        bool acquireChunk(std::uint32_t &index);
+        void releaseChunk(std::uint32_t index);
+
+    public:
+        /// @brief Starts the background thread. map must outlive the streamer.
+        LevelStreamer(const TiledMap &map, const StreamSettings &settings = {});
+        ~LevelStreamer();
+
+        LevelStreamer(const LevelStreamer &) = delete;
+        LevelStreamer &operator=(const LevelStreamer &) = delete;
+        LevelStreamer(LevelStreamer &&) = delete;
+        LevelStreamer &operator=(LevelStreamer &&) = delete;
+
+        /// @brief Takes over the chunks read since the last call and requests those around the camera, nearest first.
+        void update(const engine::render::Camera &camera);
+
+        /// @brief Tile id at tile coordinates, or 0 if there is none or its chunk is not loaded.
+        std::uint32_t getTile(std::size_t layer, int x, int y) const;
+
+        /// @brief Calls func(const StreamedChunk &) for every loaded chunk overlapping rect (in tiles).
+        template <typename Func>
+        void forEachChunk(const TileRect &rect, Func &&func) const
+        {
+            const int size = settings_.chunk_size;
+            for (std::size_t i = 0; i < chunks_.size(); ++i)
+            {
+                const StreamedChunk &chunk = chunks_[i];
+                if (states_[i] == ChunkState::Ready && chunk.chunk_x * size < rect.x + rect.width && rect.x < (chunk.chunk_x + 1) * size &&
+                    chunk.chunk_y * size < rect.y + rect.height && rect.y < (chunk.chunk_y + 1) * size)
+                {
+                    func(chunk);
+                }
+            }
+        }
+
+        const TiledMap &getMap() const { return map_; }
+        int getChunkSize() const { return settings_.chunk_size; }
+        std::size_t getTilesPerLayer() const { return tiles_per_layer_; }
+        std::size_t getResidentCount() const { return resident_count_; }
+        /// @brief Bytes of all chunk buffers, which stays the same for the streamer's whole life.
+        std::size_t getMemoryUsage() const { return chunks_.size() * (sizeof(StreamedChunk) + tiles_per_layer_ * map_.getTileLayers().size() * sizeof(std::uint32_t)); }
+    };
+} // namespace engine::level
@@ -0,0 +1,712 @@
+#include "tiled_map.h"
+#include "../utils/json_cache.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::level
+{
+    namespace
+    {
+        int floorDiv(int value, int divisor)
+        {
+            int quotient = value / divisor;
+            return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+        }
+
+        std::uint64_t spanKey(int x, int y)
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+        }
+
+        /// @brief Resolves a path stored in a Tiled file, which is relative to that file.
+        std::string resolvePath(const std::string &owner_file, const std::string &path)
+        {
+            return (std::filesystem::path(owner_file).parent_path() / path).lexically_normal().generic_string();
+        }
+
+        /// @brief Reads the ids of a JSON array from a seeked position through a small buffer.
+        class GidReader final
+        {
+        private:
+            std::istream &file_;
+            std::array<char, 4096> buffer_;
+            std::size_t position_ = 0;
+            std::size_t end_ = 0;
+
+            bool refill()
+            {
+                file_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+                end_ = static_cast<std::size_t>(file_.gcount());
+                position_ = 0;
+                return end_ > 0;
+            }
+
+        public:
+            explicit GidReader(std::istream &file) : file_(file) {}
+
+            bool seek(std::uint64_t offset)
+            {
+                file_.clear();
+                file_.seekg(static_cast<std::streamoff>(offset));
+                position_ = end_ = 0;
+                return static_cast<bool>(file_);
+            }
+
+            /// @brief Returns false at the end of the array or on unexpected input.
+            bool next(std::uint32_t &value)
+            {
+                char c = 0;
+                for (;;)
+                {
+                    if (position_ == end_ && !refill())
+                        return false;
+                    c = buffer_[position_];
+                    if (c != ',' && c != ' ' && c != '\n' && c != '\r' && c != '\t')
+                        break;
+                    ++position_;
+                }
+                if (c < '0' || c > '9')
+                {
+                    return false;
+                }
+                std::uint64_t number = 0;
+                while (position_ < end_ || refill())
+                {
+                    c = buffer_[position_];
+                    if (c < '0' || c > '9')
+                        break;
+                    number = number * 10 + static_cast<std::uint64_t>(c - '0');
+                    ++position_;
+                }
+                value = static_cast<std::uint32_t>(number);
+                return true;
+            }
+        };
+    }
+
+    SDL_FRect TiledTileset::getSourceRect(std::uint32_t gid) const
+    {
+        int local_id = static_cast<int>(gid - first_gid);
+        int column = columns > 0 ? local_id % columns : 0;
+        int row = columns > 0 ? local_id / columns : 0;
+        return {static_cast<float>(margin + column * (tile_width + spacing)), static_cast<float>(margin + row * (tile_height + spacing)),
+                static_cast<float>(tile_width), static_cast<float>(tile_height)};
+    }
+
+    /// @brief Follows the nesting of the map with a stack of scopes. Scalars are dispatched on the
+    /// innermost scope and the last key; subtrees without a scope of their own are skipped.
+    class TiledMap::SaxHandler final
+    {
+    private:
+        using json = nlohmann::json;
+
+        enum class Scope
+        {
+            Root,
+            Layers,
+            Layer,
+            Data,
+            Chunks,
+            Chunk,
+            Objects,
+            Object,
+            Properties,
+            Property,
+            Tilesets,
+            Tileset,
+            Skip
+        };
+
+        struct PendingLayer
+        {
+            TiledTileLayer tiles;
+            TiledObjectLayer objects;
+            std::string type;
+            TileRect rect;
+            bool encoded = false;
+            bool has_data = false;
+            std::uint64_t data_count = 0;
+        };
+
+        TiledMap &map_;
+        std::istream &file_;
+        std::vector<Scope> scopes_;
+        std::string key_;
+        std::vector<PendingLayer> layers_;
+        TiledObject object_;
+        TiledProperty property_;
+        TileRect chunk_;
+        std::uint64_t chunk_first_checkpoint_ = 0;
+        std::uint64_t element_count_ = 0;
+        bool chunk_sizes_differ_ = false;
+
+    public:
+        int map_width = 0;
+        int map_height = 0;
+        std::string error;
+
+    private:
+        Scope top() const { return scopes_.empty() ? Scope::Skip : scopes_.back(); }
+
+        std::uint64_t offset() const
+        {
+            return static_cast<std::uint64_t>(file_.rdbuf()->pubseekoff(0, std::ios::cur, std::ios::in));
+        }
+
+        void beginData(TiledTileLayer &layer)
+        {
+            element_count_ = 0;
+            layer.checkpoints.push_back(offset());
+        }
+
+        /// @brief Drops data that does not match its declared size, so that readTiles() never reads past it.
+        bool checkDataSize(const PendingLayer &layer, const TileRect &rect, std::uint64_t count)
+        {
+            if (count == static_cast<std::uint64_t>(rect.width) * static_cast<std::uint64_t>(rect.height))
+            {
+                return true;
+            }
+            spdlog::warn("Tiled map {}: layer '{}' has {} tile ids for {}x{} tiles, skipping its data", map_.file_path_,
+                         layer.tiles.name, count, rect.width, rect.height);
+            return false;
+        }
+
+        void endLayer()
+        {
+            PendingLayer layer = std::move(layers_.back());
+            layers_.pop_back();
+            if (layer.type == "tilelayer")
+            {
+                if (layer.encoded)
+                {
+                    spdlog::warn("Tiled map {}: layer '{}' uses base64 encoding, only CSV layers are supported", map_.file_path_, layer.tiles.name);
+                    layer.tiles.spans.clear();
+                    layer.tiles.checkpoints.clear();
+                    layer.tiles.span_lookup.clear();
+                }
+                else if (layer.has_data)
+                {
+                    // Fixed size layer: its size is only known here, as "width" and "height" follow "data"
+                    if (checkDataSize(layer, layer.rect, layer.data_count))
+                        layer.tiles.spans.push_back({layer.rect, 0});
+                    else
+                        layer.tiles.checkpoints.clear();
+                }
+                else if (chunk_sizes_differ_)
+                {
+                    layer.tiles.span_lookup.clear();
+                }
+                map_.tile_layers_.push_back(std::move(layer.tiles));
+            }
+            else if (layer.type == "objectgroup")
+            {
+                map_.object_layers_.push_back(std::move(layer.objects));
+            }
+            else if (layer.type != "group")
+            {
+                spdlog::debug("Tiled map {}: ignoring {} '{}'", map_.file_path_, layer.type, layer.tiles.name);
+            }
+        }
+
+        void endChunk()
+        {
+            PendingLayer &layer = layers_.back();
+            TiledTileLayer &tiles = layer.tiles;
+            if (layer.encoded || !checkDataSize(layer, chunk_, element_count_))
+            {
+                return;
+            }
+            if (tiles.spans.empty())
+            {
+                tiles.span_width = chunk_.width;
+                tiles.span_height = chunk_.height;
+                chunk_sizes_differ_ = false;
+            }
+            else if (chunk_.width != tiles.span_width || chunk_.height != tiles.span_height)
+            {
+                chunk_sizes_differ_ = true;
+            }
+            auto span_index = static_cast<std::uint32_t>(tiles.spans.size());
+            tiles.spans.push_back({chunk_, static_cast<std::uint32_t>(chunk_first_checkpoint_)});
+            if (tiles.span_width > 0 && tiles.span_height > 0)
+            {
+                tiles.span_lookup[spanKey(floorDiv(chunk_.x, tiles.span_width), floorDiv(chunk_.y, tiles.span_height))] = span_index;
+            }
+        }
+
+        /// @brief number is the value of numbers and booleans, text its JSON form (or the string itself).
+        void scalar(double number, const std::string &text, bool is_string)
+        {
+            auto as_int = [&]
+            { return static_cast<int>(number); };
+            switch (top())
+            {
+            case Scope::Root:
+                if (key_ == "width")
+                    map_width = as_int();
+                else if (key_ == "height")
+                    map_height = as_int();
+                else if (key_ == "tilewidth")
+                    map_.tile_width_ = as_int();
+                else if (key_ == "tileheight")
+                    map_.tile_height_ = as_int();
+                else if (key_ == "infinite")
+                    map_.infinite_ = number != 0.0;
+                else if (key_ == "orientation" && text != "orthogonal")
+                    spdlog::warn("Tiled map {}: {} orientation is drawn as orthogonal", map_.file_path_, text);
+                break;
+            case Scope::Layer:
+            {
+                PendingLayer &layer = layers_.back();
+                if (key_ == "name")
+                    layer.tiles.name = layer.objects.name = text;
+                else if (key_ == "type")
+                    layer.type = text;
+                else if (key_ == "id")
+                    layer.tiles.id = static_cast<std::uint32_t>(number);
+                else if (key_ == "visible")
+                    layer.tiles.visible = layer.objects.visible = number != 0.0;
+                else if (key_ == "opacity")
+                    layer.tiles.opacity = static_cast<float>(number);
+                else if (key_ == "offsetx")
+                    layer.tiles.offset.x = static_cast<float>(number);
+                else if (key_ == "offsety")
+                    layer.tiles.offset.y = static_cast<float>(number);
+                else if (key_ == "parallaxx")
+                    layer.tiles.parallax.x = static_cast<float>(number);
+                else if (key_ == "parallaxy")
+                    layer.tiles.parallax.y = static_cast<float>(number);
+                else if (key_ == "x")
+                    layer.rect.x = as_int();
+                else if (key_ == "y")
+                    layer.rect.y = as_int();
+                else if (key_ == "width")
+                    layer.rect.width = as_int();
+                else if (key_ == "height")
+                    layer.rect.height = as_int();
+                else if ((key_ == "encoding" && text != "csv") || (key_ == "compression" && !text.empty()) || (key_ == "data" && is_string))
+                    layer.encoded = true;
+                break;
+            }
+            case Scope::Chunk:
+                if (key_ == "x")
+                    chunk_.x = as_int();
+                else if (key_ == "y")
+                    chunk_.y = as_int();
+                else if (key_ == "width")
+                    chunk_.width = as_int();
+                else if (key_ == "height")
+                    chunk_.height = as_int();
+                else if (key_ == "data" && is_string)
+                    layers_.back().encoded = true;
+                break;
+            case Scope::Object:
+                if (key_ == "id")
+                    object_.id = static_cast<std::uint32_t>(number);
+                else if (key_ == "name")
+                    object_.name = text;
+                else if (key_ == "type" || key_ == "class")
+                    object_.type = text;
+                else if (key_ == "x")
+                    object_.bounds.position.x = static_cast<float>(number);
+                else if (key_ == "y")
+                    object_.bounds.position.y = static_cast<float>(number);
+                else if (key_ == "width")
+                    object_.bounds.size.x = static_cast<float>(number);
+                else if (key_ == "height")
+                    object_.bounds.size.y = static_cast<float>(number);
+                else if (key_ == "rotation")
+                    object_.rotation = static_cast<float>(number);
+                else if (key_ == "gid")
+                    object_.gid = static_cast<std::uint32_t>(number);
+                else if (key_ == "visible")
+                    object_.visible = number != 0.0;
+                break;
+            case Scope::Property:
+                if (key_ == "name")
+                    property_.name = text;
+                else if (key_ == "type")
+                    property_.type = text;
+                else if (key_ == "value")
+                    property_.value = text;
+                break;
+            case Scope::Tileset:
+            {
+                TiledTileset &tileset = map_.tilesets_.back();
+                if (key_ == "firstgid")
+                    tileset.first_gid = static_cast<std::uint32_t>(number);
+                else if (key_ == "name")
+                    tileset.name = text;
+                else if (key_ == "image")
+                    tileset.image = resolvePath(map_.file_path_, text);
+                else if (key_ == "source")
+                    tileset.source = resolvePath(map_.file_path_, text);
+                else if (key_ == "tilewidth")
+                    tileset.tile_width = as_int();
+                else if (key_ == "tileheight")
+                    tileset.tile_height = as_int();
+                else if (key_ == "columns")
+                    tileset.columns = as_int();
+                else if (key_ == "tilecount")
+                    tileset.tile_count = as_int();
+                else if (key_ == "margin")
+                    tileset.margin = as_int();
+                else if (key_ == "spacing")
+                    tileset.spacing = as_int();
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        /// @brief The hot path: one call per tile. The stream has already consumed the separator after
+        /// the id, so its position is where the next id starts.
+        void dataElement()
+        {
+            if (++element_count_ % TILE_CHECKPOINT_STRIDE == 0)
+            {
+                layers_.back().tiles.checkpoints.push_back(offset());
+            }
+        }
+
+        template <typename Number>
+        bool number(Number value)
+        {
+            if (top() == Scope::Data)
+            {
+                dataElement();
+                return true;
+            }
+            std::array<char, 32> text;
+            auto result = std::to_chars(text.data(), text.data() + text.size(), value);
+            scalar(static_cast<double>(value), std::string(text.data(), result.ptr), false);
+            return true;
+        }
+
+    public:
+        SaxHandler(TiledMap &map, std::istream &file) : map_(map), file_(file) {}
+
+        bool null() { return true; }
+        bool boolean(bool value)
+        {
+            scalar(value ? 1.0 : 0.0, value ? "true" : "false", false);
+            return true;
+        }
+        bool number_integer(json::number_integer_t value) { return number(value); }
+        bool number_float(json::number_float_t value, const json::string_t &) { return number(value); }
+        bool number_unsigned(json::number_unsigned_t value) { return number(value); }
+        bool string(json::string_t &value)
+        {
+            if (top() == Scope::Data)
+            {
+                error = "tile data contains a string";
+                return false;
+            }
+            scalar(0.0, value, true);
+            return true;
+        }
+        bool binary(json::binary_t &) { return true; }
+        bool key(json::string_t &value)
+        {
+            key_ = value;
+            return true;
+        }
+
+        bool start_object(std::size_t)
+        {
+            if (scopes_.empty())
+            {
+                scopes_.push_back(Scope::Root);
+                return true;
+            }
+            switch (top())
+            {
+            case Scope::Layers:
+                scopes_.push_back(Scope::Layer);
+                layers_.emplace_back();
+                break;
+            case Scope::Chunks:
+                scopes_.push_back(Scope::Chunk);
+                chunk_ = {};
+                element_count_ = 0;
+                chunk_first_checkpoint_ = 0;
+                break;
+            case Scope::Objects:
+                scopes_.push_back(Scope::Object);
+                object_ = {};
+                break;
+            case Scope::Properties:
+                scopes_.push_back(Scope::Property);
+                property_ = {};
+                break;
+            case Scope::Tilesets:
+                scopes_.push_back(Scope::Tileset);
+                map_.tilesets_.emplace_back();
+                break;
+            default:
+                scopes_.push_back(Scope::Skip);
+                break;
+            }
+            return true;
+        }
+
+        bool end_object()
+        {
+            Scope scope = top();
+            scopes_.pop_back();
+            if (scope == Scope::Layer)
+                endLayer();
+            else if (scope == Scope::Chunk)
+                endChunk();
+            else if (scope == Scope::Object)
+                layers_.back().objects.objects.push_back(std::move(object_));
+            else if (scope == Scope::Property && top() == Scope::Properties && scopes_.size() >= 2 && scopes_[scopes_.size() - 2] == Scope::Object)
+                object_.properties.push_back(std::move(property_));
+            return true;
+        }
+
+        bool start_array(std::size_t)
+        {
+            Scope scope = top();
+            Scope next = Scope::Skip;
+            if ((scope == Scope::Root || scope == Scope::Layer) && key_ == "layers")
+                next = Scope::Layers;
+            else if (scope == Scope::Root && key_ == "tilesets")
+                next = Scope::Tilesets;
+            else if (scope == Scope::Layer && key_ == "objects")
+                next = Scope::Objects;
+            else if (scope == Scope::Layer && key_ == "chunks")
+                next = Scope::Chunks;
+            else if (scope == Scope::Object && key_ == "properties")
+                next = Scope::Properties;
+            else if ((scope == Scope::Layer || scope == Scope::Chunk) && key_ == "data")
+            {
+                next = Scope::Data;
+                TiledTileLayer &tiles = layers_.back().tiles;
+                if (scope == Scope::Layer)
+                    layers_.back().has_data = true;
+                else
+                    chunk_first_checkpoint_ = tiles.checkpoints.size();
+                beginData(tiles);
+            }
+            scopes_.push_back(next);
+            return true;
+        }
+
+        bool end_array()
+        {
+            Scope scope = top();
+            scopes_.pop_back();
+            if (scope == Scope::Data && top() == Scope::Layer)
+            {
+                layers_.back().data_count = element_count_;
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t position, const std::string &, const nlohmann::detail::exception &e)
+        {
+            error = "parse error at byte " + std::to_string(position) + ": " + e.what();
+            return false;
+        }
+    };
+
+    TiledMap::TiledMap(const std::string &file_path) : file_path_(file_path)
+    {
+        // Binary mode, so that the recorded offsets can be seeked to exactly
+        std::ifstream file(file_path, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Failed to open Tiled map: " + file_path);
+        }
+
+        SaxHandler handler(*this, file);
+        if (!nlohmann::json::sax_parse(file, &handler) || !handler.error.empty())
+        {
+            throw std::runtime_error("Failed to parse Tiled map " + file_path + ": " + handler.error);
+        }
+        if (tile_width_ <= 0 || tile_height_ <= 0)
+        {
+            throw std::runtime_error("Tiled map has no tile size: " + file_path);
+        }
+
+        for (TiledTileset &tileset : tilesets_)
+        {
+            if (!tileset.source.empty())
+            {
+                loadExternalTileset(tileset);
+            }
+        }
+        std::sort(tilesets_.begin(), tilesets_.end(), [](const TiledTileset &a, const TiledTileset &b)
+                  { return a.first_gid < b.first_gid; });
+
+        if (infinite_)
+        {
+            int min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+            bool first = true;
+            for (const TiledTileLayer &layer : tile_layers_)
+            {
+                for (const TileSpan &span : layer.spans)
+                {
+                    min_x = first ? span.rect.x : std::min(min_x, span.rect.x);
+                    min_y = first ? span.rect.y : std::min(min_y, span.rect.y);
+                    max_x = first ? span.rect.x + span.rect.width : std::max(max_x, span.rect.x + span.rect.width);
+                    max_y = first ? span.rect.y + span.rect.height : std::max(max_y, span.rect.y + span.rect.height);
+                    first = false;
+                }
+            }
+            bounds_ = {min_x, min_y, max_x - min_x, max_y - min_y};
+        }
+        else
+        {
+            bounds_ = {0, 0, handler.map_width, handler.map_height};
+        }
+
+        spdlog::debug("Tiled map loaded: {} ({}x{} tiles, {} tile layers, {} object layers, {} tilesets, {} bytes of index)", file_path,
+                      bounds_.width, bounds_.height, tile_layers_.size(), object_layers_.size(), tilesets_.size(), getIndexMemoryUsage());
+    }
+
+    void TiledMap::loadExternalTileset(TiledTileset &tileset)
+    {
+        std::string extension = std::filesystem::path(tileset.source).extension().string();
+        if (extension != ".tsj" && extension != ".json")
+        {
+            spdlog::warn("Tiled map {}: tileset {} is not in JSON format and cannot be loaded", file_path_, tileset.source);
+            return;
+        }
+        try
+        {
+            // Tileset files are small, so the DOM is fine here
+            nlohmann::json json = engine::utils::loadJson(tileset.source);
+            tileset.name = json.value("name", std::string());
+            tileset.image = resolvePath(tileset.source, json.at("image").get<std::string>());
+            tileset.tile_width = json.at("tilewidth").get<int>();
+            tileset.tile_height = json.at("tileheight").get<int>();
+            tileset.columns = json.at("columns").get<int>();
+            tileset.tile_count = json.at("tilecount").get<int>();
+            tileset.margin = json.value("margin", 0);
+            tileset.spacing = json.value("spacing", 0);
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::warn("Tiled map {}: failed to load tileset {}: {}", file_path_, tileset.source, e.what());
+        }
+    }
+
+    const TiledObjectLayer *TiledMap::findObjectLayer(const std::string &name) const
+    {
+        for (const TiledObjectLayer &layer : object_layers_)
+        {
+            if (layer.name == name)
+            {
+                return &layer;
+            }
+        }
+        return nullptr;
+    }
+
+    int TiledMap::findTileset(std::uint32_t gid) const
+    {
+        gid &= TILE_GID_MASK;
+        auto it = std::upper_bound(tilesets_.begin(), tilesets_.end(), gid, [](std::uint32_t value, const TiledTileset &tileset)
+                                   { return value < tileset.first_gid; });
+        if (it == tilesets_.begin())
+        {
+            return -1;
+        }
+        --it;
+        if (it->tile_count > 0 && gid >= it->first_gid + static_cast<std::uint32_t>(it->tile_count))
+        {
+            return -1;
+        }
+        return static_cast<int>(it - tilesets_.begin());
+    }
+
+    bool TiledMap::readTiles(std::istream &file, std::size_t layer_index, const TileRect &rect, std::span<std::uint32_t> out) const
+    {
+        std::fill(out.begin(), out.end(), 0u);
+        if (layer_index >= tile_layers_.size() || out.size() < static_cast<std::size_t>(rect.width) * static_cast<std::size_t>(rect.height))
+        {
+            return false;
+        }
+        const TiledTileLayer &layer = tile_layers_[layer_index];
+        GidReader reader(file);
+        // Where the reader stands, so that rows close to each other are reached by reading on instead of seeking
+        const TileSpan *reader_span = nullptr;
+        std::uint64_t reader_element = 0;
+
+        auto read_span = [&](const TileSpan &span)
+        {
+            const int x0 = std::max(rect.x, span.rect.x);
+            const int x1 = std::min(rect.x + rect.width, span.rect.x + span.rect.width);
+            const int y0 = std::max(rect.y, span.rect.y);
+            const int y1 = std::min(rect.y + rect.height, span.rect.y + span.rect.height);
+            for (int y = y0; y < y1 && x0 < x1; ++y)
+            {
+                std::uint64_t element = static_cast<std::uint64_t>(y - span.rect.y) * static_cast<std::uint64_t>(span.rect.width) +
+                                        static_cast<std::uint64_t>(x0 - span.rect.x);
+                std::uint32_t skipped = 0;
+                if (reader_span != &span || element < reader_element || element - reader_element >= TILE_CHECKPOINT_STRIDE)
+                {
+                    if (!reader.seek(layer.checkpoints[span.first_checkpoint + element / TILE_CHECKPOINT_STRIDE]))
+                        return false;
+                    reader_span = &span;
+                    reader_element = element - element % TILE_CHECKPOINT_STRIDE;
+                }
+                for (; reader_element < element; ++reader_element)
+                {
+                    if (!reader.next(skipped))
+                        return false;
+                }
+                std::uint32_t *row = out.data() + static_cast<std::size_t>(y - rect.y) * static_cast<std::size_t>(rect.width) +
+                                     static_cast<std::size_t>(x0 - rect.x);
+                for (int x = x0; x < x1; ++x, ++reader_element)
+                {
+                    if (!reader.next(*row++))
+                        return false;
+                }
+            }
+            return true;
+        };
+
+        if (!layer.span_lookup.empty())
+        {
+            for (int cy = floorDiv(rect.y, layer.span_height); cy <= floorDiv(rect.y + rect.height - 1, layer.span_height); ++cy)
+            {
+                for (int cx = floorDiv(rect.x, layer.span_width); cx <= floorDiv(rect.x + rect.width - 1, layer.span_width); ++cx)
+                {
+                    auto it = layer.span_lookup.find(spanKey(cx, cy));
+                    if (it != layer.span_lookup.end() && !read_span(layer.spans[it->second]))
+                        return false;
+                }
+            }
+            return true;
+        }
+        for (const TileSpan &span : layer.spans)
+        {
+            if (!read_span(span))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t TiledMap::getIndexMemoryUsage() const
+    {
+        std::size_t bytes = 0;
+        for (const TiledTileLayer &layer : tile_layers_)
+        {
+            bytes += layer.spans.capacity() * sizeof(TileSpan) + layer.checkpoints.capacity() * sizeof(std::uint64_t) +
+                     layer.span_lookup.size() * (sizeof(std::uint64_t) + sizeof(std::uint32_t) + sizeof(void *));
+        }
+        return bytes;
+    }
+} // namespace engine::level
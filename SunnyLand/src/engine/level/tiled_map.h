@@ -0,0 +1,164 @@
+#pragma once
+#include "../utils/math.h"
+#include <cstdint>
+#include <istream>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL3/SDL_rect.h>
+
+namespace engine::level
+{
+    /// @brief Flag bits Tiled stores in the top of a tile id; mask them off with TILE_GID_MASK before looking up the tileset.
+    constexpr std::uint32_t TILE_FLIPPED_HORIZONTALLY = 0x80000000u;
+    constexpr std::uint32_t TILE_FLIPPED_VERTICALLY = 0x40000000u;
+    constexpr std::uint32_t TILE_FLIPPED_DIAGONALLY = 0x20000000u;
+    constexpr std::uint32_t TILE_GID_MASK = 0x0FFFFFFFu;
+
+    /// @brief Rectangle in tiles.
+    struct TileRect
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    struct TiledTileset
+    {
+        /// @brief Tile id of the first tile; the tileset covers first_gid .. first_gid + tile_count - 1.
+        std::uint32_t first_gid = 1;
+        std::string name;
+        /// @brief Image path relative to the working directory, like every other resource path.
+        std::string image;
+        /// @brief External tileset file, empty if the tileset is embedded in the map.
+        std::string source;
+        int tile_width = 0;
+        int tile_height = 0;
+        int columns = 0;
+        int tile_count = 0;
+        int margin = 0;
+        int spacing = 0;
+
+        /// @brief Part of the image showing the tile with id gid (flag bits already removed).
+        SDL_FRect getSourceRect(std::uint32_t gid) const;
+    };
+
+    /// @brief Custom property of an object. Numbers and booleans are kept in their JSON text form.
+    struct TiledProperty
+    {
+        std::string name;
+        std::string type;
+        std::string value;
+    };
+
+    struct TiledObject
+    {
+        std::uint32_t id = 0;
+        std::string name;
+        /// @brief "type" in older Tiled versions, "class" in newer ones.
+        std::string type;
+        engine::utils::Rect bounds{};
+        float rotation = 0.0f;
+        /// @brief Non-zero for tile objects.
+        std::uint32_t gid = 0;
+        bool visible = true;
+        std::vector<TiledProperty> properties;
+    };
+
+    struct TiledObjectLayer
+    {
+        std::string name;
+        bool visible = true;
+        std::vector<TiledObject> objects;
+    };
+
+    /// @brief Where one run of a tile layer's ids is stored in the map file: the whole layer of a
+    /// fixed size map, or one chunk of an infinite map.
+    struct TileSpan
+    {
+        TileRect rect;
+        /// @brief Index of the checkpoint holding the span's first tile.
+        std::uint32_t first_checkpoint = 0;
+    };
+
+    /// @brief A tile layer without its tiles. The ids stay in the file and are read on demand with TiledMap::readTiles().
+    struct TiledTileLayer
+    {
+        std::string name;
+        std::uint32_t id = 0;
+        bool visible = true;
+        float opacity = 1.0f;
+        glm::vec2 offset{0.0f, 0.0f};
+        glm::vec2 parallax{1.0f, 1.0f};
+
+        std::vector<TileSpan> spans;
+        /// @brief File offsets of every TILE_CHECKPOINT_STRIDE-th id of the spans, in span order.
+        std::vector<std::uint64_t> checkpoints;
+        /// @brief Infinite maps only: span index by chunk coordinates, all chunks having the size of the first one.
+        std::unordered_map<std::uint64_t, std::uint32_t> span_lookup;
+        int span_width = 0;
+        int span_height = 0;
+    };
+
+    /// @brief Index of a Tiled JSON map (.tmj / .json).
+    /// The file is parsed once with SAX events, without building a DOM: tilesets, layer properties and
+    /// objects are kept, while tile ids are only located. Every TILE_CHECKPOINT_STRIDE-th id of a layer
+    /// records its file offset, so any rectangle of tiles can be read back later by seeking, and the
+    /// index stays a small fraction of the map's size.
+    ///
+    /// Tile layers must use the default CSV (JSON array) encoding; base64 layers are skipped with a warning.
+    /// External tilesets are supported in the JSON format (.tsj / .json). Group layers are flattened.
+    /// Read-only once constructed; readTiles() may run on any thread with its own stream.
+    class TiledMap final
+    {
+    public:
+        static constexpr std::uint32_t TILE_CHECKPOINT_STRIDE = 512;
+
+    private:
+        std::string file_path_;
+        int tile_width_ = 0;
+        int tile_height_ = 0;
+        bool infinite_ = false;
+        /// @brief All tiles of the map; for infinite maps the union of the chunks of all layers.
+        TileRect bounds_;
+        std::vector<TiledTileset> tilesets_;
+        std::vector<TiledTileLayer> tile_layers_;
+        std::vector<TiledObjectLayer> object_layers_;
+
+        class SaxHandler;
+        void loadExternalTileset(TiledTileset &tileset);
+
+    public:
+        /// @brief Throws std::runtime_error if the file cannot be read or is not a valid Tiled map.
+        explicit TiledMap(const std::string &file_path);
+
+        TiledMap(const TiledMap &) = delete;
+        TiledMap &operator=(const TiledMap &) = delete;
+        TiledMap(TiledMap &&) = delete;
+        TiledMap &operator=(TiledMap &&) = delete;
+
+        const std::string &getFilePath() const { return file_path_; }
+        int getTileWidth() const { return tile_width_; }
+        int getTileHeight() const { return tile_height_; }
+        bool isInfinite() const { return infinite_; }
+        const TileRect &getBounds() const { return bounds_; }
+
+        const std::vector<TiledTileset> &getTilesets() const { return tilesets_; }
+        const std::vector<TiledTileLayer> &getTileLayers() const { return tile_layers_; }
+        const std::vector<TiledObjectLayer> &getObjectLayers() const { return object_layers_; }
+        /// @brief Returns nullptr if there is no object layer with that name.
+        const TiledObjectLayer *findObjectLayer(const std::string &name) const;
+        /// @brief Index into getTilesets() of the tileset holding gid, or -1. Flag bits are ignored.
+        int findTileset(std::uint32_t gid) const;
+
+        /// @brief Reads the ids of rect from a tile layer, row by row, into out (rect.width * rect.height ids).
+        /// Tiles outside the layer are 0. file must be opened on getFilePath() in binary mode.
+        /// Returns false if the file could not be read as indexed.
+        bool readTiles(std::istream &file, std::size_t layer, const TileRect &rect, std::span<std::uint32_t> out) const;
+
+        /// @brief Bytes used by the index of the tile layers, which grows with the map's area / TILE_CHECKPOINT_STRIDE.
+        std::size_t getIndexMemoryUsage() const;
+    };
+} // namespace engine::level
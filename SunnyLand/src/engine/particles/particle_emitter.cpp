@@ -0,0 +1,167 @@
+#include "particle_emitter.h"
+#include "../render/render_snapshot.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SUNNYLAND_PARTICLES_SSE2 1
+#endif
+
+namespace engine::particles
+{
+    namespace
+    {
+        float lerp(float a, float b, float t) { return a + (b - a) * t; }
+    }
+
+    ParticleEmitter::ParticleEmitter(const EmitterSettings &settings, const glm::vec2 &position, std::uint64_t seed)
+        : settings_(settings), position_(position), random_(seed)
+    {
+        settings_.frame_count = std::max(settings_.frame_count, 1);
+        settings_.lifetime_min = std::max(settings_.lifetime_min, 0.001f);
+        settings_.lifetime_max = std::max(settings_.lifetime_max, settings_.lifetime_min);
+
+        // The pool is allocated once; spawning never reallocates
+        std::size_t capacity = settings_.max_particles;
+        for (auto *column : {&x_, &y_, &vx_, &vy_, &age_, &inv_lifetime_, &size_})
+        {
+            column->resize(capacity);
+        }
+    }
+
+    void ParticleEmitter::update(float delta_time)
+    {
+        integrate(delta_time);
+        removeDead();
+
+        if (active_ && settings_.emit_rate > 0.0f)
+        {
+            emit_accumulator_ += settings_.emit_rate * delta_time;
+            auto count = static_cast<std::size_t>(emit_accumulator_);
+            emit_accumulator_ -= static_cast<float>(count);
+            spawn(count);
+        }
+    }
+
+    void ParticleEmitter::burst(std::size_t count)
+    {
+        spawn(count);
+    }
+
+    void ParticleEmitter::spawn(std::size_t count)
+    {
+        count = std::min(count, settings_.max_particles - count_);
+        const float half_spread = settings_.spread * 0.5f;
+        for (std::size_t n = 0; n < count; ++n)
+        {
+            std::size_t i = count_++;
+            float angle = settings_.direction + random_.range(-half_spread, half_spread);
+            float speed = random_.range(settings_.speed_min, settings_.speed_max);
+            x_[i] = position_.x + random_.range(-settings_.spawn_radius, settings_.spawn_radius);
+            y_[i] = position_.y + random_.range(-settings_.spawn_radius, settings_.spawn_radius);
+            vx_[i] = std::cos(angle) * speed;
+            vy_[i] = std::sin(angle) * speed;
+            age_[i] = 0.0f;
+            inv_lifetime_[i] = 1.0f / random_.range(settings_.lifetime_min, settings_.lifetime_max);
+            size_[i] = 1.0f + random_.range(-settings_.size_variance, settings_.size_variance);
+        }
+    }
+
+    void ParticleEmitter::integrate(float delta_time)
+    {
+        const float damping = std::max(0.0f, 1.0f - settings_.drag * delta_time);
+        const float gravity_x = settings_.gravity.x * delta_time;
+        const float gravity_y = settings_.gravity.y * delta_time;
+
+        float *x = x_.data();
+        float *y = y_.data();
+        float *vx = vx_.data();
+        float *vy = vy_.data();
+        float *age = age_.data();
+        std::size_t i = 0;
+
+#ifdef SUNNYLAND_PARTICLES_SSE2
+        const __m128 damping4 = _mm_set1_ps(damping);
+        const __m128 gravity_x4 = _mm_set1_ps(gravity_x);
+        const __m128 gravity_y4 = _mm_set1_ps(gravity_y);
+        const __m128 dt4 = _mm_set1_ps(delta_time);
+        for (; i + 4 <= count_; i += 4)
+        {
+            __m128 new_vx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vx + i), damping4), gravity_x4);
+            __m128 new_vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), damping4), gravity_y4);
+            _mm_storeu_ps(vx + i, new_vx);
+            _mm_storeu_ps(vy + i, new_vy);
+            _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(new_vx, dt4)));
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(new_vy, dt4)));
+            _mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), dt4));
+        }
+#endif
+        // Same operations in the same order as above, so both paths give identical results
+        for (; i < count_; ++i)
+        {
+            vx[i] = vx[i] * damping + gravity_x;
+            vy[i] = vy[i] * damping + gravity_y;
+            x[i] += vx[i] * delta_time;
+            y[i] += vy[i] * delta_time;
+            age[i] += delta_time;
+        }
+    }
+
+    void ParticleEmitter::removeDead()
+    {
+        std::size_t i = 0;
+        while (i < count_)
+        {
+            if (age_[i] * inv_lifetime_[i] < 1.0f)
+            {
+                ++i;
+                continue;
+            }
+            // The last particle takes the dead one's slot and is checked on the next iteration
+            std::size_t last = --count_;
+            x_[i] = x_[last];
+            y_[i] = y_[last];
+            vx_[i] = vx_[last];
+            vy_[i] = vy_[last];
+            age_[i] = age_[last];
+            inv_lifetime_[i] = inv_lifetime_[last];
+            size_[i] = size_[last];
+        }
+    }
+
+    void ParticleEmitter::extract(engine::render::RenderSnapshot &snapshot) const
+    {
+        if (count_ == 0 || settings_.texture_id == engine::utils::EMPTY_STRING_ID)
+        {
+            return;
+        }
+
+        const engine::render::Camera &camera = snapshot.getCamera();
+        glm::vec2 view_min = camera.getPosition();
+        glm::vec2 view_max = view_min + camera.getViewportSize();
+        const SDL_FRect &rect = settings_.source_rect;
+        const float half_extent = std::max(rect.w, rect.h) * 0.5f *
+                                  std::max(settings_.size_start, settings_.size_end) * (1.0f + settings_.size_variance);
+        const SDL_FColor &c0 = settings_.color_start;
+        const SDL_FColor &c1 = settings_.color_end;
+        const float frames = static_cast<float>(settings_.frame_count);
+
+        std::vector<engine::render::ParticleInstance> &out = snapshot.getParticleBatch(settings_.texture_id);
+        out.reserve(out.size() + count_);
+        for (std::size_t i = 0; i < count_; ++i)
+        {
+            if (x_[i] + half_extent < view_min.x || x_[i] - half_extent > view_max.x ||
+                y_[i] + half_extent < view_min.y || y_[i] - half_extent > view_max.y)
+            {
+                continue;
+            }
+            float t = std::min(age_[i] * inv_lifetime_[i], 1.0f);
+            int frame = std::min(static_cast<int>(t * frames), settings_.frame_count - 1);
+            SDL_FRect source = {rect.x + rect.w * static_cast<float>(frame), rect.y, rect.w, rect.h};
+            out.push_back({{x_[i], y_[i]},
+                           size_[i] * lerp(settings_.size_start, settings_.size_end, t),
+                           {lerp(c0.r, c1.r, t), lerp(c0.g, c1.g, t), lerp(c0.b, c1.b, t), lerp(c0.a, c1.a, t)},
+                           source});
+        }
+    }
+} // namespace engine::particles
@@ -0,0 +1,97 @@
+#pragma once
+#include "../utils/string_id.h"
+#include "../utils/random.h"
+#include <cstddef>
+#include <vector>
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_rect.h>
+#include <glm/vec2.hpp>
+
+namespace engine::render
+{
+    class RenderSnapshot;
+}
+
+namespace engine::particles
+{
+    /// @brief How an emitter spawns its particles and how they change over their life.
+    struct EmitterSettings
+    {
+        engine::utils::StringId texture_id = engine::utils::EMPTY_STRING_ID;
+        /// @brief First frame of the texture. Further frames follow to the right and are picked by age.
+        SDL_FRect source_rect = {0.0f, 0.0f, 0.0f, 0.0f};
+        int frame_count = 1;
+
+        std::size_t max_particles = 1024;
+        /// @brief Particles spawned per second while the emitter is active (0 = bursts only).
+        float emit_rate = 0.0f;
+        float lifetime_min = 0.5f;
+        float lifetime_max = 1.0f;
+        float speed_min = 0.0f;
+        float speed_max = 50.0f;
+        /// @brief Emission direction and the angle around it, in radians. 0 points right, y points down.
+        float direction = 0.0f;
+        float spread = 6.2831853f;
+        /// @brief Random offset of the spawn point in both axes.
+        float spawn_radius = 0.0f;
+
+        glm::vec2 gravity = {0.0f, 0.0f};
+        /// @brief Fraction of the velocity lost per second.
+        float drag = 0.0f;
+
+        /// @brief Scale of the source rect at birth and death.
+        float size_start = 1.0f;
+        float size_end = 1.0f;
+        float size_variance = 0.0f;
+        SDL_FColor color_start = {1.0f, 1.0f, 1.0f, 1.0f};
+        SDL_FColor color_end = {1.0f, 1.0f, 1.0f, 0.0f};
+    };
+
+    /// @brief Spawns and simulates particles of one texture.
+    /// Particles are kept in one array per attribute so that update() streams through contiguous floats;
+    /// dead particles are replaced by the last live one, keeping the arrays packed.
+    class ParticleEmitter final
+    {
+    private:
+        EmitterSettings settings_;
+        glm::vec2 position_;
+        engine::utils::Random random_;
+        bool active_ = true;
+        float emit_accumulator_ = 0.0f;
+        std::size_t count_ = 0;
+
+        std::vector<float> x_, y_, vx_, vy_;
+        std::vector<float> age_, inv_lifetime_, size_;
+
+        void spawn(std::size_t count);
+        void integrate(float delta_time);
+        void removeDead();
+
+    public:
+        ParticleEmitter(const EmitterSettings &settings, const glm::vec2 &position, std::uint64_t seed);
+
+        ParticleEmitter(const ParticleEmitter &) = delete;
+        ParticleEmitter &operator=(const ParticleEmitter &) = delete;
+        ParticleEmitter(ParticleEmitter &&) = delete;
+        ParticleEmitter &operator=(ParticleEmitter &&) = delete;
+
+        /// @brief Emits new particles, moves the live ones and removes the expired ones.
+        void update(float delta_time);
+        /// @brief Spawns count particles at once. Particles beyond max_particles are dropped.
+        void burst(std::size_t count);
+
+        /// @brief Appends the live particles to the snapshot batch of the emitter's texture.
+        void extract(engine::render::RenderSnapshot &snapshot) const;
+
+        void setPosition(const glm::vec2 &position) { position_ = position; }
+        const glm::vec2 &getPosition() const { return position_; }
+        /// @brief Inactive emitters stop emitting; their live particles still finish their life.
+        void setActive(bool active) { active_ = active; }
+        bool isActive() const { return active_; }
+        const EmitterSettings &getSettings() const { return settings_; }
+
+        std::size_t getCount() const { return count_; }
+        /// @brief True when the emitter no longer emits and has no live particles.
+        bool isFinished() const { return (!active_ || settings_.emit_rate <= 0.0f) && count_ == 0; }
+    };
+} // namespace engine::particles
@@ -0,0 +1,99 @@
+#include "particle_system.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::particles
+{
+    EmitterId ParticleSystem::createEmitter(const EmitterSettings &settings, const glm::vec2 &position, std::uint64_t seed)
+    {
+        std::uint32_t index;
+        if (!free_slots_.empty())
+        {
+            index = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        Slot &slot = slots_[index];
+        slot.emitter = std::make_unique<ParticleEmitter>(settings, position, seed);
+        slot.release_when_finished = false;
+        return {index, slot.generation};
+    }
+
+    ParticleEmitter *ParticleSystem::getEmitter(EmitterId id) const
+    {
+        if (id.index >= slots_.size() || slots_[id.index].generation != id.generation)
+        {
+            return nullptr;
+        }
+        return slots_[id.index].emitter.get();
+    }
+
+    void ParticleSystem::destroyEmitter(EmitterId id, bool let_finish)
+    {
+        ParticleEmitter *emitter = getEmitter(id);
+        if (!emitter)
+        {
+            spdlog::warn("Trying to destroy a particle emitter that does not exist");
+            return;
+        }
+        Slot &slot = slots_[id.index];
+        if (let_finish)
+        {
+            emitter->setActive(false);
+            slot.release_when_finished = true;
+            return;
+        }
+        slot.emitter.reset();
+        ++slot.generation;
+        free_slots_.push_back(id.index);
+    }
+
+    void ParticleSystem::update(float delta_time)
+    {
+        particle_count_ = 0;
+        for (std::uint32_t i = 0; i < slots_.size(); ++i)
+        {
+            Slot &slot = slots_[i];
+            if (!slot.emitter)
+            {
+                continue;
+            }
+            slot.emitter->update(delta_time);
+            if (slot.release_when_finished && slot.emitter->isFinished())
+            {
+                destroyEmitter({i, slot.generation});
+                continue;
+            }
+            particle_count_ += slot.emitter->getCount();
+        }
+    }
+
+    void ParticleSystem::extract(engine::render::RenderSnapshot &snapshot) const
+    {
+        for (const Slot &slot : slots_)
+        {
+            if (slot.emitter)
+            {
+                slot.emitter->extract(snapshot);
+            }
+        }
+    }
+
+    void ParticleSystem::clear()
+    {
+        for (Slot &slot : slots_)
+        {
+            slot.emitter.reset();
+            ++slot.generation;
+        }
+        free_slots_.clear();
+        for (std::uint32_t i = static_cast<std::uint32_t>(slots_.size()); i > 0; --i)
+        {
+            free_slots_.push_back(i - 1);
+        }
+        particle_count_ = 0;
+    }
+} // namespace engine::particles
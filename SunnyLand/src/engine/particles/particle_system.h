@@ -0,0 +1,57 @@
+#pragma once
+#include "particle_emitter.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine::particles
+{
+    /// @brief Handle of an emitter. Stays invalid after the emitter is destroyed, even if its slot is reused.
+    struct EmitterId
+    {
+        std::uint32_t index = UINT32_MAX;
+        std::uint32_t generation = 0;
+
+        bool isValid() const { return index != UINT32_MAX; }
+    };
+
+    /// @brief Owns every particle emitter. Updated with the simulation and extracted into the render snapshot.
+    class ParticleSystem final
+    {
+    private:
+        struct Slot
+        {
+            std::unique_ptr<ParticleEmitter> emitter;
+            std::uint32_t generation = 0;
+            /// @brief Destroy the emitter once it has no particles left instead of immediately.
+            bool release_when_finished = false;
+        };
+
+        std::vector<Slot> slots_;
+        std::vector<std::uint32_t> free_slots_;
+        std::size_t particle_count_ = 0;
+
+    public:
+        ParticleSystem() = default;
+
+        ParticleSystem(const ParticleSystem &) = delete;
+        ParticleSystem &operator=(const ParticleSystem &) = delete;
+        ParticleSystem(ParticleSystem &&) = delete;
+        ParticleSystem &operator=(ParticleSystem &&) = delete;
+
+        EmitterId createEmitter(const EmitterSettings &settings, const glm::vec2 &position, std::uint64_t seed);
+        /// @brief Returns nullptr when the handle no longer refers to a live emitter.
+        ParticleEmitter *getEmitter(EmitterId id) const;
+        /// @brief Destroys the emitter. With let_finish the emitter stops emitting and is destroyed once its particles died.
+        void destroyEmitter(EmitterId id, bool let_finish = false);
+
+        void update(float delta_time);
+        /// @brief Adds the live particles of all emitters to the snapshot, one batch per texture.
+        void extract(engine::render::RenderSnapshot &snapshot) const;
+        void clear();
+
+        std::size_t getEmitterCount() const { return slots_.size() - free_slots_.size(); }
+        /// @brief Live particles after the last update().
+        std::size_t getParticleCount() const { return particle_count_; }
+    };
+} // namespace engine::particles
@@ -0,0 +1,188 @@
+#include "broad_phase.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::physics
+{
+    namespace
+    {
+        /// @brief Upper bounds sort after lower bounds at the same x, so touching bounds count as overlapping.
+        bool endpointLess(float a_value, std::uint32_t a_side, float b_value, std::uint32_t b_side)
+        {
+            return a_value < b_value || (a_value == b_value && (a_side & 1u) < (b_side & 1u));
+        }
+
+        /// @brief Incremental sorting gives up after this many swaps per endpoint; a full sort is faster then.
+        constexpr std::size_t MAX_SWAPS_PER_ENDPOINT = 8;
+    }
+
+    ProxyId BroadPhase::createProxy(const engine::utils::Rect &bounds, CollisionLayers layers, CollisionLayers mask,
+                                    std::uint64_t user_data)
+    {
+        ProxyId id;
+        if (!free_proxies_.empty())
+        {
+            id = free_proxies_.back();
+            free_proxies_.pop_back();
+        }
+        else
+        {
+            id = static_cast<ProxyId>(proxies_.size());
+            proxies_.emplace_back();
+        }
+        proxies_[id] = {bounds, layers, mask, user_data, true};
+        endpoints_.push_back({bounds.position.x, id << 1});
+        endpoints_.push_back({bounds.position.x + bounds.size.x, (id << 1) | 1u});
+        ++added_since_update_;
+        ++proxy_count_;
+        return id;
+    }
+
+    void BroadPhase::destroyProxy(ProxyId id)
+    {
+        if (!isValid(id))
+        {
+            spdlog::warn("Trying to destroy broad phase proxy {} which does not exist", id);
+            return;
+        }
+        proxies_[id].alive = false;
+        // The id is only reused once update() dropped its endpoints
+        destroyed_proxies_.push_back(id);
+        --proxy_count_;
+    }
+
+    void BroadPhase::moveProxy(ProxyId id, const engine::utils::Rect &bounds)
+    {
+        proxies_[id].bounds = bounds;
+    }
+
+    void BroadPhase::setFilter(ProxyId id, CollisionLayers layers, CollisionLayers mask)
+    {
+        proxies_[id].layers = layers;
+        proxies_[id].mask = mask;
+    }
+
+    void BroadPhase::update()
+    {
+        stats_ = {};
+        stats_.proxies = proxy_count_;
+        refreshEndpoints();
+        sortEndpoints();
+        sweep();
+        added_since_update_ = 0;
+    }
+
+    void BroadPhase::clear()
+    {
+        proxies_.clear();
+        free_proxies_.clear();
+        destroyed_proxies_.clear();
+        endpoints_.clear();
+        active_.clear();
+        pairs_.clear();
+        proxy_count_ = 0;
+        added_since_update_ = 0;
+        stats_ = {};
+    }
+
+    void BroadPhase::refreshEndpoints()
+    {
+        if (!destroyed_proxies_.empty())
+        {
+            std::erase_if(endpoints_, [this](const Endpoint &endpoint)
+                          { return !proxies_[endpoint.proxy_and_side >> 1].alive; });
+            free_proxies_.insert(free_proxies_.end(), destroyed_proxies_.begin(), destroyed_proxies_.end());
+            destroyed_proxies_.clear();
+        }
+
+        for (Endpoint &endpoint : endpoints_)
+        {
+            const engine::utils::Rect &bounds = proxies_[endpoint.proxy_and_side >> 1].bounds;
+            endpoint.value = (endpoint.proxy_and_side & 1u) ? bounds.position.x + bounds.size.x : bounds.position.x;
+        }
+    }
+
+    void BroadPhase::sortEndpoints()
+    {
+        auto full_sort = [this]
+        {
+            std::sort(endpoints_.begin(), endpoints_.end(), [](const Endpoint &a, const Endpoint &b)
+                      { return endpointLess(a.value, a.proxy_and_side, b.value, b.proxy_and_side); });
+            stats_.full_sort = true;
+        };
+
+        // Newly added endpoints start at the end of the array and would each travel through all others
+        if (added_since_update_ * 8 > endpoints_.size())
+        {
+            full_sort();
+            return;
+        }
+
+        // Insertion sort: proxies move little between updates, so most endpoints stay in place
+        const std::size_t max_swaps = endpoints_.size() * MAX_SWAPS_PER_ENDPOINT;
+        std::size_t swaps = 0;
+        for (std::size_t i = 1; i < endpoints_.size(); ++i)
+        {
+            Endpoint key = endpoints_[i];
+            std::size_t j = i;
+            while (j > 0 && endpointLess(key.value, key.proxy_and_side, endpoints_[j - 1].value, endpoints_[j - 1].proxy_and_side))
+            {
+                endpoints_[j] = endpoints_[j - 1];
+                --j;
+            }
+            endpoints_[j] = key;
+            swaps += i - j;
+            if (swaps > max_swaps)
+            {
+                stats_.endpoint_swaps = swaps;
+                full_sort();
+                return;
+            }
+        }
+        stats_.endpoint_swaps = swaps;
+    }
+
+    void BroadPhase::sweep()
+    {
+        pairs_.clear();
+        active_.clear();
+        active_index_.resize(proxies_.size());
+
+        for (const Endpoint &endpoint : endpoints_)
+        {
+            ProxyId id = endpoint.proxy_and_side >> 1;
+            if (endpoint.proxy_and_side & 1u)
+            {
+                // Leaving the interval: the last active proxy takes its place
+                std::uint32_t index = active_index_[id];
+                active_[index] = active_.back();
+                active_index_[active_[index].id] = index;
+                active_.pop_back();
+                continue;
+            }
+
+            const Proxy &proxy = proxies_[id];
+            const float min_y = proxy.bounds.position.y;
+            const float max_y = min_y + proxy.bounds.size.y;
+            stats_.pairs_tested += active_.size();
+            for (const ActiveProxy &other : active_)
+            {
+                // Most proxies in the active list are far away on y, so that is tested first
+                if (other.min_y > max_y || min_y > other.max_y)
+                {
+                    continue;
+                }
+                if ((other.layers & proxy.mask) == 0 || (proxy.layers & other.mask) == 0)
+                {
+                    ++stats_.pairs_filtered;
+                    continue;
+                }
+                pairs_.push_back({std::min(id, other.id), std::max(id, other.id)});
+            }
+
+            active_index_[id] = static_cast<std::uint32_t>(active_.size());
+            active_.push_back({min_y, max_y, proxy.layers, proxy.mask, id});
+        }
+        stats_.pairs_found = pairs_.size();
+    }
+} // namespace engine::physics
@@ -0,0 +1,116 @@
+#pragma once
+#include "../utils/math.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics
+{
+    using ProxyId = std::uint32_t;
+    constexpr ProxyId INVALID_PROXY = UINT32_MAX;
+
+    /// @brief Layer bits of a proxy. Two proxies are paired only if each one's mask contains the other's layer.
+    using CollisionLayers = std::uint32_t;
+    constexpr CollisionLayers ALL_LAYERS = UINT32_MAX;
+
+    /// @brief Two proxies whose bounds overlap. first < second.
+    struct ProxyPair
+    {
+        ProxyId first;
+        ProxyId second;
+    };
+
+    /// @brief Counters of the last update(), for profiling.
+    struct BroadPhaseStats
+    {
+        std::size_t proxies = 0;
+        /// @brief Endpoint swaps of the incremental sort. Low when proxies moved little.
+        std::size_t endpoint_swaps = 0;
+        /// @brief True when the endpoints were sorted from scratch instead of incrementally.
+        bool full_sort = false;
+        /// @brief Proxy pairs overlapping on x, i.e. the pairs whose y range was tested.
+        std::size_t pairs_tested = 0;
+        /// @brief Overlapping pairs that the layer masks rejected.
+        std::size_t pairs_filtered = 0;
+        std::size_t pairs_found = 0;
+    };
+
+    /// @brief Finds overlapping bounds with sweep and prune along x.
+    /// The endpoint array stays sorted between updates, so with small movements re-sorting it is close
+    /// to linear. The sweep then only tests proxies whose x intervals overlap.
+    class BroadPhase final
+    {
+    private:
+        /// @brief Lower or upper x bound of a proxy. The lowest bit of proxy_and_side is set for the upper bound.
+        struct Endpoint
+        {
+            float value;
+            std::uint32_t proxy_and_side;
+        };
+
+        /// @brief Copy of a proxy's sweep data in the active list, so testing it needs no lookup.
+        struct ActiveProxy
+        {
+            float min_y;
+            float max_y;
+            CollisionLayers layers;
+            CollisionLayers mask;
+            ProxyId id;
+        };
+
+        struct Proxy
+        {
+            engine::utils::Rect bounds;
+            CollisionLayers layers = 0;
+            CollisionLayers mask = 0;
+            std::uint64_t user_data = 0;
+            bool alive = false;
+        };
+
+        std::vector<Proxy> proxies_;
+        std::vector<ProxyId> free_proxies_;
+        /// @brief Destroyed proxies whose endpoints are still in the array. Freed by the next update().
+        std::vector<ProxyId> destroyed_proxies_;
+        std::size_t proxy_count_ = 0;
+        std::vector<Endpoint> endpoints_;
+        std::size_t added_since_update_ = 0;
+
+        std::vector<ActiveProxy> active_;
+        /// @brief Position of each proxy in active_ while the sweep is inside its interval.
+        std::vector<std::uint32_t> active_index_;
+        std::vector<ProxyPair> pairs_;
+        BroadPhaseStats stats_;
+
+        void refreshEndpoints();
+        void sortEndpoints();
+        void sweep();
+
+    public:
+        BroadPhase() = default;
+
+        BroadPhase(const BroadPhase &) = delete;
+        BroadPhase &operator=(const BroadPhase &) = delete;
+        BroadPhase(BroadPhase &&) = delete;
+        BroadPhase &operator=(BroadPhase &&) = delete;
+
+        ProxyId createProxy(const engine::utils::Rect &bounds, CollisionLayers layers, CollisionLayers mask,
+                            std::uint64_t user_data = 0);
+        void destroyProxy(ProxyId id);
+        /// @brief Sets the bounds used by the next update().
+        void moveProxy(ProxyId id, const engine::utils::Rect &bounds);
+        void setFilter(ProxyId id, CollisionLayers layers, CollisionLayers mask);
+
+        bool isValid(ProxyId id) const { return id < proxies_.size() && proxies_[id].alive; }
+        const engine::utils::Rect &getBounds(ProxyId id) const { return proxies_[id].bounds; }
+        std::uint64_t getUserData(ProxyId id) const { return proxies_[id].user_data; }
+
+        /// @brief Re-sorts the endpoints and collects the overlapping pairs.
+        void update();
+
+        /// @brief Pairs found by the last update(), ordered by the x position where they start to overlap.
+        const std::vector<ProxyPair> &getPairs() const { return pairs_; }
+        const BroadPhaseStats &getStats() const { return stats_; }
+        std::size_t getProxyCount() const { return proxy_count_; }
+        void clear();
+    };
+} // namespace engine::physics
@@ -0,0 +1,21 @@
+#pragma once
+#include "broad_phase.h"
+#include "../ecs/component.h"
+#include <string_view>
+#include <glm/vec2.hpp>
+
+namespace engine::physics
+{
+    /// @brief Axis-aligned bounds of an entity, relative to its Transform position, registered with the broad phase.
+    struct Collider
+    {
+        static constexpr std::string_view COMPONENT_NAME = "Collider";
+
+        glm::vec2 offset{0.0f, 0.0f};
+        glm::vec2 size{0.0f, 0.0f};
+        CollisionLayers layers = 1;
+        CollisionLayers mask = ALL_LAYERS;
+        /// @brief Managed by the CollisionSystem.
+        ProxyId proxy = INVALID_PROXY;
+    };
+} // namespace engine::physics
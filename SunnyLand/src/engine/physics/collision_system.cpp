@@ -0,0 +1,64 @@
+#include "collision_system.h"
+#include "collider.h"
+#include "../ecs/world.h"
+#include "../ecs/components.h"
+
+namespace engine::physics
+{
+    namespace
+    {
+        std::uint64_t packEntity(engine::ecs::Entity entity)
+        {
+            return (static_cast<std::uint64_t>(entity.generation) << 32) | entity.index;
+        }
+    }
+
+    CollisionSystem::CollisionSystem(engine::ecs::World &world)
+        : query_(world.query<engine::ecs::Transform, Collider>())
+    {
+    }
+
+    engine::ecs::SystemAccess CollisionSystem::getAccess() const
+    {
+        return engine::ecs::SystemAccess().read<engine::ecs::Transform>().write<Collider>();
+    }
+
+    engine::ecs::Entity CollisionSystem::getEntity(ProxyId proxy) const
+    {
+        std::uint64_t packed = broad_phase_.getUserData(proxy);
+        return {static_cast<std::uint32_t>(packed), static_cast<std::uint32_t>(packed >> 32)};
+    }
+
+    void CollisionSystem::update(const engine::ecs::SystemContext &)
+    {
+        ++tick_;
+        query_.eachWithEntity<engine::ecs::Transform, Collider>([this](engine::ecs::Entity entity, const engine::ecs::Transform &transform, Collider &collider)
+                                                                {
+                                                                    engine::utils::Rect bounds{transform.position + collider.offset, collider.size};
+                                                                    std::uint64_t owner = packEntity(entity);
+                                                                    // A copied or stale id may point at a proxy that belongs to another entity now
+                                                                    if (!broad_phase_.isValid(collider.proxy) || broad_phase_.getUserData(collider.proxy) != owner)
+                                                                    {
+                                                                        collider.proxy = broad_phase_.createProxy(bounds, collider.layers, collider.mask, owner);
+                                                                        if (collider.proxy >= last_seen_.size())
+                                                                        {
+                                                                            last_seen_.resize(collider.proxy + 1, 0);
+                                                                        }
+                                                                    }
+                                                                    else
+                                                                    {
+                                                                        broad_phase_.moveProxy(collider.proxy, bounds);
+                                                                        broad_phase_.setFilter(collider.proxy, collider.layers, collider.mask);
+                                                                    }
+                                                                    last_seen_[collider.proxy] = tick_; });
+
+        for (ProxyId proxy = 0; proxy < last_seen_.size(); ++proxy)
+        {
+            if (last_seen_[proxy] != tick_ && broad_phase_.isValid(proxy))
+            {
+                broad_phase_.destroyProxy(proxy);
+            }
+        }
+        broad_phase_.update();
+    }
+} // namespace engine::physics
@@ -0,0 +1,36 @@
+#pragma once
+#include "broad_phase.h"
+#include "../ecs/entity.h"
+#include "../ecs/system.h"
+#include <vector>
+
+namespace engine::ecs
+{
+    class Query;
+}
+
+namespace engine::physics
+{
+    /// @brief Keeps a broad phase proxy for every entity with a Transform and a Collider and finds the overlapping ones.
+    /// Proxies of entities that lost their Collider or were destroyed are removed on the next update.
+    class CollisionSystem final : public engine::ecs::System
+    {
+    private:
+        engine::ecs::Query &query_;
+        BroadPhase broad_phase_;
+        /// @brief Tick each proxy was last seen in, to find the ones whose entity is gone.
+        std::vector<std::uint32_t> last_seen_;
+        std::uint32_t tick_ = 0;
+
+    public:
+        explicit CollisionSystem(engine::ecs::World &world);
+
+        std::string_view getName() const override { return "CollisionSystem"; }
+        engine::ecs::SystemAccess getAccess() const override;
+        void update(const engine::ecs::SystemContext &context) override;
+
+        /// @brief Pairs and statistics of the last update. The user data of each proxy is its entity, see getEntity().
+        const BroadPhase &getBroadPhase() const { return broad_phase_; }
+        engine::ecs::Entity getEntity(ProxyId proxy) const;
+    };
+} // namespace engine::physics
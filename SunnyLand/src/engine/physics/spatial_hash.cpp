@@ -0,0 +1,182 @@
+#include "spatial_hash.h"
+#include <bit>
+#include <stdexcept>
+#include <spdlog/spdlog.h>
+
+namespace engine::physics
+{
+    SpatialHash::SpatialHash(float cell_size) : cell_size_(cell_size)
+    {
+        if (!(cell_size > 0.0f))
+        {
+            throw std::runtime_error("SpatialHash cell size must be positive");
+        }
+        inv_cell_size_ = 1.0f / cell_size;
+    }
+
+    int SpatialHash::toCell(float world) const
+    {
+        // Clamped so that far away or invalid coordinates still give a valid cell
+        float cell = std::floor(world * inv_cell_size_);
+        return cell >= -1073741824.0f && cell <= 1073741824.0f ? static_cast<int>(cell) : (cell > 0.0f ? 1073741824 : -1073741824);
+    }
+
+    SpatialHash::CellRange SpatialHash::cellRange(const engine::utils::Rect &bounds) const
+    {
+        return {toCell(bounds.position.x), toCell(bounds.position.y),
+                toCell(bounds.position.x + bounds.size.x), toCell(bounds.position.y + bounds.size.y)};
+    }
+
+    const SpatialHash::Cell *SpatialHash::findCell(int x, int y) const
+    {
+        std::uint64_t key = cellKey(x, y);
+        for (std::uint64_t slot = hashKey(key) & cell_mask_;; slot = (slot + 1) & cell_mask_)
+        {
+            const Cell &cell = cells_[slot];
+            if (cell.count == 0)
+                return nullptr;
+            if (cell.key == key)
+                return &cell;
+        }
+    }
+
+    SpatialHash::Cell &SpatialHash::findOrInsertCell(int x, int y)
+    {
+        std::uint64_t key = cellKey(x, y);
+        for (std::uint64_t slot = hashKey(key) & cell_mask_;; slot = (slot + 1) & cell_mask_)
+        {
+            Cell &cell = cells_[slot];
+            if (cell.count == 0)
+            {
+                cell.key = key;
+                ++used_cells_;
+                return cell;
+            }
+            if (cell.key == key)
+                return cell;
+        }
+    }
+
+    SpatialItem SpatialHash::insert(const engine::utils::Rect &bounds)
+    {
+        SpatialItem item;
+        if (!free_items_.empty())
+        {
+            item = free_items_.back();
+            free_items_.pop_back();
+            bounds_[item] = bounds;
+            alive_[item] = true;
+        }
+        else
+        {
+            item = static_cast<SpatialItem>(bounds_.size());
+            bounds_.push_back(bounds);
+            ranges_.push_back({});
+            alive_.push_back(true);
+        }
+        // ranges_ keeps describing the table until the next build()
+        dirty_ = true;
+        return item;
+    }
+
+    void SpatialHash::move(SpatialItem item, const engine::utils::Rect &bounds)
+    {
+        bounds_[item] = bounds;
+        // Still in the same cells: the table stays valid
+        if (!dirty_ && cellRange(bounds) != ranges_[item])
+        {
+            dirty_ = true;
+        }
+    }
+
+    void SpatialHash::remove(SpatialItem item)
+    {
+        if (!isValid(item))
+        {
+            spdlog::warn("Trying to remove spatial hash item {} which does not exist", item);
+            return;
+        }
+        alive_[item] = false;
+        free_items_.push_back(item);
+        dirty_ = true;
+    }
+
+    void SpatialHash::clear()
+    {
+        bounds_.clear();
+        ranges_.clear();
+        alive_.clear();
+        free_items_.clear();
+        cell_items_.clear();
+        std::fill(cells_.begin(), cells_.end(), Cell{0, 0, 0});
+        used_cells_ = 0;
+        dirty_ = false;
+    }
+
+    void SpatialHash::build()
+    {
+        if (!dirty_)
+        {
+            return;
+        }
+        dirty_ = false;
+
+        // Counts the entries of every cell, then hands each cell its slice of cell_items_
+        std::size_t entries = 0;
+        for (SpatialItem item = 0; item < bounds_.size(); ++item)
+        {
+            if (!alive_[item])
+                continue;
+            CellRange &range = ranges_[item];
+            range = cellRange(bounds_[item]);
+            entries += static_cast<std::size_t>(range.max_x - range.min_x + 1) * static_cast<std::size_t>(range.max_y - range.min_y + 1);
+        }
+
+        // At most one cell per entry; twice that many slots keeps probe sequences short
+        std::size_t capacity = std::bit_ceil(std::max<std::size_t>(entries * 2, 16));
+        if (cells_.size() != capacity)
+        {
+            cells_.assign(capacity, Cell{0, 0, 0});
+        }
+        else
+        {
+            std::fill(cells_.begin(), cells_.end(), Cell{0, 0, 0});
+        }
+        cell_mask_ = capacity - 1;
+        used_cells_ = 0;
+
+        for (SpatialItem item = 0; item < bounds_.size(); ++item)
+        {
+            if (!alive_[item])
+                continue;
+            const CellRange &range = ranges_[item];
+            for (int y = range.min_y; y <= range.max_y; ++y)
+                for (int x = range.min_x; x <= range.max_x; ++x)
+                    ++findOrInsertCell(x, y).count;
+        }
+
+        // start points past the cell's slice first and is moved back while filling it
+        std::uint32_t end = 0;
+        for (Cell &cell : cells_)
+        {
+            end += cell.count;
+            cell.start = end;
+        }
+
+        cell_items_.resize(entries);
+        for (SpatialItem item = 0; item < bounds_.size(); ++item)
+        {
+            if (!alive_[item])
+                continue;
+            const CellRange &range = ranges_[item];
+            for (int y = range.min_y; y <= range.max_y; ++y)
+            {
+                for (int x = range.min_x; x <= range.max_x; ++x)
+                {
+                    Cell &cell = findOrInsertCell(x, y);
+                    cell_items_[--cell.start] = item;
+                }
+            }
+        }
+    }
+} // namespace engine::physics
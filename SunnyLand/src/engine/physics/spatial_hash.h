@@ -0,0 +1,245 @@
+#pragma once
+#include "../utils/math.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace engine::physics
+{
+    /// @brief Index of an item in a SpatialHash.
+    using SpatialItem = std::uint32_t;
+
+    /// @brief Uniform grid of square cells for proximity queries, stored in a flat open-addressed table.
+    /// Each cell maps to a contiguous range of one shared item array, so queries touch no per-cell
+    /// containers and never allocate. Items are inserted into every cell their bounds overlap, which
+    /// suits items up to a few cells in size.
+    ///
+    /// Changes become visible to queries after build(). Moving an item within its cells only updates
+    /// its bounds; the table is rebuilt only when an item changed cells or was added or removed.
+    /// Queries are const and may run concurrently.
+    class SpatialHash final
+    {
+    private:
+        struct CellRange
+        {
+            int min_x, min_y, max_x, max_y;
+
+            bool contains(int x, int y) const { return x >= min_x && x <= max_x && y >= min_y && y <= max_y; }
+            bool operator==(const CellRange &) const = default;
+        };
+
+        /// @brief Slot of the cell table. Empty while count is 0.
+        struct Cell
+        {
+            std::uint64_t key;
+            std::uint32_t start;
+            std::uint32_t count;
+        };
+
+        float cell_size_;
+        float inv_cell_size_;
+
+        std::vector<engine::utils::Rect> bounds_;
+        std::vector<CellRange> ranges_;
+        std::vector<bool> alive_;
+        std::vector<SpatialItem> free_items_;
+        bool dirty_ = false;
+
+        std::vector<Cell> cells_;
+        std::uint64_t cell_mask_ = 0;
+        std::vector<SpatialItem> cell_items_;
+        std::size_t used_cells_ = 0;
+
+        static std::uint64_t cellKey(int x, int y) { return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y); }
+        static std::uint64_t hashKey(std::uint64_t key)
+        {
+            key ^= key >> 33;
+            key *= 0xFF51AFD7ED558CCDull;
+            key ^= key >> 33;
+            return key;
+        }
+
+        int toCell(float world) const;
+        CellRange cellRange(const engine::utils::Rect &bounds) const;
+        /// @brief Returns nullptr if no item is in the cell.
+        const Cell *findCell(int x, int y) const;
+        Cell &findOrInsertCell(int x, int y);
+
+        /// @brief Calls func(item) once per live item whose cells overlap range; the caller tests the exact bounds.
+        template <typename Func>
+        void forEachCandidate(const CellRange &range, Func &&func) const
+        {
+            if (used_cells_ == 0)
+            {
+                return;
+            }
+            // Large ranges are cheaper to answer by scanning the occupied cells than by probing each one
+            std::int64_t area = (static_cast<std::int64_t>(range.max_x) - range.min_x + 1) * (static_cast<std::int64_t>(range.max_y) - range.min_y + 1);
+            auto visit = [&](int x, int y, const Cell &cell)
+            {
+                for (std::uint32_t i = cell.start; i < cell.start + cell.count; ++i)
+                {
+                    SpatialItem item = cell_items_[i];
+                    const CellRange &item_range = ranges_[item];
+                    // An item in several cells is reported only from the first cell it shares with the range
+                    if (x == std::max(item_range.min_x, range.min_x) && y == std::max(item_range.min_y, range.min_y))
+                    {
+                        func(item);
+                    }
+                }
+            };
+            if (area > static_cast<std::int64_t>(cells_.size()))
+            {
+                for (const Cell &cell : cells_)
+                {
+                    if (cell.count == 0)
+                        continue;
+                    int x = static_cast<int>(static_cast<std::uint32_t>(cell.key >> 32));
+                    int y = static_cast<int>(static_cast<std::uint32_t>(cell.key));
+                    if (range.contains(x, y))
+                        visit(x, y, cell);
+                }
+                return;
+            }
+            for (int y = range.min_y; y <= range.max_y; ++y)
+            {
+                for (int x = range.min_x; x <= range.max_x; ++x)
+                {
+                    if (const Cell *cell = findCell(x, y))
+                        visit(x, y, *cell);
+                }
+            }
+        }
+
+    public:
+        explicit SpatialHash(float cell_size);
+
+        SpatialHash(const SpatialHash &) = delete;
+        SpatialHash &operator=(const SpatialHash &) = delete;
+        SpatialHash(SpatialHash &&) = delete;
+        SpatialHash &operator=(SpatialHash &&) = delete;
+
+        SpatialItem insert(const engine::utils::Rect &bounds);
+        void move(SpatialItem item, const engine::utils::Rect &bounds);
+        void remove(SpatialItem item);
+        void clear();
+        /// @brief Makes the changes since the last build visible to queries.
+        void build();
+
+        bool isValid(SpatialItem item) const { return item < alive_.size() && alive_[item]; }
+        const engine::utils::Rect &getBounds(SpatialItem item) const { return bounds_[item]; }
+        float getCellSize() const { return cell_size_; }
+        std::size_t getItemCount() const { return bounds_.size() - free_items_.size(); }
+        /// @brief Cells holding at least one item, and item references over all cells, as of the last build().
+        std::size_t getCellCount() const { return used_cells_; }
+        std::size_t getEntryCount() const { return cell_items_.size(); }
+
+        /// @brief Calls func(item) for every item whose bounds overlap rect (touching counts).
+        template <typename Func>
+        void queryRect(const engine::utils::Rect &rect, Func &&func) const
+        {
+            const glm::vec2 min = rect.position;
+            const glm::vec2 max = rect.position + rect.size;
+            forEachCandidate(cellRange(rect), [&](SpatialItem item)
+                             {
+                                 const engine::utils::Rect &b = bounds_[item];
+                                 if (b.position.x <= max.x && min.x <= b.position.x + b.size.x &&
+                                     b.position.y <= max.y && min.y <= b.position.y + b.size.y)
+                                     func(item); });
+        }
+
+        /// @brief Calls func(item) for every item whose bounds are within radius of center.
+        template <typename Func>
+        void queryRadius(const glm::vec2 &center, float radius, Func &&func) const
+        {
+            const float radius_sq = radius * radius;
+            forEachCandidate(cellRange({center - radius, glm::vec2(radius * 2.0f)}), [&](SpatialItem item)
+                             {
+                                 const engine::utils::Rect &b = bounds_[item];
+                                 glm::vec2 closest = glm::clamp(center, b.position, b.position + b.size);
+                                 glm::vec2 offset = closest - center;
+                                 if (offset.x * offset.x + offset.y * offset.y <= radius_sq)
+                                     func(item); });
+        }
+
+        /// @brief Walks the cells along the ray and calls func(item, distance) for every item it hits within
+        /// max_distance, roughly in order of distance. direction must be normalized. func returns false to stop.
+        template <typename Func>
+        void queryRay(const glm::vec2 &origin, const glm::vec2 &direction, float max_distance, Func &&func) const
+        {
+            if (used_cells_ == 0 || !(max_distance >= 0.0f))
+            {
+                return;
+            }
+            constexpr float INF = std::numeric_limits<float>::infinity();
+            const glm::vec2 inv_direction(direction.x != 0.0f ? 1.0f / direction.x : INF, direction.y != 0.0f ? 1.0f / direction.y : INF);
+
+            int x = toCell(origin.x);
+            int y = toCell(origin.y);
+            const int end_x = toCell(origin.x + direction.x * max_distance);
+            const int end_y = toCell(origin.y + direction.y * max_distance);
+            const int step_x = direction.x > 0.0f ? 1 : -1;
+            const int step_y = direction.y > 0.0f ? 1 : -1;
+            // Distance along the ray to the next cell boundary on each axis, and between boundaries
+            auto first_boundary = [&](int cell, int step, float start, float inv)
+            {
+                if (inv == INF)
+                    return INF;
+                float boundary = static_cast<float>(step > 0 ? cell + 1 : cell) * cell_size_;
+                return (boundary - start) * inv;
+            };
+            float next_x = first_boundary(x, step_x, origin.x, inv_direction.x);
+            float next_y = first_boundary(y, step_y, origin.y, inv_direction.y);
+            const float delta_x = direction.x != 0.0f ? cell_size_ * std::fabs(inv_direction.x) : INF;
+            const float delta_y = direction.y != 0.0f ? cell_size_ * std::fabs(inv_direction.y) : INF;
+
+            int previous_x = x - step_x;
+            int previous_y = y;
+            const std::int64_t max_steps = std::int64_t{std::abs(static_cast<std::int64_t>(end_x) - x)} + std::abs(static_cast<std::int64_t>(end_y) - y) + 1;
+            for (std::int64_t steps = 0; steps < max_steps; ++steps)
+            {
+                if (const Cell *cell = findCell(x, y))
+                {
+                    for (std::uint32_t i = cell->start; i < cell->start + cell->count; ++i)
+                    {
+                        SpatialItem item = cell_items_[i];
+                        // The cells of the ray inside an item's range form one run; only its first cell reports the item
+                        if (steps > 0 && ranges_[item].contains(previous_x, previous_y))
+                            continue;
+                        const engine::utils::Rect &b = bounds_[item];
+                        float t1 = (b.position.x - origin.x) * inv_direction.x;
+                        float t2 = (b.position.x + b.size.x - origin.x) * inv_direction.x;
+                        float t3 = (b.position.y - origin.y) * inv_direction.y;
+                        float t4 = (b.position.y + b.size.y - origin.y) * inv_direction.y;
+                        // A zero direction component gives NaN for items level with the origin; fmin/fmax ignore it
+                        float t_enter = std::fmax(std::fmin(t1, t2), std::fmin(t3, t4));
+                        float t_exit = std::fmin(std::fmax(t1, t2), std::fmax(t3, t4));
+                        if (direction.x == 0.0f && (origin.x < b.position.x || origin.x > b.position.x + b.size.x))
+                            continue;
+                        if (direction.y == 0.0f && (origin.y < b.position.y || origin.y > b.position.y + b.size.y))
+                            continue;
+                        if (t_exit >= std::max(t_enter, 0.0f) && t_enter <= max_distance)
+                        {
+                            if (!func(item, std::max(t_enter, 0.0f)))
+                                return;
+                        }
+                    }
+                }
+                previous_x = x;
+                previous_y = y;
+                if (next_x < next_y)
+                {
+                    x += step_x;
+                    next_x += delta_x;
+                }
+                else
+                {
+                    y += step_y;
+                    next_y += delta_y;
+                }
+            }
+        }
+    };
+} // namespace engine::physics
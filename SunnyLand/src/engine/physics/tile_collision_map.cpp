@@ -0,0 +1,103 @@
+#include "tile_collision_map.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <spdlog/spdlog.h>
+
+namespace engine::physics
+{
+    namespace
+    {
+        /// @brief Tiled stores flip and rotation flags in the top bits of a tile id.
+        constexpr std::uint32_t TILE_ID_MASK = 0x0FFFFFFFu;
+
+        void assignBit(std::vector<std::uint64_t> &bits, std::size_t index, bool value)
+        {
+            std::uint64_t mask = std::uint64_t{1} << (index & 63);
+            if (value)
+                bits[index >> 6] |= mask;
+            else
+                bits[index >> 6] &= ~mask;
+        }
+    }
+
+    TileCollisionMap::TileCollisionMap(int width, int height, float tile_size)
+        : width_(width), height_(height), tile_size_(tile_size)
+    {
+        if (width <= 0 || height <= 0 || tile_size <= 0.0f)
+        {
+            throw std::runtime_error("Invalid tile collision map size");
+        }
+        inv_tile_size_ = 1.0f / tile_size;
+        std::size_t words = (static_cast<std::size_t>(width) * static_cast<std::size_t>(height) + 63) / 64;
+        for (auto *plane : {&solid_, &one_way_, &slope_, &slope_down_})
+        {
+            plane->assign(words, 0);
+        }
+    }
+
+    TileCollisionMap TileCollisionMap::fromTiles(int width, int height, float tile_size, std::span<const std::uint32_t> tiles,
+                                                 std::span<const TileType> types)
+    {
+        TileCollisionMap map(width, height, tile_size);
+        if (tiles.size() < static_cast<std::size_t>(width) * static_cast<std::size_t>(height))
+        {
+            throw std::runtime_error("Tile layer has fewer tiles than its size");
+        }
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                std::uint32_t id = tiles[map.bitIndex(x, y)] & TILE_ID_MASK;
+                if (id < types.size() && types[id] != TileType::Empty)
+                {
+                    map.setTile(x, y, types[id]);
+                }
+            }
+        }
+        return map;
+    }
+
+    void TileCollisionMap::setTile(int x, int y, TileType type)
+    {
+        if (!isInside(x, y))
+        {
+            spdlog::warn("Tile ({}, {}) is outside the {}x{} collision map", x, y, width_, height_);
+            return;
+        }
+        std::size_t index = bitIndex(x, y);
+        assignBit(solid_, index, type == TileType::Solid);
+        assignBit(one_way_, index, type == TileType::OneWay);
+        assignBit(slope_, index, type == TileType::SlopeUp || type == TileType::SlopeDown);
+        assignBit(slope_down_, index, type == TileType::SlopeDown);
+    }
+
+    TileType TileCollisionMap::getTile(int x, int y) const
+    {
+        if (!isInside(x, y))
+        {
+            return TileType::Empty;
+        }
+        std::size_t index = bitIndex(x, y);
+        if (testBit(solid_, index))
+            return TileType::Solid;
+        if (testBit(one_way_, index))
+            return TileType::OneWay;
+        if (testBit(slope_, index))
+            return testBit(slope_down_, index) ? TileType::SlopeDown : TileType::SlopeUp;
+        return TileType::Empty;
+    }
+
+    float TileCollisionMap::getSlopeHeight(int x, int y, float local_x) const
+    {
+        local_x = std::clamp(local_x, 0.0f, tile_size_);
+        return testBit(slope_down_, bitIndex(x, y)) ? tile_size_ - local_x : local_x;
+    }
+
+    int TileCollisionMap::toTile(float world) const
+    {
+        // Clamped so that far away or invalid coordinates still give a safe index outside the map
+        float tile = std::floor(world * inv_tile_size_);
+        return tile >= -1073741824.0f && tile <= 1073741824.0f ? static_cast<int>(tile) : (tile > 0.0f ? 1073741824 : -1073741824);
+    }
+} // namespace engine::physics
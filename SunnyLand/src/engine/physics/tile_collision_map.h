@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace engine::physics
+{
+    /// @brief Collision behaviour of one tile.
+    enum class TileType : std::uint8_t
+    {
+        Empty,
+        Solid,
+        /// @brief Only blocks movement down onto its top edge.
+        OneWay,
+        /// @brief Floor rising to the right ("/"). Does not block sideways movement.
+        SlopeUp,
+        /// @brief Floor falling to the right ("\").
+        SlopeDown
+    };
+
+    /// @brief Collision grid of a tile layer, one bit per tile and flag.
+    /// Tiles outside the grid are empty.
+    class TileCollisionMap final
+    {
+    private:
+        int width_ = 0;
+        int height_ = 0;
+        float tile_size_ = 1.0f;
+        float inv_tile_size_ = 1.0f;
+        std::vector<std::uint64_t> solid_;
+        std::vector<std::uint64_t> one_way_;
+        std::vector<std::uint64_t> slope_;
+        /// @brief Set for SlopeDown, clear for SlopeUp. Only meaningful where slope_ is set.
+        std::vector<std::uint64_t> slope_down_;
+
+        std::size_t bitIndex(int x, int y) const { return static_cast<std::size_t>(y) * static_cast<std::size_t>(width_) + static_cast<std::size_t>(x); }
+        static bool testBit(const std::vector<std::uint64_t> &bits, std::size_t index) { return (bits[index >> 6] >> (index & 63)) & 1u; }
+
+    public:
+        TileCollisionMap() = default;
+        TileCollisionMap(int width, int height, float tile_size);
+
+        /// @brief Builds the grid from the tile ids of a layer, in rows from the top left.
+        /// types maps each tile id to its collision; ids beyond it and the flip bits of Tiled ids are ignored.
+        static TileCollisionMap fromTiles(int width, int height, float tile_size, std::span<const std::uint32_t> tiles,
+                                          std::span<const TileType> types);
+
+        void setTile(int x, int y, TileType type);
+        TileType getTile(int x, int y) const;
+
+        bool isInside(int x, int y) const { return x >= 0 && y >= 0 && x < width_ && y < height_; }
+        bool isSolid(int x, int y) const { return isInside(x, y) && testBit(solid_, bitIndex(x, y)); }
+        bool isOneWay(int x, int y) const { return isInside(x, y) && testBit(one_way_, bitIndex(x, y)); }
+        bool isSlope(int x, int y) const { return isInside(x, y) && testBit(slope_, bitIndex(x, y)); }
+        /// @brief Height of the slope floor above the tile's bottom edge at local_x (0 .. tile size) inside the tile.
+        float getSlopeHeight(int x, int y, float local_x) const;
+
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+        float getTileSize() const { return tile_size_; }
+        /// @brief Index of the tile column or row containing the world coordinate.
+        int toTile(float world) const;
+        /// @brief Bytes used by the grid.
+        std::size_t getMemoryUsage() const { return (solid_.size() + one_way_.size() + slope_.size() + slope_down_.size()) * sizeof(std::uint64_t); }
+    };
+} // namespace engine::physics
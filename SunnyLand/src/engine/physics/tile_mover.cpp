@@ -0,0 +1,222 @@
+#include "tile_mover.h"
+#include "tile_collision_map.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace engine::physics
+{
+    namespace
+    {
+        /// @brief Boxes touching a tile edge do not overlap the tile.
+        constexpr float SKIN = 1.0e-3f;
+
+        /// @brief Boxes walk up onto solid tiles whose top is at most this fraction of a tile above their bottom edge.
+        constexpr float STEP_HEIGHT = 0.5f;
+
+        /// @brief Returns false for solid tiles the box can step onto: small steps, and the filled part below a slope.
+        /// step_top is lowered to the top of every such tile.
+        bool blocksSideways(const TileCollisionMap &map, int x, int y, int bottom_row, float bottom, float &step_top)
+        {
+            if (!map.isSolid(x, y))
+            {
+                return false;
+            }
+            float top = static_cast<float>(y) * map.getTileSize();
+            if (y == bottom_row && !map.isSolid(x, y - 1) &&
+                (map.isSlope(x, y - 1) || bottom - top <= map.getTileSize() * STEP_HEIGHT))
+            {
+                step_top = std::min(step_top, top);
+                return false;
+            }
+            return true;
+        }
+
+        /// @brief How far the box may be lifted in column x before its top enters a solid tile above first_row.
+        float headroomIn(const TileCollisionMap &map, int x, int first_row, float top)
+        {
+            return map.isSolid(x, first_row - 1) ? top - static_cast<float>(first_row) * map.getTileSize() : std::numeric_limits<float>::max();
+        }
+
+        /// @brief Tests the column the leading edge enters. Rows are checked top to bottom, so a wall is found before a step below it.
+        /// A step that would lift the box into a ceiling over any column it covers blocks like a wall.
+        bool columnBlocked(const TileCollisionMap &map, int x, int first_row, int last_row, int bottom_row, float top, float bottom,
+                           float &step_top, float &headroom)
+        {
+            const float previous_step_top = step_top;
+            for (int y = first_row; y <= last_row; ++y)
+            {
+                if (blocksSideways(map, x, y, bottom_row, bottom, step_top))
+                {
+                    return true;
+                }
+            }
+            headroom = std::min(headroom, headroomIn(map, x, first_row, top));
+            if (bottom - step_top > headroom)
+            {
+                step_top = previous_step_top;
+                return true;
+            }
+            return false;
+        }
+
+        void moveX(const TileCollisionMap &map, engine::utils::Rect &box, float dx, TileMoveResult &result)
+        {
+            if (dx == 0.0f)
+            {
+                return;
+            }
+            const float tile_size = map.getTileSize();
+            const float start = box.position.x;
+            const float bottom = box.position.y + box.size.y;
+            const int first_row = std::max(map.toTile(box.position.y), 0);
+            const int bottom_row = map.toTile(bottom - SKIN);
+            const int last_row = std::min(bottom_row, map.getHeight() - 1);
+            float step_top = bottom;
+            // Only rows above the box can stop a step: the lift is less than a tile
+            float headroom = std::numeric_limits<float>::max();
+            const int start_column = std::max(map.toTile(start), 0);
+            const int end_column = std::min(map.toTile(start + box.size.x - SKIN), map.getWidth() - 1);
+            for (int x = start_column; x <= end_column; ++x)
+            {
+                headroom = std::min(headroom, headroomIn(map, x, first_row, box.position.y));
+            }
+
+            box.position.x += dx;
+            if (dx > 0.0f)
+            {
+                int from = std::max(map.toTile(start + box.size.x - SKIN) + 1, 0);
+                int to = std::min(map.toTile(start + box.size.x + dx - SKIN), map.getWidth() - 1);
+                for (int x = from; x <= to; ++x)
+                {
+                    if (columnBlocked(map, x, first_row, last_row, bottom_row, box.position.y, bottom, step_top, headroom))
+                    {
+                        box.position.x = std::max(static_cast<float>(x) * tile_size - box.size.x, start);
+                        result.hit_right = true;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                int from = std::min(map.toTile(start) - 1, map.getWidth() - 1);
+                int to = std::max(map.toTile(start + dx), 0);
+                for (int x = from; x >= to; --x)
+                {
+                    if (columnBlocked(map, x, first_row, last_row, bottom_row, box.position.y, bottom, step_top, headroom))
+                    {
+                        box.position.x = std::min(static_cast<float>(x + 1) * tile_size, start);
+                        result.hit_left = true;
+                        break;
+                    }
+                }
+            }
+            result.moved.x = box.position.x - start;
+            // Stepped onto a low tile: stand on top of it
+            box.position.y -= bottom - step_top;
+        }
+
+        void moveUp(const TileCollisionMap &map, engine::utils::Rect &box, float dy, TileMoveResult &result)
+        {
+            const int first_column = std::max(map.toTile(box.position.x), 0);
+            const int last_column = std::min(map.toTile(box.position.x + box.size.x - SKIN), map.getWidth() - 1);
+            const float start = box.position.y;
+            int from = std::min(map.toTile(box.position.y) - 1, map.getHeight() - 1);
+            int to = std::max(map.toTile(box.position.y + dy), 0);
+            for (int y = from; y >= to; --y)
+            {
+                for (int x = first_column; x <= last_column; ++x)
+                {
+                    if (map.isSolid(x, y))
+                    {
+                        box.position.y = std::min(static_cast<float>(y + 1) * map.getTileSize(), start);
+                        result.moved.y = box.position.y - start;
+                        result.hit_ceiling = true;
+                        return;
+                    }
+                }
+            }
+            box.position.y += dy;
+            result.moved.y = dy;
+        }
+
+        /// @brief Also runs with dy == 0, to find the ground below a resting box and to follow slopes after moving sideways.
+        void moveDown(const TileCollisionMap &map, engine::utils::Rect &box, float dy, bool drop_through, TileMoveResult &result)
+        {
+            const float tile_size = map.getTileSize();
+            const int first_column = std::max(map.toTile(box.position.x), 0);
+            const int last_column = std::min(map.toTile(box.position.x + box.size.x - SKIN), map.getWidth() - 1);
+            const float bottom = box.position.y + box.size.y;
+            float target = bottom + dy;
+
+            // Rows the bottom edge enters. With dy == 0 this is the row right below a box resting on a tile edge.
+            int from = std::max(map.toTile(bottom - SKIN) + 1, 0);
+            int to = std::min(map.toTile(bottom + std::max(dy, SKIN) - SKIN), map.getHeight() - 1);
+            for (int y = from; y <= to; ++y)
+            {
+                bool blocked = false;
+                for (int x = first_column; x <= last_column && !blocked; ++x)
+                {
+                    blocked = map.isSolid(x, y) || (!drop_through && map.isOneWay(x, y));
+                }
+                if (blocked)
+                {
+                    target = std::min(target, static_cast<float>(y) * tile_size);
+                    result.on_ground = true;
+                    break;
+                }
+            }
+
+            // Slopes are followed at the box's horizontal center, starting one row up so that walking
+            // up a slope onto the next tile lifts the box as well
+            const float center_x = box.position.x + box.size.x * 0.5f;
+            const int column = map.toTile(center_x);
+            const float local_x = center_x - static_cast<float>(column) * tile_size;
+            const int first_row = std::max(map.toTile(bottom - SKIN) - 1, 0);
+            const int last_row = column >= 0 && column < map.getWidth() ? std::min(map.toTile(target - SKIN), map.getHeight() - 1) : -1;
+            for (int y = first_row; y <= last_row; ++y)
+            {
+                if (!map.isSlope(column, y))
+                {
+                    continue;
+                }
+                float surface = static_cast<float>(y + 1) * tile_size - map.getSlopeHeight(column, y, local_x);
+                if (surface <= target + SKIN && surface >= bottom - tile_size)
+                {
+                    target = surface;
+                    result.on_ground = true;
+                    result.on_slope = true;
+                    break;
+                }
+            }
+
+            box.position.y = target - box.size.y;
+            result.moved.y = target - bottom;
+        }
+    }
+
+    TileMoveResult moveBox(const TileCollisionMap &map, engine::utils::Rect &box, const glm::vec2 &delta, bool drop_through)
+    {
+        TileMoveResult result;
+        moveX(map, box, delta.x, result);
+        if (delta.y < 0.0f)
+        {
+            moveUp(map, box, delta.y, result);
+        }
+        else
+        {
+            moveDown(map, box, delta.y, drop_through, result);
+        }
+        return result;
+    }
+
+    void moveBoxes(const TileCollisionMap &map, std::span<engine::utils::Rect> boxes, std::span<const glm::vec2> deltas,
+                   std::span<TileMoveResult> results)
+    {
+        assert(boxes.size() == deltas.size() && boxes.size() == results.size());
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+        {
+            results[i] = moveBox(map, boxes[i], deltas[i]);
+        }
+    }
+} // namespace engine::physics
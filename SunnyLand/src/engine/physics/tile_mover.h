@@ -0,0 +1,30 @@
+#pragma once
+#include "../utils/math.h"
+#include <span>
+
+namespace engine::physics
+{
+    class TileCollisionMap;
+
+    /// @brief What a box touched while moving.
+    struct TileMoveResult
+    {
+        /// @brief Distance actually moved.
+        glm::vec2 moved{0.0f, 0.0f};
+        bool hit_left = false;
+        bool hit_right = false;
+        bool hit_ceiling = false;
+        /// @brief Standing on a solid, one-way or slope tile after the move.
+        bool on_ground = false;
+        bool on_slope = false;
+    };
+
+    /// @brief Moves box by delta against the map, first along x, then along y.
+    /// Every tile column and row the leading edge crosses is checked, so fast boxes cannot tunnel through
+    /// thin walls; the cost is proportional to the tiles touched. With drop_through the box falls through one-way tiles.
+    TileMoveResult moveBox(const TileCollisionMap &map, engine::utils::Rect &box, const glm::vec2 &delta, bool drop_through = false);
+
+    /// @brief Moves many boxes at once. All spans must have the same size; boxes are updated in place.
+    void moveBoxes(const TileCollisionMap &map, std::span<engine::utils::Rect> boxes, std::span<const glm::vec2> deltas,
+                   std::span<TileMoveResult> results);
+} // namespace engine::physics
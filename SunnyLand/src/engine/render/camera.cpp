@@ -30,6 +30,27 @@ namespace engine::render
         viewport_size_ = size;
     }
 
+    void Camera::setScreenMapping(const glm::vec2 &offset, float scale)
+    {
+        screen_offset_ = offset;
+        screen_scale_ = scale > 0.0f ? scale : 1.0f;
+    }
+
+    glm::vec2 Camera::getScreenOffset() const
+    {
+        return screen_offset_;
+    }
+
+    float Camera::getScreenScale() const
+    {
+        return screen_scale_;
+    }
+
+    glm::vec2 Camera::getScreenSize() const
+    {
+        return viewport_size_ * screen_scale_;
+    }
+
     glm::vec2 Camera::getPosition() const
     {
         return position_;
@@ -61,18 +82,33 @@ namespace engine::render
         }
     }
 
-    glm::vec2 Camera::worldToScreen(const glm::vec2 &world_pos) const
+    glm::vec2 Camera::worldToViewport(const glm::vec2 &world_pos) const
     {
         return world_pos - position_;
     }
 
+    glm::vec2 Camera::worldToViewportWithParallax(const glm::vec2 &world_pos, const glm::vec2 &scroll_factor) const
+    {
+        return world_pos - position_ * scroll_factor;
+    }
+
+    glm::vec2 Camera::worldToScreen(const glm::vec2 &world_pos) const
+    {
+        return viewportToScreen(worldToViewport(world_pos));
+    }
+
     glm::vec2 Camera::screenToWorld(const glm::vec2 &screen_pos) const
     {
-        return screen_pos + position_;
+        return screenToViewport(screen_pos) + position_;
     }
 
-    glm::vec2 Camera::worldToScreenWithParallax(const glm::vec2 &world_pos, const glm::vec2 &scroll_factor) const
+    glm::vec2 Camera::viewportToScreen(const glm::vec2 &viewport_pos) const
     {
-        return world_pos - position_ * scroll_factor;
+        return viewport_pos * screen_scale_ + screen_offset_;
+    }
+
+    glm::vec2 Camera::screenToViewport(const glm::vec2 &screen_pos) const
+    {
+        return (screen_pos - screen_offset_) / screen_scale_;
     }
 }
\ No newline at end of file
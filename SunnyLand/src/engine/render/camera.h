@@ -10,6 +10,9 @@ namespace engine::render
     private:
         glm::vec2 viewport_size_;
         glm::vec2 position_;
+        /// @brief Where the viewport appears in the window: its top left corner and the upscale factor.
+        glm::vec2 screen_offset_ = glm::vec2(0.0f, 0.0f);
+        float screen_scale_ = 1.0f;
         std::optional<engine::utils::Rect> limit_bounds_;
 
         void clampPosition();
@@ -22,9 +25,15 @@ namespace engine::render
         Camera(Camera &&) noexcept = default;
         Camera &operator=(Camera &&) noexcept = default;
 
+        /// @brief World position to viewport pixels, the coordinates the world is drawn in.
+        glm::vec2 worldToViewport(const glm::vec2 &world_pos) const;
+        glm::vec2 worldToViewportWithParallax(const glm::vec2 &world_pos, const glm::vec2 &scroll_fator) const;
+        /// @brief World position to window pixels, after the viewport is upscaled onto the window.
         glm::vec2 worldToScreen(const glm::vec2 &world_pos) const;
+        /// @brief Window pixels, e.g. the mouse position, to a world position.
         glm::vec2 screenToWorld(const glm::vec2 &screen_pos) const;
-        glm::vec2 worldToScreenWithParallax(const glm::vec2 &world_pos, const glm::vec2 &scroll_fator) const;
+        glm::vec2 viewportToScreen(const glm::vec2 &viewport_pos) const;
+        glm::vec2 screenToViewport(const glm::vec2 &screen_pos) const;
 
         void update(float delta);
         void move(const glm::vec2 &offset);
@@ -32,6 +41,13 @@ namespace engine::render
         glm::vec2 getViewportSize() const;
         void setViewportSize(const glm::vec2 &size);
 
+        /// @brief Places the viewport in the window, scaled by an integer factor when rendering at a lower resolution.
+        void setScreenMapping(const glm::vec2 &offset, float scale);
+        glm::vec2 getScreenOffset() const;
+        float getScreenScale() const;
+        /// @brief Size of the viewport in window pixels.
+        glm::vec2 getScreenSize() const;
+
         glm::vec2 getPosition() const;
         void setPosition(const glm::vec2 &position);
 
@@ -0,0 +1,55 @@
+#include "particle_geometry.h"
+
+namespace engine::render
+{
+    void buildParticleVertices(std::span<const ParticleInstance> particles, const glm::vec2 &screen_offset,
+                               const glm::vec2 &texture_size, std::vector<SDL_Vertex> &vertices)
+    {
+        vertices.resize(particles.size() * 4);
+        const float inv_width = texture_size.x > 0.0f ? 1.0f / texture_size.x : 0.0f;
+        const float inv_height = texture_size.y > 0.0f ? 1.0f / texture_size.y : 0.0f;
+
+        SDL_Vertex *out = vertices.data();
+        for (const ParticleInstance &particle : particles)
+        {
+            const SDL_FRect &source = particle.source_rect;
+            float half_w = source.w * particle.size * 0.5f;
+            float half_h = source.h * particle.size * 0.5f;
+            float left = particle.position.x - screen_offset.x - half_w;
+            float top = particle.position.y - screen_offset.y - half_h;
+            float right = left + half_w * 2.0f;
+            float bottom = top + half_h * 2.0f;
+            float u0 = source.x * inv_width;
+            float v0 = source.y * inv_height;
+            float u1 = (source.x + source.w) * inv_width;
+            float v1 = (source.y + source.h) * inv_height;
+
+            out[0] = {{left, top}, particle.color, {u0, v0}};
+            out[1] = {{right, top}, particle.color, {u1, v0}};
+            out[2] = {{right, bottom}, particle.color, {u1, v1}};
+            out[3] = {{left, bottom}, particle.color, {u0, v1}};
+            out += 4;
+        }
+    }
+
+    void buildQuadIndices(std::size_t quad_count, std::vector<int> &indices)
+    {
+        std::size_t built = indices.size() / 6;
+        if (built >= quad_count)
+        {
+            return;
+        }
+        indices.resize(quad_count * 6);
+        for (std::size_t quad = built; quad < quad_count; ++quad)
+        {
+            int base = static_cast<int>(quad * 4);
+            int *out = indices.data() + quad * 6;
+            out[0] = base;
+            out[1] = base + 1;
+            out[2] = base + 2;
+            out[3] = base;
+            out[4] = base + 2;
+            out[5] = base + 3;
+        }
+    }
+} // namespace engine::render
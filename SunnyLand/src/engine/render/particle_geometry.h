@@ -0,0 +1,16 @@
+#pragma once
+#include "render_snapshot.h"
+#include <span>
+#include <vector>
+#include <SDL3/SDL_render.h>
+
+namespace engine::render
+{
+    /// @brief Replaces vertices with one quad (4 vertices) per particle, translated by -screen_offset.
+    /// Texture coordinates are normalized with the size of the texture the particles sample from.
+    void buildParticleVertices(std::span<const ParticleInstance> particles, const glm::vec2 &screen_offset,
+                               const glm::vec2 &texture_size, std::vector<SDL_Vertex> &vertices);
+
+    /// @brief Grows indices to cover at least quad_count quads (6 indices each). Existing indices are kept.
+    void buildQuadIndices(std::size_t quad_count, std::vector<int> &indices);
+} // namespace engine::render
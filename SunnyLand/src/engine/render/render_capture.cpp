@@ -0,0 +1,340 @@
+#include "render_capture.h"
+#include "../utils/mapped_file.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace engine::render
+{
+    namespace
+    {
+        /// @brief Bounds-checked reads from the mapped file.
+        class Reader
+        {
+        private:
+            std::span<const std::byte> bytes_;
+            std::size_t offset_ = 0;
+
+        public:
+            explicit Reader(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+            const std::byte *take(std::size_t size)
+            {
+                if (size > bytes_.size() - offset_)
+                {
+                    throw std::runtime_error("Corrupt render capture: truncated");
+                }
+                const std::byte *data = bytes_.data() + offset_;
+                offset_ += size;
+                return data;
+            }
+
+            template <typename T>
+            T read()
+            {
+                T value;
+                std::memcpy(&value, take(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            std::size_t getOffset() const { return offset_; }
+        };
+
+        std::uint32_t readTexture(Reader &reader, std::size_t texture_count)
+        {
+            auto texture = reader.read<std::uint32_t>();
+            if (texture != CAPTURE_NO_TEXTURE && texture >= texture_count)
+            {
+                throw std::runtime_error("Corrupt render capture: bad texture index");
+            }
+            return texture;
+        }
+    }
+
+    RenderCaptureData loadRenderCapture(const std::string &file_path)
+    {
+        engine::utils::MappedFile file(file_path);
+        Reader reader(file.getBytes());
+
+        CaptureHeader expected;
+        auto header = reader.read<CaptureHeader>();
+        if (std::memcmp(header.magic, expected.magic, sizeof(expected.magic)) != 0)
+        {
+            throw std::runtime_error("Not a render capture: " + file_path);
+        }
+        if (header.byte_order != CAPTURE_BYTE_ORDER)
+        {
+            throw std::runtime_error("Render capture was written on a machine of another byte order: " + file_path);
+        }
+        if (header.version != CAPTURE_VERSION)
+        {
+            throw std::runtime_error("Unsupported render capture version " + std::to_string(header.version) + ": " + file_path);
+        }
+
+        RenderCaptureData data;
+        data.output_width = header.output_width;
+        data.output_height = header.output_height;
+        for (std::uint32_t i = 0; i < header.texture_count; ++i)
+        {
+            CaptureTexture &texture = data.textures.emplace_back();
+            texture.header = reader.read<CaptureTextureHeader>();
+            const std::byte *path = reader.take(texture.header.path_length);
+            texture.path.assign(reinterpret_cast<const char *>(path), texture.header.path_length);
+        }
+
+        const std::size_t commands_begin = reader.getOffset();
+        if (header.command_bytes > file.getBytes().size() - commands_begin)
+        {
+            throw std::runtime_error("Corrupt render capture: truncated");
+        }
+        const std::size_t commands_end = commands_begin + static_cast<std::size_t>(header.command_bytes);
+        const std::size_t texture_count = data.textures.size();
+        std::size_t next_vertex = 0;
+        while (reader.getOffset() < commands_end)
+        {
+            CaptureCommand &command = data.commands.emplace_back();
+            auto op = reader.read<std::uint8_t>();
+            if (op > static_cast<std::uint8_t>(CaptureOp::Present))
+            {
+                throw std::runtime_error("Corrupt render capture: unknown command");
+            }
+            command.op = static_cast<CaptureOp>(op);
+            switch (command.op)
+            {
+            case CaptureOp::SetTarget:
+                command.texture = readTexture(reader, texture_count);
+                break;
+            case CaptureOp::SetDrawColor:
+                command.color = reader.read<SDL_FColor>();
+                break;
+            case CaptureOp::SetBlendMode:
+                command.value = reader.read<std::uint32_t>();
+                break;
+            case CaptureOp::SetClip:
+                command.flags = reader.read<std::uint8_t>();
+                if (command.flags != 0)
+                {
+                    auto clip = reader.read<SDL_Rect>();
+                    command.rect = {static_cast<float>(clip.x), static_cast<float>(clip.y), static_cast<float>(clip.w), static_cast<float>(clip.h)};
+                }
+                break;
+            case CaptureOp::Clear:
+                break;
+            case CaptureOp::FillRect:
+                command.rect = reader.read<SDL_FRect>();
+                break;
+            case CaptureOp::Texture:
+                command.flags = reader.read<std::uint8_t>();
+                command.texture = readTexture(reader, texture_count);
+                if (command.texture == CAPTURE_NO_TEXTURE)
+                {
+                    throw std::runtime_error("Corrupt render capture: texture command without texture");
+                }
+                if (command.flags & CAPTURE_HAS_SOURCE)
+                {
+                    command.source = reader.read<SDL_FRect>();
+                }
+                command.rect = reader.read<SDL_FRect>();
+                if (command.flags & CAPTURE_ROTATED)
+                {
+                    command.rotation = reader.read<float>();
+                    command.flip = static_cast<SDL_FlipMode>(reader.read<std::uint8_t>());
+                }
+                break;
+            case CaptureOp::Quads:
+                command.texture = readTexture(reader, texture_count);
+                command.value = reader.read<std::uint32_t>();
+                command.first_vertex = next_vertex;
+                next_vertex += static_cast<std::size_t>(command.value) * 4;
+                break;
+            case CaptureOp::Present:
+                data.frame_ends.push_back(data.commands.size());
+                break;
+            }
+        }
+        if (reader.getOffset() != commands_end || next_vertex != header.vertex_count || data.frame_ends.size() != header.frame_count)
+        {
+            throw std::runtime_error("Corrupt render capture: commands do not match the header");
+        }
+
+        const std::byte *vertices = reader.take(next_vertex * sizeof(SDL_Vertex));
+        data.vertices.resize(next_vertex);
+        std::memcpy(data.vertices.data(), vertices, next_vertex * sizeof(SDL_Vertex));
+        return data;
+    }
+
+    RenderCapture::RenderCapture(std::string file_path, std::uint32_t frame_count, int output_width, int output_height)
+        : file_path_(std::move(file_path)), frames_to_capture_(frame_count)
+    {
+        header_.output_width = output_width;
+        header_.output_height = output_height;
+        commands_.reserve(1 << 20);
+    }
+
+    template <typename T>
+    void RenderCapture::put(const T &value)
+    {
+        const std::size_t offset = commands_.size();
+        commands_.resize(offset + sizeof(T));
+        std::memcpy(commands_.data() + offset, &value, sizeof(T));
+    }
+
+    std::uint32_t RenderCapture::getTextureIndex(SDL_Texture *texture, std::string_view path)
+    {
+        if (!texture)
+        {
+            return CAPTURE_NO_TEXTURE;
+        }
+        auto it = texture_indices_.find(texture);
+        if (it != texture_indices_.end())
+        {
+            // The pointer may have been freed and reused by a texture of another image or size
+            const CaptureTexture &known = textures_[it->second];
+            if (known.path == path && known.header.width == texture->w && known.header.height == texture->h)
+            {
+                return it->second;
+            }
+        }
+
+        CaptureTexture entry;
+        entry.header.width = texture->w;
+        entry.header.height = texture->h;
+        SDL_BlendMode blend_mode = SDL_BLENDMODE_NONE;
+        SDL_ScaleMode scale_mode = SDL_SCALEMODE_LINEAR;
+        SDL_GetTextureBlendMode(texture, &blend_mode);
+        SDL_GetTextureScaleMode(texture, &scale_mode);
+        entry.header.blend_mode = blend_mode;
+        entry.header.scale_mode = static_cast<std::uint32_t>(scale_mode);
+        entry.header.path_length = static_cast<std::uint32_t>(path.size());
+        entry.path = path;
+        const auto index = static_cast<std::uint32_t>(textures_.size());
+        textures_.push_back(std::move(entry));
+        texture_indices_[texture] = index;
+        return index;
+    }
+
+    void RenderCapture::setTarget(SDL_Texture *target)
+    {
+        const std::uint32_t index = getTextureIndex(target, {});
+        putOp(CaptureOp::SetTarget);
+        put(index);
+    }
+
+    void RenderCapture::setDrawColor(const SDL_FColor &color)
+    {
+        putOp(CaptureOp::SetDrawColor);
+        put(color);
+    }
+
+    void RenderCapture::setBlendMode(SDL_BlendMode blend_mode)
+    {
+        putOp(CaptureOp::SetBlendMode);
+        put(static_cast<std::uint32_t>(blend_mode));
+    }
+
+    void RenderCapture::setClip(const SDL_Rect *clip)
+    {
+        putOp(CaptureOp::SetClip);
+        put(static_cast<std::uint8_t>(clip ? 1 : 0));
+        if (clip)
+        {
+            put(*clip);
+        }
+    }
+
+    void RenderCapture::clear()
+    {
+        putOp(CaptureOp::Clear);
+    }
+
+    void RenderCapture::fillRect(const SDL_FRect &rect)
+    {
+        putOp(CaptureOp::FillRect);
+        put(rect);
+    }
+
+    void RenderCapture::texture(SDL_Texture *texture, std::string_view path, const SDL_FRect *source, const SDL_FRect &dest,
+                                bool rotated, double rotation, SDL_FlipMode flip)
+    {
+        const std::uint32_t index = getTextureIndex(texture, path);
+        std::uint8_t flags = 0;
+        flags |= source ? CAPTURE_HAS_SOURCE : 0;
+        flags |= rotated ? CAPTURE_ROTATED : 0;
+        putOp(CaptureOp::Texture);
+        put(flags);
+        put(index);
+        if (source)
+        {
+            put(*source);
+        }
+        put(dest);
+        if (rotated)
+        {
+            put(static_cast<float>(rotation));
+            put(static_cast<std::uint8_t>(flip));
+        }
+    }
+
+    void RenderCapture::quads(SDL_Texture *texture, std::string_view path, std::span<const SDL_Vertex> vertices)
+    {
+        const std::uint32_t index = getTextureIndex(texture, path);
+        putOp(CaptureOp::Quads);
+        put(index);
+        put(static_cast<std::uint32_t>(vertices.size() / 4));
+        vertices_.insert(vertices_.end(), vertices.begin(), vertices.begin() + static_cast<std::ptrdiff_t>(vertices.size() / 4 * 4));
+    }
+
+    bool RenderCapture::present()
+    {
+        putOp(CaptureOp::Present);
+        ++captured_frames_;
+        frame_command_bytes_ = commands_.size();
+        frame_vertex_count_ = vertices_.size();
+        return captured_frames_ >= frames_to_capture_;
+    }
+
+    void RenderCapture::save() const
+    {
+        CaptureHeader header = header_;
+        header.frame_count = captured_frames_;
+        header.texture_count = static_cast<std::uint32_t>(textures_.size());
+        header.command_bytes = frame_command_bytes_;
+        header.vertex_count = frame_vertex_count_;
+
+        std::filesystem::path path(file_path_);
+        if (path.has_parent_path())
+        {
+            std::filesystem::create_directories(path.parent_path());
+        }
+        const std::string temp_path = file_path_ + ".tmp";
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                throw std::runtime_error("Failed to open render capture for writing: " + temp_path);
+            }
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            for (const CaptureTexture &texture : textures_)
+            {
+                file.write(reinterpret_cast<const char *>(&texture.header), sizeof(texture.header));
+                file.write(texture.path.data(), static_cast<std::streamsize>(texture.path.size()));
+            }
+            file.write(reinterpret_cast<const char *>(commands_.data()), static_cast<std::streamsize>(frame_command_bytes_));
+            file.write(reinterpret_cast<const char *>(vertices_.data()), static_cast<std::streamsize>(frame_vertex_count_ * sizeof(SDL_Vertex)));
+            file.close();
+            if (!file)
+            {
+                throw std::runtime_error("Failed to write render capture: " + temp_path);
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temp_path, file_path_, error);
+        if (error)
+        {
+            const std::string reason = error.message();
+            std::filesystem::remove(temp_path, error);
+            throw std::runtime_error("Failed to replace render capture " + file_path_ + ": " + reason);
+        }
+    }
+} // namespace engine::render
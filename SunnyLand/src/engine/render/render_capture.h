@@ -0,0 +1,167 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <SDL3/SDL_render.h>
+
+namespace engine::render
+{
+    constexpr std::uint32_t CAPTURE_VERSION = 1;
+    constexpr std::uint32_t CAPTURE_BYTE_ORDER = 0x01020304;
+    /// @brief Texture index of the window, and of untextured geometry.
+    constexpr std::uint32_t CAPTURE_NO_TEXTURE = 0xFFFFFFFF;
+
+    /// @brief Start of a render capture file. It is followed by texture_count textures, each a CaptureTextureHeader
+    /// and its path, then command_bytes of encoded commands and vertex_count SDL_Vertex of the quad commands.
+    struct CaptureHeader
+    {
+        char magic[4] = {'S', 'L', 'R', 'C'};
+        std::uint32_t version = CAPTURE_VERSION;
+        /// @brief Written in the byte order of the capturing machine, so files of the other order are rejected.
+        std::uint32_t byte_order = CAPTURE_BYTE_ORDER;
+        /// @brief Size of the window when the capture started.
+        std::int32_t output_width = 0;
+        std::int32_t output_height = 0;
+        std::uint32_t frame_count = 0;
+        std::uint32_t texture_count = 0;
+        std::uint32_t reserved = 0;
+        std::uint64_t command_bytes = 0;
+        std::uint64_t vertex_count = 0;
+    };
+
+    /// @brief A texture drawn during the capture. Textures with a path were loaded from that image;
+    /// the others are render targets, created empty with the same size.
+    struct CaptureTextureHeader
+    {
+        std::int32_t width = 0;
+        std::int32_t height = 0;
+        std::uint32_t blend_mode = SDL_BLENDMODE_NONE;
+        std::uint32_t scale_mode = SDL_SCALEMODE_LINEAR;
+        std::uint32_t path_length = 0;
+    };
+
+    /// @brief One SDL call of the Renderer. Commands are stored as a one byte op followed by its operands.
+    enum class CaptureOp : std::uint8_t
+    {
+        /// @brief u32 texture, CAPTURE_NO_TEXTURE for the window.
+        SetTarget = 0,
+        /// @brief SDL_FColor.
+        SetDrawColor = 1,
+        /// @brief u32 SDL_BlendMode.
+        SetBlendMode = 2,
+        /// @brief u8 enabled, then the SDL_Rect if enabled.
+        SetClip = 3,
+        Clear = 4,
+        /// @brief SDL_FRect.
+        FillRect = 5,
+        /// @brief u8 flags (CAPTURE_HAS_SOURCE, CAPTURE_ROTATED), u32 texture, the source SDL_FRect if it has one, the
+        /// destination SDL_FRect, then if rotated f32 degrees and u8 SDL_FlipMode.
+        Texture = 6,
+        /// @brief u32 texture, u32 quad count. The 4 vertices of each quad follow those of the previous Quads command.
+        Quads = 7,
+        /// @brief Ends a frame.
+        Present = 8,
+    };
+
+    constexpr std::uint8_t CAPTURE_HAS_SOURCE = 1;
+    /// @brief Issued with SDL_RenderTextureRotated rather than SDL_RenderTexture.
+    constexpr std::uint8_t CAPTURE_ROTATED = 2;
+
+    /// @brief A decoded command. Only the fields of its op are set.
+    struct CaptureCommand
+    {
+        CaptureOp op = CaptureOp::Present;
+        /// @brief Flags of Texture; for SetClip, whether the clip is enabled.
+        std::uint8_t flags = 0;
+        SDL_FlipMode flip = SDL_FLIP_NONE;
+        std::uint32_t texture = CAPTURE_NO_TEXTURE;
+        /// @brief Blend mode of SetBlendMode, quad count of Quads.
+        std::uint32_t value = 0;
+        /// @brief Index of the first vertex of Quads.
+        std::size_t first_vertex = 0;
+        float rotation = 0.0f;
+        SDL_FRect source{};
+        /// @brief Destination of Texture, rect of FillRect and SetClip.
+        SDL_FRect rect{};
+        SDL_FColor color{};
+    };
+
+    struct CaptureTexture
+    {
+        CaptureTextureHeader header;
+        /// @brief Empty for render targets.
+        std::string path;
+    };
+
+    /// @brief Content of a capture file.
+    struct RenderCaptureData
+    {
+        int output_width = 0;
+        int output_height = 0;
+        std::vector<CaptureTexture> textures;
+        std::vector<CaptureCommand> commands;
+        std::vector<SDL_Vertex> vertices;
+        /// @brief Index one past the Present command of each frame.
+        std::vector<std::size_t> frame_ends;
+    };
+
+    /// @brief Reads and decodes a capture file. Throws std::runtime_error if it cannot be read or is corrupt.
+    RenderCaptureData loadRenderCapture(const std::string &file_path);
+
+    /// @brief Records the SDL calls of the Renderer for a number of presented frames.
+    /// Textures are identified by pointer while recording and written as a table, so a capture can be replayed
+    /// without the game: images are loaded again from their paths and render targets recreated.
+    class RenderCapture final
+    {
+    private:
+        std::string file_path_;
+        std::uint32_t frames_to_capture_ = 0;
+        std::uint32_t captured_frames_ = 0;
+        CaptureHeader header_;
+        std::vector<CaptureTexture> textures_;
+        std::unordered_map<SDL_Texture *, std::uint32_t> texture_indices_;
+        std::vector<std::byte> commands_;
+        std::vector<SDL_Vertex> vertices_;
+        /// @brief Sizes at the last present(); commands of an unfinished frame are not saved.
+        std::size_t frame_command_bytes_ = 0;
+        std::size_t frame_vertex_count_ = 0;
+
+        template <typename T>
+        void put(const T &value);
+        void putOp(CaptureOp op) { put(static_cast<std::uint8_t>(op)); }
+        /// @brief Index of the texture in the table, adding it on first use or when the pointer now holds another texture.
+        std::uint32_t getTextureIndex(SDL_Texture *texture, std::string_view path);
+
+    public:
+        RenderCapture(std::string file_path, std::uint32_t frame_count, int output_width, int output_height);
+
+        RenderCapture(const RenderCapture &) = delete;
+        RenderCapture &operator=(const RenderCapture &) = delete;
+        RenderCapture(RenderCapture &&) = delete;
+        RenderCapture &operator=(RenderCapture &&) = delete;
+
+        void setTarget(SDL_Texture *target);
+        void setDrawColor(const SDL_FColor &color);
+        void setBlendMode(SDL_BlendMode blend_mode);
+        void setClip(const SDL_Rect *clip);
+        void clear();
+        void fillRect(const SDL_FRect &rect);
+        /// @brief path is the image the texture was loaded from, empty for render targets.
+        void texture(SDL_Texture *texture, std::string_view path, const SDL_FRect *source, const SDL_FRect &dest,
+                     bool rotated, double rotation, SDL_FlipMode flip);
+        void quads(SDL_Texture *texture, std::string_view path, std::span<const SDL_Vertex> vertices);
+        /// @brief Ends a frame. Returns true once all frames are captured.
+        bool present();
+
+        const std::string &getFilePath() const { return file_path_; }
+        std::uint32_t getCapturedFrames() const { return captured_frames_; }
+
+        /// @brief Writes the frames presented so far, replacing the file only once it is complete.
+        /// Throws std::runtime_error on failure.
+        void save() const;
+    };
+} // namespace engine::render
@@ -0,0 +1,209 @@
+#pragma once
+#include "sprite.h"
+#include "camera.h"
+#include "../utils/string_id.h"
+#include "../audio/sound_queue.h"
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <optional>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_pixels.h>
+#include <glm/glm.hpp>
+
+namespace engine::render
+{
+    struct SpriteCommand
+    {
+        Sprite sprite;
+        glm::vec2 position;
+        glm::vec2 scale;
+        float rotation;
+    };
+
+    struct ParallaxCommand
+    {
+        Sprite sprite;
+        glm::vec2 position;
+        glm::vec2 scroll_factor;
+        glm::bvec2 repeat;
+        glm::vec2 scale;
+    };
+
+    /// @brief One ECS sprite, packed for the renderer. The texture is an interned path.
+    struct SpriteInstance
+    {
+        engine::utils::StringId texture_id;
+        SDL_FRect source_rect;
+        glm::vec2 position;
+        glm::vec2 scale;
+        float rotation;
+        bool is_flipped;
+    };
+
+    /// @brief One particle, centered on position. size scales the source rect.
+    struct ParticleInstance
+    {
+        glm::vec2 position;
+        float size;
+        SDL_FColor color;
+        SDL_FRect source_rect;
+    };
+
+    /// @brief All particles using one texture, drawn with a single geometry call.
+    struct ParticleBatch
+    {
+        engine::utils::StringId texture_id;
+        std::vector<ParticleInstance> particles;
+    };
+
+    /// @brief One widget of a retained UI layer, in screen coordinates. The texture is stretched over rect.
+    struct UIWidgetDraw
+    {
+        engine::utils::StringId texture_id;
+        SDL_FRect rect;
+    };
+
+    /// @brief Area of a UI layer that changed in the given revision.
+    struct UIDirtyRect
+    {
+        SDL_FRect rect;
+        std::uint64_t revision;
+    };
+
+    /// @brief State of a retained UI layer for one frame, see engine::ui::UILayer.
+    /// The Renderer keeps the layer composited in a render target and only redraws the dirty rects
+    /// newer than the revision it has cached, or everything if it fell too far behind.
+    struct UILayerFrame
+    {
+        std::uint32_t layer_id = 0;
+        std::uint64_t revision = 0;
+        /// @brief Caches older than this cannot be updated from dirty_rects and are redrawn completely.
+        std::uint64_t full_redraw_revision = 0;
+        /// @brief Screen area covered by the layer, and the size of its render target.
+        SDL_FRect bounds{};
+        std::vector<UIDirtyRect> dirty_rects;
+        /// @brief Visible widgets, back to front.
+        std::vector<UIWidgetDraw> widgets;
+    };
+
+    struct UISpriteCommand
+    {
+        Sprite sprite;
+        glm::vec2 position;
+        std::optional<glm::vec2> size;
+    };
+
+    /// @brief Immutable description of one frame, built by the simulation and drawn by the Renderer.
+    /// The simulation never touches the Renderer directly, so a snapshot can be drawn on the main
+    /// thread while the next one is being built on another thread.
+    /// Layers are drawn in order: parallax, tiles, world sprites, particles, UI sprites, UI layers.
+    class RenderSnapshot final
+    {
+    private:
+        Camera camera_{glm::vec2(0.0f, 0.0f)};
+        std::vector<ParallaxCommand> parallax_;
+        std::vector<SpriteInstance> tiles_;
+        std::vector<SpriteCommand> sprites_;
+        std::vector<SpriteInstance> sprite_instances_;
+        /// @brief Only the first particle_batch_count_ batches are in use; the rest keep their capacity for later frames.
+        std::vector<ParticleBatch> particle_batches_;
+        std::size_t particle_batch_count_ = 0;
+        std::vector<UISpriteCommand> ui_sprites_;
+        /// @brief Only the first ui_layer_count_ layers are in use, like the particle batches.
+        std::vector<UILayerFrame> ui_layers_;
+        std::size_t ui_layer_count_ = 0;
+        /// @brief Sounds started, stopped or changed by the tick; not drawn, but played when the snapshot is handed over.
+        std::vector<engine::audio::SoundCommand> sound_commands_;
+        /// @brief SDL_GetTicksNS() when the input this snapshot was simulated from was sampled.
+        Uint64 input_time_ns_ = 0;
+        /// @brief False when the frame looks exactly like the previous one and may be skipped.
+        bool needs_redraw_ = true;
+
+    public:
+        /// @brief Removes all commands but keeps the allocated capacity.
+        void clear()
+        {
+            parallax_.clear();
+            tiles_.clear();
+            sprites_.clear();
+            sprite_instances_.clear();
+            particle_batch_count_ = 0;
+            ui_sprites_.clear();
+            ui_layer_count_ = 0;
+            sound_commands_.clear();
+        }
+
+        void setCamera(const Camera &camera) { camera_ = camera; }
+        const Camera &getCamera() const { return camera_; }
+
+        void setInputTime(Uint64 input_time_ns) { input_time_ns_ = input_time_ns; }
+        Uint64 getInputTime() const { return input_time_ns_; }
+
+        void setNeedsRedraw(bool needs_redraw) { needs_redraw_ = needs_redraw; }
+        bool getNeedsRedraw() const { return needs_redraw_; }
+
+        void addSprite(const Sprite &sprite, const glm::vec2 &position, const glm::vec2 &scale = glm::vec2(1.0f, 1.0f), float rotation = 0.0f)
+        {
+            sprites_.push_back({sprite, position, scale, rotation});
+        }
+
+        void addParallax(const Sprite &sprite, const glm::vec2 &position, const glm::vec2 &scroll_factor,
+                         const glm::bvec2 &repeat = {true, true}, const glm::vec2 &scale = glm::vec2(1.0f, 1.0f))
+        {
+            parallax_.push_back({sprite, position, scroll_factor, repeat, scale});
+        }
+
+        void addUISprite(const Sprite &sprite, const glm::vec2 &position, const std::optional<glm::vec2> &size = std::nullopt)
+        {
+            ui_sprites_.push_back({sprite, position, size});
+        }
+
+        const std::vector<ParallaxCommand> &getParallax() const { return parallax_; }
+        std::vector<engine::audio::SoundCommand> &getSoundCommands() { return sound_commands_; }
+        const std::vector<engine::audio::SoundCommand> &getSoundCommands() const { return sound_commands_; }
+        /// @brief Level tiles, drawn after the parallax layers and before everything else in the world.
+        std::vector<SpriteInstance> &getTiles() { return tiles_; }
+        const std::vector<SpriteInstance> &getTiles() const { return tiles_; }
+        const std::vector<SpriteCommand> &getSprites() const { return sprites_; }
+        /// @brief World sprites extracted from the ECS, drawn after the sprite commands.
+        std::vector<SpriteInstance> &getSpriteInstances() { return sprite_instances_; }
+        const std::vector<SpriteInstance> &getSpriteInstances() const { return sprite_instances_; }
+
+        /// @brief Particles of the texture, drawn after the world sprites. Reuses a batch of an earlier frame when possible.
+        std::vector<ParticleInstance> &getParticleBatch(engine::utils::StringId texture_id)
+        {
+            for (std::size_t i = 0; i < particle_batch_count_; ++i)
+            {
+                if (particle_batches_[i].texture_id == texture_id)
+                {
+                    return particle_batches_[i].particles;
+                }
+            }
+            if (particle_batch_count_ == particle_batches_.size())
+            {
+                particle_batches_.emplace_back();
+            }
+            ParticleBatch &batch = particle_batches_[particle_batch_count_++];
+            batch.texture_id = texture_id;
+            batch.particles.clear();
+            return batch.particles;
+        }
+        std::span<const ParticleBatch> getParticleBatches() const { return {particle_batches_.data(), particle_batch_count_}; }
+        const std::vector<UISpriteCommand> &getUISprites() const { return ui_sprites_; }
+
+        /// @brief Adds a retained UI layer, drawn after the UI sprites. Reuses the vectors of an earlier frame's layer.
+        UILayerFrame &addUILayer()
+        {
+            if (ui_layer_count_ == ui_layers_.size())
+            {
+                ui_layers_.emplace_back();
+            }
+            UILayerFrame &layer = ui_layers_[ui_layer_count_++];
+            layer.dirty_rects.clear();
+            layer.widgets.clear();
+            return layer;
+        }
+        std::span<const UILayerFrame> getUILayers() const { return {ui_layers_.data(), ui_layer_count_}; }
+    };
+} // namespace engine::render
@@ -1,12 +1,23 @@
 #include "renderer.h"
 #include "../resource/resource_manager.h"
 #include "camera.h"
+#include "render_snapshot.h"
+#include "particle_geometry.h"
+#include "render_capture.h"
+#include "../utils/log.h"
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <cmath>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
 namespace engine::render
 {
+    namespace
+    {
+        /// @brief Stored in Renderer::texture_cache_ for textures that failed to load. Its address is compared, never drawn.
+        SDL_Texture missing_texture{};
+    }
 
     Renderer::Renderer(engine::resource::ResourceManager *resourceManager, SDL_Renderer *renderer)
         : resourceManager_(resourceManager), renderer_(renderer)
@@ -22,13 +33,32 @@ namespace engine::render
         }
     }
 
+    Renderer::~Renderer()
+    {
+        if (capture_)
+        {
+            finishCapture();
+        }
+        for (UILayerCache &cache : ui_layer_caches_)
+        {
+            if (cache.target)
+            {
+                SDL_DestroyTexture(cache.target);
+            }
+        }
+        if (world_target_)
+        {
+            SDL_DestroyTexture(world_target_);
+        }
+    }
+
     void Renderer::drawSprite(const Camera &camera, const engine::render::Sprite &sprite, const glm::vec2 &position,
                               const glm::vec2 &scale, float rotation)
     {
-        auto texture = resourceManager_->getTexture(sprite.getTextureId());
+        auto texture = getTexture(sprite.getTextureId());
         if (!texture)
         {
-            spdlog::error("Failed to get texture for sprite");
+            ENGINE_LOG_ERROR_THROTTLED("Failed to get texture for sprite");
             return;
         }
 
@@ -36,11 +66,11 @@ namespace engine::render
         auto origintRect = getSpriteOriginRect(sprite);
         if (!origintRect.has_value())
         {
-            spdlog::error("Failed to get sprite origin rect");
+            ENGINE_LOG_ERROR_THROTTLED("Failed to get sprite origin rect");
             return;
         }
 
-        glm::vec2 screenPos = camera.worldToScreen(position);
+        glm::vec2 screenPos = camera.worldToViewport(position);
         SDL_FRect destRect = {
             screenPos.x,
             screenPos.y,
@@ -54,19 +84,20 @@ namespace engine::render
         }
 
         // Render the sprite
-        if (!SDL_RenderTextureRotated(renderer_, texture, &origintRect.value(), &destRect, rotation, nullptr, sprite.getIsFlip() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
+        ++draw_calls_;
+        if (!renderTextureRotated(texture, sprite.getTextureId(), &origintRect.value(), destRect, rotation, sprite.getIsFlip() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
         {
-            spdlog::error("Failed to render sprite: {}", SDL_GetError());
+            ENGINE_LOG_ERROR_THROTTLED("Failed to render sprite: {}", SDL_GetError());
         }
     }
 
     void Renderer::drawParallax(const Camera &camera, const engine::render::Sprite &sprite, const glm::vec2 &position,
                                 const glm::vec2 &scroll_factor, const glm::bvec2 &repeat, const glm::vec2 &scale)
     {
-        auto texture = resourceManager_->getTexture(sprite.getTextureId());
+        auto texture = getTexture(sprite.getTextureId());
         if (!texture)
         {
-            spdlog::error("Failed to get texture for sprite");
+            ENGINE_LOG_ERROR_THROTTLED("Failed to get texture for sprite");
             return;
         }
 
@@ -74,11 +105,11 @@ namespace engine::render
         auto origintRect = getSpriteOriginRect(sprite);
         if (!origintRect.has_value())
         {
-            spdlog::error("Failed to get sprite origin rect");
+            ENGINE_LOG_ERROR_THROTTLED("Failed to get sprite origin rect");
             return;
         }
         // Calculate the parallax position
-        glm::vec2 parallaxPos = camera.worldToScreenWithParallax(position, scroll_factor);
+        glm::vec2 parallaxPos = camera.worldToViewportWithParallax(position, scroll_factor);
 
         float w = origintRect->w * scale.x;
         float h = origintRect->h * scale.y;
@@ -121,9 +152,10 @@ namespace engine::render
                 }
 
                 // Render the sprite
-                if (!SDL_RenderTexture(renderer_, texture, nullptr, &destRect))
+                ++draw_calls_;
+                if (!renderTexture(texture, sprite.getTextureId(), nullptr, destRect))
                 {
-                    spdlog::error("Failed to render sprite: {}", SDL_GetError());
+                    ENGINE_LOG_ERROR_THROTTLED("Failed to render sprite: {}", SDL_GetError());
                 }
             }
         }
@@ -131,17 +163,17 @@ namespace engine::render
 
     void Renderer::drawUISprite(const Sprite &sprite, const glm::vec2 &position, const std::optional<glm::vec2> &size)
     {
-        auto texture = resourceManager_->getTexture(sprite.getTextureId());
+        auto texture = getTexture(sprite.getTextureId());
         if (!texture)
         {
-            spdlog::error("Failed to get texture for sprite");
+            ENGINE_LOG_ERROR_THROTTLED("Failed to get texture for sprite");
             return;
         }
 
         auto originRect = getSpriteOriginRect(sprite);
         if (!originRect.has_value())
         {
-            spdlog::error("Failed to get sprite origin rect");
+            ENGINE_LOG_ERROR_THROTTLED("Failed to get sprite origin rect");
             return;
         }
 
@@ -157,18 +189,368 @@ namespace engine::render
             destRect.h = originRect->h;
         }
 
-        if (!SDL_RenderTextureRotated(renderer_, texture, &originRect.value(), &destRect, 0.0, nullptr, sprite.getIsFlip() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
+        ++draw_calls_;
+        if (!renderTextureRotated(texture, sprite.getTextureId(), &originRect.value(), destRect, 0.0, sprite.getIsFlip() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
         {
-            spdlog::error("Failed to render sprite: {}", SDL_GetError());
+            ENGINE_LOG_ERROR_THROTTLED("Failed to render sprite: {}", SDL_GetError());
         }
     }
 
+    SDL_Texture *Renderer::getTexture(engine::utils::StringId texture_id)
+    {
+        // Unloading a texture invalidates every cached pointer
+        if (texture_cache_generation_ != resourceManager_->getTextureGeneration())
+        {
+            texture_cache_.clear();
+            texture_cache_generation_ = resourceManager_->getTextureGeneration();
+        }
+        if (texture_id >= texture_cache_.size())
+        {
+            texture_cache_.resize(texture_id + 1, nullptr);
+        }
+        SDL_Texture *&texture = texture_cache_[texture_id];
+        if (!texture)
+        {
+            // A failed load is not retried every frame; adding any texture changes the generation and retries it
+            SDL_Texture *loaded = resourceManager_->getTexture(engine::utils::StringTable::lookup(texture_id));
+            texture = loaded ? loaded : &missing_texture;
+        }
+        return texture == &missing_texture ? nullptr : texture;
+    }
+
+    SDL_Texture *Renderer::getTexture(const std::string &texture_path)
+    {
+        return getTexture(engine::utils::StringTable::intern(texture_path));
+    }
+
+    void Renderer::drawSpriteInstances(const Camera &camera, const std::vector<SpriteInstance> &instances)
+    {
+        for (const SpriteInstance &instance : instances)
+        {
+            SDL_Texture *texture = getTexture(instance.texture_id);
+            if (!texture)
+            {
+                ENGINE_LOG_ERROR_THROTTLED("Failed to get texture for sprite instance: {}", engine::utils::StringTable::lookup(instance.texture_id));
+                continue;
+            }
+
+            SDL_FRect source_rect = instance.source_rect;
+            if (source_rect.w <= 0.0f || source_rect.h <= 0.0f)
+            {
+                source_rect = {0.0f, 0.0f, static_cast<float>(texture->w), static_cast<float>(texture->h)};
+            }
+            glm::vec2 screen_position = camera.worldToViewport(instance.position);
+            SDL_FRect dest_rect = {
+                screen_position.x,
+                screen_position.y,
+                source_rect.w * instance.scale.x,
+                source_rect.h * instance.scale.y};
+            if (!isRectInViewport(dest_rect, camera))
+            {
+                continue;
+            }
+
+            ++draw_calls_;
+            if (!renderTextureRotated(texture, getCapturePath(instance.texture_id), &source_rect, dest_rect,
+                                      instance.rotation, instance.is_flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
+            {
+                ENGINE_LOG_ERROR_THROTTLED("Failed to render sprite: {}", SDL_GetError());
+            }
+        }
+    }
+
+    void Renderer::drawParticles(const Camera &camera, std::span<const ParticleBatch> batches)
+    {
+        for (const ParticleBatch &batch : batches)
+        {
+            if (batch.particles.empty())
+            {
+                continue;
+            }
+            SDL_Texture *texture = getTexture(batch.texture_id);
+            if (!texture)
+            {
+                ENGINE_LOG_ERROR_THROTTLED("Failed to get texture for particles: {}", engine::utils::StringTable::lookup(batch.texture_id));
+                continue;
+            }
+
+            buildParticleVertices(batch.particles, camera.getPosition(),
+                                  {static_cast<float>(texture->w), static_cast<float>(texture->h)}, particle_vertices_);
+            ++draw_calls_;
+            if (!renderQuads(texture, getCapturePath(batch.texture_id), particle_vertices_))
+            {
+                ENGINE_LOG_ERROR_THROTTLED("Failed to render particles: {}", SDL_GetError());
+            }
+        }
+    }
+
+    void Renderer::drawQuads(std::span<const SDL_Vertex> vertices)
+    {
+        if (vertices.size() < 4)
+        {
+            return;
+        }
+        ++draw_calls_;
+        // Untextured geometry blends with the draw blend mode
+        SDL_BlendMode blend_mode;
+        SDL_GetRenderDrawBlendMode(renderer_, &blend_mode);
+        setBlendMode(SDL_BLENDMODE_BLEND);
+        if (!renderQuads(nullptr, {}, vertices))
+        {
+            ENGINE_LOG_ERROR_THROTTLED("Failed to render quads: {}", SDL_GetError());
+        }
+        setBlendMode(blend_mode);
+    }
+
+    void Renderer::redrawUIRegion(const UILayerFrame &frame, const SDL_FRect &region)
+    {
+        const SDL_Rect clip = {static_cast<int>(std::floor(region.x)), static_cast<int>(std::floor(region.y)),
+                               static_cast<int>(std::ceil(region.x + region.w) - std::floor(region.x)),
+                               static_cast<int>(std::ceil(region.y + region.h) - std::floor(region.y))};
+        setClipRect(&clip);
+        // SDL_RenderClear ignores the clip rect, so the region is cleared with an unblended fill
+        const SDL_FRect clear_rect = {static_cast<float>(clip.x), static_cast<float>(clip.y), static_cast<float>(clip.w), static_cast<float>(clip.h)};
+        setBlendMode(SDL_BLENDMODE_NONE);
+        setDrawColor(0, 0, 0, 0);
+        fillRect(clear_rect);
+
+        for (const UIWidgetDraw &widget : frame.widgets)
+        {
+            const SDL_FRect dest_rect = {widget.rect.x - frame.bounds.x, widget.rect.y - frame.bounds.y, widget.rect.w, widget.rect.h};
+            if (!SDL_HasRectIntersectionFloat(&dest_rect, &clear_rect))
+            {
+                continue;
+            }
+            SDL_Texture *texture = getTexture(widget.texture_id);
+            if (!texture)
+            {
+                ENGINE_LOG_ERROR_THROTTLED("Failed to get texture for UI widget: {}", engine::utils::StringTable::lookup(widget.texture_id));
+                continue;
+            }
+            ++draw_calls_;
+            if (!renderTexture(texture, getCapturePath(widget.texture_id), nullptr, dest_rect))
+            {
+                ENGINE_LOG_ERROR_THROTTLED("Failed to render UI widget: {}", SDL_GetError());
+            }
+        }
+    }
+
+    void Renderer::updateUILayerCache(UILayerCache &cache, const UILayerFrame &frame)
+    {
+        Uint8 r, g, b, a;
+        SDL_BlendMode blend_mode;
+        SDL_GetRenderDrawColor(renderer_, &r, &g, &b, &a);
+        SDL_GetRenderDrawBlendMode(renderer_, &blend_mode);
+        setRenderTarget(cache.target);
+
+        if (cache.revision == 0 || cache.revision < frame.full_redraw_revision)
+        {
+            redrawUIRegion(frame, {0.0f, 0.0f, frame.bounds.w, frame.bounds.h});
+        }
+        else
+        {
+            for (const UIDirtyRect &dirty : frame.dirty_rects)
+            {
+                if (dirty.revision > cache.revision)
+                {
+                    redrawUIRegion(frame, {dirty.rect.x - frame.bounds.x, dirty.rect.y - frame.bounds.y, dirty.rect.w, dirty.rect.h});
+                }
+            }
+        }
+
+        setClipRect(nullptr);
+        setRenderTarget(nullptr);
+        setBlendMode(blend_mode);
+        setDrawColor(r, g, b, a);
+        cache.revision = frame.revision;
+    }
+
+    void Renderer::drawUILayers(std::span<const UILayerFrame> layers)
+    {
+        for (UILayerCache &cache : ui_layer_caches_)
+        {
+            cache.used = false;
+        }
+
+        for (const UILayerFrame &frame : layers)
+        {
+            auto it = std::find_if(ui_layer_caches_.begin(), ui_layer_caches_.end(), [&frame](const UILayerCache &cache)
+                                   { return cache.layer_id == frame.layer_id; });
+            if (it == ui_layer_caches_.end())
+            {
+                ui_layer_caches_.push_back({});
+                it = ui_layer_caches_.end() - 1;
+                it->layer_id = frame.layer_id;
+            }
+            UILayerCache &cache = *it;
+            cache.used = true;
+
+            const int width = static_cast<int>(frame.bounds.w);
+            const int height = static_cast<int>(frame.bounds.h);
+            if (width <= 0 || height <= 0)
+            {
+                continue;
+            }
+            if (!cache.target || cache.width != width || cache.height != height)
+            {
+                if (cache.target)
+                {
+                    SDL_DestroyTexture(cache.target);
+                }
+                cache.target = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+                cache.width = width;
+                cache.height = height;
+                cache.revision = 0;
+                if (!cache.target)
+                {
+                    ENGINE_LOG_ERROR_THROTTLED("Failed to create UI render target: {}", SDL_GetError());
+                    continue;
+                }
+                SDL_SetTextureBlendMode(cache.target, SDL_BLENDMODE_BLEND);
+                SDL_SetTextureScaleMode(cache.target, SDL_SCALEMODE_NEAREST);
+            }
+            if (cache.revision != frame.revision)
+            {
+                updateUILayerCache(cache, frame);
+            }
+            ++draw_calls_;
+            if (!renderTexture(cache.target, {}, nullptr, frame.bounds))
+            {
+                ENGINE_LOG_ERROR_THROTTLED("Failed to render UI layer: {}", SDL_GetError());
+            }
+        }
+
+        // Layers of scenes that went away
+        std::erase_if(ui_layer_caches_, [](UILayerCache &cache)
+                      {
+                          if (cache.used)
+                              return false;
+                          if (cache.target)
+                              SDL_DestroyTexture(cache.target);
+                          return true; });
+    }
+
+    void Renderer::invalidateUICaches()
+    {
+        for (UILayerCache &cache : ui_layer_caches_)
+        {
+            cache.revision = 0;
+        }
+    }
+
+    void Renderer::setInternalResolution(int width, int height)
+    {
+        if (width == internal_width_ && height == internal_height_)
+        {
+            return;
+        }
+        if (world_target_)
+        {
+            SDL_DestroyTexture(world_target_);
+            world_target_ = nullptr;
+        }
+        internal_width_ = std::max(width, 0);
+        internal_height_ = std::max(height, 0);
+    }
+
+    SDL_FRect Renderer::getWorldScreenRect() const
+    {
+        int output_width = 0, output_height = 0;
+        if (!hasInternalResolution() || !SDL_GetRenderOutputSize(renderer_, &output_width, &output_height))
+        {
+            return {0.0f, 0.0f, static_cast<float>(internal_width_), static_cast<float>(internal_height_)};
+        }
+        // Whole multiples keep every texel the same size on screen; the rest of the window is letterboxed
+        const int scale = std::max(1, std::min(output_width / internal_width_, output_height / internal_height_));
+        const int width = internal_width_ * scale;
+        const int height = internal_height_ * scale;
+        return {static_cast<float>((output_width - width) / 2), static_cast<float>((output_height - height) / 2),
+                static_cast<float>(width), static_cast<float>(height)};
+    }
+
+    void Renderer::applyScreenMapping(Camera &camera) const
+    {
+        if (!hasInternalResolution())
+        {
+            camera.setScreenMapping(glm::vec2(0.0f, 0.0f), 1.0f);
+            return;
+        }
+        const SDL_FRect rect = getWorldScreenRect();
+        camera.setScreenMapping(glm::vec2(rect.x, rect.y), rect.w / static_cast<float>(internal_width_));
+    }
+
+    bool Renderer::beginWorld()
+    {
+        if (!hasInternalResolution())
+        {
+            return false;
+        }
+        if (!world_target_)
+        {
+            world_target_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, internal_width_, internal_height_);
+            if (!world_target_)
+            {
+                spdlog::error("Failed to create world render target, drawing at window resolution: {}", SDL_GetError());
+                internal_width_ = 0;
+                internal_height_ = 0;
+                return false;
+            }
+            SDL_SetTextureScaleMode(world_target_, SDL_SCALEMODE_NEAREST);
+        }
+        setRenderTarget(world_target_);
+        clearScreen();
+        return true;
+    }
+
+    void Renderer::endWorld()
+    {
+        setRenderTarget(nullptr);
+        const SDL_FRect dest_rect = getWorldScreenRect();
+        ++draw_calls_;
+        if (!renderTexture(world_target_, {}, nullptr, dest_rect))
+        {
+            ENGINE_LOG_ERROR_THROTTLED("Failed to upscale world render target: {}", SDL_GetError());
+        }
+    }
+
+    void Renderer::drawSnapshot(const RenderSnapshot &snapshot)
+    {
+        const Camera &camera = snapshot.getCamera();
+        draw_calls_ = 0;
+        const bool world_target = beginWorld();
+        for (const auto &command : snapshot.getParallax())
+        {
+            drawParallax(camera, command.sprite, command.position, command.scroll_factor, command.repeat, command.scale);
+        }
+        drawSpriteInstances(camera, snapshot.getTiles());
+        for (const auto &command : snapshot.getSprites())
+        {
+            drawSprite(camera, command.sprite, command.position, command.scale, command.rotation);
+        }
+        drawSpriteInstances(camera, snapshot.getSpriteInstances());
+        drawParticles(camera, snapshot.getParticleBatches());
+        if (world_target)
+        {
+            endWorld();
+        }
+
+        for (const auto &command : snapshot.getUISprites())
+        {
+            drawUISprite(command.sprite, command.position, command.size);
+        }
+        drawUILayers(snapshot.getUILayers());
+    }
+
     void Renderer::setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     {
         if (!SDL_SetRenderDrawColor(renderer_, r, g, b, a))
         {
             spdlog::error("Failed to set draw color: {}", SDL_GetError());
         }
+        if (capture_)
+        {
+            capture_->setDrawColor({r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f});
+        }
     }
 
     void Renderer::setDrawColorFloat(float r, float g, float b, float a)
@@ -177,13 +559,21 @@ namespace engine::render
         {
             spdlog::error("Failed to set draw color (float): {}", SDL_GetError());
         }
+        if (capture_)
+        {
+            capture_->setDrawColor({r, g, b, a});
+        }
     }
 
     void Renderer::present()
     {
         if (!SDL_RenderPresent(renderer_))
         {
-            spdlog::error("Failed to present renderer: {}", SDL_GetError());
+            ENGINE_LOG_ERROR_THROTTLED("Failed to present renderer: {}", SDL_GetError());
+        }
+        if (capture_ && capture_->present())
+        {
+            finishCapture();
         }
     }
 
@@ -191,8 +581,131 @@ namespace engine::render
     {
         if (!SDL_RenderClear(renderer_))
         {
-            spdlog::error("Failed to clear screen: {}", SDL_GetError());
+            ENGINE_LOG_ERROR_THROTTLED("Failed to clear screen: {}", SDL_GetError());
+        }
+        if (capture_)
+        {
+            capture_->clear();
+        }
+    }
+
+    void Renderer::startCapture(const std::string &file_path, int frame_count)
+    {
+        if (capture_)
+        {
+            spdlog::warn("A render capture into {} is already running", capture_->getFilePath());
+            return;
+        }
+        if (frame_count <= 0)
+        {
+            spdlog::warn("Invalid render capture frame count: {}", frame_count);
+            return;
+        }
+        int width = 0;
+        int height = 0;
+        SDL_GetRenderOutputSize(renderer_, &width, &height);
+        capture_ = std::make_unique<RenderCapture>(file_path, static_cast<std::uint32_t>(frame_count), width, height);
+        // Retained UI targets were drawn before the capture and the replay creates them empty, so the first
+        // captured frame redraws all of them
+        invalidateUICaches();
+
+        // State set before the capture, which the replay starts from
+        SDL_FColor color;
+        SDL_BlendMode blend_mode;
+        SDL_GetRenderDrawColorFloat(renderer_, &color.r, &color.g, &color.b, &color.a);
+        SDL_GetRenderDrawBlendMode(renderer_, &blend_mode);
+        capture_->setTarget(SDL_GetRenderTarget(renderer_));
+        capture_->setDrawColor(color);
+        capture_->setBlendMode(blend_mode);
+        SDL_Rect clip;
+        capture_->setClip(SDL_RenderClipEnabled(renderer_) && SDL_GetRenderClipRect(renderer_, &clip) ? &clip : nullptr);
+        spdlog::info("Capturing {} frames of render commands into {}", frame_count, file_path);
+    }
+
+    void Renderer::finishCapture()
+    {
+        std::unique_ptr<RenderCapture> capture = std::move(capture_);
+        try
+        {
+            capture->save();
+            spdlog::info("Saved {} frames of render commands to {}", capture->getCapturedFrames(), capture->getFilePath());
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("Failed to save render capture: {}", e.what());
+        }
+    }
+
+    std::string_view Renderer::getCapturePath(engine::utils::StringId texture_id) const
+    {
+        return capture_ ? std::string_view(engine::utils::StringTable::lookup(texture_id)) : std::string_view();
+    }
+
+    void Renderer::setRenderTarget(SDL_Texture *target)
+    {
+        SDL_SetRenderTarget(renderer_, target);
+        if (capture_)
+        {
+            capture_->setTarget(target);
+        }
+    }
+
+    void Renderer::setBlendMode(SDL_BlendMode blend_mode)
+    {
+        SDL_SetRenderDrawBlendMode(renderer_, blend_mode);
+        if (capture_)
+        {
+            capture_->setBlendMode(blend_mode);
+        }
+    }
+
+    void Renderer::setClipRect(const SDL_Rect *clip)
+    {
+        SDL_SetRenderClipRect(renderer_, clip);
+        if (capture_)
+        {
+            capture_->setClip(clip);
+        }
+    }
+
+    void Renderer::fillRect(const SDL_FRect &rect)
+    {
+        SDL_RenderFillRect(renderer_, &rect);
+        if (capture_)
+        {
+            capture_->fillRect(rect);
+        }
+    }
+
+    bool Renderer::renderTexture(SDL_Texture *texture, std::string_view path, const SDL_FRect *source, const SDL_FRect &dest)
+    {
+        if (capture_)
+        {
+            capture_->texture(texture, path, source, dest, false, 0.0, SDL_FLIP_NONE);
+        }
+        return SDL_RenderTexture(renderer_, texture, source, &dest);
+    }
+
+    bool Renderer::renderTextureRotated(SDL_Texture *texture, std::string_view path, const SDL_FRect *source, const SDL_FRect &dest,
+                                        double rotation, SDL_FlipMode flip)
+    {
+        if (capture_)
+        {
+            capture_->texture(texture, path, source, dest, true, rotation, flip);
+        }
+        return SDL_RenderTextureRotated(renderer_, texture, source, &dest, rotation, nullptr, flip);
+    }
+
+    bool Renderer::renderQuads(SDL_Texture *texture, std::string_view path, std::span<const SDL_Vertex> vertices)
+    {
+        const std::size_t quad_count = vertices.size() / 4;
+        buildQuadIndices(quad_count, quad_indices_);
+        if (capture_)
+        {
+            capture_->quads(texture, path, vertices);
         }
+        return SDL_RenderGeometry(renderer_, texture, vertices.data(), static_cast<int>(quad_count * 4), quad_indices_.data(),
+                                  static_cast<int>(quad_count * 6));
     }
 
     std::optional<SDL_FRect> Renderer::getSpriteOriginRect(const engine::render::Sprite &sprite) const
@@ -218,7 +731,7 @@ namespace engine::render
             }
             else
             {
-                spdlog::error("Texture not found for sprite: {}", sprite.getTextureId());
+                ENGINE_LOG_ERROR_THROTTLED("Texture not found for sprite: {}", sprite.getTextureId());
                 return std::nullopt;
             }
         }
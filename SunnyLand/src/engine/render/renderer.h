@@ -1,10 +1,15 @@
 #pragma once
 #include "sprite.h"
 #include <string>
+#include <string_view>
+#include <memory>
 #include <optional>
+#include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
-struct SDL_Renderer;
-struct SDL_FRect;
+#include <span>
+#include <SDL3/SDL_render.h>
+#include "../utils/string_id.h"
 
 namespace engine::resource
 {
@@ -15,17 +20,88 @@ namespace engine::render
 {
 
     class Camera;
+    class RenderSnapshot;
+    class RenderCapture;
+    struct SpriteInstance;
+    struct ParticleBatch;
+    struct UILayerFrame;
     class Renderer
     {
     private:
         engine::resource::ResourceManager *resourceManager_ = nullptr;
         SDL_Renderer *renderer_ = nullptr;
 
+        /// @brief Textures of ECS sprites by interned path, so drawing an instance needs no string hashing.
+        /// nullptr until looked up; textures that failed to load hold a sentinel until the texture generation changes.
+        std::vector<SDL_Texture *> texture_cache_;
+        std::uint64_t texture_cache_generation_ = 0;
+
+        /// @brief Scratch geometry of particle batches, kept between frames.
+        std::vector<SDL_Vertex> particle_vertices_;
+        std::vector<int> quad_indices_;
+
+        /// @brief Render target holding the composited widgets of a retained UI layer, and the revision it shows.
+        struct UILayerCache
+        {
+            std::uint32_t layer_id = 0;
+            SDL_Texture *target = nullptr;
+            int width = 0;
+            int height = 0;
+            /// @brief 0 when the content is undefined.
+            std::uint64_t revision = 0;
+            bool used = false;
+        };
+        std::vector<UILayerCache> ui_layer_caches_;
+
+        /// @brief Low resolution target the world is drawn into when an internal resolution is set.
+        SDL_Texture *world_target_ = nullptr;
+        int internal_width_ = 0;
+        int internal_height_ = 0;
+
+        /// @brief SDL draw calls issued by the last drawSnapshot().
+        std::uint32_t draw_calls_ = 0;
+
+        /// @brief Records the SDL calls below while a capture runs.
+        std::unique_ptr<RenderCapture> capture_;
+
+        // Every SDL call that changes the output goes through these, so a capture sees all of them.
+        // path is the image a texture was loaded from, empty for render targets.
+        void setRenderTarget(SDL_Texture *target);
+        void setBlendMode(SDL_BlendMode blend_mode);
+        void setClipRect(const SDL_Rect *clip);
+        void fillRect(const SDL_FRect &rect);
+        bool renderTexture(SDL_Texture *texture, std::string_view path, const SDL_FRect *source, const SDL_FRect &dest);
+        bool renderTextureRotated(SDL_Texture *texture, std::string_view path, const SDL_FRect *source, const SDL_FRect &dest,
+                                  double rotation, SDL_FlipMode flip);
+        /// @brief Draws 4 vertices per quad with one geometry call.
+        bool renderQuads(SDL_Texture *texture, std::string_view path, std::span<const SDL_Vertex> vertices);
+        /// @brief Path of an interned texture for the capture; empty without one, saving the string table lookup.
+        std::string_view getCapturePath(engine::utils::StringId texture_id) const;
+        /// @brief Writes the capture and stops it.
+        void finishCapture();
+
+        /// @brief Binds and clears the world target, if any. Returns whether it is bound.
+        bool beginWorld();
+        /// @brief Binds the window again and upscales the world target onto it in one blit.
+        void endWorld();
+        /// @brief Largest integer-scaled rect of the internal resolution centered in the window.
+        SDL_FRect getWorldScreenRect() const;
+
+        /// @brief Brings the cache up to the frame's revision: redraws the dirty rects it has not seen, or everything.
+        void updateUILayerCache(UILayerCache &cache, const UILayerFrame &frame);
+        /// @brief Draws the widgets overlapping region (layer coordinates) into the bound target, replacing what was there.
+        void redrawUIRegion(const UILayerFrame &frame, const SDL_FRect &region);
+
+        /// @brief Cached texture, or nullptr if it is missing. Missing textures are looked up again only after a texture is added or removed.
+        SDL_Texture *getTexture(engine::utils::StringId texture_id);
+        SDL_Texture *getTexture(const std::string &texture_path);
+
         std::optional<SDL_FRect> getSpriteOriginRect(const engine::render::Sprite &sprite) const;
         bool isRectInViewport(const SDL_FRect &rect, const Camera &camera) const;
 
     public:
         Renderer(engine::resource::ResourceManager *resourceManager, SDL_Renderer *renderer);
+        ~Renderer();
 
         Renderer(const Renderer &) = delete;
         Renderer &operator=(const Renderer &) = delete;
@@ -40,6 +116,38 @@ namespace engine::render
 
         void drawUISprite(const Sprite &sprite, const glm::vec2 &position, const std::optional<glm::vec2> &size = std::nullopt);
 
+        /// @brief Draws sprites extracted from the ECS.
+        void drawSpriteInstances(const Camera &camera, const std::vector<SpriteInstance> &instances);
+
+        /// @brief Draws each batch of particles with a single geometry call.
+        void drawParticles(const Camera &camera, std::span<const ParticleBatch> batches);
+
+        /// @brief Draws each retained UI layer with one call, updating its cached render target first if it changed.
+        /// Targets of layers missing from the frame are released.
+        void drawUILayers(std::span<const UILayerFrame> layers);
+
+        /// @brief Draws untextured quads of 4 vertices each, in window coordinates, with a single geometry call.
+        void drawQuads(std::span<const SDL_Vertex> vertices);
+
+        /// @brief Forgets the content of the UI render targets, e.g. after SDL_EVENT_RENDER_TARGETS_RESET.
+        void invalidateUICaches();
+
+        /// @brief Draws the world into a width x height target that is upscaled by an integer factor with nearest
+        /// filtering, so fill cost no longer grows with the window. UI is still drawn at window resolution. 0 disables it.
+        void setInternalResolution(int width, int height);
+        bool hasInternalResolution() const { return internal_width_ > 0 && internal_height_ > 0; }
+        /// @brief Tells the camera where its viewport appears in the window, for screenToWorld().
+        void applyScreenMapping(Camera &camera) const;
+
+        /// @brief Draws every command of a snapshot with the snapshot's camera.
+        void drawSnapshot(const RenderSnapshot &snapshot);
+        std::uint32_t getDrawCalls() const { return draw_calls_; }
+
+        /// @brief Records every SDL call of the next frame_count presented frames, written to file_path after
+        /// the last one. Ignored while a capture runs. Replay the file with the render replay tool.
+        void startCapture(const std::string &file_path, int frame_count);
+        bool isCapturing() const { return capture_ != nullptr; }
+
         void present();
 
         void clearScreen();
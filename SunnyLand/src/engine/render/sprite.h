@@ -17,7 +17,7 @@ namespace engine::render
             : texture_id(texture_id), rect(rect), is_flip(is_flip) {}
 
         // Getters and setters for the private members
-        std::string getTextureId() const { return texture_id; }
+        const std::string &getTextureId() const { return texture_id; }
         void setTextureId(const std::string &id) { texture_id = id; }
 
         std::optional<SDL_FRect> getRect() const { return rect; }
@@ -0,0 +1,269 @@
+#include "async_resource_loader.h"
+#include "resource_manager.h"
+#include "../core/memory_tracker.h"
+#include <algorithm>
+#include <SDL3/SDL_timer.h>
+#include <SDL3_image/SDL_image.h>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource
+{
+    namespace
+    {
+        struct ChunkDeleter
+        {
+            void operator()(Mix_Chunk *chunk) const { Mix_FreeChunk(chunk); }
+        };
+        struct MusicDeleter
+        {
+            void operator()(Mix_Music *music) const { Mix_FreeMusic(music); }
+        };
+        struct FontDeleter
+        {
+            void operator()(TTF_Font *font) const { TTF_CloseFont(font); }
+        };
+    }
+
+    /// @brief A decoded resource waiting to be handed to the ResourceManager.
+    struct AsyncResourceLoader::Result
+    {
+        Job job;
+        std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> surface;
+        std::unique_ptr<Mix_Chunk, ChunkDeleter> chunk;
+        std::unique_ptr<Mix_Music, MusicDeleter> music;
+        std::unique_ptr<TTF_Font, FontDeleter> font;
+    };
+
+    AsyncResourceLoader::AsyncResourceLoader(ResourceManager &resource_manager, std::size_t thread_count)
+        : resource_manager_(resource_manager)
+    {
+        thread_count = std::max<std::size_t>(thread_count, 1);
+        for (std::size_t i = 0; i < thread_count; ++i)
+        {
+            workers_.emplace_back(&AsyncResourceLoader::workerMain, this);
+        }
+        spdlog::trace("AsyncResourceLoader started with {} worker threads.", thread_count);
+    }
+
+    AsyncResourceLoader::~AsyncResourceLoader()
+    {
+        {
+            std::lock_guard lock(job_mutex_);
+            stopping_ = true;
+        }
+        job_cv_.notify_all();
+        for (auto &worker : workers_)
+        {
+            worker.join();
+        }
+        spdlog::trace("AsyncResourceLoader stopped.");
+    }
+
+    LoadHandle AsyncResourceLoader::requestLoad(ResourceManifest manifest)
+    {
+        auto ticket = std::make_shared<LoadTicket>(std::move(manifest));
+        busy_tickets_.fetch_add(1, std::memory_order_acq_rel);
+        std::lock_guard lock(request_mutex_);
+        new_requests_.push_back(ticket);
+        return ticket;
+    }
+
+    void AsyncResourceLoader::requestUnload(ResourceManifest manifest)
+    {
+        std::lock_guard lock(request_mutex_);
+        unload_requests_.push_back(std::move(manifest));
+    }
+
+    void AsyncResourceLoader::pump(double budget_ms)
+    {
+        Uint64 start = SDL_GetTicksNS();
+        Uint64 budget_ns = static_cast<Uint64>(budget_ms * 1000000.0);
+
+        std::vector<LoadHandle> new_requests;
+        std::vector<ResourceManifest> unload_requests;
+        {
+            std::lock_guard lock(request_mutex_);
+            new_requests.swap(new_requests_);
+            unload_requests.swap(unload_requests_);
+        }
+
+        // Unloads first, so that a later request for the same file loads it again
+        for (const auto &manifest : unload_requests)
+        {
+            for (const auto &file_path : manifest.textures)
+            {
+                if (resource_manager_.hasTexture(file_path))
+                    resource_manager_.unloadTexture(file_path);
+            }
+            for (const auto &file_path : manifest.sounds)
+            {
+                if (resource_manager_.hasSound(file_path))
+                    resource_manager_.unloadSound(file_path);
+            }
+            for (const auto &file_path : manifest.music)
+            {
+                if (resource_manager_.hasMusic(file_path))
+                    resource_manager_.unloadMusic(file_path);
+            }
+            for (const auto &[file_path, size] : manifest.fonts)
+            {
+                if (resource_manager_.hasFont(file_path, size))
+                    resource_manager_.unloadFont(file_path, size);
+            }
+        }
+
+        for (const auto &ticket : new_requests)
+        {
+            dispatch(ticket);
+        }
+
+        while (true)
+        {
+            std::unique_ptr<Result> result;
+            {
+                std::lock_guard lock(result_mutex_);
+                if (results_.empty())
+                {
+                    break;
+                }
+                result = std::move(results_.front());
+                results_.pop_front();
+            }
+
+            finishResult(*result);
+
+            if (SDL_GetTicksNS() - start >= budget_ns)
+            {
+                break;
+            }
+        }
+    }
+
+    void AsyncResourceLoader::dispatch(const LoadHandle &ticket)
+    {
+        const ResourceManifest &manifest = ticket->manifest_;
+        std::vector<Job> jobs;
+        for (const auto &file_path : manifest.textures)
+        {
+            if (!resource_manager_.hasTexture(file_path))
+                jobs.push_back({ResourceType::Texture, file_path, 0, ticket});
+        }
+        for (const auto &file_path : manifest.sounds)
+        {
+            if (!resource_manager_.hasSound(file_path))
+                jobs.push_back({ResourceType::Sound, file_path, 0, ticket});
+        }
+        for (const auto &file_path : manifest.music)
+        {
+            if (!resource_manager_.hasMusic(file_path))
+                jobs.push_back({ResourceType::Music, file_path, 0, ticket});
+        }
+        for (const auto &[file_path, size] : manifest.fonts)
+        {
+            if (!resource_manager_.hasFont(file_path, size))
+                jobs.push_back({ResourceType::Font, file_path, size, ticket});
+        }
+
+        ticket->pending_ = jobs.size();
+        if (jobs.empty())
+        {
+            ticket->done_.store(true, std::memory_order_release);
+            busy_tickets_.fetch_sub(1, std::memory_order_acq_rel);
+            return;
+        }
+
+        spdlog::debug("Loading {} resources in the background", jobs.size());
+        {
+            std::lock_guard lock(job_mutex_);
+            for (auto &job : jobs)
+            {
+                jobs_.push_back(std::move(job));
+            }
+        }
+        job_cv_.notify_all();
+    }
+
+    void AsyncResourceLoader::finishResult(Result &result)
+    {
+        const Job &job = result.job;
+        bool loaded = false;
+        switch (job.type)
+        {
+        case ResourceType::Texture:
+            loaded = result.surface && resource_manager_.addTexture(job.file_path, result.surface.get());
+            break;
+        case ResourceType::Sound:
+            loaded = result.chunk && resource_manager_.addSound(job.file_path, result.chunk.release());
+            break;
+        case ResourceType::Music:
+            loaded = result.music && resource_manager_.addMusic(job.file_path, result.music.release());
+            break;
+        case ResourceType::Font:
+            loaded = result.font && resource_manager_.addFont(job.file_path, job.font_size, result.font.release());
+            break;
+        }
+        finishItem(*job.ticket, !loaded);
+    }
+
+    void AsyncResourceLoader::finishItem(LoadTicket &ticket, bool failed)
+    {
+        if (failed)
+        {
+            ticket.failed_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (--ticket.pending_ == 0)
+        {
+            ticket.done_.store(true, std::memory_order_release);
+            busy_tickets_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    void AsyncResourceLoader::workerMain()
+    {
+        // Everything a loader thread allocates belongs to the resources it loads
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock lock(job_mutex_);
+                job_cv_.wait(lock, [this]
+                             { return stopping_ || !jobs_.empty(); });
+                if (stopping_)
+                {
+                    return;
+                }
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+
+            auto result = std::make_unique<Result>();
+            const char *file_path = job.file_path.c_str();
+            switch (job.type)
+            {
+            case ResourceType::Texture:
+                result->surface.reset(IMG_Load(file_path));
+                break;
+            case ResourceType::Sound:
+                result->chunk.reset(Mix_LoadWAV(file_path));
+                break;
+            case ResourceType::Music:
+                result->music.reset(Mix_LoadMUS(file_path));
+                break;
+            case ResourceType::Font:
+                result->font.reset(TTF_OpenFont(file_path, static_cast<float>(job.font_size)));
+                break;
+            }
+            if (!result->surface && !result->chunk && !result->music && !result->font)
+            {
+                spdlog::error("Failed to load resource in the background: {}. SDL Error: {}", job.file_path, SDL_GetError());
+            }
+            result->job = std::move(job);
+
+            std::lock_guard lock(result_mutex_);
+            results_.push_back(std::move(result));
+        }
+    }
+} // namespace engine::resource
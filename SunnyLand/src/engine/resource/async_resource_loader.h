@@ -0,0 +1,109 @@
+#pragma once
+#include "resource_manifest.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::resource
+{
+    class ResourceManager;
+    class AsyncResourceLoader;
+
+    /// @brief Progress of one load request. Shared between the requester and the loader.
+    class LoadTicket final
+    {
+        friend class AsyncResourceLoader;
+
+    private:
+        ResourceManifest manifest_;
+        std::atomic<bool> done_ = false;
+        std::atomic<std::size_t> failed_ = 0;
+        std::size_t pending_ = 0; // Only touched by the thread calling pump()
+
+    public:
+        explicit LoadTicket(ResourceManifest manifest) : manifest_(std::move(manifest)) {}
+
+        /// @brief True once every resource of the manifest is usable (or failed to load).
+        bool isDone() const { return done_.load(std::memory_order_acquire); }
+        std::size_t getFailedCount() const { return failed_.load(std::memory_order_relaxed); }
+        const ResourceManifest &getManifest() const { return manifest_; }
+    };
+
+    using LoadHandle = std::shared_ptr<LoadTicket>;
+
+    /// @brief Loads resources in the background without stalling the frame.
+    /// Files are decoded on worker threads; the results are handed to the ResourceManager in pump(),
+    /// which must be called once per frame on the render thread and respects a time budget so that
+    /// texture uploads are spread over several frames.
+    /// requestLoad() and requestUnload() may be called from any thread.
+    class AsyncResourceLoader final
+    {
+    private:
+        enum class ResourceType
+        {
+            Texture,
+            Sound,
+            Music,
+            Font
+        };
+
+        struct Job
+        {
+            ResourceType type;
+            std::string file_path;
+            int font_size = 0;
+            LoadHandle ticket;
+        };
+
+        struct Result;
+
+        ResourceManager &resource_manager_;
+
+        std::mutex request_mutex_;
+        std::vector<LoadHandle> new_requests_;
+        std::vector<ResourceManifest> unload_requests_;
+
+        std::mutex job_mutex_;
+        std::condition_variable job_cv_;
+        std::deque<Job> jobs_;
+        bool stopping_ = false;
+        std::vector<std::thread> workers_;
+
+        std::mutex result_mutex_;
+        std::deque<std::unique_ptr<Result>> results_;
+
+        std::atomic<std::size_t> busy_tickets_ = 0;
+
+        void workerMain();
+        void dispatch(const LoadHandle &ticket);
+        /// @brief Hands one decoded resource to the ResourceManager.
+        void finishResult(Result &result);
+        void finishItem(LoadTicket &ticket, bool failed);
+
+    public:
+        explicit AsyncResourceLoader(ResourceManager &resource_manager, std::size_t thread_count = 2);
+        ~AsyncResourceLoader();
+
+        AsyncResourceLoader(const AsyncResourceLoader &) = delete;
+        AsyncResourceLoader &operator=(const AsyncResourceLoader &) = delete;
+        AsyncResourceLoader(AsyncResourceLoader &&) = delete;
+        AsyncResourceLoader &operator=(AsyncResourceLoader &&) = delete;
+
+        /// @brief Starts loading every resource of the manifest that is not loaded yet.
+        LoadHandle requestLoad(ResourceManifest manifest);
+
+        /// @brief Unloads the resources of the manifest on the next pump().
+        void requestUnload(ResourceManifest manifest);
+
+        /// @brief Applies unload requests, dispatches new load requests and uploads finished resources
+        /// until budget_ms is used up. Must be called on the render thread.
+        void pump(double budget_ms);
+
+        /// @brief True while any load request is not done yet.
+        bool isBusy() const { return busy_tickets_.load(std::memory_order_acquire) > 0; }
+    };
+} // namespace engine::resource
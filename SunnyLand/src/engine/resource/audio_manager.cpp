@@ -1,4 +1,6 @@
 #include "audio_manager.h"
+#include "../utils/log.h"
+#include <algorithm>
 #include <stdexcept>
 #include <spdlog/spdlog.h>
 namespace engine::resource
@@ -46,11 +48,11 @@ namespace engine::resource
         Mix_Chunk *chunk = Mix_LoadWAV(filePath.c_str());
         if (!chunk)
         {
-            spdlog::error("Failed to load sound: {}. SDL_mixer Error: {}", filePath, SDL_GetError());
+            ENGINE_LOG_ERROR_THROTTLED("Failed to load sound: {}. SDL_mixer Error: {}", filePath, SDL_GetError());
             return nullptr;
         }
 
-        mAudioChunks[filePath] = std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter>(chunk);
+        cacheSound(filePath, chunk);
         spdlog::debug("Sound loaded: {}", filePath);
         return chunk;
     }
@@ -60,16 +62,42 @@ namespace engine::resource
         auto it = mAudioChunks.find(filePath);
         if (it != mAudioChunks.end())
         {
-            spdlog::debug("Retrieving sound: {}", filePath);
+            ENGINE_LOG_DEBUG("Retrieving sound: {}", filePath);
             return it->second.get();
         }
         else
         {
-            spdlog::warn("Sound not found: {}", filePath);
+            ENGINE_LOG_WARN_THROTTLED("Sound not found: {}", filePath);
             return loadSound(filePath);
         }
     }
 
+    Mix_Chunk *AudioManager::addSound(const std::string &filePath, Mix_Chunk *chunk)
+    {
+        auto it = mAudioChunks.find(filePath);
+        if (it != mAudioChunks.end())
+        {
+            // Already loaded by someone else; keep the cached chunk
+            Mix_FreeChunk(chunk);
+            return it->second.get();
+        }
+        cacheSound(filePath, chunk);
+        spdlog::debug("Sound added: {}", filePath);
+        return chunk;
+    }
+
+    void AudioManager::cacheSound(const std::string &filePath, Mix_Chunk *chunk)
+    {
+        mAudioChunks[filePath] = std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter>(chunk);
+        mSoundMemoryUsage += chunk->alen;
+        mPeakSoundMemoryUsage = std::max(mPeakSoundMemoryUsage, mSoundMemoryUsage);
+    }
+
+    bool AudioManager::hasSound(const std::string &filePath) const
+    {
+        return mAudioChunks.contains(filePath);
+    }
+
     void AudioManager::unloadSound(const std::string &filePath)
     {
         auto it = mAudioChunks.find(filePath);
@@ -81,6 +109,7 @@ namespace engine::resource
         else
         {
             spdlog::debug("Unloading sound: {}", filePath);
+            mSoundMemoryUsage -= it->second->alen;
             mAudioChunks.erase(it);
         }
     }
@@ -91,6 +120,7 @@ namespace engine::resource
         {
             spdlog::debug("Clearing all sound chunks.");
             mAudioChunks.clear();
+            mSoundMemoryUsage = 0;
         }
     }
 
@@ -119,7 +149,7 @@ namespace engine::resource
         auto it = mMusicTracks.find(filePath);
         if (it != mMusicTracks.end())
         {
-            spdlog::debug("Retrieving music: {}", filePath);
+            ENGINE_LOG_DEBUG("Retrieving music: {}", filePath);
             return it->second.get();
         }
         else
@@ -129,6 +159,24 @@ namespace engine::resource
         }
     }
 
+    Mix_Music *AudioManager::addMusic(const std::string &filePath, Mix_Music *music)
+    {
+        auto it = mMusicTracks.find(filePath);
+        if (it != mMusicTracks.end())
+        {
+            Mix_FreeMusic(music);
+            return it->second.get();
+        }
+        mMusicTracks[filePath] = std::unique_ptr<Mix_Music, SDLMixMusicDeleter>(music);
+        spdlog::debug("Music added: {}", filePath);
+        return music;
+    }
+
+    bool AudioManager::hasMusic(const std::string &filePath) const
+    {
+        return mMusicTracks.contains(filePath);
+    }
+
     void AudioManager::unloadMusic(const std::string &filePath)
     {
         auto it = mMusicTracks.find(filePath);
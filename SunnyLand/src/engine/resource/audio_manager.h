@@ -36,6 +36,11 @@ namespace engine::resource
 
         std::unordered_map<std::string, std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter>> mAudioChunks;
         std::unordered_map<std::string, std::unique_ptr<Mix_Music, SDLMixMusicDeleter>> mMusicTracks;
+        /// @brief Sample bytes of the cached chunks, and the most they ever added up to.
+        std::size_t mSoundMemoryUsage = 0;
+        std::size_t mPeakSoundMemoryUsage = 0;
+
+        void cacheSound(const std::string &filePath, Mix_Chunk *chunk);
 
     public:
         explicit AudioManager();
@@ -49,14 +54,24 @@ namespace engine::resource
     private:
         Mix_Chunk *loadSound(const std::string &filePath);
         Mix_Chunk *getSound(const std::string &filePath);
+        Mix_Chunk *addSound(const std::string &filePath, Mix_Chunk *chunk);
+        bool hasSound(const std::string &filePath) const;
         void unloadSound(const std::string &filePath);
         void clearSounds();
 
         Mix_Music *loadMusic(const std::string &filePath);
         Mix_Music *getMusic(const std::string &filePath);
+        Mix_Music *addMusic(const std::string &filePath, Mix_Music *music);
+        bool hasMusic(const std::string &filePath) const;
         void unloadMusic(const std::string &filePath);
         void clearMusics();
 
         void clearAudio();
+
+        std::size_t getSoundCount() const { return mAudioChunks.size(); }
+        std::size_t getMusicCount() const { return mMusicTracks.size(); }
+        /// @brief Bytes of decoded samples of all sound chunks. Music is streamed and not counted.
+        std::size_t getSoundMemoryUsage() const { return mSoundMemoryUsage; }
+        std::size_t getPeakSoundMemoryUsage() const { return mPeakSoundMemoryUsage; }
     };
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "font_manager.h"
+#include "../utils/log.h"
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
@@ -54,7 +55,7 @@ namespace engine::resource
         auto it = mFontCache.find(key);
         if (it != mFontCache.end())
         {
-            spdlog::debug("Retrieving font: {} at size {}", filePath, size);
+            ENGINE_LOG_DEBUG("Retrieving font: {} at size {}", filePath, size);
             return it->second.get();
         }
         else
@@ -64,6 +65,25 @@ namespace engine::resource
         }
     }
 
+    TTF_Font *FontManager::addFont(const std::string &filePath, int size, TTF_Font *font)
+    {
+        FontKey key(filePath, size);
+        auto it = mFontCache.find(key);
+        if (it != mFontCache.end())
+        {
+            TTF_CloseFont(font);
+            return it->second.get();
+        }
+        mFontCache[key] = std::unique_ptr<TTF_Font, TTFDeleter>(font);
+        spdlog::debug("Font added: {} at size {}", filePath, size);
+        return font;
+    }
+
+    bool FontManager::hasFont(const std::string &filePath, int size) const
+    {
+        return mFontCache.contains(FontKey(filePath, size));
+    }
+
     void FontManager::unloadFont(const std::string &filePath, int size)
     {
         FontKey key(filePath, size);
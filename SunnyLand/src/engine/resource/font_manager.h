@@ -46,7 +46,10 @@ namespace engine::resource
     private:
         TTF_Font *loadFont(const std::string &filePath, int size);
         TTF_Font *getFont(const std::string &filePath, int size);
+        TTF_Font *addFont(const std::string &filePath, int size, TTF_Font *font);
+        bool hasFont(const std::string &filePath, int size) const;
         void unloadFont(const std::string &filePath, int size);
         void clearFonts();
+        std::size_t getFontCount() const { return mFontCache.size(); }
     };
 }
\ No newline at end of file
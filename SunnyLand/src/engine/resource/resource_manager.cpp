@@ -2,6 +2,9 @@
 #include "texture_manager.h"
 #include "audio_manager.h"
 #include "font_manager.h"
+#include "resource_manifest.h"
+#include "../audio/voice_manager.h"
+#include "../core/memory_tracker.h"
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
@@ -10,6 +13,7 @@ namespace engine::resource
 
     ResourceManager::ResourceManager(SDL_Renderer *renderer)
     {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
         if (!renderer)
         {
             throw std::runtime_error("Renderer is null. Cannot initialize ResourceManager.");
@@ -17,28 +21,111 @@ namespace engine::resource
         textureManager_ = std::make_unique<TextureManager>(renderer);
         audioManager_ = std::make_unique<AudioManager>();
         fontManager_ = std::make_unique<FontManager>();
+        voiceManager_ = std::make_unique<engine::audio::VoiceManager>(*this);
         spdlog::trace("ResourceManager initialized successfully with provided renderer.");
     }
 
+    ResourceManager::ResourceManager(SDL_Renderer *renderer, std::unique_ptr<AudioManager> audioManager, std::unique_ptr<FontManager> fontManager)
+        : audioManager_(std::move(audioManager)), fontManager_(std::move(fontManager))
+    {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        if (!renderer)
+        {
+            throw std::runtime_error("Renderer is null. Cannot initialize ResourceManager.");
+        }
+        if (!audioManager_ || !fontManager_)
+        {
+            throw std::runtime_error("Audio or font manager is null. Cannot initialize ResourceManager.");
+        }
+        textureManager_ = std::make_unique<TextureManager>(renderer);
+        voiceManager_ = std::make_unique<engine::audio::VoiceManager>(*this);
+        spdlog::trace("ResourceManager initialized successfully with preloaded managers.");
+    }
+
     ResourceManager::~ResourceManager() = default;
 
+    std::unique_ptr<AudioManager> ResourceManager::createAudioManager(const std::vector<std::string> &sounds,
+                                                                      const std::vector<std::string> &music)
+    {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        auto audioManager = std::make_unique<AudioManager>();
+        for (const auto &filePath : sounds)
+        {
+            audioManager->loadSound(filePath);
+        }
+        for (const auto &filePath : music)
+        {
+            audioManager->loadMusic(filePath);
+        }
+        return audioManager;
+    }
+
+    std::unique_ptr<FontManager> ResourceManager::createFontManager(const std::vector<std::pair<std::string, int>> &fonts)
+    {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        auto fontManager = std::make_unique<FontManager>();
+        for (const auto &[filePath, size] : fonts)
+        {
+            fontManager->loadFont(filePath, size);
+        }
+        return fontManager;
+    }
+
+    void ResourceManager::uploadTextures(std::vector<DecodedTexture> &decodedTextures)
+    {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        for (auto &decoded : decodedTextures)
+        {
+            textureManager_->loadTextureFromSurface(decoded.file_path, decoded.surface.get());
+        }
+        decodedTextures.clear();
+    }
+
     void ResourceManager::clearResources()
     {
         textureManager_->clearTextures();
+        voiceManager_->releaseSounds();
         audioManager_->clearAudio();
         fontManager_->clearFonts();
     }
 
+    ResourceMemoryUsage ResourceManager::getMemoryUsage() const
+    {
+        ResourceMemoryUsage usage;
+        usage.texture_count = textureManager_->getTextureCount();
+        usage.texture_bytes = textureManager_->getMemoryUsage();
+        usage.peak_texture_bytes = textureManager_->getPeakMemoryUsage();
+        usage.sound_count = audioManager_->getSoundCount();
+        usage.sound_bytes = audioManager_->getSoundMemoryUsage();
+        usage.peak_sound_bytes = audioManager_->getPeakSoundMemoryUsage();
+        usage.music_count = audioManager_->getMusicCount();
+        usage.font_count = fontManager_->getFontCount();
+        return usage;
+    }
+
     SDL_Texture *ResourceManager::loadTexture(const std::string &filePath)
     {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
         return textureManager_->loadTexture(filePath);
     }
 
     SDL_Texture *ResourceManager::getTexture(const std::string &filePath)
     {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
         return textureManager_->getTexture(filePath);
     }
 
+    SDL_Texture *ResourceManager::addTexture(const std::string &filePath, SDL_Surface *surface)
+    {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        return textureManager_->loadTextureFromSurface(filePath, surface);
+    }
+
+    bool ResourceManager::hasTexture(const std::string &filePath) const
+    {
+        return textureManager_->hasTexture(filePath);
+    }
+
     glm::vec2 ResourceManager::getTextureSize(const std::string &filePath) const
     {
         return textureManager_->getTextureSize(filePath);
@@ -54,36 +141,79 @@ namespace engine::resource
         textureManager_->clearTextures();
     }
 
+    std::uint64_t ResourceManager::getTextureGeneration() const
+    {
+        return textureManager_->getGeneration();
+    }
+
     Mix_Chunk *ResourceManager::loadSound(const std::string &filePath)
     {
-        return audioManager_->loadSound(filePath);
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        Mix_Chunk *chunk = audioManager_->loadSound(filePath);
+        if (chunk)
+        {
+            voiceManager_->forgetMissingSounds();
+        }
+        return chunk;
     }
 
     Mix_Chunk *ResourceManager::getSound(const std::string &filePath)
     {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
         return audioManager_->getSound(filePath);
     }
 
+    Mix_Chunk *ResourceManager::addSound(const std::string &filePath, Mix_Chunk *chunk)
+    {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        Mix_Chunk *added = audioManager_->addSound(filePath, chunk);
+        voiceManager_->forgetMissingSounds();
+        return added;
+    }
+
+    bool ResourceManager::hasSound(const std::string &filePath) const
+    {
+        return audioManager_->hasSound(filePath);
+    }
+
     void ResourceManager::unloadSound(const std::string &filePath)
     {
+        if (audioManager_->hasSound(filePath))
+        {
+            voiceManager_->releaseSound(audioManager_->getSound(filePath));
+        }
         audioManager_->unloadSound(filePath);
     }
 
     void ResourceManager::clearSounds()
     {
+        voiceManager_->releaseSounds();
         audioManager_->clearSounds();
     }
 
     Mix_Music *ResourceManager::loadMusic(const std::string &filePath)
     {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
         return audioManager_->loadMusic(filePath);
     }
 
     Mix_Music *ResourceManager::getMusic(const std::string &filePath)
     {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
         return audioManager_->getMusic(filePath);
     }
 
+    Mix_Music *ResourceManager::addMusic(const std::string &filePath, Mix_Music *music)
+    {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        return audioManager_->addMusic(filePath, music);
+    }
+
+    bool ResourceManager::hasMusic(const std::string &filePath) const
+    {
+        return audioManager_->hasMusic(filePath);
+    }
+
     void ResourceManager::unloadMusic(const std::string &filePath)
     {
         audioManager_->unloadMusic(filePath);
@@ -96,19 +226,33 @@ namespace engine::resource
 
     void ResourceManager::clearAudio()
     {
+        voiceManager_->releaseSounds();
         audioManager_->clearAudio();
     }
 
     TTF_Font *ResourceManager::loadFont(const std::string &filePath, int size)
     {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
         return fontManager_->loadFont(filePath, size);
     }
 
     TTF_Font *ResourceManager::getFont(const std::string &filePath, int size)
     {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
         return fontManager_->getFont(filePath, size);
     }
 
+    TTF_Font *ResourceManager::addFont(const std::string &filePath, int size, TTF_Font *font)
+    {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        return fontManager_->addFont(filePath, size, font);
+    }
+
+    bool ResourceManager::hasFont(const std::string &filePath, int size) const
+    {
+        return fontManager_->hasFont(filePath, size);
+    }
+
     void ResourceManager::unloadFont(const std::string &filePath, int size)
     {
         fontManager_->unloadFont(filePath, size);
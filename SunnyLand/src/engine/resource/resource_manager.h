@@ -5,11 +5,36 @@
 #include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <string>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+namespace engine::audio
+{
+    class VoiceManager;
+}
+
 namespace engine::resource
 {
+    struct DecodedTexture;
     class TextureManager;
     class AudioManager;
     class FontManager;
+
+    /// @brief Sizes of the cached resources as reported by the managers. SDL allocates this memory itself,
+    /// so it never shows up in the engine's allocation tracking.
+    struct ResourceMemoryUsage
+    {
+        std::size_t texture_count = 0;
+        std::size_t texture_bytes = 0;
+        std::size_t peak_texture_bytes = 0;
+        std::size_t sound_count = 0;
+        std::size_t sound_bytes = 0;
+        std::size_t peak_sound_bytes = 0;
+        std::size_t music_count = 0;
+        std::size_t font_count = 0;
+    };
+
     class ResourceManager final
     {
 
@@ -17,35 +42,61 @@ namespace engine::resource
         std::unique_ptr<TextureManager> textureManager_;
         std::unique_ptr<AudioManager> audioManager_;
         std::unique_ptr<FontManager> fontManager_;
+        std::unique_ptr<engine::audio::VoiceManager> voiceManager_;
 
     public:
         explicit ResourceManager(SDL_Renderer *renderer);
+        /// @brief Takes over audio and font managers that were created ahead of time, e.g. on worker threads.
+        ResourceManager(SDL_Renderer *renderer, std::unique_ptr<AudioManager> audioManager, std::unique_ptr<FontManager> fontManager);
         ~ResourceManager();
         void clearResources();
+        ResourceMemoryUsage getMemoryUsage() const;
 
         ResourceManager(const ResourceManager &) = delete;
         ResourceManager &operator=(const ResourceManager &) = delete;
         ResourceManager(ResourceManager &&) = delete;
         ResourceManager &operator=(ResourceManager &&) = delete;
 
+        /// @brief Initializes SDL_mixer, opens the audio device and loads the given audio. Safe to call from a worker thread.
+        static std::unique_ptr<AudioManager> createAudioManager(const std::vector<std::string> &sounds = {},
+                                                                const std::vector<std::string> &music = {});
+        /// @brief Initializes SDL_ttf and loads the given fonts. Safe to call from a worker thread.
+        static std::unique_ptr<FontManager> createFontManager(const std::vector<std::pair<std::string, int>> &fonts = {});
+
+        /// @brief Creates textures from images decoded on a worker thread. Must be called on the render thread.
+        void uploadTextures(std::vector<DecodedTexture> &decodedTextures);
+
         SDL_Texture *loadTexture(const std::string &filePath);
         SDL_Texture *getTexture(const std::string &filePath);
+        SDL_Texture *addTexture(const std::string &filePath, SDL_Surface *surface);
+        bool hasTexture(const std::string &filePath) const;
         glm::vec2 getTextureSize(const std::string &filePath) const;
         void unloadTexture(const std::string &filePath);
         void clearTextures();
+        /// @brief Changes whenever a texture is added or destroyed. Caches of SDL_Texture pointers and of missing textures
+        /// must be dropped when it does.
+        std::uint64_t getTextureGeneration() const;
 
         Mix_Chunk *loadSound(const std::string &filePath);
         Mix_Chunk *getSound(const std::string &filePath);
+        Mix_Chunk *addSound(const std::string &filePath, Mix_Chunk *chunk);
+        bool hasSound(const std::string &filePath) const;
         void unloadSound(const std::string &filePath);
         void clearSounds();
         Mix_Music *loadMusic(const std::string &filePath);
         Mix_Music *getMusic(const std::string &filePath);
+        Mix_Music *addMusic(const std::string &filePath, Mix_Music *music);
+        bool hasMusic(const std::string &filePath) const;
         void unloadMusic(const std::string &filePath);
         void clearMusics();
         void clearAudio();
+        /// @brief Plays sound effects on the mixer channels; unloading a sound stops its voices first.
+        engine::audio::VoiceManager &getVoiceManager() { return *voiceManager_; }
 
         TTF_Font *loadFont(const std::string &filePath, int size);
         TTF_Font *getFont(const std::string &filePath, int size);
+        TTF_Font *addFont(const std::string &filePath, int size, TTF_Font *font);
+        bool hasFont(const std::string &filePath, int size) const;
         void unloadFont(const std::string &filePath, int size);
         void clearFonts();
     };
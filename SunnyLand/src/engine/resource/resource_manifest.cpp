@@ -0,0 +1,52 @@
+#include "resource_manifest.h"
+#include "../core/memory_tracker.h"
+#include "../utils/json_cache.h"
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource
+{
+    ResourceManifest ResourceManifest::loadFromFile(const std::string &file_path)
+    {
+        ResourceManifest manifest;
+        try
+        {
+            nlohmann::json json = engine::utils::loadJson(file_path);
+            manifest.textures = json.value("textures", std::vector<std::string>{});
+            manifest.sounds = json.value("sounds", std::vector<std::string>{});
+            manifest.music = json.value("music", std::vector<std::string>{});
+            for (const auto &font : json.value("fonts", nlohmann::json::array()))
+            {
+                manifest.fonts.emplace_back(font.at("path").get<std::string>(), font.at("size").get<int>());
+            }
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            throw std::runtime_error("Failed to parse resource manifest " + file_path + ": " + e.what());
+        }
+
+        spdlog::debug("Resource manifest loaded: {} ({} textures, {} sounds, {} music, {} fonts)", file_path,
+                      manifest.textures.size(), manifest.sounds.size(), manifest.music.size(), manifest.fonts.size());
+        return manifest;
+    }
+
+    std::vector<DecodedTexture> decodeTextures(const std::vector<std::string> &file_paths)
+    {
+        engine::core::MemoryScope memory_scope(engine::core::MemoryTag::Resource);
+        std::vector<DecodedTexture> decoded;
+        decoded.reserve(file_paths.size());
+        for (const auto &file_path : file_paths)
+        {
+            SDL_Surface *surface = IMG_Load(file_path.c_str());
+            if (!surface)
+            {
+                spdlog::error("Failed to decode texture: {}. SDL_image Error: {}", file_path, SDL_GetError());
+                continue;
+            }
+            decoded.push_back({file_path, std::unique_ptr<SDL_Surface, SDLSurfaceDeleter>(surface)});
+        }
+        return decoded;
+    }
+} // namespace engine::resource
@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <SDL3/SDL_surface.h>
+
+namespace engine::resource
+{
+    /// @brief List of resources to preload at startup, read from a JSON manifest.
+    struct ResourceManifest
+    {
+        std::vector<std::string> textures;
+        std::vector<std::string> sounds;
+        std::vector<std::string> music;
+        std::vector<std::pair<std::string, int>> fonts; // font file path and size
+
+        /// @brief Loads a manifest file. Throws std::runtime_error if the file cannot be read or parsed.
+        static ResourceManifest loadFromFile(const std::string &file_path);
+    };
+
+    struct SDLSurfaceDeleter
+    {
+        void operator()(SDL_Surface *surface) const
+        {
+            if (surface)
+            {
+                SDL_DestroySurface(surface);
+            }
+        }
+    };
+
+    /// @brief Image decoded on a worker thread, waiting to be uploaded as a texture on the render thread.
+    struct DecodedTexture
+    {
+        std::string file_path;
+        std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> surface;
+    };
+
+    /// @brief Decodes image files to surfaces. Safe to call from any thread.
+    /// Files that fail to decode are logged and skipped.
+    std::vector<DecodedTexture> decodeTextures(const std::vector<std::string> &file_paths);
+} // namespace engine::resource
@@ -1,5 +1,7 @@
 #include "texture_manager.h"
+#include "../utils/log.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <stdexcept>
 #include <SDL3_image/SDL_image.h>
 
@@ -33,30 +35,68 @@ namespace engine::resource
         SDL_Texture *texture = IMG_LoadTexture(renderer_, filePath.c_str());
         if (!texture)
         {
-            spdlog::error("Failed to load texture: {}. SDL_image Error: {}", filePath, SDL_GetError());
+            ENGINE_LOG_ERROR_THROTTLED("Failed to load texture: {}. SDL_image Error: {}", filePath, SDL_GetError());
             return nullptr;
         }
 
-        mTextureCache[filePath] = std::unique_ptr<SDL_Texture, SDLTextureDeleter>(texture);
+        cacheTexture(filePath, texture);
         spdlog::debug("Texture loaded: {}", filePath);
         return texture;
     }
 
+    SDL_Texture *TextureManager::loadTextureFromSurface(const std::string &filePath, SDL_Surface *surface)
+    {
+        auto it = mTextureCache.find(filePath);
+        if (it != mTextureCache.end())
+        {
+            return it->second.get();
+        }
+
+        SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer_, surface);
+        if (!texture)
+        {
+            spdlog::error("Failed to create texture from surface: {}. SDL Error: {}", filePath, SDL_GetError());
+            return nullptr;
+        }
+
+        cacheTexture(filePath, texture);
+        spdlog::debug("Texture uploaded: {}", filePath);
+        return texture;
+    }
+
     SDL_Texture *TextureManager::getTexture(const std::string &filePath)
     {
         auto it = mTextureCache.find(filePath);
         if (it != mTextureCache.end())
         {
-            spdlog::trace("Retrieving texture: {}", filePath);
+            ENGINE_LOG_TRACE("Retrieving texture: {}", filePath);
             return it->second.get();
         }
         else
         {
-            spdlog::warn("Texture not found in cache: {}", filePath);
+            ENGINE_LOG_WARN_THROTTLED("Texture not found in cache: {}", filePath);
             return loadTexture(filePath);
         }
     }
 
+    bool TextureManager::hasTexture(const std::string &filePath) const
+    {
+        return mTextureCache.contains(filePath);
+    }
+
+    std::size_t TextureManager::textureBytes(const SDL_Texture *texture)
+    {
+        return static_cast<std::size_t>(texture->w) * static_cast<std::size_t>(texture->h) * SDL_BYTESPERPIXEL(texture->format);
+    }
+
+    void TextureManager::cacheTexture(const std::string &filePath, SDL_Texture *texture)
+    {
+        mTextureCache[filePath] = std::unique_ptr<SDL_Texture, SDLTextureDeleter>(texture);
+        ++mGeneration;
+        mMemoryUsage += textureBytes(texture);
+        mPeakMemoryUsage = std::max(mPeakMemoryUsage, mMemoryUsage);
+    }
+
     glm::vec2 TextureManager::getTextureSize(const std::string &filePath) const
     {
         auto it = mTextureCache.find(filePath);
@@ -84,7 +124,9 @@ namespace engine::resource
         else
         {
             spdlog::debug("Unloading texture: {}", filePath);
+            mMemoryUsage -= textureBytes(it->second.get());
             mTextureCache.erase(it);
+            ++mGeneration;
         }
     }
 
@@ -94,6 +136,8 @@ namespace engine::resource
         {
             spdlog::debug("Clearing all textures.");
             mTextureCache.clear();
+            mMemoryUsage = 0;
+            ++mGeneration;
         }
     }
 } // namespace engine::resource
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <cstdint>
 #include <memory>
 #include <SDL3/SDL_render.h>
 #include <unordered_map>
@@ -24,6 +25,12 @@ namespace engine::resource
             }
         };
         std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> mTextureCache;
+        /// @brief Incremented whenever a texture is added or destroyed, so holders of raw texture pointers can drop them
+        /// and holders of failed lookups can retry.
+        std::uint64_t mGeneration = 0;
+        /// @brief Pixel bytes of the cached textures, and the most they ever added up to.
+        std::size_t mMemoryUsage = 0;
+        std::size_t mPeakMemoryUsage = 0;
 
         SDL_Renderer *renderer_ = nullptr;
 
@@ -38,9 +45,20 @@ namespace engine::resource
 
     private:
         SDL_Texture *loadTexture(const std::string &filePath);
+        SDL_Texture *loadTextureFromSurface(const std::string &filePath, SDL_Surface *surface);
         SDL_Texture *getTexture(const std::string &filePath);
+        bool hasTexture(const std::string &filePath) const;
         glm::vec2 getTextureSize(const std::string &filePath) const;
         void unloadTexture(const std::string &filePath);
         void clearTextures();
+        std::uint64_t getGeneration() const { return mGeneration; }
+        std::size_t getTextureCount() const { return mTextureCache.size(); }
+        /// @brief Bytes of pixel data of all textures, as if each were stored unpadded in its pixel format.
+        std::size_t getMemoryUsage() const { return mMemoryUsage; }
+        std::size_t getPeakMemoryUsage() const { return mPeakMemoryUsage; }
+
+    private:
+        static std::size_t textureBytes(const SDL_Texture *texture);
+        void cacheTexture(const std::string &filePath, SDL_Texture *texture);
     };
 }
\ No newline at end of file
@@ -0,0 +1,632 @@
+#include "world_serializer.h"
+#include "../ecs/world.h"
+#include "../utils/mapped_file.h"
+#include "../utils/string_id.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace engine::save
+{
+    namespace
+    {
+        static_assert(sizeof(SaveHeader) % 8 == 0 && sizeof(SchemaEntry) % 8 == 0 && sizeof(BlockHeader) % 8 == 0 &&
+                      sizeof(ArchetypeHeader) % 8 == 0);
+        static_assert(std::is_trivially_copyable_v<engine::ecs::Entity>);
+
+        constexpr std::size_t BLOCK_ALIGNMENT = 8;
+        /// @brief Blocks smaller than this are not worth encoding.
+        constexpr std::size_t MIN_COMPRESSED_SIZE = 64;
+        constexpr std::size_t MIN_RUN = 3;
+        constexpr std::size_t MAX_RUN = 0x7F + MIN_RUN;
+        constexpr std::size_t MAX_LITERALS = 0x80;
+
+        std::size_t paddingOf(std::size_t size)
+        {
+            return (BLOCK_ALIGNMENT - size % BLOCK_ALIGNMENT) % BLOCK_ALIGNMENT;
+        }
+
+        /// @brief Delta + run-length encoding. A control byte with the high bit set repeats the next byte
+        /// (c & 0x7F) + MIN_RUN times; otherwise c + 1 literal bytes follow.
+        void encodeDeltaRle(std::span<const std::byte> raw, std::size_t stride, std::vector<std::byte> &delta, std::vector<std::byte> &out)
+        {
+            const std::size_t size = raw.size();
+            const auto *in = reinterpret_cast<const std::uint8_t *>(raw.data());
+            delta.resize(size);
+            auto *d = reinterpret_cast<std::uint8_t *>(delta.data());
+            for (std::size_t i = 0; i < std::min(stride, size); ++i)
+            {
+                d[i] = in[i];
+            }
+            for (std::size_t i = stride; i < size; ++i)
+            {
+                d[i] = static_cast<std::uint8_t>(in[i] - in[i - stride]);
+            }
+
+            // Worst case: all literals, one control byte per MAX_LITERALS
+            out.resize(size + size / MAX_LITERALS + 1);
+            auto *o = reinterpret_cast<std::uint8_t *>(out.data());
+            std::size_t written = 0;
+            std::size_t i = 0;
+            while (i < size)
+            {
+                std::size_t run = 1;
+                while (i + run < size && run < MAX_RUN && d[i + run] == d[i])
+                {
+                    ++run;
+                }
+                if (run >= MIN_RUN)
+                {
+                    o[written++] = static_cast<std::uint8_t>(0x80 | (run - MIN_RUN));
+                    o[written++] = d[i];
+                    i += run;
+                    continue;
+                }
+
+                // Literals up to the next run worth encoding
+                std::size_t start = i;
+                while (i < size && i - start < MAX_LITERALS)
+                {
+                    if (i + 2 < size && d[i] == d[i + 1] && d[i] == d[i + 2])
+                    {
+                        break;
+                    }
+                    ++i;
+                }
+                o[written++] = static_cast<std::uint8_t>(i - start - 1);
+                std::memcpy(o + written, d + start, i - start);
+                written += i - start;
+            }
+            out.resize(written);
+        }
+
+        void decodeDeltaRle(std::span<const std::byte> stored, std::byte *out, std::size_t raw_size, std::size_t stride)
+        {
+            std::size_t in = 0;
+            std::size_t written = 0;
+            while (written < raw_size)
+            {
+                if (in >= stored.size())
+                {
+                    throw std::runtime_error("Corrupt save file: encoded block ends early");
+                }
+                auto control = std::to_integer<std::uint8_t>(stored[in++]);
+                if (control & 0x80)
+                {
+                    std::size_t count = (control & 0x7Fu) + MIN_RUN;
+                    if (in >= stored.size() || count > raw_size - written)
+                    {
+                        throw std::runtime_error("Corrupt save file: run overflows block");
+                    }
+                    std::memset(out + written, std::to_integer<int>(stored[in++]), count);
+                    written += count;
+                }
+                else
+                {
+                    std::size_t count = std::size_t(control) + 1;
+                    if (count > stored.size() - in || count > raw_size - written)
+                    {
+                        throw std::runtime_error("Corrupt save file: literals overflow block");
+                    }
+                    std::memcpy(out + written, stored.data() + in, count);
+                    in += count;
+                    written += count;
+                }
+            }
+            for (std::size_t i = stride; i < raw_size; ++i)
+            {
+                out[i] = static_cast<std::byte>(static_cast<std::uint8_t>(std::to_integer<std::uint8_t>(out[i]) + std::to_integer<std::uint8_t>(out[i - stride])));
+            }
+        }
+
+        class Writer
+        {
+        private:
+            std::string file_path_;
+            std::ofstream file_;
+            const SaveOptions &options_;
+            SaveStats &stats_;
+            std::vector<std::byte> delta_;
+            std::vector<std::byte> encoded_;
+
+        public:
+            Writer(const std::string &file_path, const SaveOptions &options, SaveStats &stats)
+                : file_path_(file_path), file_(file_path, std::ios::binary | std::ios::trunc), options_(options), stats_(stats)
+            {
+                if (!file_)
+                {
+                    throw std::runtime_error("Failed to open save file for writing: " + file_path);
+                }
+            }
+
+            void write(const void *data, std::size_t size)
+            {
+                file_.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+                stats_.file_bytes += size;
+            }
+
+            template <typename T>
+            void write(const T &value) { write(&value, sizeof(T)); }
+
+            void writeBlock(const void *data, std::size_t size, std::size_t stride)
+            {
+                std::span<const std::byte> raw(static_cast<const std::byte *>(data), size);
+                BlockHeader header;
+                header.stride = static_cast<std::uint32_t>(stride);
+                header.raw_size = size;
+                header.stored_size = size;
+                if (options_.compress && size >= MIN_COMPRESSED_SIZE)
+                {
+                    encodeDeltaRle(raw, stride, delta_, encoded_);
+                    if (encoded_.size() <= size - size / 4)
+                    {
+                        header.encoding = BlockEncoding::DeltaRle;
+                        header.stored_size = encoded_.size();
+                        raw = encoded_;
+                        ++stats_.compressed_blocks;
+                    }
+                }
+                write(header);
+                write(raw.data(), raw.size());
+                static constexpr std::array<std::byte, BLOCK_ALIGNMENT> zeros{};
+                write(zeros.data(), paddingOf(raw.size()));
+                stats_.raw_bytes += size;
+            }
+
+            void close()
+            {
+                file_.close();
+                if (!file_)
+                {
+                    throw std::runtime_error("Failed to write save file: " + file_path_);
+                }
+            }
+        };
+
+        class Reader
+        {
+        private:
+            std::span<const std::byte> bytes_;
+            std::size_t offset_ = 0;
+
+        public:
+            explicit Reader(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+            const std::byte *take(std::size_t size)
+            {
+                if (size > bytes_.size() - offset_)
+                {
+                    throw std::runtime_error("Corrupt save file: truncated");
+                }
+                const std::byte *data = bytes_.data() + offset_;
+                offset_ += size;
+                return data;
+            }
+
+            template <typename T>
+            T read()
+            {
+                T value;
+                std::memcpy(&value, take(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            /// @brief Reads a block header and returns its stored bytes, skipping the padding after them.
+            std::span<const std::byte> readBlock(BlockHeader &header)
+            {
+                header = read<BlockHeader>();
+                // Each run of MAX_RUN bytes takes two stored bytes, so no valid block expands further
+                if (header.stored_size > bytes_.size() - offset_ || header.stride == 0 ||
+                    (header.encoding == BlockEncoding::Raw && header.stored_size != header.raw_size) ||
+                    (header.encoding == BlockEncoding::DeltaRle && header.raw_size > header.stored_size / 2 * MAX_RUN) ||
+                    (header.encoding != BlockEncoding::Raw && header.encoding != BlockEncoding::DeltaRle))
+                {
+                    throw std::runtime_error("Corrupt save file: bad block header");
+                }
+                std::span<const std::byte> stored(take(static_cast<std::size_t>(header.stored_size)), static_cast<std::size_t>(header.stored_size));
+                take(paddingOf(stored.size()));
+                return stored;
+            }
+
+            /// @brief Copies or decodes the next block into out, which must hold exactly raw_size bytes.
+            void readBlockInto(void *out, std::size_t raw_size)
+            {
+                BlockHeader header;
+                std::span<const std::byte> stored = readBlock(header);
+                if (header.raw_size != raw_size)
+                {
+                    throw std::runtime_error("Corrupt save file: block size does not match its content");
+                }
+                if (header.encoding == BlockEncoding::Raw)
+                {
+                    std::memcpy(out, stored.data(), raw_size);
+                }
+                else
+                {
+                    decodeDeltaRle(stored, static_cast<std::byte *>(out), raw_size, header.stride);
+                }
+            }
+
+            /// @brief Decoded size of the next block, without consuming it, to check counts read from the file before allocating.
+            std::uint64_t peekBlockSize() const
+            {
+                Reader ahead = *this;
+                BlockHeader header;
+                ahead.readBlock(header);
+                return header.raw_size;
+            }
+
+            /// @brief Throws unless the next block decodes to exactly count elements of element_size bytes.
+            void expectBlockSize(std::uint64_t count, std::size_t element_size, const char *what) const
+            {
+                const std::uint64_t size = peekBlockSize();
+                if (count > size / element_size || count * element_size != size)
+                {
+                    throw std::runtime_error(std::string("Corrupt save file: ") + what + " does not match its block");
+                }
+            }
+
+            void skipBlock()
+            {
+                BlockHeader header;
+                readBlock(header);
+            }
+
+            /// @brief The bytes of the next block, decoded into scratch unless stored raw.
+            std::span<const std::byte> readBlockBytes(std::vector<std::byte> &scratch)
+            {
+                BlockHeader header;
+                std::span<const std::byte> stored = readBlock(header);
+                if (header.encoding == BlockEncoding::Raw)
+                {
+                    return stored;
+                }
+                scratch.resize(static_cast<std::size_t>(header.raw_size));
+                decodeDeltaRle(stored, scratch.data(), scratch.size(), header.stride);
+                return scratch;
+            }
+        };
+
+        /// @brief Renumbers the StringId members of rows components of one type.
+        void remapStringIds(std::byte *rows, std::size_t count, const engine::ecs::ComponentInfo &info,
+                            const std::vector<engine::utils::StringId> &remap)
+        {
+            for (std::size_t row = 0; row < count; ++row)
+            {
+                for (std::size_t field = 0; field < info.string_id_count; ++field)
+                {
+                    std::byte *member = rows + row * info.size + info.string_id_offsets[field];
+                    engine::utils::StringId id;
+                    std::memcpy(&id, member, sizeof(id));
+                    id = id < remap.size() ? remap[id] : engine::utils::EMPTY_STRING_ID;
+                    std::memcpy(member, &id, sizeof(id));
+                }
+            }
+        }
+    }
+
+    SaveStats WorldSerializer::save(const engine::ecs::World &world, const std::string &file_path, const SaveOptions &options)
+    {
+        using engine::ecs::ComponentMask;
+        using engine::ecs::ComponentRegistry;
+        using engine::ecs::ComponentTypeId;
+
+        // The schema lists only the component types some entity has, in type id order
+        std::vector<const engine::ecs::Archetype *> archetypes;
+        ComponentMask used = 0;
+        for (const auto &archetype : world.archetypes_)
+        {
+            if (!archetype->empty())
+            {
+                archetypes.push_back(archetype.get());
+                used |= archetype->getMask();
+            }
+        }
+        std::array<int, engine::ecs::MAX_COMPONENT_TYPES> schema_index;
+        schema_index.fill(-1);
+        std::vector<ComponentTypeId> schema;
+        bool has_string_ids = false;
+        for (ComponentMask remaining = used; remaining != 0; remaining &= remaining - 1)
+        {
+            auto type_id = static_cast<ComponentTypeId>(std::countr_zero(remaining));
+            schema_index[type_id] = static_cast<int>(schema.size());
+            schema.push_back(type_id);
+            has_string_ids = has_string_ids || ComponentRegistry::info(type_id).string_id_count > 0;
+        }
+
+        SaveStats stats;
+        std::string temp_path = file_path + ".tmp";
+        try
+        {
+            Writer writer(temp_path, options, stats);
+
+            SaveHeader header;
+            header.component_count = static_cast<std::uint32_t>(schema.size());
+            header.string_count = has_string_ids ? static_cast<std::uint32_t>(engine::utils::StringTable::size()) : 0;
+            header.archetype_count = static_cast<std::uint32_t>(archetypes.size());
+            header.record_count = static_cast<std::uint32_t>(world.records_.size());
+            header.entity_count = world.getEntityCount();
+            writer.write(header);
+
+            for (ComponentTypeId type_id : schema)
+            {
+                const engine::ecs::ComponentInfo &info = ComponentRegistry::info(type_id);
+                if (info.name.size() >= SAVE_NAME_LENGTH)
+                {
+                    throw std::runtime_error("Component name too long for save files: " + std::string(info.name));
+                }
+                SchemaEntry entry;
+                std::memcpy(entry.name, info.name.data(), info.name.size());
+                entry.size = static_cast<std::uint32_t>(info.size);
+                entry.alignment = static_cast<std::uint32_t>(info.alignment);
+                writer.write(entry);
+            }
+
+            // All interned strings, so ids can be renumbered on load without knowing which ones are referenced
+            std::vector<std::byte> strings;
+            for (engine::utils::StringId id = 0; id < header.string_count; ++id)
+            {
+                const std::string &str = engine::utils::StringTable::lookup(id);
+                auto length = static_cast<std::uint32_t>(str.size());
+                const auto *length_bytes = reinterpret_cast<const std::byte *>(&length);
+                strings.insert(strings.end(), length_bytes, length_bytes + sizeof(length));
+                const auto *str_bytes = reinterpret_cast<const std::byte *>(str.data());
+                strings.insert(strings.end(), str_bytes, str_bytes + str.size());
+            }
+            writer.writeBlock(strings.data(), strings.size(), 1);
+
+            std::vector<std::uint32_t> generations(world.records_.size());
+            for (std::size_t index = 0; index < generations.size(); ++index)
+            {
+                generations[index] = world.records_[index].generation;
+            }
+            writer.writeBlock(generations.data(), generations.size() * sizeof(std::uint32_t), sizeof(std::uint32_t));
+
+            for (const engine::ecs::Archetype *archetype : archetypes)
+            {
+                ArchetypeHeader archetype_header;
+                for (ComponentMask remaining = archetype->getMask(); remaining != 0; remaining &= remaining - 1)
+                {
+                    archetype_header.schema_mask |= std::uint64_t(1) << schema_index[std::countr_zero(remaining)];
+                }
+                archetype_header.rows = archetype->size();
+                writer.write(archetype_header);
+
+                const std::vector<engine::ecs::Entity> &entities = archetype->getEntities();
+                writer.writeBlock(entities.data(), entities.size() * sizeof(engine::ecs::Entity), sizeof(engine::ecs::Entity));
+                // Columns are ordered by type id, which is also schema order
+                for (const engine::ecs::Column &column : archetype->getColumns())
+                {
+                    writer.writeBlock(column.get(0), archetype->size() * column.getElementSize(), column.getElementSize());
+                }
+            }
+            writer.close();
+
+            std::filesystem::rename(temp_path, file_path);
+        }
+        catch (const std::filesystem::filesystem_error &e)
+        {
+            std::error_code ignored;
+            std::filesystem::remove(temp_path, ignored);
+            throw std::runtime_error("Failed to replace save file " + file_path + ": " + e.what());
+        }
+        catch (...)
+        {
+            // Whatever was saved before stays in place
+            std::error_code ignored;
+            std::filesystem::remove(temp_path, ignored);
+            throw;
+        }
+
+        stats.entities = world.getEntityCount();
+        stats.archetypes = archetypes.size();
+        spdlog::info("World saved: {} ({} entities, {} archetypes, {} bytes, {:.0f}% of raw)", file_path, stats.entities, stats.archetypes,
+                     stats.file_bytes, stats.raw_bytes > 0 ? 100.0 * static_cast<double>(stats.file_bytes) / static_cast<double>(stats.raw_bytes) : 100.0);
+        return stats;
+    }
+
+    SaveStats WorldSerializer::load(engine::ecs::World &world, const std::string &file_path)
+    {
+        using engine::ecs::ComponentRegistry;
+        using engine::ecs::ComponentTypeId;
+
+        engine::utils::MappedFile file(file_path);
+        Reader reader(file.getBytes());
+        SaveStats stats;
+        stats.file_bytes = file.size();
+
+        SaveHeader expected;
+        auto header = reader.read<SaveHeader>();
+        if (std::memcmp(header.magic, expected.magic, sizeof(expected.magic)) != 0)
+        {
+            throw std::runtime_error("Not a save file: " + file_path);
+        }
+        if (header.byte_order != SAVE_BYTE_ORDER)
+        {
+            throw std::runtime_error("Save file was written on a machine of another byte order: " + file_path);
+        }
+        if (header.version != SAVE_VERSION)
+        {
+            throw std::runtime_error("Unsupported save file version " + std::to_string(header.version) + ": " + file_path);
+        }
+        if (header.component_count > engine::ecs::MAX_COMPONENT_TYPES)
+        {
+            throw std::runtime_error("Corrupt save file: too many component types");
+        }
+
+        std::vector<std::optional<ComponentTypeId>> local_ids;
+        for (std::uint32_t i = 0; i < header.component_count; ++i)
+        {
+            auto entry = reader.read<SchemaEntry>();
+            std::string_view name(entry.name, static_cast<std::size_t>(std::find(entry.name, entry.name + SAVE_NAME_LENGTH, '\0') - entry.name));
+            std::optional<ComponentTypeId> type_id = ComponentRegistry::find(name);
+            if (!type_id)
+            {
+                spdlog::warn("Save file {} has component '{}', which is not registered. It is dropped.", file_path, name);
+            }
+            else if (ComponentRegistry::info(*type_id).size != entry.size)
+            {
+                spdlog::warn("Component '{}' was {} bytes when {} was saved and is {} bytes now. It is dropped.", name, entry.size,
+                             file_path, ComponentRegistry::info(*type_id).size);
+                type_id.reset();
+            }
+            stats.skipped_components += type_id ? 0 : 1;
+            local_ids.push_back(type_id);
+        }
+
+        // Interned ids depend on the order strings were first used in a run
+        std::vector<std::byte> scratch;
+        std::span<const std::byte> strings = reader.readBlockBytes(scratch);
+        // Every string starts with its length
+        if (header.string_count > strings.size() / sizeof(std::uint32_t))
+        {
+            throw std::runtime_error("Corrupt save file: string count does not match the string table");
+        }
+        std::vector<engine::utils::StringId> string_remap;
+        string_remap.reserve(header.string_count);
+        bool identity_remap = true;
+        for (std::size_t offset = 0, i = 0; i < header.string_count; ++i)
+        {
+            std::uint32_t length;
+            if (sizeof(length) > strings.size() - offset)
+            {
+                throw std::runtime_error("Corrupt save file: string table");
+            }
+            std::memcpy(&length, strings.data() + offset, sizeof(length));
+            offset += sizeof(length);
+            if (length > strings.size() - offset)
+            {
+                throw std::runtime_error("Corrupt save file: string table");
+            }
+            engine::utils::StringId id = engine::utils::StringTable::intern({reinterpret_cast<const char *>(strings.data() + offset), length});
+            offset += length;
+            identity_remap = identity_remap && id == i;
+            string_remap.push_back(id);
+        }
+
+        reader.expectBlockSize(header.record_count, sizeof(std::uint32_t), "record count");
+        std::vector<std::uint32_t> generations(header.record_count);
+        reader.readBlockInto(generations.data(), generations.size() * sizeof(std::uint32_t));
+
+        world.clear();
+        try
+        {
+            // Every index keeps its generation, so handles saved with the world stay valid and older ones stay stale
+            world.records_.assign(header.record_count, {});
+            for (std::size_t index = 0; index < generations.size(); ++index)
+            {
+                world.records_[index].generation = generations[index];
+            }
+
+            std::uint64_t loaded = 0;
+            for (std::uint32_t a = 0; a < header.archetype_count; ++a)
+            {
+                auto archetype_header = reader.read<ArchetypeHeader>();
+                if ((header.component_count < 64 && archetype_header.schema_mask >> header.component_count != 0) ||
+                    archetype_header.rows > header.entity_count - loaded)
+                {
+                    throw std::runtime_error("Corrupt save file: bad archetype header");
+                }
+                auto rows = static_cast<std::size_t>(archetype_header.rows);
+
+                engine::ecs::ComponentMask local_mask = 0;
+                for (std::uint64_t remaining = archetype_header.schema_mask; remaining != 0; remaining &= remaining - 1)
+                {
+                    if (const auto &type_id = local_ids[std::countr_zero(remaining)])
+                    {
+                        local_mask |= engine::ecs::ComponentMask(1) << *type_id;
+                    }
+                }
+                // Dropping unknown components can merge two archetypes of the file into one
+                engine::ecs::Archetype &archetype = world.getOrCreateArchetype(local_mask);
+                std::size_t first_row = archetype.size();
+
+                reader.expectBlockSize(rows, sizeof(engine::ecs::Entity), "archetype row count");
+                archetype.entities_.resize(first_row + rows);
+                reader.readBlockInto(archetype.entities_.data() + first_row, rows * sizeof(engine::ecs::Entity));
+                for (std::size_t row = 0; row < rows; ++row)
+                {
+                    const engine::ecs::Entity &entity = archetype.entities_[first_row + row];
+                    if (entity.index >= world.records_.size() || world.records_[entity.index].archetype != nullptr ||
+                        world.records_[entity.index].generation != entity.generation)
+                    {
+                        throw std::runtime_error("Corrupt save file: bad entity handle");
+                    }
+                    world.records_[entity.index].archetype = &archetype;
+                    world.records_[entity.index].row = static_cast<std::uint32_t>(first_row + row);
+                }
+
+                for (std::uint64_t remaining = archetype_header.schema_mask; remaining != 0; remaining &= remaining - 1)
+                {
+                    const auto &type_id = local_ids[std::countr_zero(remaining)];
+                    if (!type_id)
+                    {
+                        reader.skipBlock();
+                        continue;
+                    }
+                    const engine::ecs::ComponentInfo &info = ComponentRegistry::info(*type_id);
+                    engine::ecs::Column &column = archetype.columns_[archetype.column_index_[*type_id]];
+                    reader.expectBlockSize(rows, info.size, "component column");
+                    column.resize(first_row + rows);
+                    auto *data = static_cast<std::byte *>(column.get(first_row));
+                    reader.readBlockInto(data, rows * info.size);
+                    if (info.string_id_count > 0 && !identity_remap)
+                    {
+                        remapStringIds(data, rows, info, string_remap);
+                    }
+                }
+                loaded += rows;
+                ++stats.archetypes;
+            }
+            if (loaded != header.entity_count)
+            {
+                throw std::runtime_error("Corrupt save file: entity count does not match its archetypes");
+            }
+
+            // Lowest indices are reused first, as pop_back takes from the end
+            world.free_indices_.clear();
+            for (std::size_t index = world.records_.size(); index-- > 0;)
+            {
+                if (world.records_[index].archetype == nullptr)
+                {
+                    world.free_indices_.push_back(static_cast<std::uint32_t>(index));
+                }
+            }
+            world.entity_count_ = static_cast<std::size_t>(loaded);
+            stats.entities = world.entity_count_;
+        }
+        catch (...)
+        {
+            // Rows already restored may not have their components; drop everything
+            for (auto &archetype : world.archetypes_)
+            {
+                archetype->clear();
+            }
+            world.free_indices_.clear();
+            for (std::size_t index = world.records_.size(); index-- > 0;)
+            {
+                auto &record = world.records_[index];
+                if (record.archetype)
+                {
+                    record.archetype = nullptr;
+                    ++record.generation;
+                }
+                world.free_indices_.push_back(static_cast<std::uint32_t>(index));
+            }
+            world.entity_count_ = 0;
+            throw;
+        }
+
+        spdlog::info("World loaded: {} ({} entities, {} archetypes)", file_path, stats.entities, stats.archetypes);
+        return stats;
+    }
+} // namespace engine::save
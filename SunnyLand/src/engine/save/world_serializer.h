@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace engine::ecs
+{
+    class World;
+}
+
+namespace engine::save
+{
+    constexpr std::uint32_t SAVE_VERSION = 1;
+    constexpr std::uint32_t SAVE_BYTE_ORDER = 0x01020304;
+    constexpr std::size_t SAVE_NAME_LENGTH = 40;
+
+    /// @brief Start of a save file. It is followed by, in order and each padded to 8 bytes:
+    /// component_count SchemaEntries, a block of string_count (u32 length, bytes) strings, a block of record_count
+    /// entity generations, then archetype_count archetypes, each an ArchetypeHeader followed by a block of its
+    /// entities and one block per component in schema order.
+    struct SaveHeader
+    {
+        char magic[4] = {'S', 'L', 'S', 'V'};
+        std::uint32_t version = SAVE_VERSION;
+        /// @brief Written in the byte order of the saving machine, so files of the other order are rejected.
+        std::uint32_t byte_order = SAVE_BYTE_ORDER;
+        std::uint32_t component_count = 0;
+        std::uint32_t string_count = 0;
+        std::uint32_t archetype_count = 0;
+        /// @brief Entity indices in use when saving, alive or free.
+        std::uint32_t record_count = 0;
+        std::uint32_t reserved = 0;
+        std::uint64_t entity_count = 0;
+    };
+
+    /// @brief Component type of the file. Components are matched by name on load, and must have the same size.
+    struct SchemaEntry
+    {
+        char name[SAVE_NAME_LENGTH] = {};
+        std::uint32_t size = 0;
+        std::uint32_t alignment = 0;
+    };
+
+    enum class BlockEncoding : std::uint32_t
+    {
+        /// @brief The bytes as they are in memory, copied in one go.
+        Raw = 0,
+        /// @brief Each byte minus the same byte of the previous element, then run-length encoded.
+        /// Columns of similar values turn into long runs of zeros.
+        DeltaRle = 1,
+    };
+
+    struct BlockHeader
+    {
+        BlockEncoding encoding = BlockEncoding::Raw;
+        /// @brief Element size the delta is taken over.
+        std::uint32_t stride = 1;
+        std::uint64_t raw_size = 0;
+        std::uint64_t stored_size = 0;
+    };
+
+    struct ArchetypeHeader
+    {
+        /// @brief Bit i is set when the archetype has the component of SchemaEntry i.
+        std::uint64_t schema_mask = 0;
+        std::uint64_t rows = 0;
+    };
+
+    struct SaveOptions
+    {
+        /// @brief Store blocks that shrink by at least a quarter as BlockEncoding::DeltaRle.
+        bool compress = true;
+    };
+
+    struct SaveStats
+    {
+        std::size_t entities = 0;
+        std::size_t archetypes = 0;
+        /// @brief Bytes of the blocks before encoding.
+        std::size_t raw_bytes = 0;
+        std::size_t file_bytes = 0;
+        std::size_t compressed_blocks = 0;
+        /// @brief Components of the file that are not registered in this run, or changed size. Dropped on load.
+        std::size_t skipped_components = 0;
+    };
+
+    /// @brief Binary snapshot of all entities of a World, with their handles.
+    /// Archetype columns are written as contiguous blocks, and loading maps the file and copies or decodes
+    /// each block straight into the column it came from. Entity indices and generations are restored, so
+    /// handles held by scenes stay valid; StringIds in components are renumbered for the running process.
+    class WorldSerializer final
+    {
+    public:
+        WorldSerializer() = delete;
+
+        /// @brief Writes the world to file_path, replacing it only once the whole file is written.
+        /// Throws std::runtime_error on failure.
+        static SaveStats save(const engine::ecs::World &world, const std::string &file_path, const SaveOptions &options = {});
+
+        /// @brief Replaces all entities of the world with those of the file. Pending commands are dropped.
+        /// Throws std::runtime_error if the file cannot be read or is corrupt. A file rejected before any entity is
+        /// restored leaves the world untouched; one found corrupt after that leaves it empty.
+        /// Components are matched by name against ComponentRegistry; types that are not registered are dropped with a warning,
+        /// so register every saved type (ComponentRegistry::registerTypes) before loading.
+        static SaveStats load(engine::ecs::World &world, const std::string &file_path);
+    };
+} // namespace engine::save
@@ -0,0 +1,45 @@
+#include "scene.h"
+#include "../core/context.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::scene
+{
+    Scene::Scene(std::string scene_name, engine::core::Context &context, SceneManager &scene_manager)
+        : scene_name_(std::move(scene_name)), context_(context), scene_manager_(scene_manager)
+    {
+        spdlog::trace("Scene '{}' created", scene_name_);
+    }
+
+    Scene::~Scene() = default;
+
+    engine::resource::ResourceManifest Scene::getResources() const
+    {
+        return {};
+    }
+
+    void Scene::init()
+    {
+        is_initialized_ = true;
+        context_.requestRedraw();
+        spdlog::trace("Scene '{}' initialized", scene_name_);
+    }
+
+    void Scene::update(float)
+    {
+    }
+
+    void Scene::render(engine::render::RenderSnapshot &) const
+    {
+    }
+
+    void Scene::clean()
+    {
+        is_initialized_ = false;
+        spdlog::trace("Scene '{}' cleaned", scene_name_);
+    }
+
+    std::uint64_t Scene::computeChecksum(std::uint64_t seed) const
+    {
+        return seed;
+    }
+} // namespace engine::scene
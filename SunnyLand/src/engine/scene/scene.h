@@ -0,0 +1,58 @@
+#pragma once
+#include "../resource/resource_manifest.h"
+#include <string>
+#include <cstdint>
+
+namespace engine::core
+{
+    class Context;
+}
+
+namespace engine::render
+{
+    class RenderSnapshot;
+}
+
+namespace engine::scene
+{
+    class SceneManager;
+
+    /// @brief Base class of all scenes (title, levels, menus...).
+    /// A scene lists its resources in getResources(); the SceneManager loads them in the background
+    /// and only calls init() once all of them are available.
+    class Scene
+    {
+    protected:
+        std::string scene_name_;
+        engine::core::Context &context_;
+        SceneManager &scene_manager_;
+        bool is_initialized_ = false;
+
+    public:
+        Scene(std::string scene_name, engine::core::Context &context, SceneManager &scene_manager);
+        virtual ~Scene();
+
+        Scene(const Scene &) = delete;
+        Scene &operator=(const Scene &) = delete;
+        Scene(Scene &&) = delete;
+        Scene &operator=(Scene &&) = delete;
+
+        /// @brief Resources that must be loaded before init() is called.
+        virtual engine::resource::ResourceManifest getResources() const;
+
+        virtual void init();
+        virtual void update(float delta_time);
+        /// @brief Describes the scene into the snapshot. Must not change the scene.
+        virtual void render(engine::render::RenderSnapshot &snapshot) const;
+        virtual void clean();
+
+        /// @brief Mixes the simulation state of the scene into a checksum, see GameApp::computeStateChecksum.
+        virtual std::uint64_t computeChecksum(std::uint64_t seed) const;
+
+        /// @brief True if the ECS systems should not run while this scene is on top, e.g. a pause menu.
+        virtual bool pausesWorld() const { return false; }
+
+        const std::string &getName() const { return scene_name_; }
+        bool isInitialized() const { return is_initialized_; }
+    };
+} // namespace engine::scene
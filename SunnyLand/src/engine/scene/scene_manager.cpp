@@ -0,0 +1,197 @@
+#include "scene_manager.h"
+#include "scene.h"
+#include "../core/context.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene
+{
+    namespace
+    {
+        template <typename T>
+        void eraseContained(std::vector<T> &items, const std::vector<T> &used)
+        {
+            std::erase_if(items, [&used](const T &item)
+                          { return std::find(used.begin(), used.end(), item) != used.end(); });
+        }
+
+        /// @brief Removes from released every resource that is also listed in used.
+        void eraseUsed(engine::resource::ResourceManifest &released, const engine::resource::ResourceManifest &used)
+        {
+            eraseContained(released.textures, used.textures);
+            eraseContained(released.sounds, used.sounds);
+            eraseContained(released.music, used.music);
+            eraseContained(released.fonts, used.fonts);
+        }
+    }
+
+    SceneManager::SceneManager(engine::core::Context &context, engine::resource::AsyncResourceLoader &resource_loader)
+        : context_(context), resource_loader_(resource_loader)
+    {
+        spdlog::trace("SceneManager created");
+    }
+
+    SceneManager::~SceneManager()
+    {
+        close();
+    }
+
+    void SceneManager::requestPushScene(std::unique_ptr<Scene> scene)
+    {
+        if (isTransitionPending())
+        {
+            spdlog::warn("Ignoring push of scene '{}': another scene transition is pending", scene->getName());
+            return;
+        }
+        pending_load_ = resource_loader_.requestLoad(scene->getResources());
+        pending_scene_ = std::move(scene);
+        pending_action_ = PendingAction::Push;
+    }
+
+    void SceneManager::requestPopScene()
+    {
+        if (isTransitionPending())
+        {
+            spdlog::warn("Ignoring scene pop: another scene transition is pending");
+            return;
+        }
+        pending_action_ = PendingAction::Pop;
+    }
+
+    void SceneManager::requestReplaceScene(std::unique_ptr<Scene> scene)
+    {
+        if (isTransitionPending())
+        {
+            spdlog::warn("Ignoring replace with scene '{}': another scene transition is pending", scene->getName());
+            return;
+        }
+        pending_load_ = resource_loader_.requestLoad(scene->getResources());
+        pending_scene_ = std::move(scene);
+        pending_action_ = PendingAction::Replace;
+    }
+
+    bool SceneManager::isWaitingForResources() const
+    {
+        return pending_load_ && !pending_load_->isDone();
+    }
+
+    void SceneManager::update(float delta_time)
+    {
+        if (isTransitionPending() && !isWaitingForResources())
+        {
+            applyPendingAction();
+        }
+
+        if (Scene *scene = getCurrentScene())
+        {
+            scene->update(delta_time);
+        }
+    }
+
+    void SceneManager::render(engine::render::RenderSnapshot &snapshot) const
+    {
+        for (const auto &scene : scene_stack_)
+        {
+            scene->render(snapshot);
+        }
+    }
+
+    void SceneManager::close()
+    {
+        while (!scene_stack_.empty())
+        {
+            scene_stack_.back()->clean();
+            scene_stack_.pop_back();
+        }
+        pending_scene_.reset();
+        pending_load_.reset();
+        pending_action_ = PendingAction::None;
+    }
+
+    bool SceneManager::isWorldPaused() const
+    {
+        Scene *scene = getCurrentScene();
+        return scene && scene->pausesWorld();
+    }
+
+    Scene *SceneManager::getCurrentScene() const
+    {
+        return scene_stack_.empty() ? nullptr : scene_stack_.back().get();
+    }
+
+    std::uint64_t SceneManager::computeChecksum(std::uint64_t seed) const
+    {
+        for (const auto &scene : scene_stack_)
+        {
+            seed = scene->computeChecksum(seed);
+        }
+        return seed;
+    }
+
+    void SceneManager::applyPendingAction()
+    {
+        if (pending_load_ && pending_load_->getFailedCount() > 0)
+        {
+            spdlog::error("{} resources of scene '{}' failed to load", pending_load_->getFailedCount(), pending_scene_->getName());
+        }
+
+        std::unique_ptr<Scene> removed;
+        switch (pending_action_)
+        {
+        case PendingAction::Push:
+            spdlog::debug("Pushing scene '{}'", pending_scene_->getName());
+            scene_stack_.push_back(std::move(pending_scene_));
+            scene_stack_.back()->init();
+            break;
+        case PendingAction::Pop:
+            if (!scene_stack_.empty())
+            {
+                spdlog::debug("Popping scene '{}'", scene_stack_.back()->getName());
+                removed = std::move(scene_stack_.back());
+                scene_stack_.pop_back();
+            }
+            break;
+        case PendingAction::Replace:
+            spdlog::debug("Replacing scene with '{}'", pending_scene_->getName());
+            if (!scene_stack_.empty())
+            {
+                removed = std::move(scene_stack_.back());
+                scene_stack_.pop_back();
+            }
+            // The old scene is cleaned before the new one starts so they never both own the camera etc.
+            if (removed)
+            {
+                removed->clean();
+            }
+            scene_stack_.push_back(std::move(pending_scene_));
+            scene_stack_.back()->init();
+            break;
+        case PendingAction::None:
+            break;
+        }
+
+        pending_action_ = PendingAction::None;
+        pending_load_.reset();
+        context_.requestRedraw();
+
+        if (removed)
+        {
+            releaseScene(std::move(removed));
+        }
+    }
+
+    void SceneManager::releaseScene(std::unique_ptr<Scene> scene)
+    {
+        if (scene->isInitialized())
+        {
+            scene->clean();
+        }
+
+        engine::resource::ResourceManifest released = scene->getResources();
+        for (const auto &remaining : scene_stack_)
+        {
+            eraseUsed(released, remaining->getResources());
+        }
+        resource_loader_.requestUnload(std::move(released));
+    }
+} // namespace engine::scene
@@ -0,0 +1,77 @@
+#pragma once
+#include "../resource/async_resource_loader.h"
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace engine::core
+{
+    class Context;
+}
+
+namespace engine::render
+{
+    class RenderSnapshot;
+}
+
+namespace engine::scene
+{
+    class Scene;
+
+    /// @brief Stack of scenes with asynchronous transitions.
+    /// push and replace requests first load the new scene's resources in the background while the
+    /// current scene keeps running; the switch happens on the first update after loading finished.
+    /// Resources of removed scenes that no remaining scene needs are released afterwards.
+    class SceneManager final
+    {
+    private:
+        enum class PendingAction
+        {
+            None,
+            Push,
+            Pop,
+            Replace
+        };
+
+        engine::core::Context &context_;
+        engine::resource::AsyncResourceLoader &resource_loader_;
+        std::vector<std::unique_ptr<Scene>> scene_stack_;
+
+        PendingAction pending_action_ = PendingAction::None;
+        std::unique_ptr<Scene> pending_scene_;
+        engine::resource::LoadHandle pending_load_;
+
+        void applyPendingAction();
+        /// @brief Cleans a scene that left the stack and releases the resources only it used.
+        void releaseScene(std::unique_ptr<Scene> scene);
+
+    public:
+        SceneManager(engine::core::Context &context, engine::resource::AsyncResourceLoader &resource_loader);
+        ~SceneManager();
+
+        SceneManager(const SceneManager &) = delete;
+        SceneManager &operator=(const SceneManager &) = delete;
+        SceneManager(SceneManager &&) = delete;
+        SceneManager &operator=(SceneManager &&) = delete;
+
+        void requestPushScene(std::unique_ptr<Scene> scene);
+        void requestPopScene();
+        void requestReplaceScene(std::unique_ptr<Scene> scene);
+
+        /// @brief Applies a finished transition, then updates the top scene.
+        void update(float delta_time);
+        /// @brief Describes all scenes of the stack, bottom to top.
+        void render(engine::render::RenderSnapshot &snapshot) const;
+        /// @brief Cleans every scene. Resources stay loaded until the ResourceManager is destroyed.
+        void close();
+
+        Scene *getCurrentScene() const;
+        bool isTransitionPending() const { return pending_action_ != PendingAction::None; }
+        /// @brief True while a requested transition still waits for its resources.
+        bool isWaitingForResources() const;
+        /// @brief True while the top scene pauses the ECS systems.
+        bool isWorldPaused() const;
+
+        std::uint64_t computeChecksum(std::uint64_t seed) const;
+    };
+} // namespace engine::scene
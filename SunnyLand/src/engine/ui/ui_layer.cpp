@@ -0,0 +1,338 @@
+#include "ui_layer.h"
+#include "../input/input_state.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace engine::ui
+{
+    namespace
+    {
+        bool sameRect(const SDL_FRect &a, const SDL_FRect &b)
+        {
+            return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+        }
+
+        bool isEmpty(const SDL_FRect &rect)
+        {
+            return rect.w <= 0.0f || rect.h <= 0.0f;
+        }
+
+        std::atomic<std::uint32_t> next_layer_id{1};
+    }
+
+    UILayer::UILayer() : layer_id_(next_layer_id.fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+    WidgetId UILayer::addWidget(const Widget &widget)
+    {
+        // Parents always come before their children, which relayout() relies on
+        if (widget.parent != NO_WIDGET && !isValid(widget.parent))
+        {
+            spdlog::warn("UILayer: parent widget {} does not exist", widget.parent);
+            return NO_WIDGET;
+        }
+        widgets_.push_back(widget);
+        ++revision_;
+        layout_dirty_ = true;
+        return static_cast<WidgetId>(widgets_.size() - 1);
+    }
+
+    WidgetId UILayer::addImage(engine::utils::StringId texture, const SDL_FRect &rect, WidgetId parent)
+    {
+        Widget widget;
+        widget.parent = parent;
+        widget.local = rect;
+        widget.textures[0] = texture;
+        return addWidget(widget);
+    }
+
+    WidgetId UILayer::addImage(std::string_view texture_path, const SDL_FRect &rect, WidgetId parent)
+    {
+        return addImage(engine::utils::StringTable::intern(texture_path), rect, parent);
+    }
+
+    WidgetId UILayer::addButton(std::string_view normal_path, std::string_view hover_path, std::string_view pressed_path,
+                                const SDL_FRect &rect, WidgetId parent)
+    {
+        Widget widget;
+        widget.parent = parent;
+        widget.local = rect;
+        widget.textures = {engine::utils::StringTable::intern(normal_path), engine::utils::StringTable::intern(hover_path),
+                           engine::utils::StringTable::intern(pressed_path)};
+        widget.interactive = true;
+        return addWidget(widget);
+    }
+
+    void UILayer::setVisible(WidgetId id, bool visible)
+    {
+        if (!isValid(id) || widgets_[id].visible == visible)
+        {
+            return;
+        }
+        widgets_[id].visible = visible;
+        ++revision_;
+        layout_dirty_ = true;
+    }
+
+    void UILayer::setPosition(WidgetId id, const glm::vec2 &position)
+    {
+        if (!isValid(id) || (widgets_[id].local.x == position.x && widgets_[id].local.y == position.y))
+        {
+            return;
+        }
+        widgets_[id].local.x = position.x;
+        widgets_[id].local.y = position.y;
+        ++revision_;
+        layout_dirty_ = true;
+    }
+
+    void UILayer::setTexture(WidgetId id, engine::utils::StringId texture)
+    {
+        if (!isValid(id) || widgets_[id].textures[0] == texture)
+        {
+            return;
+        }
+        widgets_[id].textures[0] = texture;
+        if (widgets_[id].shown)
+        {
+            ++revision_;
+            markDirty(widgets_[id].rect);
+        }
+    }
+
+    void UILayer::setFocus(WidgetId id)
+    {
+        const WidgetId old_focused = focused_;
+        focused_ = isValid(id) ? id : NO_WIDGET;
+        refreshState(old_focused);
+        refreshState(focused_);
+    }
+
+    void UILayer::markDirty(const SDL_FRect &rect)
+    {
+        if (isEmpty(rect))
+        {
+            return;
+        }
+        // A rect that changes again only needs to be redrawn once, at the newest revision
+        auto it = std::find_if(dirty_rects_.begin(), dirty_rects_.end(), [&rect](const engine::render::UIDirtyRect &dirty)
+                               { return sameRect(dirty.rect, rect); });
+        if (it != dirty_rects_.end())
+        {
+            dirty_rects_.erase(it);
+        }
+        else if (dirty_rects_.size() == MAX_DIRTY_RECTS)
+        {
+            full_redraw_revision_ = std::max(full_redraw_revision_, dirty_rects_.front().revision);
+            dirty_rects_.erase(dirty_rects_.begin());
+        }
+        dirty_rects_.push_back({rect, revision_});
+    }
+
+    void UILayer::relayout()
+    {
+        layout_dirty_ = false;
+        ++revision_;
+        const SDL_FRect old_bounds = bounds_;
+        float min_x = 0.0f, min_y = 0.0f, max_x = 0.0f, max_y = 0.0f;
+        bool any_shown = false;
+        for (Widget &widget : widgets_)
+        {
+            SDL_FRect rect = widget.local;
+            bool shown = widget.visible;
+            if (widget.parent != NO_WIDGET)
+            {
+                const Widget &parent = widgets_[widget.parent];
+                rect.x += parent.rect.x;
+                rect.y += parent.rect.y;
+                shown = shown && parent.shown;
+            }
+            if (shown != widget.shown || !sameRect(rect, widget.rect))
+            {
+                if (widget.shown)
+                    markDirty(widget.rect);
+                if (shown)
+                    markDirty(rect);
+            }
+            widget.rect = rect;
+            widget.shown = shown;
+
+            if (shown && !isEmpty(rect))
+            {
+                min_x = any_shown ? std::min(min_x, rect.x) : rect.x;
+                min_y = any_shown ? std::min(min_y, rect.y) : rect.y;
+                max_x = any_shown ? std::max(max_x, rect.x + rect.w) : rect.x + rect.w;
+                max_y = any_shown ? std::max(max_y, rect.y + rect.h) : rect.y + rect.h;
+                any_shown = true;
+            }
+        }
+        // Whole pixels, so that the render target maps 1:1 to the screen
+        bounds_ = any_shown ? SDL_FRect{std::floor(min_x), std::floor(min_y), std::ceil(max_x) - std::floor(min_x), std::ceil(max_y) - std::floor(min_y)}
+                            : SDL_FRect{};
+        if (!sameRect(bounds_, old_bounds))
+        {
+            // The render target changes size or position, so nothing of it can be kept
+            full_redraw_revision_ = revision_;
+            dirty_rects_.clear();
+        }
+        rebuildGrid();
+    }
+
+    void UILayer::rebuildGrid()
+    {
+        grid_columns_ = isEmpty(bounds_) ? 0 : std::max(1, static_cast<int>(std::ceil(bounds_.w / GRID_CELL_SIZE)));
+        grid_rows_ = isEmpty(bounds_) ? 0 : std::max(1, static_cast<int>(std::ceil(bounds_.h / GRID_CELL_SIZE)));
+        const std::size_t cell_count = static_cast<std::size_t>(grid_columns_) * static_cast<std::size_t>(grid_rows_);
+        cell_start_.assign(cell_count + 1, 0);
+        cell_items_.clear();
+        if (cell_count == 0)
+        {
+            return;
+        }
+
+        auto for_each_cell = [this](const SDL_FRect &rect, auto &&func)
+        {
+            const int x0 = std::clamp(static_cast<int>((rect.x - bounds_.x) / GRID_CELL_SIZE), 0, grid_columns_ - 1);
+            const int y0 = std::clamp(static_cast<int>((rect.y - bounds_.y) / GRID_CELL_SIZE), 0, grid_rows_ - 1);
+            const int x1 = std::clamp(static_cast<int>((rect.x + rect.w - bounds_.x) / GRID_CELL_SIZE), 0, grid_columns_ - 1);
+            const int y1 = std::clamp(static_cast<int>((rect.y + rect.h - bounds_.y) / GRID_CELL_SIZE), 0, grid_rows_ - 1);
+            for (int y = y0; y <= y1; ++y)
+                for (int x = x0; x <= x1; ++x)
+                    func(static_cast<std::size_t>(y) * static_cast<std::size_t>(grid_columns_) + static_cast<std::size_t>(x));
+        };
+
+        // Count per cell, turn the counts into cell ends, then fill each cell backwards so it ends up at its start
+        for (const Widget &widget : widgets_)
+        {
+            if (widget.interactive && widget.shown && !isEmpty(widget.rect))
+            {
+                for_each_cell(widget.rect, [this](std::size_t cell)
+                              { ++cell_start_[cell]; });
+            }
+        }
+        std::uint32_t total = 0;
+        for (std::size_t cell = 0; cell < cell_count; ++cell)
+        {
+            total += cell_start_[cell];
+            cell_start_[cell] = total;
+        }
+        cell_start_[cell_count] = total;
+        cell_items_.resize(total);
+        for (WidgetId id = static_cast<WidgetId>(widgets_.size()); id-- > 0;)
+        {
+            const Widget &widget = widgets_[id];
+            if (widget.interactive && widget.shown && !isEmpty(widget.rect))
+            {
+                for_each_cell(widget.rect, [this, id](std::size_t cell)
+                              { cell_items_[--cell_start_[cell]] = id; });
+            }
+        }
+    }
+
+    WidgetId UILayer::hitTest(float x, float y) const
+    {
+        if (grid_columns_ == 0 || x < bounds_.x || y < bounds_.y || x >= bounds_.x + bounds_.w || y >= bounds_.y + bounds_.h)
+        {
+            return NO_WIDGET;
+        }
+        const int column = std::min(static_cast<int>((x - bounds_.x) / GRID_CELL_SIZE), grid_columns_ - 1);
+        const int row = std::min(static_cast<int>((y - bounds_.y) / GRID_CELL_SIZE), grid_rows_ - 1);
+        const std::size_t cell = static_cast<std::size_t>(row) * static_cast<std::size_t>(grid_columns_) + static_cast<std::size_t>(column);
+        // Later widgets are drawn on top, so they win
+        for (std::uint32_t i = cell_start_[cell + 1]; i-- > cell_start_[cell];)
+        {
+            const SDL_FRect &rect = widgets_[cell_items_[i]].rect;
+            if (x >= rect.x && y >= rect.y && x < rect.x + rect.w && y < rect.y + rect.h)
+            {
+                return cell_items_[i];
+            }
+        }
+        return NO_WIDGET;
+    }
+
+    void UILayer::refreshState(WidgetId id)
+    {
+        if (!isValid(id))
+        {
+            return;
+        }
+        Widget &widget = widgets_[id];
+        WidgetState state = WidgetState::Normal;
+        if (widget.interactive && id == pressed_ && id == hovered_)
+            state = WidgetState::Pressed;
+        else if (widget.interactive && (id == hovered_ || id == focused_))
+            state = WidgetState::Hover;
+        if (state == widget.state)
+        {
+            return;
+        }
+        widget.state = state;
+        if (widget.shown)
+        {
+            ++revision_;
+            markDirty(widget.rect);
+        }
+    }
+
+    void UILayer::update(const engine::input::InputState &input)
+    {
+        if (layout_dirty_)
+        {
+            relayout();
+        }
+
+        const WidgetId old_hovered = hovered_;
+        const WidgetId old_pressed = pressed_;
+        clicked_ = NO_WIDGET;
+        hovered_ = hitTest(input.getMouseX(), input.getMouseY());
+
+        const bool button_down = input.isMouseButtonDown(SDL_BUTTON_LEFT);
+        if (button_down && !was_button_down_)
+        {
+            pressed_ = hovered_;
+        }
+        else if (!button_down && was_button_down_)
+        {
+            if (pressed_ != NO_WIDGET && pressed_ == hovered_)
+            {
+                clicked_ = pressed_;
+            }
+            pressed_ = NO_WIDGET;
+        }
+        was_button_down_ = button_down;
+
+        refreshState(old_hovered);
+        refreshState(old_pressed);
+        refreshState(hovered_);
+        refreshState(pressed_);
+    }
+
+    void UILayer::extract(engine::render::RenderSnapshot &snapshot) const
+    {
+        if (isEmpty(bounds_))
+        {
+            return;
+        }
+        engine::render::UILayerFrame &frame = snapshot.addUILayer();
+        frame.layer_id = layer_id_;
+        frame.revision = revision_;
+        frame.full_redraw_revision = full_redraw_revision_;
+        frame.bounds = bounds_;
+        frame.dirty_rects.assign(dirty_rects_.begin(), dirty_rects_.end());
+        for (const Widget &widget : widgets_)
+        {
+            engine::utils::StringId texture = widget.textures[static_cast<std::size_t>(widget.state)];
+            if (texture == engine::utils::EMPTY_STRING_ID)
+            {
+                texture = widget.textures[0];
+            }
+            if (widget.shown && texture != engine::utils::EMPTY_STRING_ID && !isEmpty(widget.rect))
+            {
+                frame.widgets.push_back({texture, widget.rect});
+            }
+        }
+    }
+} // namespace engine::ui
@@ -0,0 +1,128 @@
+#pragma once
+#include "../utils/string_id.h"
+#include "../render/render_snapshot.h"
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <SDL3/SDL_rect.h>
+
+namespace engine::input
+{
+    class InputState;
+}
+
+namespace engine::ui
+{
+    using WidgetId = std::uint32_t;
+    constexpr WidgetId NO_WIDGET = ~WidgetId{0};
+
+    enum class WidgetState : std::uint8_t
+    {
+        Normal,
+        Hover,
+        Pressed
+    };
+
+    /// @brief Retained UI: a tree of image and button widgets that only reports what changed.
+    /// Every change bumps the layer's revision and records the screen area it touched, so the Renderer can keep
+    /// the layer composited in a render target and redraw just those areas. Buttons are found under the cursor
+    /// through a uniform grid instead of testing every widget. Adding, moving or hiding widgets only marks the layout
+    /// dirty; it is recomputed once, at the start of the next update().
+    /// The layer is simulation state; the Renderer only sees what extract() puts into the snapshot.
+    class UILayer final
+    {
+    private:
+        struct Widget
+        {
+            WidgetId parent = NO_WIDGET;
+            /// @brief Relative to the parent's top left corner, or to the screen for root widgets.
+            SDL_FRect local{};
+            /// @brief Screen rect, valid after relayout().
+            SDL_FRect rect{};
+            /// @brief Texture per WidgetState; 0 falls back to the Normal texture, which may be 0 for invisible containers.
+            std::array<engine::utils::StringId, 3> textures{};
+            WidgetState state = WidgetState::Normal;
+            bool interactive = false;
+            bool visible = true;
+            /// @brief Visible and all its ancestors too.
+            bool shown = true;
+        };
+
+        static constexpr float GRID_CELL_SIZE = 64.0f;
+        /// @brief Older dirty rects are dropped; renderers that missed them redraw the whole layer.
+        static constexpr std::size_t MAX_DIRTY_RECTS = 32;
+
+        std::uint32_t layer_id_;
+        std::vector<Widget> widgets_;
+        SDL_FRect bounds_{};
+
+        // Hit-test grid over bounds_: the interactive widgets of cell i are cell_items_[cell_start_[i] .. cell_start_[i + 1])
+        int grid_columns_ = 0;
+        int grid_rows_ = 0;
+        std::vector<std::uint32_t> cell_start_;
+        std::vector<WidgetId> cell_items_;
+
+        std::vector<engine::render::UIDirtyRect> dirty_rects_;
+        std::uint64_t revision_ = 1;
+        std::uint64_t full_redraw_revision_ = 1;
+        bool layout_dirty_ = false;
+
+        WidgetId hovered_ = NO_WIDGET;
+        WidgetId pressed_ = NO_WIDGET;
+        WidgetId focused_ = NO_WIDGET;
+        WidgetId clicked_ = NO_WIDGET;
+        bool was_button_down_ = false;
+
+        WidgetId addWidget(const Widget &widget);
+        bool isValid(WidgetId id) const { return id < widgets_.size(); }
+        void markDirty(const SDL_FRect &rect);
+        /// @brief Recomputes screen rects, visibility, bounds and the hit-test grid, marking whatever moved as dirty.
+        /// Starts a new revision, so the moved areas are newer than any frame extracted with the old layout.
+        void relayout();
+        void rebuildGrid();
+        /// @brief Derives the widget's state from hover, press and focus, marking it dirty if the state changed.
+        void refreshState(WidgetId id);
+
+    public:
+        UILayer();
+
+        UILayer(const UILayer &) = delete;
+        UILayer &operator=(const UILayer &) = delete;
+        UILayer(UILayer &&) = delete;
+        UILayer &operator=(UILayer &&) = delete;
+
+        /// @brief Adds an image; with texture 0 it draws nothing and only groups its children.
+        WidgetId addImage(engine::utils::StringId texture, const SDL_FRect &rect, WidgetId parent = NO_WIDGET);
+        WidgetId addImage(std::string_view texture_path, const SDL_FRect &rect, WidgetId parent = NO_WIDGET);
+        /// @brief Adds a clickable widget drawn with one texture per state.
+        WidgetId addButton(std::string_view normal_path, std::string_view hover_path, std::string_view pressed_path,
+                           const SDL_FRect &rect, WidgetId parent = NO_WIDGET);
+
+        /// @brief Hides or shows the widget and its children.
+        void setVisible(WidgetId id, bool visible);
+        /// @brief Moves the widget and its children; position is relative to the parent.
+        void setPosition(WidgetId id, const glm::vec2 &position);
+        /// @brief Replaces the Normal texture, e.g. to show a full or empty heart.
+        void setTexture(WidgetId id, engine::utils::StringId texture);
+        /// @brief Shows a widget as hovered while the cursor is elsewhere, for keyboard navigation. NO_WIDGET clears it.
+        void setFocus(WidgetId id);
+
+        /// @brief Lays out pending changes, then tracks the cursor and left mouse button of the tick.
+        /// A click is a press and release on the same button.
+        void update(const engine::input::InputState &input);
+
+        /// @brief Topmost visible button at the screen position, or NO_WIDGET.
+        WidgetId hitTest(float x, float y) const;
+        /// @brief Button clicked during the last update(), or NO_WIDGET.
+        WidgetId getClicked() const { return clicked_; }
+        WidgetId getHovered() const { return hovered_; }
+        WidgetState getState(WidgetId id) const { return isValid(id) ? widgets_[id].state : WidgetState::Normal; }
+        /// @brief Changes whenever the layer looks different.
+        std::uint64_t getRevision() const { return revision_; }
+
+        /// @brief Describes the layer into the snapshot: its visible widgets and the areas that changed lately.
+        void extract(engine::render::RenderSnapshot &snapshot) const;
+    };
+} // namespace engine::ui
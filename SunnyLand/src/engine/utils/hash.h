@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+namespace engine::utils
+{
+    constexpr std::uint64_t FNV1A64_OFFSET = 0xCBF29CE484222325ull;
+    constexpr std::uint64_t FNV1A64_PRIME = 0x100000001B3ull;
+
+    /// @brief 64-bit FNV-1a hash. Pass the previous result as seed to hash several buffers in a row.
+    inline std::uint64_t fnv1a64(const void *data, std::size_t size, std::uint64_t seed = FNV1A64_OFFSET)
+    {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        std::uint64_t hash = seed;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= FNV1A64_PRIME;
+        }
+        return hash;
+    }
+
+    /// @brief Hashes the object representation of a trivially copyable value.
+    template <typename T>
+    std::uint64_t fnv1a64Value(const T &value, std::uint64_t seed = FNV1A64_OFFSET)
+    {
+        return fnv1a64(&value, sizeof(T), seed);
+    }
+} // namespace engine::utils
@@ -0,0 +1,205 @@
+#include "json_cache.h"
+#include "hash.h"
+#include "mapped_file.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace engine::utils
+{
+    namespace
+    {
+        struct SourceInfo
+        {
+            std::uint64_t size = 0;
+            std::int64_t mtime = 0;
+        };
+
+        std::optional<SourceInfo> statSource(const std::string &file_path)
+        {
+            std::error_code error;
+            SourceInfo info;
+            info.size = std::filesystem::file_size(file_path, error);
+            if (error)
+            {
+                return std::nullopt;
+            }
+            auto mtime = std::filesystem::last_write_time(file_path, error);
+            if (error)
+            {
+                return std::nullopt;
+            }
+            info.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+            return info;
+        }
+
+        std::optional<std::string> readText(const std::string &file_path)
+        {
+            std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+            if (!file)
+            {
+                return std::nullopt;
+            }
+            std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+            file.seekg(0);
+            if (!file.read(text.data(), static_cast<std::streamsize>(text.size())))
+            {
+                return std::nullopt;
+            }
+            return text;
+        }
+
+        /// @brief Parses the cooked copy. With a source, only a copy of the same text is accepted: the size and
+        /// modification time are compared first, and the text is read and hashed only if the time differs.
+        std::optional<nlohmann::json> readCooked(const std::string &file_path, const std::optional<SourceInfo> &source)
+        {
+            const std::string cooked_path = getCookedJsonPath(file_path);
+            std::error_code error;
+            if (!std::filesystem::exists(cooked_path, error))
+            {
+                return std::nullopt;
+            }
+            try
+            {
+                MappedFile file(cooked_path);
+                std::span<const std::byte> bytes = file.getBytes();
+                CookedJsonHeader expected;
+                CookedJsonHeader header;
+                if (bytes.size() < sizeof(header))
+                {
+                    return std::nullopt;
+                }
+                std::memcpy(&header, bytes.data(), sizeof(header));
+                if (std::memcmp(header.magic, expected.magic, sizeof(expected.magic)) != 0 || header.version != expected.version)
+                {
+                    return std::nullopt;
+                }
+                if (source && (header.source_size != source->size || header.source_mtime != source->mtime))
+                {
+                    // Checkouts and copies change the time but not the text
+                    std::optional<std::string> text = header.source_size == source->size ? readText(file_path) : std::nullopt;
+                    if (!text || header.source_hash != fnv1a64(text->data(), text->size()))
+                    {
+                        spdlog::debug("Cooked file {} is stale", cooked_path);
+                        return std::nullopt;
+                    }
+                }
+                const auto *body = reinterpret_cast<const std::uint8_t *>(bytes.data() + sizeof(header));
+                return nlohmann::json::from_msgpack(body, body + (bytes.size() - sizeof(header)));
+            }
+            catch (const std::exception &e)
+            {
+                spdlog::debug("Ignoring cooked file {}: {}", cooked_path, e.what());
+                return std::nullopt;
+            }
+        }
+
+        /// @brief Whether the cooked copy records exactly this source, so loading it needs no hashing.
+        bool isCookedCurrent(const std::string &cooked_path, const SourceInfo &source)
+        {
+            std::ifstream file(cooked_path, std::ios::binary);
+            CookedJsonHeader expected;
+            CookedJsonHeader header;
+            if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+            {
+                return false;
+            }
+            return std::memcmp(header.magic, expected.magic, sizeof(expected.magic)) == 0 && header.version == expected.version &&
+                   header.source_size == source.size && header.source_mtime == source.mtime;
+        }
+
+        bool writeCooked(const std::string &cooked_path, const std::string &source, const SourceInfo &info, const nlohmann::json &json)
+        {
+            CookedJsonHeader header;
+            header.source_hash = fnv1a64(source.data(), source.size());
+            header.source_size = source.size();
+            header.source_mtime = info.mtime;
+            std::vector<std::uint8_t> body = nlohmann::json::to_msgpack(json);
+
+            const std::string temp_path = cooked_path + ".tmp";
+            {
+                std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+                file.write(reinterpret_cast<const char *>(body.data()), static_cast<std::streamsize>(body.size()));
+                file.close();
+                if (!file)
+                {
+                    std::error_code ignored;
+                    std::filesystem::remove(temp_path, ignored);
+                    return false;
+                }
+            }
+            std::error_code error;
+            std::filesystem::rename(temp_path, cooked_path, error);
+            if (error)
+            {
+                std::filesystem::remove(temp_path, error);
+                return false;
+            }
+            spdlog::debug("Cooked {} ({} bytes of JSON, {} bytes of MessagePack)", cooked_path, source.size(), body.size());
+            return true;
+        }
+    }
+
+    std::string getCookedJsonPath(const std::string &file_path)
+    {
+        return file_path + ".cooked";
+    }
+
+    nlohmann::json loadJson(const std::string &file_path)
+    {
+        std::optional<SourceInfo> source = statSource(file_path);
+        if (!source || source->size >= COOKED_JSON_MIN_SIZE)
+        {
+            if (std::optional<nlohmann::json> cooked = readCooked(file_path, source))
+            {
+                return std::move(*cooked);
+            }
+        }
+        std::optional<std::string> text = readText(file_path);
+        if (!text)
+        {
+            throw std::runtime_error("Failed to open JSON file: " + file_path);
+        }
+        return nlohmann::json::parse(*text);
+    }
+
+    CookResult cookJson(const std::string &file_path, bool force)
+    {
+        std::optional<SourceInfo> info = statSource(file_path);
+        std::optional<std::string> source = info ? readText(file_path) : std::nullopt;
+        if (!source)
+        {
+            spdlog::error("Failed to open JSON file: {}", file_path);
+            return CookResult::Failed;
+        }
+        if (source->size() < COOKED_JSON_MIN_SIZE)
+        {
+            return CookResult::TooSmall;
+        }
+        const std::string cooked_path = getCookedJsonPath(file_path);
+        // A copy of the same text with an older time is rewritten, so loads stop hashing the source
+        if (!force && isCookedCurrent(cooked_path, *info))
+        {
+            return CookResult::UpToDate;
+        }
+        try
+        {
+            if (!writeCooked(cooked_path, *source, *info, nlohmann::json::parse(*source)))
+            {
+                spdlog::error("Failed to write cooked file: {}", cooked_path);
+                return CookResult::Failed;
+            }
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            spdlog::error("Failed to parse {}: {}", file_path, e.what());
+            return CookResult::Failed;
+        }
+        return CookResult::Cooked;
+    }
+} // namespace engine::utils
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace engine::utils
+{
+    /// @brief Sources smaller than this are always parsed as text: opening and decoding the cooked copy costs more
+    /// than the parse saves.
+    constexpr std::size_t COOKED_JSON_MIN_SIZE = 16 * 1024;
+
+    /// @brief Start of a cooked JSON file, followed by the MessagePack encoding of the source.
+    /// A copy whose size and modification time match the source is current; otherwise the source's content hash decides.
+    struct CookedJsonHeader
+    {
+        char magic[4] = {'S', 'L', 'C', 'K'};
+        std::uint32_t version = 2;
+        /// @brief fnv1a64 of the source text.
+        std::uint64_t source_hash = 0;
+        std::uint64_t source_size = 0;
+        /// @brief std::filesystem::last_write_time of the source, in ticks of its clock.
+        std::int64_t source_mtime = 0;
+    };
+
+    enum class CookResult
+    {
+        Cooked,
+        UpToDate,
+        /// @brief Below COOKED_JSON_MIN_SIZE; nothing was written.
+        TooSmall,
+        Failed,
+    };
+
+    /// @brief Path of the cooked copy of a JSON file, next to it: the same path with ".cooked" appended.
+    std::string getCookedJsonPath(const std::string &file_path);
+
+    /// @brief Parses a JSON file, from its cooked copy when that is current and the source is large enough to gain
+    /// from it. Without the source an existing copy is used as is, so builds may ship cooked files only.
+    /// Never writes files; cooking is done by cookJson(). Throws std::runtime_error if neither can be read and
+    /// nlohmann::json::exception if the text is not valid JSON.
+    nlohmann::json loadJson(const std::string &file_path);
+
+    /// @brief Writes the cooked copy of a JSON file unless it is current or the file is too small to gain from it.
+    CookResult cookJson(const std::string &file_path, bool force = false);
+} // namespace engine::utils
@@ -0,0 +1,24 @@
+#include "log.h"
+#include <chrono>
+
+namespace engine::utils
+{
+    LogRateLimiter::LogRateLimiter(std::uint32_t interval_ms)
+        : interval_ns_(static_cast<std::int64_t>(interval_ms) * 1000000)
+    {
+    }
+
+    bool LogRateLimiter::allow(std::uint32_t &suppressed)
+    {
+        const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        std::int64_t next_allowed = next_allowed_ns_.load(std::memory_order_relaxed);
+        // Of several threads failing at once, only the one that moves the deadline logs
+        if (now < next_allowed || !next_allowed_ns_.compare_exchange_strong(next_allowed, now + interval_ns_, std::memory_order_relaxed))
+        {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+} // namespace engine::utils
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <spdlog/spdlog.h>
+
+/// Engine logging macros. Calls below SPDLOG_ACTIVE_LEVEL (set by CMake: trace in Debug, info otherwise) are
+/// compiled out together with their arguments, so trace and debug logging in hot paths costs nothing in Release.
+/// A Release build therefore prints no ENGINE_LOG_TRACE / ENGINE_LOG_DEBUG messages even with --log-level trace;
+/// main() warns when that is asked for. Plain spdlog::debug() calls are not affected.
+#define ENGINE_LOG_TRACE(...) SPDLOG_TRACE(__VA_ARGS__)
+#define ENGINE_LOG_DEBUG(...) SPDLOG_DEBUG(__VA_ARGS__)
+#define ENGINE_LOG_INFO(...) SPDLOG_INFO(__VA_ARGS__)
+#define ENGINE_LOG_WARN(...) SPDLOG_WARN(__VA_ARGS__)
+#define ENGINE_LOG_ERROR(...) SPDLOG_ERROR(__VA_ARGS__)
+
+/// Logging for failures that may repeat every frame: each call site logs at most once per
+/// engine::utils::LOG_THROTTLE_INTERVAL_MS and reports how many repeats it dropped. Dropped calls do not evaluate their arguments.
+#define ENGINE_LOG_THROTTLED_(log_macro, ...)                                                                        \
+    do                                                                                                               \
+    {                                                                                                                \
+        static ::engine::utils::LogRateLimiter engine_log_limiter_{::engine::utils::LOG_THROTTLE_INTERVAL_MS};       \
+        std::uint32_t engine_log_suppressed_ = 0;                                                                    \
+        if (engine_log_limiter_.allow(engine_log_suppressed_))                                                       \
+        {                                                                                                            \
+            if (engine_log_suppressed_ > 0)                                                                          \
+            {                                                                                                        \
+                SPDLOG_WARN("{} similar messages suppressed", engine_log_suppressed_);                               \
+            }                                                                                                        \
+            log_macro(__VA_ARGS__);                                                                                  \
+        }                                                                                                            \
+    } while (false)
+#define ENGINE_LOG_WARN_THROTTLED(...) ENGINE_LOG_THROTTLED_(SPDLOG_WARN, __VA_ARGS__)
+#define ENGINE_LOG_ERROR_THROTTLED(...) ENGINE_LOG_THROTTLED_(SPDLOG_ERROR, __VA_ARGS__)
+
+namespace engine::utils
+{
+    constexpr std::uint32_t LOG_THROTTLE_INTERVAL_MS = 1000;
+
+    /// @brief Lets one message through per interval and counts the ones it held back. Thread-safe.
+    class LogRateLimiter final
+    {
+    private:
+        std::int64_t interval_ns_;
+        std::atomic<std::int64_t> next_allowed_ns_{0};
+        std::atomic<std::uint32_t> suppressed_{0};
+
+    public:
+        explicit LogRateLimiter(std::uint32_t interval_ms);
+
+        LogRateLimiter(const LogRateLimiter &) = delete;
+        LogRateLimiter &operator=(const LogRateLimiter &) = delete;
+        LogRateLimiter(LogRateLimiter &&) = delete;
+        LogRateLimiter &operator=(LogRateLimiter &&) = delete;
+
+        /// @brief Whether to log now; if so, suppressed receives the number of calls dropped since the last one.
+        bool allow(std::uint32_t &suppressed);
+    };
+} // namespace engine::utils
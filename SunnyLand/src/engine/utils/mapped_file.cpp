@@ -0,0 +1,128 @@
+#include "mapped_file.h"
+#include <stdexcept>
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine::utils
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string &file_path) : file_path_(file_path)
+    {
+        HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Failed to open file for mapping: " + file_path);
+        }
+        file_handle_ = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            close();
+            throw std::runtime_error("Failed to get the size of " + file_path);
+        }
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (size_ == 0)
+        {
+            // Empty files cannot be mapped
+            return;
+        }
+
+        mapping_handle_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_handle_)
+        {
+            close();
+            throw std::runtime_error("Failed to map file: " + file_path);
+        }
+        data_ = static_cast<const std::byte *>(MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+        if (!data_)
+        {
+            close();
+            throw std::runtime_error("Failed to map file: " + file_path);
+        }
+        spdlog::trace("Mapped {} ({} bytes)", file_path_, size_);
+    }
+
+    void MappedFile::close()
+    {
+        if (data_)
+        {
+            UnmapViewOfFile(data_);
+            data_ = nullptr;
+        }
+        if (mapping_handle_)
+        {
+            CloseHandle(mapping_handle_);
+            mapping_handle_ = nullptr;
+        }
+        if (file_handle_)
+        {
+            CloseHandle(file_handle_);
+            file_handle_ = nullptr;
+        }
+        size_ = 0;
+    }
+#else
+    MappedFile::MappedFile(const std::string &file_path) : file_path_(file_path)
+    {
+        int fd = ::open(file_path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Failed to open file for mapping: " + file_path);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("Failed to get the size of " + file_path);
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ == 0)
+        {
+            // Empty files cannot be mapped
+            ::close(fd);
+            return;
+        }
+
+        void *data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            size_ = 0;
+            throw std::runtime_error("Failed to map file: " + file_path);
+        }
+        // Readers go through the file front to back
+        ::madvise(data, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const std::byte *>(data);
+        spdlog::trace("Mapped {} ({} bytes)", file_path_, size_);
+    }
+
+    void MappedFile::close()
+    {
+        if (data_)
+        {
+            ::munmap(const_cast<std::byte *>(data_), size_);
+            data_ = nullptr;
+        }
+        size_ = 0;
+    }
+#endif
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+} // namespace engine::utils
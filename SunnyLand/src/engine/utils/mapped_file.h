@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace engine::utils
+{
+    /// @brief Read-only memory mapping of a whole file. Pages are read by the OS on first access,
+    /// so loading large files costs no copy into an intermediate buffer.
+    class MappedFile final
+    {
+    private:
+        std::string file_path_;
+        const std::byte *data_ = nullptr;
+        std::size_t size_ = 0;
+#ifdef _WIN32
+        void *file_handle_ = nullptr;
+        void *mapping_handle_ = nullptr;
+#endif
+
+        void close();
+
+    public:
+        /// @brief Maps the file. Throws std::runtime_error if it cannot be opened or mapped.
+        explicit MappedFile(const std::string &file_path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile(MappedFile &&) = delete;
+        MappedFile &operator=(MappedFile &&) = delete;
+
+        const std::string &getFilePath() const { return file_path_; }
+        /// @brief Contents of the file. Empty files map to an empty span.
+        std::span<const std::byte> getBytes() const { return {data_, size_}; }
+        std::size_t size() const { return size_; }
+    };
+} // namespace engine::utils
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+
+namespace engine::utils
+{
+    /// @brief Small deterministic random number generator (splitmix64 seeded xorshift64*).
+    /// Produces the same sequence on every platform for a given seed, which replays rely on.
+    class Random final
+    {
+    private:
+        std::uint64_t state_ = 0x9E3779B97F4A7C15ull;
+        std::uint64_t seed_ = 0;
+
+    public:
+        explicit Random(std::uint64_t seed = 0) { setSeed(seed); }
+
+        void setSeed(std::uint64_t seed)
+        {
+            seed_ = seed;
+            // splitmix64 so that small seeds still give a well mixed, non-zero state
+            std::uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            state_ = (z ^ (z >> 31)) | 1ull;
+        }
+
+        std::uint64_t getSeed() const { return seed_; }
+        std::uint64_t getState() const { return state_; }
+
+        std::uint64_t nextU64()
+        {
+            state_ ^= state_ >> 12;
+            state_ ^= state_ << 25;
+            state_ ^= state_ >> 27;
+            return state_ * 0x2545F4914F6CDD1Dull;
+        }
+
+        /// @brief Returns a float in [0, 1).
+        float nextFloat()
+        {
+            return static_cast<float>(nextU64() >> 40) * (1.0f / 16777216.0f);
+        }
+
+        /// @brief Returns a float in [min, max).
+        float range(float min, float max)
+        {
+            return min + (max - min) * nextFloat();
+        }
+    };
+} // namespace engine::utils
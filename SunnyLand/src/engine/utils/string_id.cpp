@@ -0,0 +1,68 @@
+#include "string_id.h"
+#include <deque>
+#include <shared_mutex>
+#include <mutex>
+#include <unordered_map>
+#include <stdexcept>
+
+namespace engine::utils
+{
+    namespace
+    {
+        struct Table
+        {
+            std::shared_mutex mutex;
+            // A deque never moves its elements, so the string_view keys and returned references stay valid
+            std::deque<std::string> strings{std::string()};
+            std::unordered_map<std::string_view, StringId> ids{{std::string_view(), EMPTY_STRING_ID}};
+        };
+
+        Table &table()
+        {
+            static Table instance;
+            return instance;
+        }
+    }
+
+    StringId StringTable::intern(std::string_view str)
+    {
+        Table &t = table();
+        {
+            std::shared_lock lock(t.mutex);
+            auto it = t.ids.find(str);
+            if (it != t.ids.end())
+            {
+                return it->second;
+            }
+        }
+
+        std::unique_lock lock(t.mutex);
+        auto it = t.ids.find(str);
+        if (it != t.ids.end())
+        {
+            return it->second;
+        }
+        auto id = static_cast<StringId>(t.strings.size());
+        const std::string &stored = t.strings.emplace_back(str);
+        t.ids.emplace(std::string_view(stored), id);
+        return id;
+    }
+
+    const std::string &StringTable::lookup(StringId id)
+    {
+        Table &t = table();
+        std::shared_lock lock(t.mutex);
+        if (id >= t.strings.size())
+        {
+            throw std::out_of_range("Unknown string id: " + std::to_string(id));
+        }
+        return t.strings[id];
+    }
+
+    std::size_t StringTable::size()
+    {
+        Table &t = table();
+        std::shared_lock lock(t.mutex);
+        return t.strings.size();
+    }
+} // namespace engine::utils
@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace engine::utils
+{
+    /// @brief Small integer standing for an interned string, e.g. a texture path.
+    /// Cheap to copy, compare and store in trivially copyable components.
+    using StringId = std::uint32_t;
+
+    /// @brief Id of the empty string.
+    constexpr StringId EMPTY_STRING_ID = 0;
+
+    /// @brief Process-wide string interning table. Thread-safe.
+    class StringTable final
+    {
+    public:
+        StringTable() = delete;
+
+        /// @brief Returns the id of the string, adding it to the table on first use.
+        static StringId intern(std::string_view str);
+
+        /// @brief Returns the string of an id. The reference stays valid for the whole run.
+        static const std::string &lookup(StringId id);
+
+        /// @brief Number of interned strings, including the empty string.
+        static std::size_t size();
+    };
+} // namespace engine::utils
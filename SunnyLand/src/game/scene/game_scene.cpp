@@ -0,0 +1,370 @@
+#include "game_scene.h"
+#include "menu_scene.h"
+#include "../../engine/core/context.h"
+#include "../../engine/render/camera.h"
+#include "../../engine/render/render_snapshot.h"
+#include "../../engine/scene/scene_manager.h"
+#include "../../engine/ecs/world.h"
+#include "../../engine/ecs/components.h"
+#include "../../engine/animation/animation_library.h"
+#include "../../engine/animation/animator.h"
+#include "../../engine/physics/collider.h"
+#include "../../engine/utils/random.h"
+#include "../../engine/utils/string_id.h"
+#include "../../engine/utils/hash.h"
+#include "../../engine/audio/sound_queue.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+namespace game::scene
+{
+    namespace
+    {
+        constexpr engine::physics::CollisionLayers ACTOR_LAYER = 1u << 0;
+        constexpr engine::physics::CollisionLayers ITEM_LAYER = 1u << 1;
+        constexpr engine::physics::CollisionLayers TRIGGER_LAYER = 1u << 2;
+
+        constexpr const char *LEVEL_PATH = "assets/maps/level1.tmj";
+        /// @brief Tile layer of the level that actors collide with.
+        constexpr const char *COLLISION_LAYER = "ground";
+        constexpr const char *BURST_SOUND_PATH = "assets/audio/punch2a.mp3";
+    }
+
+    GameScene::GameScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager)
+        : Scene("GameScene", context, scene_manager)
+    {
+    }
+
+    engine::resource::ResourceManifest GameScene::getResources() const
+    {
+        engine::resource::ResourceManifest manifest;
+        manifest.textures = {
+            "assets/textures/Actors/frog.png",
+            "assets/textures/Actors/eagle-attack.png",
+            "assets/textures/FX/enemy-deadth.png",
+            "assets/textures/FX/item-feedback.png",
+            "assets/textures/UI/buttons/Start1.png",
+            "assets/textures/UI/buttons/Start2.png",
+            "assets/textures/UI/buttons/Start3.png",
+            "assets/textures/UI/Heart.png",
+            "assets/textures/UI/Heart-bg.png",
+            "assets/textures/Layers/back.png",
+            "assets/textures/Layers/tileset.png",
+        };
+        manifest.sounds = {BURST_SOUND_PATH};
+        return manifest;
+    }
+
+    void GameScene::init()
+    {
+        context_.getCamera().setPosition(glm::vec2(0.0f, 0.0f));
+        loadLevel();
+        spawnActors();
+        createEmitters();
+        createHud();
+        Scene::init();
+    }
+
+    void GameScene::createHud()
+    {
+        constexpr int HEART_COUNT = 3;
+        constexpr float HEART_SCALE = 0.4f;
+        const SDL_FRect heart_rect = {0.0f, 0.0f, 98.0f * HEART_SCALE, 87.0f * HEART_SCALE};
+        engine::ui::WidgetId hearts = hud_.addImage(engine::utils::EMPTY_STRING_ID, {16.0f, 16.0f, 0.0f, 0.0f});
+        for (int i = 0; i < HEART_COUNT; ++i)
+        {
+            SDL_FRect rect = heart_rect;
+            rect.x = static_cast<float>(i) * (heart_rect.w + 4.0f);
+            engine::ui::WidgetId background = hud_.addImage("assets/textures/UI/Heart-bg.png", rect, hearts);
+            hud_.addImage("assets/textures/UI/Heart.png", {0.0f, 0.0f, 97.0f * HEART_SCALE, heart_rect.h}, background);
+        }
+        start_button_ = hud_.addButton("assets/textures/UI/buttons/Start1.png", "assets/textures/UI/buttons/Start2.png",
+                                       "assets/textures/UI/buttons/Start3.png", {100.0f, 100.0f, 96.0f, 32.0f});
+    }
+
+    void GameScene::update(float)
+    {
+        if (context_.isKeyPressed(SDL_SCANCODE_ESCAPE))
+        {
+            scene_manager_.requestPushScene(std::make_unique<MenuScene>(context_, scene_manager_));
+            return;
+        }
+
+        testCamera();
+        if (level_streamer_)
+        {
+            level_streamer_->update(context_.getCamera());
+        }
+        testParticles();
+        hud_.update(context_.getInput());
+        if (hud_.getClicked() == start_button_)
+        {
+            spdlog::info("Start button clicked");
+        }
+        test_rotation_ += 0.1f;
+        context_.markAnimating();
+    }
+
+    void GameScene::render(engine::render::RenderSnapshot &snapshot) const
+    {
+        engine::render::Sprite sprite_world("assets/textures/Actors/frog.png");
+        engine::render::Sprite sprite_parallax("assets/textures/Layers/back.png");
+
+        // 注意渲染顺序: the snapshot draws parallax, world sprites and UI in that order
+        snapshot.addParallax(sprite_parallax, glm::vec2(100, 100), glm::vec2(0.5f, 0.5f), glm::bvec2(true, false));
+        renderLevel(snapshot);
+        snapshot.addSprite(sprite_world, glm::vec2(200, 200), glm::vec2(1.0f, 1.0f), test_rotation_);
+        hud_.extract(snapshot);
+    }
+
+    void GameScene::clean()
+    {
+        engine::ecs::CommandBuffer &commands = context_.getWorld().getCommandBuffer();
+        for (engine::ecs::Entity actor : actors_)
+        {
+            commands.destroyEntity(actor);
+        }
+        actors_.clear();
+        engine::particles::ParticleSystem &particles = context_.getParticles();
+        particles.destroyEmitter(sparkle_emitter_);
+        particles.destroyEmitter(burst_emitter_);
+        // The streamer's thread reads from the map, so it goes first
+        level_streamer_.reset();
+        level_map_.reset();
+        level_collision_ = {};
+        tileset_textures_.clear();
+        Scene::clean();
+    }
+
+    std::uint64_t GameScene::computeChecksum(std::uint64_t seed) const
+    {
+        return engine::utils::fnv1a64Value(std::bit_cast<std::uint32_t>(test_rotation_), seed);
+    }
+
+    void GameScene::spawnActors()
+    {
+        engine::ecs::World &world = context_.getWorld();
+        engine::utils::Random &random = context_.getRandom();
+        const engine::animation::AnimationLibrary &animations = context_.getAnimations();
+        const engine::animation::AnimationClipId clips[] = {
+            animations.findClip("frog_idle"),
+            animations.findClip("frog_blink"),
+            animations.findClip("eagle_attack"),
+        };
+
+        for (int i = 0; i < 32; ++i)
+        {
+            engine::ecs::Transform transform;
+            transform.position = glm::vec2(random.range(0.0f, 1200.0f), random.range(0.0f, 650.0f));
+            engine::ecs::Velocity velocity{glm::vec2(random.range(-40.0f, 40.0f), random.range(-40.0f, 40.0f))};
+            engine::ecs::SpriteComponent sprite;
+            sprite.is_flipped = velocity.value.x > 0.0f;
+
+            // The AnimationSystem fills in texture and rect; actors whose clip is missing stay invisible
+            engine::animation::Animator animator;
+            animator.play(clips[i % 3]);
+            animator.time = random.range(0.0f, 1.0f);
+            engine::physics::Collider collider;
+            collider.size = glm::vec2(32.0f, 32.0f);
+            collider.layers = ACTOR_LAYER;
+            collider.mask = ACTOR_LAYER | ITEM_LAYER | TRIGGER_LAYER;
+            actors_.push_back(world.createEntity(transform, velocity, sprite, animator, collider));
+        }
+    }
+
+    void GameScene::loadLevel()
+    {
+        try
+        {
+            level_map_ = std::make_unique<engine::level::TiledMap>(LEVEL_PATH);
+            level_streamer_ = std::make_unique<engine::level::LevelStreamer>(*level_map_);
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("Failed to load level {}: {}", LEVEL_PATH, e.what());
+            level_streamer_.reset();
+            level_map_.reset();
+            return;
+        }
+        for (const engine::level::TiledTileset &tileset : level_map_->getTilesets())
+        {
+            tileset_textures_.push_back(engine::utils::StringTable::intern(tileset.image));
+        }
+        buildLevelCollision();
+        const engine::level::TileRect &bounds = level_map_->getBounds();
+        spdlog::info("Level {}: {}x{} tiles, {} bytes of chunk buffers, {} bytes of collision", LEVEL_PATH, bounds.width, bounds.height,
+                     level_streamer_->getMemoryUsage(), level_collision_.getMemoryUsage());
+    }
+
+    void GameScene::buildLevelCollision()
+    {
+        const engine::level::TiledMap &map = *level_map_;
+        const auto &layers = map.getTileLayers();
+        auto layer = std::find_if(layers.begin(), layers.end(), [](const engine::level::TiledTileLayer &l)
+                                  { return l.name == COLLISION_LAYER; });
+        if (layer == layers.end())
+        {
+            spdlog::warn("Level {} has no '{}' layer, actors will not collide with it", LEVEL_PATH, COLLISION_LAYER);
+            return;
+        }
+        // The grid starts at tile (0, 0), while infinite maps may extend to negative tiles
+        if (map.isInfinite())
+        {
+            spdlog::warn("Level {} is an infinite map, its collision is not supported", LEVEL_PATH);
+            return;
+        }
+
+        const engine::level::TileRect &bounds = map.getBounds();
+        std::vector<std::uint32_t> tiles(static_cast<std::size_t>(bounds.width) * static_cast<std::size_t>(bounds.height));
+        std::ifstream file(map.getFilePath(), std::ios::binary);
+        if (!file || !map.readTiles(file, static_cast<std::size_t>(layer - layers.begin()), bounds, tiles))
+        {
+            spdlog::error("Failed to read the '{}' layer of {}", COLLISION_LAYER, LEVEL_PATH);
+            return;
+        }
+
+        // The tilesets carry no collision properties yet, so every tile of the layer is solid
+        std::uint32_t last_gid = 0;
+        for (const engine::level::TiledTileset &tileset : map.getTilesets())
+        {
+            last_gid = std::max(last_gid, tileset.first_gid + static_cast<std::uint32_t>(tileset.tile_count) - 1);
+        }
+        std::vector<engine::physics::TileType> types(last_gid + 1, engine::physics::TileType::Solid);
+        types[0] = engine::physics::TileType::Empty;
+        level_collision_ = engine::physics::TileCollisionMap::fromTiles(bounds.width, bounds.height, static_cast<float>(map.getTileWidth()),
+                                                                        tiles, types);
+    }
+
+    void GameScene::renderLevel(engine::render::RenderSnapshot &snapshot) const
+    {
+        if (!level_streamer_)
+        {
+            return;
+        }
+        const engine::render::Camera &camera = context_.getCamera();
+        const glm::vec2 tile_size(static_cast<float>(level_map_->getTileWidth()), static_cast<float>(level_map_->getTileHeight()));
+        const glm::ivec2 view_min(glm::floor(camera.getPosition() / tile_size));
+        const glm::ivec2 view_max(glm::floor((camera.getPosition() + camera.getViewportSize()) / tile_size));
+        const engine::level::TileRect view{view_min.x, view_min.y, view_max.x - view_min.x + 1, view_max.y - view_min.y + 1};
+
+        std::vector<engine::render::SpriteInstance> &tiles = snapshot.getTiles();
+        level_streamer_->forEachChunk(view, [&](const engine::level::StreamedChunk &chunk)
+                                      { renderChunk(chunk, view, tiles); });
+    }
+
+    void GameScene::renderChunk(const engine::level::StreamedChunk &chunk, const engine::level::TileRect &view,
+                                std::vector<engine::render::SpriteInstance> &tiles) const
+    {
+        const engine::level::TiledMap &map = *level_map_;
+        const auto &layers = map.getTileLayers();
+        const auto &tilesets = map.getTilesets();
+        const glm::vec2 tile_size(static_cast<float>(map.getTileWidth()), static_cast<float>(map.getTileHeight()));
+        const int chunk_size = level_streamer_->getChunkSize();
+        const glm::ivec2 origin(chunk.chunk_x * chunk_size, chunk.chunk_y * chunk_size);
+
+        // Only the part of the chunk in view
+        const int x0 = std::max(view.x - origin.x, 0);
+        const int y0 = std::max(view.y - origin.y, 0);
+        const int x1 = std::min(view.x + view.width - origin.x, chunk_size);
+        const int y1 = std::min(view.y + view.height - origin.y, chunk_size);
+        for (std::size_t layer = 0; layer < layers.size(); ++layer)
+        {
+            if (!layers[layer].visible)
+            {
+                continue;
+            }
+            const std::uint32_t *layer_tiles = chunk.tiles.data() + layer * level_streamer_->getTilesPerLayer();
+            int tileset = -1;
+            for (int y = y0; y < y1; ++y)
+            {
+                for (int x = x0; x < x1; ++x)
+                {
+                    const std::uint32_t raw = layer_tiles[y * chunk_size + x];
+                    const std::uint32_t gid = raw & engine::level::TILE_GID_MASK;
+                    if (gid == 0)
+                        continue;
+                    // Neighbouring tiles nearly always come from the same tileset
+                    if (tileset < 0 || gid < tilesets[tileset].first_gid ||
+                        gid - tilesets[tileset].first_gid >= static_cast<std::uint32_t>(tilesets[tileset].tile_count))
+                        tileset = map.findTileset(gid);
+                    if (tileset < 0)
+                        continue;
+                    const glm::vec2 position = glm::vec2(origin + glm::ivec2(x, y)) * tile_size + layers[layer].offset;
+                    tiles.push_back({tileset_textures_[tileset], tilesets[tileset].getSourceRect(gid), position, glm::vec2(1.0f, 1.0f), 0.0f,
+                                     (raw & engine::level::TILE_FLIPPED_HORIZONTALLY) != 0});
+                }
+            }
+        }
+    }
+
+    void GameScene::createEmitters()
+    {
+        engine::particles::ParticleSystem &particles = context_.getParticles();
+        engine::utils::Random &random = context_.getRandom();
+
+        engine::particles::EmitterSettings sparkle;
+        sparkle.texture_id = engine::utils::StringTable::intern("assets/textures/FX/item-feedback.png");
+        sparkle.source_rect = {0.0f, 0.0f, 40.0f, 32.0f};
+        sparkle.frame_count = 4;
+        sparkle.max_particles = 512;
+        sparkle.emit_rate = 60.0f;
+        sparkle.speed_min = 20.0f;
+        sparkle.speed_max = 60.0f;
+        sparkle.direction = -1.5707963f;
+        sparkle.spread = 1.2f;
+        sparkle.gravity = {0.0f, 40.0f};
+        sparkle.size_start = 0.6f;
+        sparkle.size_end = 0.2f;
+        sparkle.size_variance = 0.2f;
+        sparkle_emitter_ = particles.createEmitter(sparkle, {600.0f, 300.0f}, random.nextU64());
+
+        engine::particles::EmitterSettings burst;
+        burst.texture_id = engine::utils::StringTable::intern("assets/textures/FX/enemy-deadth.png");
+        burst.source_rect = {0.0f, 0.0f, 40.0f, 41.0f};
+        burst.frame_count = 6;
+        burst.max_particles = 4096;
+        burst.lifetime_min = 0.4f;
+        burst.lifetime_max = 0.8f;
+        burst.speed_min = 30.0f;
+        burst.speed_max = 160.0f;
+        burst.drag = 2.0f;
+        burst.size_start = 0.8f;
+        burst.size_end = 0.3f;
+        burst.color_end = {1.0f, 0.6f, 0.4f, 0.0f};
+        burst_emitter_ = particles.createEmitter(burst, {0.0f, 0.0f}, random.nextU64());
+    }
+
+    void GameScene::testParticles()
+    {
+        engine::particles::ParticleEmitter *emitter = context_.getParticles().getEmitter(burst_emitter_);
+        if (emitter && !actors_.empty() && context_.isKeyPressed(SDL_SCANCODE_SPACE))
+        {
+            engine::utils::Random &random = context_.getRandom();
+            engine::ecs::Entity actor = actors_[static_cast<std::size_t>(random.nextU64() % actors_.size())];
+            if (const auto *transform = context_.getWorld().getComponent<engine::ecs::Transform>(actor))
+            {
+                emitter->setPosition(transform->position);
+                emitter->burst(64);
+                context_.getSounds().play(BURST_SOUND_PATH, transform->position);
+            }
+        }
+    }
+
+    void GameScene::testCamera()
+    {
+        engine::render::Camera &camera = context_.getCamera();
+        glm::vec2 old_position = camera.getPosition();
+        if (context_.isKeyDown(SDL_SCANCODE_UP))
+            camera.move(glm::vec2(0, -1));
+        if (context_.isKeyDown(SDL_SCANCODE_DOWN))
+            camera.move(glm::vec2(0, 1));
+        if (context_.isKeyDown(SDL_SCANCODE_LEFT))
+            camera.move(glm::vec2(-1, 0));
+        if (context_.isKeyDown(SDL_SCANCODE_RIGHT))
+            camera.move(glm::vec2(1, 0));
+        if (camera.getPosition() != old_position)
+            context_.requestRedraw();
+    }
+} // namespace game::scene
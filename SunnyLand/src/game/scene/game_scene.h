@@ -0,0 +1,63 @@
+#pragma once
+#include "../../engine/scene/scene.h"
+#include "../../engine/ecs/entity.h"
+#include "../../engine/particles/particle_system.h"
+#include "../../engine/level/tiled_map.h"
+#include "../../engine/level/level_streamer.h"
+#include "../../engine/physics/tile_collision_map.h"
+#include "../../engine/utils/string_id.h"
+#include "../../engine/ui/ui_layer.h"
+#include <memory>
+#include <vector>
+
+namespace engine::render
+{
+    struct SpriteInstance;
+}
+
+namespace game::scene
+{
+    /// @brief The playable level. For now it hosts the renderer and camera test content.
+    class GameScene final : public engine::scene::Scene
+    {
+    private:
+        float test_rotation_ = 0.0f;
+        std::vector<engine::ecs::Entity> actors_;
+        engine::particles::EmitterId sparkle_emitter_;
+        engine::particles::EmitterId burst_emitter_;
+        std::unique_ptr<engine::level::TiledMap> level_map_;
+        std::unique_ptr<engine::level::LevelStreamer> level_streamer_;
+        /// @brief Collision grid of the level's ground layer, for moveBox(). Empty without a level.
+        engine::physics::TileCollisionMap level_collision_;
+        /// @brief Interned image path of each tileset of level_map_.
+        std::vector<engine::utils::StringId> tileset_textures_;
+        /// @brief Hearts and the test button, composited once and redrawn only when the button changes state.
+        engine::ui::UILayer hud_;
+        engine::ui::WidgetId start_button_ = engine::ui::NO_WIDGET;
+
+        void testCamera();
+        void spawnActors();
+        void createEmitters();
+        void createHud();
+        /// @brief Indexes the level map and starts streaming it. The scene still runs without a level if that fails.
+        void loadLevel();
+        /// @brief Reads the whole ground layer once into level_collision_. Leaves it empty on failure.
+        void buildLevelCollision();
+        /// @brief Adds the tiles of the loaded chunks in view to the snapshot.
+        void renderLevel(engine::render::RenderSnapshot &snapshot) const;
+        void renderChunk(const engine::level::StreamedChunk &chunk, const engine::level::TileRect &view,
+                         std::vector<engine::render::SpriteInstance> &tiles) const;
+        /// @brief Space bursts death particles at a random actor.
+        void testParticles();
+
+    public:
+        GameScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager);
+
+        engine::resource::ResourceManifest getResources() const override;
+        void init() override;
+        void update(float delta_time) override;
+        void render(engine::render::RenderSnapshot &snapshot) const override;
+        void clean() override;
+        std::uint64_t computeChecksum(std::uint64_t seed) const override;
+    };
+} // namespace game::scene
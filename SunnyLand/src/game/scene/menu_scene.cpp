@@ -0,0 +1,157 @@
+#include "menu_scene.h"
+#include "../../engine/core/context.h"
+#include "../../engine/render/camera.h"
+#include "../../engine/render/render_snapshot.h"
+#include "../../engine/scene/scene_manager.h"
+#include "../../engine/save/world_serializer.h"
+#include <filesystem>
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace game::scene
+{
+    namespace
+    {
+        constexpr const char *QUICK_SAVE_PATH = "saves/quicksave.slsv";
+        constexpr const char *BUTTON_NAMES[] = {"Resume", "Save", "Load", "Quit"};
+
+        std::string buttonTexture(const char *name, int frame)
+        {
+            return "assets/textures/UI/buttons/" + std::string(name) + std::to_string(frame) + ".png";
+        }
+    }
+
+    MenuScene::MenuScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager)
+        : Scene("MenuScene", context, scene_manager)
+    {
+    }
+
+    engine::resource::ResourceManifest MenuScene::getResources() const
+    {
+        engine::resource::ResourceManifest manifest;
+        for (const char *name : BUTTON_NAMES)
+        {
+            for (int frame = 1; frame <= 3; ++frame)
+            {
+                manifest.textures.push_back(buttonTexture(name, frame));
+            }
+        }
+        return manifest;
+    }
+
+    void MenuScene::init()
+    {
+        // UI is drawn at window resolution, centered over where the world appears
+        const engine::render::Camera &camera = context_.getCamera();
+        glm::vec2 origin = camera.getScreenOffset();
+        glm::vec2 screen = camera.getScreenSize();
+        glm::vec2 button_size(96.0f * 2.0f, 32.0f * 2.0f);
+        float spacing = button_size.y * 1.25f;
+        float x = origin.x + (screen.x - button_size.x) * 0.5f;
+        float y = origin.y + (screen.y - button_size.y - spacing * (BUTTON_COUNT - 1)) * 0.5f;
+
+        // Frame 2 of a button is its highlighted state, frame 3 its pressed state
+        for (int button = 0; button < BUTTON_COUNT; ++button)
+        {
+            const char *name = BUTTON_NAMES[button];
+            buttons_[button] = ui_.addButton(buttonTexture(name, 1), buttonTexture(name, 2), buttonTexture(name, 3),
+                                             {x, y + spacing * static_cast<float>(button), button_size.x, button_size.y});
+        }
+        ui_.setFocus(buttons_[selected_]);
+        Scene::init();
+    }
+
+    void MenuScene::update(float)
+    {
+        if (context_.isKeyPressed(SDL_SCANCODE_ESCAPE))
+        {
+            scene_manager_.requestPopScene();
+            return;
+        }
+
+        std::uint64_t ui_revision = ui_.getRevision();
+        ui_.update(context_.getInput());
+        for (int button = 0; button < BUTTON_COUNT; ++button)
+        {
+            if (ui_.getHovered() == buttons_[button])
+            {
+                selected_ = button;
+            }
+        }
+        if (context_.isKeyPressed(SDL_SCANCODE_UP))
+        {
+            selected_ = (selected_ + BUTTON_COUNT - 1) % BUTTON_COUNT;
+        }
+        if (context_.isKeyPressed(SDL_SCANCODE_DOWN))
+        {
+            selected_ = (selected_ + 1) % BUTTON_COUNT;
+        }
+        ui_.setFocus(buttons_[selected_]);
+        if (ui_.getRevision() != ui_revision)
+        {
+            context_.requestRedraw();
+        }
+
+        engine::ui::WidgetId clicked = ui_.getClicked();
+        for (int button = 0; button < BUTTON_COUNT; ++button)
+        {
+            if (clicked == buttons_[button])
+            {
+                activate(button);
+                return;
+            }
+        }
+        if (context_.isKeyPressed(SDL_SCANCODE_RETURN))
+        {
+            activate(selected_);
+        }
+    }
+
+    void MenuScene::activate(int button)
+    {
+        switch (button)
+        {
+        case RESUME_BUTTON:
+            scene_manager_.requestPopScene();
+            break;
+        case SAVE_BUTTON:
+            try
+            {
+                std::filesystem::create_directories(std::filesystem::path(QUICK_SAVE_PATH).parent_path());
+                engine::save::WorldSerializer::save(context_.getWorld(), QUICK_SAVE_PATH);
+            }
+            catch (const std::exception &e)
+            {
+                spdlog::error("Saving failed: {}", e.what());
+            }
+            break;
+        case LOAD_BUTTON:
+            if (!std::filesystem::exists(QUICK_SAVE_PATH))
+            {
+                spdlog::warn("Nothing to load, {} does not exist", QUICK_SAVE_PATH);
+                break;
+            }
+            try
+            {
+                engine::save::WorldSerializer::load(context_.getWorld(), QUICK_SAVE_PATH);
+                context_.requestRedraw();
+                scene_manager_.requestPopScene();
+            }
+            catch (const std::exception &e)
+            {
+                spdlog::error("Loading failed: {}", e.what());
+            }
+            break;
+        case QUIT_BUTTON:
+            context_.requestQuit();
+            break;
+        default:
+            break;
+        }
+    }
+
+    void MenuScene::render(engine::render::RenderSnapshot &snapshot) const
+    {
+        ui_.extract(snapshot);
+    }
+} // namespace game::scene
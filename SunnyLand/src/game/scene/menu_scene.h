@@ -0,0 +1,36 @@
+#pragma once
+#include "../../engine/scene/scene.h"
+#include "../../engine/ui/ui_layer.h"
+#include <array>
+
+namespace game::scene
+{
+    /// @brief Pause menu pushed on top of the game scene. The game underneath is still drawn but not updated.
+    /// Buttons are picked with the arrow keys and Enter, or with the mouse. Save and Load write and read
+    /// the whole ECS world to a single quick-save file.
+    class MenuScene final : public engine::scene::Scene
+    {
+    private:
+        engine::ui::UILayer ui_;
+        // Buttons from top to bottom
+        static constexpr int RESUME_BUTTON = 0;
+        static constexpr int SAVE_BUTTON = 1;
+        static constexpr int LOAD_BUTTON = 2;
+        static constexpr int QUIT_BUTTON = 3;
+        static constexpr int BUTTON_COUNT = 4;
+
+        std::array<engine::ui::WidgetId, BUTTON_COUNT> buttons_{};
+        int selected_ = RESUME_BUTTON;
+
+        void activate(int button);
+
+    public:
+        MenuScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager);
+
+        engine::resource::ResourceManifest getResources() const override;
+        void init() override;
+        void update(float delta_time) override;
+        void render(engine::render::RenderSnapshot &snapshot) const override;
+        bool pausesWorld() const override { return true; }
+    };
+} // namespace game::scene
@@ -0,0 +1,243 @@
+#include "stress_scene.h"
+#include "../../engine/core/context.h"
+#include "../../engine/render/camera.h"
+#include "../../engine/render/render_snapshot.h"
+#include "../../engine/scene/scene_manager.h"
+#include "../../engine/ecs/world.h"
+#include "../../engine/ecs/components.h"
+#include "../../engine/animation/animation_library.h"
+#include "../../engine/animation/animator.h"
+#include "../../engine/utils/random.h"
+#include "../../engine/utils/string_id.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace game::scene
+{
+    namespace
+    {
+        /// @brief Rotation speed of a stress actor, in degrees per second.
+        struct Spin
+        {
+            static constexpr std::string_view COMPONENT_NAME = "Spin";
+
+            float speed = 0.0f;
+        };
+
+        /// @brief Frames skipped after spawning, while caches and allocations settle.
+        constexpr int SETTLE_FRAMES = 30;
+        constexpr int MEASURED_FRAMES = 120;
+        constexpr int MAX_SPRITES = 2000000;
+        /// @brief Largest actor frame, so bouncing actors stay fully in view.
+        constexpr float ACTOR_SIZE = 41.0f;
+
+        constexpr const char *FALLBACK_TEXTURE = "assets/textures/Actors/foxy.png";
+    }
+
+    StressScene::StressScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager, const StressSettings &settings)
+        : Scene("StressScene", context, scene_manager), settings_(settings)
+    {
+        settings_.start_count = std::max(settings_.start_count, 1);
+        settings_.step = std::max(settings_.step, 1);
+    }
+
+    engine::resource::ResourceManifest StressScene::getResources() const
+    {
+        engine::resource::ResourceManifest manifest;
+        manifest.textures = {
+            "assets/textures/Actors/eagle-attack.png",
+            "assets/textures/Actors/frog.png",
+            "assets/textures/Actors/opossum.png",
+            FALLBACK_TEXTURE,
+            "assets/textures/Layers/back.png",
+            "assets/textures/Layers/middle.png",
+        };
+        return manifest;
+    }
+
+    void StressScene::init()
+    {
+        engine::ecs::ComponentRegistry::registerTypes<Spin>();
+        context_.getCamera().setPosition(glm::vec2(0.0f, 0.0f));
+        const engine::animation::AnimationLibrary &animations = context_.getAnimations();
+        for (const char *name : {"eagle_attack", "frog_idle", "opossum_run"})
+        {
+            engine::animation::AnimationClipId clip = animations.findClip(name);
+            if (clip != engine::animation::INVALID_ANIMATION_CLIP)
+            {
+                clips_.push_back(clip);
+            }
+        }
+        if (clips_.empty())
+        {
+            spdlog::warn("Stress test: no actor animations found, drawing static sprites");
+        }
+        spin_query_ = &context_.getWorld().query<engine::ecs::Transform, engine::ecs::Velocity, Spin>();
+
+        spdlog::info("Stress test: starting at {} sprites, adding {} per step while frames stay under {:.2f} ms",
+                     settings_.start_count, settings_.step, settings_.budget_ms);
+        spawn(settings_.start_count);
+        Scene::init();
+    }
+
+    void StressScene::spawn(int count)
+    {
+        engine::ecs::World &world = context_.getWorld();
+        engine::utils::Random &random = context_.getRandom();
+        const glm::vec2 area = context_.getCamera().getViewportSize() - glm::vec2(ACTOR_SIZE, ACTOR_SIZE);
+        const engine::utils::StringId fallback_texture = engine::utils::StringTable::intern(FALLBACK_TEXTURE);
+
+        actors_.reserve(actors_.size() + static_cast<std::size_t>(count));
+        for (int i = 0; i < count; ++i)
+        {
+            engine::ecs::Transform transform;
+            transform.position = glm::vec2(random.range(0.0f, area.x), random.range(0.0f, area.y));
+            transform.rotation = random.range(0.0f, 360.0f);
+            engine::ecs::Velocity velocity{glm::vec2(random.range(-80.0f, 80.0f), random.range(-80.0f, 80.0f))};
+            Spin spin{random.range(-180.0f, 180.0f)};
+            engine::ecs::SpriteComponent sprite;
+            sprite.is_flipped = velocity.value.x > 0.0f;
+
+            if (clips_.empty())
+            {
+                sprite.texture_id = fallback_texture;
+                actors_.push_back(world.createEntity(transform, velocity, spin, sprite));
+                continue;
+            }
+            // The AnimationSystem fills in texture and rect
+            engine::animation::Animator animator;
+            animator.play(clips_[static_cast<std::size_t>(actors_.size()) % clips_.size()]);
+            animator.time = random.range(0.0f, 1.0f);
+            actors_.push_back(world.createEntity(transform, velocity, spin, sprite, animator));
+        }
+        step_frames_ = 0;
+        step_sums_ = {};
+    }
+
+    void StressScene::spinAndBounce(float delta_time)
+    {
+        const glm::vec2 area = context_.getCamera().getViewportSize() - glm::vec2(ACTOR_SIZE, ACTOR_SIZE);
+        spin_query_->forEachArchetype([&](engine::ecs::Archetype &archetype)
+                                      {
+                                          auto transforms = archetype.column<engine::ecs::Transform>();
+                                          auto velocities = archetype.column<engine::ecs::Velocity>();
+                                          auto spins = archetype.column<Spin>();
+                                          for (std::size_t i = 0; i < transforms.size(); ++i)
+                                          {
+                                              engine::ecs::Transform &transform = transforms[i];
+                                              glm::vec2 &velocity = velocities[i].value;
+                                              transform.rotation += spins[i].speed * delta_time;
+                                              // Actors that left the view would be culled and no longer cost anything
+                                              if ((transform.position.x < 0.0f && velocity.x < 0.0f) || (transform.position.x > area.x && velocity.x > 0.0f))
+                                                  velocity.x = -velocity.x;
+                                              if ((transform.position.y < 0.0f && velocity.y < 0.0f) || (transform.position.y > area.y && velocity.y > 0.0f))
+                                                  velocity.y = -velocity.y;
+                                          } });
+    }
+
+    void StressScene::update(float delta_time)
+    {
+        if (context_.isKeyPressed(SDL_SCANCODE_ESCAPE))
+        {
+            report(false);
+            return;
+        }
+
+        spinAndBounce(delta_time);
+        context_.markAnimating();
+
+        const engine::core::FrameTimings &timings = context_.getLastFrame();
+        if (!finished_ && timings.frame != last_frame_)
+        {
+            last_frame_ = timings.frame;
+            measure(timings);
+        }
+    }
+
+    void StressScene::measure(const engine::core::FrameTimings &timings)
+    {
+        // The first frame seen after spawning may still have been drawn with the old count
+        if (++step_frames_ <= SETTLE_FRAMES)
+        {
+            return;
+        }
+        step_sums_.frame_ms += timings.frame_ms;
+        step_sums_.simulation_ms += timings.simulation_ms;
+        step_sums_.render_ms += timings.render_ms;
+        step_sums_.draw_calls += static_cast<double>(timings.draw_calls);
+        step_sums_.allocations += static_cast<double>(timings.allocations);
+        if (step_frames_ == SETTLE_FRAMES + MEASURED_FRAMES)
+        {
+            endStep();
+        }
+    }
+
+    void StressScene::endStep()
+    {
+        StepResult step;
+        step.sprites = static_cast<int>(actors_.size());
+        step.frame_ms = step_sums_.frame_ms / MEASURED_FRAMES;
+        step.simulation_ms = step_sums_.simulation_ms / MEASURED_FRAMES;
+        step.render_ms = step_sums_.render_ms / MEASURED_FRAMES;
+        step.draw_calls = step_sums_.draw_calls / MEASURED_FRAMES;
+        step.allocations = step_sums_.allocations / MEASURED_FRAMES;
+        spdlog::info("Stress: {:>8} sprites  {:7.2f} ms/frame  (simulate {:6.2f} ms, render {:6.2f} ms)  {:8.0f} draw calls  {:7.1f} allocations/frame",
+                     step.sprites, step.frame_ms, step.simulation_ms, step.render_ms, step.draw_calls, step.allocations);
+
+        if (step.frame_ms > settings_.budget_ms)
+        {
+            report(true);
+            return;
+        }
+        best_ = step;
+        has_best_ = true;
+        if (step.sprites >= MAX_SPRITES)
+        {
+            report(false);
+            return;
+        }
+        spawn(std::min(settings_.step, MAX_SPRITES - step.sprites));
+    }
+
+    void StressScene::report(bool exceeded)
+    {
+        if (finished_)
+        {
+            return;
+        }
+        finished_ = true;
+        if (has_best_)
+        {
+            spdlog::info("Stress result: {} sprites sustainable within {:.2f} ms: {:.2f} ms/frame (simulate {:.2f} ms, render {:.2f} ms), {:.0f} draw calls",
+                         best_.sprites, settings_.budget_ms, best_.frame_ms, best_.simulation_ms, best_.render_ms, best_.draw_calls);
+        }
+        else if (exceeded)
+        {
+            spdlog::info("Stress result: {} sprites already exceed {:.2f} ms per frame", actors_.size(), settings_.budget_ms);
+        }
+        else
+        {
+            spdlog::info("Stress test stopped before the first step was measured");
+        }
+        context_.requestQuit();
+    }
+
+    void StressScene::render(engine::render::RenderSnapshot &snapshot) const
+    {
+        snapshot.addParallax(engine::render::Sprite("assets/textures/Layers/back.png"), glm::vec2(0.0f, 0.0f),
+                             glm::vec2(0.0f, 0.0f), glm::bvec2(true, true), glm::vec2(3.0f, 3.0f));
+        snapshot.addParallax(engine::render::Sprite("assets/textures/Layers/middle.png"), glm::vec2(0.0f, 160.0f),
+                             glm::vec2(0.0f, 0.0f), glm::bvec2(true, false), glm::vec2(3.0f, 3.0f));
+    }
+
+    void StressScene::clean()
+    {
+        engine::ecs::CommandBuffer &commands = context_.getWorld().getCommandBuffer();
+        for (engine::ecs::Entity actor : actors_)
+        {
+            commands.destroyEntity(actor);
+        }
+        actors_.clear();
+        Scene::clean();
+    }
+} // namespace game::scene
@@ -0,0 +1,75 @@
+#pragma once
+#include "../../engine/scene/scene.h"
+#include "../../engine/ecs/entity.h"
+#include "../../engine/animation/animation_clip.h"
+#include <vector>
+
+namespace engine::ecs
+{
+    class Query;
+}
+
+namespace engine::core
+{
+    struct FrameTimings;
+}
+
+namespace game::scene
+{
+    struct StressSettings
+    {
+        /// @brief Sprites spawned before the first measurement.
+        int start_count = 1000;
+        /// @brief Sprites added after every step that stayed within the budget.
+        int step = 1000;
+        /// @brief Longest average frame time that still counts as sustainable.
+        double budget_ms = 1000.0 / 60.0;
+    };
+
+    /// @brief Finds the engine's ceiling: animated, rotating actors over parallax layers, ramped up step by step
+    /// until the average frame takes longer than the budget. Logs every step and the largest sustainable count,
+    /// then quits.
+    class StressScene final : public engine::scene::Scene
+    {
+    private:
+        /// @brief Averages over the measured frames of one step.
+        struct StepResult
+        {
+            int sprites = 0;
+            double frame_ms = 0.0;
+            double simulation_ms = 0.0;
+            double render_ms = 0.0;
+            double draw_calls = 0.0;
+            double allocations = 0.0;
+        };
+
+        StressSettings settings_;
+        std::vector<engine::ecs::Entity> actors_;
+        std::vector<engine::animation::AnimationClipId> clips_;
+        engine::ecs::Query *spin_query_ = nullptr;
+
+        std::uint64_t last_frame_ = 0;
+        int step_frames_ = 0;
+        StepResult step_sums_;
+        StepResult best_;
+        bool has_best_ = false;
+        bool finished_ = false;
+
+        void spawn(int count);
+        void spinAndBounce(float delta_time);
+        /// @brief Adds a newly drawn frame to the current step, and ends the step once enough frames were measured.
+        void measure(const engine::core::FrameTimings &timings);
+        void endStep();
+        /// @brief Logs the largest sustainable step and quits. exceeded tells whether the current step went over budget.
+        void report(bool exceeded);
+
+    public:
+        StressScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager, const StressSettings &settings);
+
+        engine::resource::ResourceManifest getResources() const override;
+        void init() override;
+        void update(float delta_time) override;
+        void render(engine::render::RenderSnapshot &snapshot) const override;
+        void clean() override;
+    };
+} // namespace game::scene
@@ -0,0 +1,68 @@
+#include "title_scene.h"
+#include "game_scene.h"
+#include "../../engine/core/context.h"
+#include "../../engine/render/camera.h"
+#include "../../engine/render/render_snapshot.h"
+#include "../../engine/scene/scene_manager.h"
+#include <spdlog/spdlog.h>
+
+namespace game::scene
+{
+    TitleScene::TitleScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager)
+        : Scene("TitleScene", context, scene_manager)
+    {
+    }
+
+    engine::resource::ResourceManifest TitleScene::getResources() const
+    {
+        engine::resource::ResourceManifest manifest;
+        manifest.textures = {
+            "assets/textures/Layers/back.png",
+            "assets/textures/Layers/middle.png",
+            "assets/textures/UI/title-screen.png",
+            "assets/textures/UI/press-enter-text.png",
+        };
+        return manifest;
+    }
+
+    void TitleScene::init()
+    {
+        context_.getCamera().setPosition(glm::vec2(0.0f, 0.0f));
+        Scene::init();
+    }
+
+    void TitleScene::update(float)
+    {
+        if (context_.isKeyPressed(SDL_SCANCODE_RETURN))
+        {
+            spdlog::info("Starting game");
+            // The game scene loads in the background; the title keeps running until it is ready
+            scene_manager_.requestReplaceScene(std::make_unique<GameScene>(context_, scene_manager_));
+        }
+        else if (context_.isKeyPressed(SDL_SCANCODE_ESCAPE))
+        {
+            context_.requestQuit();
+        }
+    }
+
+    void TitleScene::render(engine::render::RenderSnapshot &snapshot) const
+    {
+        // UI is drawn at window resolution, centered over where the world appears
+        const engine::render::Camera &camera = context_.getCamera();
+        glm::vec2 origin = camera.getScreenOffset();
+        glm::vec2 screen = camera.getScreenSize();
+
+        snapshot.addParallax(engine::render::Sprite("assets/textures/Layers/back.png"), glm::vec2(0.0f, 0.0f),
+                             glm::vec2(0.0f, 0.0f), glm::bvec2(true, true), glm::vec2(3.0f, 3.0f));
+        snapshot.addParallax(engine::render::Sprite("assets/textures/Layers/middle.png"), glm::vec2(0.0f, 160.0f),
+                             glm::vec2(0.0f, 0.0f), glm::bvec2(true, false), glm::vec2(3.0f, 3.0f));
+
+        glm::vec2 title_size(194.0f * 3.0f, 38.0f * 3.0f);
+        snapshot.addUISprite(engine::render::Sprite("assets/textures/UI/title-screen.png"),
+                             origin + glm::vec2((screen.x - title_size.x) * 0.5f, screen.y * 0.25f), title_size);
+
+        glm::vec2 hint_size(76.0f * 3.0f, 12.0f * 3.0f);
+        snapshot.addUISprite(engine::render::Sprite("assets/textures/UI/press-enter-text.png"),
+                             origin + glm::vec2((screen.x - hint_size.x) * 0.5f, screen.y * 0.65f), hint_size);
+    }
+} // namespace game::scene
@@ -0,0 +1,17 @@
+#pragma once
+#include "../../engine/scene/scene.h"
+
+namespace game::scene
+{
+    /// @brief Title screen. Static, so it is never redrawn in on-demand mode unless something changes.
+    class TitleScene final : public engine::scene::Scene
+    {
+    public:
+        TitleScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager);
+
+        engine::resource::ResourceManifest getResources() const override;
+        void init() override;
+        void update(float delta_time) override;
+        void render(engine::render::RenderSnapshot &snapshot) const override;
+    };
+} // namespace game::scene
@@ -1,9 +1,59 @@
 #include "engine/core/game_app.h"
+#include "engine/core/app_config.h"
+#include "engine/scene/scene_manager.h"
+#include "game/scene/title_scene.h"
+#include "game/scene/stress_scene.h"
 #include <spdlog/spdlog.h>
-int main(int, char **)
+#include <spdlog/async.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+namespace
 {
-    spdlog::set_level(spdlog::level::warn);
-    engine::core::GameApp app;
-    app.run();
+    void setupInitialScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager)
+    {
+        scene_manager.requestPushScene(std::make_unique<game::scene::TitleScene>(context, scene_manager));
+    }
+
+    void setupLogging(spdlog::level::level_enum level)
+    {
+        // Messages are formatted and written on a background thread; when the queue is full the oldest are
+        // dropped instead of stalling a frame. Errors flush right away so they survive a crash.
+        spdlog::init_thread_pool(8192, 1);
+        auto logger = spdlog::create_async_nb<spdlog::sinks::stdout_color_sink_mt>("sunnyland");
+        logger->flush_on(spdlog::level::err);
+        spdlog::set_default_logger(logger);
+        spdlog::set_level(level);
+        // ENGINE_LOG_* calls below the compile-time level no longer exist in the binary
+        if (static_cast<int>(level) < SPDLOG_ACTIVE_LEVEL)
+        {
+            const auto compiled_level = static_cast<spdlog::level::level_enum>(SPDLOG_ACTIVE_LEVEL);
+            spdlog::warn("Log level {} requested, but this build compiles out engine messages below {}; build in Debug to see them",
+                         spdlog::level::to_string_view(level), spdlog::level::to_string_view(compiled_level));
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    auto config = engine::core::AppConfig::fromCommandLine(argc, argv);
+    setupLogging(config.log_level);
+    {
+        engine::core::GameApp app(config);
+        if (config.stress)
+        {
+            game::scene::StressSettings settings;
+            settings.start_count = config.stress_start_count;
+            settings.step = config.stress_step;
+            settings.budget_ms = config.stress_budget_ms;
+            app.registerSceneSetup([settings](engine::core::Context &context, engine::scene::SceneManager &scene_manager)
+                                   { scene_manager.requestPushScene(std::make_unique<game::scene::StressScene>(context, scene_manager, settings)); });
+        }
+        else
+        {
+            app.registerSceneSetup(setupInitialScene);
+        }
+        app.run();
+    }
+    spdlog::shutdown();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,91 @@
+// Writes the cooked (MessagePack) copy next to every JSON asset whose copy is missing or stale.
+// Loaders going through engine::utils::loadJson() pick the copies up but never write them, so run this after
+// changing large assets. Files below COOKED_JSON_MIN_SIZE are skipped: their text parses faster.
+//   SunnyLand-cook-assets [--force] [directory or file ...]   (default: assets)
+// Tiled maps (.tmj) are not cooked: they are indexed by SAX and their tiles are read from the text on demand.
+#include "../src/engine/utils/json_cache.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    bool isCookable(const std::filesystem::path &path)
+    {
+        std::string extension = path.extension().string();
+        return extension == ".json" || extension == ".tsj";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool force = false;
+    std::vector<std::filesystem::path> roots;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+        if (arg == "--force")
+        {
+            force = true;
+        }
+        else
+        {
+            roots.emplace_back(arg);
+        }
+    }
+    if (roots.empty())
+    {
+        roots.emplace_back("assets");
+    }
+
+    std::size_t cooked = 0;
+    std::size_t up_to_date = 0;
+    std::size_t skipped = 0;
+    std::size_t failed = 0;
+    auto cook = [&](const std::filesystem::path &path)
+    {
+        switch (engine::utils::cookJson(path.string(), force))
+        {
+        case engine::utils::CookResult::Cooked:
+            ++cooked;
+            break;
+        case engine::utils::CookResult::UpToDate:
+            ++up_to_date;
+            break;
+        case engine::utils::CookResult::TooSmall:
+            ++skipped;
+            break;
+        case engine::utils::CookResult::Failed:
+            ++failed;
+            break;
+        }
+    };
+    for (const std::filesystem::path &root : roots)
+    {
+        std::error_code error;
+        if (std::filesystem::is_regular_file(root, error))
+        {
+            cook(root);
+            continue;
+        }
+        std::filesystem::recursive_directory_iterator it(root, error);
+        if (error)
+        {
+            std::fprintf(stderr, "Cannot read %s: %s\n", root.string().c_str(), error.message().c_str());
+            ++failed;
+            continue;
+        }
+        for (const auto &entry : it)
+        {
+            if (entry.is_regular_file() && isCookable(entry.path()))
+            {
+                cook(entry.path());
+            }
+        }
+    }
+
+    std::printf("%zu JSON files cooked, %zu up to date, %zu too small to cook, %zu failed\n", cooked, up_to_date, skipped, failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,320 @@
+// Replays a render capture against SDL's software renderer, without a window or the game, and times every frame.
+// Capture with --capture-render <file> [--capture-frames N] or F4 in the game, then run from the game directory,
+// where the captured image paths resolve:
+//   SunnyLand-render-replay <capture> [--repeat N] [--csv file] [--dump-bmp file]
+// --csv writes the time of every frame, --dump-bmp the last frame as an image, e.g. to compare two builds.
+#include "../src/engine/render/render_capture.h"
+#include "../src/engine/render/particle_geometry.h"
+#include "../src/engine/core/frame_stats.h"
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    using engine::render::CaptureCommand;
+    using engine::render::CaptureOp;
+    using engine::render::RenderCaptureData;
+
+    struct Options
+    {
+        std::string capture_path;
+        int repeat = 1;
+        std::string csv_path;
+        std::string bmp_path;
+    };
+
+    /// @brief Images are loaded again from their paths; missing ones are replaced by a magenta texture of the same
+    /// size so the frame costs stay comparable. Render targets are created empty.
+    std::vector<SDL_Texture *> createTextures(SDL_Renderer *renderer, const RenderCaptureData &capture)
+    {
+        std::vector<SDL_Texture *> textures;
+        textures.reserve(capture.textures.size());
+        for (const engine::render::CaptureTexture &entry : capture.textures)
+        {
+            SDL_Texture *texture = nullptr;
+            if (!entry.path.empty())
+            {
+                texture = IMG_LoadTexture(renderer, entry.path.c_str());
+                if (!texture)
+                {
+                    std::fprintf(stderr, "Cannot load %s, using a placeholder: %s\n", entry.path.c_str(), SDL_GetError());
+                }
+            }
+            if (!texture)
+            {
+                texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                            std::max(entry.header.width, 1), std::max(entry.header.height, 1));
+                if (!texture)
+                {
+                    throw std::runtime_error(std::string("Failed to create texture: ") + SDL_GetError());
+                }
+                if (!entry.path.empty())
+                {
+                    SDL_SetRenderTarget(renderer, texture);
+                    SDL_SetRenderDrawColor(renderer, 255, 0, 255, 255);
+                    SDL_RenderClear(renderer);
+                    SDL_SetRenderTarget(renderer, nullptr);
+                }
+            }
+            SDL_SetTextureBlendMode(texture, static_cast<SDL_BlendMode>(entry.header.blend_mode));
+            SDL_SetTextureScaleMode(texture, static_cast<SDL_ScaleMode>(entry.header.scale_mode));
+            textures.push_back(texture);
+        }
+        return textures;
+    }
+
+    class Replayer
+    {
+    private:
+        SDL_Renderer *renderer_;
+        const RenderCaptureData &capture_;
+        const std::vector<SDL_Texture *> &textures_;
+        std::vector<int> quad_indices_;
+
+        SDL_Texture *getTexture(std::uint32_t index) const
+        {
+            return index == engine::render::CAPTURE_NO_TEXTURE ? nullptr : textures_[index];
+        }
+
+        void execute(const CaptureCommand &command)
+        {
+            switch (command.op)
+            {
+            case CaptureOp::SetTarget:
+                SDL_SetRenderTarget(renderer_, getTexture(command.texture));
+                break;
+            case CaptureOp::SetDrawColor:
+                SDL_SetRenderDrawColorFloat(renderer_, command.color.r, command.color.g, command.color.b, command.color.a);
+                break;
+            case CaptureOp::SetBlendMode:
+                SDL_SetRenderDrawBlendMode(renderer_, static_cast<SDL_BlendMode>(command.value));
+                break;
+            case CaptureOp::SetClip:
+            {
+                const SDL_Rect clip = {static_cast<int>(command.rect.x), static_cast<int>(command.rect.y),
+                                       static_cast<int>(command.rect.w), static_cast<int>(command.rect.h)};
+                SDL_SetRenderClipRect(renderer_, command.flags != 0 ? &clip : nullptr);
+                break;
+            }
+            case CaptureOp::Clear:
+                SDL_RenderClear(renderer_);
+                break;
+            case CaptureOp::FillRect:
+                SDL_RenderFillRect(renderer_, &command.rect);
+                break;
+            case CaptureOp::Texture:
+            {
+                const SDL_FRect *source = (command.flags & engine::render::CAPTURE_HAS_SOURCE) ? &command.source : nullptr;
+                if (command.flags & engine::render::CAPTURE_ROTATED)
+                {
+                    SDL_RenderTextureRotated(renderer_, getTexture(command.texture), source, &command.rect, command.rotation, nullptr, command.flip);
+                }
+                else
+                {
+                    SDL_RenderTexture(renderer_, getTexture(command.texture), source, &command.rect);
+                }
+                break;
+            }
+            case CaptureOp::Quads:
+                SDL_RenderGeometry(renderer_, getTexture(command.texture), capture_.vertices.data() + command.first_vertex,
+                                   static_cast<int>(command.value * 4), quad_indices_.data(), static_cast<int>(command.value * 6));
+                break;
+            case CaptureOp::Present:
+                SDL_RenderPresent(renderer_);
+                break;
+            }
+        }
+
+    public:
+        Replayer(SDL_Renderer *renderer, const RenderCaptureData &capture, const std::vector<SDL_Texture *> &textures)
+            : renderer_(renderer), capture_(capture), textures_(textures)
+        {
+            std::size_t max_quads = 0;
+            for (const CaptureCommand &command : capture.commands)
+            {
+                if (command.op == CaptureOp::Quads)
+                {
+                    max_quads = std::max<std::size_t>(max_quads, command.value);
+                }
+            }
+            engine::render::buildQuadIndices(max_quads, quad_indices_);
+        }
+
+        /// @brief Issues the commands of one frame and returns the time until its present finished, in ms.
+        /// The software renderer batches commands until present, so that is where most of the time is spent.
+        double replayFrame(std::size_t frame)
+        {
+            const std::size_t begin = frame == 0 ? 0 : capture_.frame_ends[frame - 1];
+            const std::size_t end = capture_.frame_ends[frame];
+            const Uint64 start = SDL_GetTicksNS();
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                execute(capture_.commands[i]);
+            }
+            return static_cast<double>(SDL_GetTicksNS() - start) / 1000000.0;
+        }
+    };
+
+    bool parseOptions(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+            bool has_value = i + 1 < argc;
+            if (arg == "--repeat" && has_value)
+            {
+                options.repeat = std::max(1, std::atoi(argv[++i]));
+            }
+            else if (arg == "--csv" && has_value)
+            {
+                options.csv_path = argv[++i];
+            }
+            else if (arg == "--dump-bmp" && has_value)
+            {
+                options.bmp_path = argv[++i];
+            }
+            else if (options.capture_path.empty() && !arg.starts_with("--"))
+            {
+                options.capture_path = arg;
+            }
+            else
+            {
+                std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+                return false;
+            }
+        }
+        return !options.capture_path.empty();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "Usage: %s <capture> [--repeat N] [--csv file] [--dump-bmp file]\n", argv[0]);
+        return 2;
+    }
+
+    RenderCaptureData capture;
+    try
+    {
+        capture = engine::render::loadRenderCapture(options.capture_path);
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    if (capture.frame_ends.empty() || capture.output_width <= 0 || capture.output_height <= 0)
+    {
+        std::fprintf(stderr, "The capture has no frames\n");
+        return 1;
+    }
+    // Opened before replaying, so a bad path fails at once instead of after the whole run
+    std::FILE *csv = options.csv_path.empty() ? nullptr : std::fopen(options.csv_path.c_str(), "w");
+    if (!options.csv_path.empty() && !csv)
+    {
+        std::fprintf(stderr, "Failed to write %s: %s\n", options.csv_path.c_str(), std::strerror(errno));
+        return 1;
+    }
+
+    SDL_Surface *surface = SDL_CreateSurface(capture.output_width, capture.output_height, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Renderer *renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!renderer)
+    {
+        std::fprintf(stderr, "Failed to create the software renderer: %s\n", SDL_GetError());
+        SDL_DestroySurface(surface);
+        if (csv)
+        {
+            std::fclose(csv);
+        }
+        return 1;
+    }
+
+    int result = 0;
+    try
+    {
+        std::vector<SDL_Texture *> textures = createTextures(renderer, capture);
+        Replayer replayer(renderer, capture, textures);
+        const std::size_t frame_count = capture.frame_ends.size();
+        std::printf("%s: %zu frames at %dx%d, %zu commands, %zu textures, %zu vertices\n", options.capture_path.c_str(), frame_count,
+                    capture.output_width, capture.output_height, capture.commands.size(), capture.textures.size(), capture.vertices.size());
+
+        engine::core::FrameStats stats(frame_count * static_cast<std::size_t>(options.repeat));
+        // Time of each frame, summed over the passes
+        std::vector<double> frame_ms(frame_count, 0.0);
+        if (csv)
+        {
+            std::fprintf(csv, "pass,frame,commands,ms\n");
+        }
+        for (int pass = 0; pass < options.repeat; ++pass)
+        {
+            for (std::size_t frame = 0; frame < frame_count; ++frame)
+            {
+                double ms = replayer.replayFrame(frame);
+                stats.addSample(ms);
+                frame_ms[frame] += ms;
+                if (csv)
+                {
+                    std::size_t commands = capture.frame_ends[frame] - (frame == 0 ? 0 : capture.frame_ends[frame - 1]);
+                    std::fprintf(csv, "%d,%zu,%zu,%.4f\n", pass, frame, commands, ms);
+                }
+            }
+        }
+
+        engine::core::FrameStats::Summary summary = stats.summarize();
+        std::printf("frame ms: avg %.3f  min %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f\n", summary.avg_ms, summary.min_ms,
+                    summary.p50_ms, summary.p95_ms, summary.p99_ms, summary.max_ms);
+
+        std::vector<std::size_t> slowest(frame_count);
+        for (std::size_t i = 0; i < frame_count; ++i)
+        {
+            slowest[i] = i;
+        }
+        const std::size_t shown = std::min<std::size_t>(5, frame_count);
+        std::partial_sort(slowest.begin(), slowest.begin() + static_cast<std::ptrdiff_t>(shown), slowest.end(),
+                          [&](std::size_t a, std::size_t b)
+                          { return frame_ms[a] > frame_ms[b]; });
+        std::printf("slowest frames:");
+        for (std::size_t i = 0; i < shown; ++i)
+        {
+            std::printf(" %zu (%.3f ms)", slowest[i], frame_ms[slowest[i]] / options.repeat);
+        }
+        std::printf("\n");
+
+        if (!options.bmp_path.empty() && !SDL_SaveBMP(surface, options.bmp_path.c_str()))
+        {
+            std::fprintf(stderr, "Failed to write %s: %s\n", options.bmp_path.c_str(), SDL_GetError());
+            result = 1;
+        }
+        for (SDL_Texture *texture : textures)
+        {
+            SDL_DestroyTexture(texture);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        result = 1;
+    }
+
+    if (csv && std::fclose(csv) != 0)
+    {
+        std::fprintf(stderr, "Failed to write %s: %s\n", options.csv_path.c_str(), std::strerror(errno));
+        result = 1;
+    }
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    SDL_Quit();
+    return result;
+}